@@ -34,6 +34,8 @@ public:
 
   void onAcceptWorker(Network::ConnectionSocketPtr&&, bool, bool) override {}
 
+  Event::Dispatcher& dispatcher() override { return handler_.dispatcher(); }
+
   // Create Dlb event and callback.
   void setDlbEvent();
 
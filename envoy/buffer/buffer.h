@@ -122,6 +122,31 @@ public:
    */
   virtual void credit(uint64_t amount) PURE;
 
+  /**
+   * Charges the account for memory the stream holds outside of buffers, such as its header maps.
+   * Unlike buffer memory, which slices credit back when they are released, this memory must be
+   * credited with creditNonBuffer() by whoever charged it.
+   *
+   * @param amount the amount to debit.
+   */
+  virtual void chargeNonBuffer(uint64_t amount) PURE;
+
+  /**
+   * Credits the account for memory charged with chargeNonBuffer() that is no longer used.
+   *
+   * @param amount the amount to credit.
+   */
+  virtual void creditNonBuffer(uint64_t amount) PURE;
+
+  /**
+   * Sets the connection and stream charged to the account, to identify the account when it is
+   * reported by the admin interface.
+   *
+   * @param connection_id the id of the downstream connection of the stream.
+   * @param stream_id the id of the stream.
+   */
+  virtual void setOwner(uint64_t connection_id, uint64_t stream_id) PURE;
+
   /**
    * Clears the associated downstream with this account.
    * After this has been called, calls to reset the downstream become no-ops.
@@ -575,6 +600,15 @@ public:
    * @return the number of streams reset
    */
   virtual uint64_t resetAccountsGivenPressure(float pressure) PURE;
+
+  /**
+   * Resets the streams of the tracked accounts with the largest balances, largest first.
+   *
+   * @param pressure scaled threshold pressure used to compute the number of
+   *  streams to reset, up to the number configured for the factory.
+   * @return the number of streams reset
+   */
+  virtual uint64_t resetLargestAccounts(float pressure) PURE;
 };
 
 using WatermarkFactoryPtr = std::unique_ptr<WatermarkFactory>;
@@ -187,6 +187,22 @@ public:
   virtual void initializeStats(Stats::Scope& scope,
                                const absl::optional<std::string>& prefix = absl::nullopt) PURE;
 
+  /**
+   * Initializes stats of the time spent in each category of callback and of the depth of the post
+   * queue, and starts keeping the slowest callbacks of this dispatcher for the admin interface.
+   * This reads the clock around every callback, so it is meant to diagnose event loop stalls. The
+   * stats share the prefix of the dispatcher stats, so initializeStats() must be called first.
+   * @param scope the scope to contain the new per-dispatcher stats created here.
+   */
+  virtual void initializeCallbackStats(Stats::Scope& scope) PURE;
+
+  /**
+   * Returns the cumulative time the event loop spent processing events, rather than polling for
+   * new ones. This is only tracked once stats have been initialized with initializeStats(), and is
+   * zero before. This is safe to call from any thread.
+   */
+  virtual std::chrono::microseconds loopBusyTime() const PURE;
+
   /**
    * Clears any items in the deferred deletion queue.
    */
@@ -3,6 +3,10 @@
 #include "envoy/network/listen_socket.h"
 
 namespace Envoy {
+namespace Event {
+class Dispatcher;
+} // namespace Event
+
 namespace Network {
 
 /**
@@ -33,6 +37,12 @@ public:
    */
   virtual void post(Network::ConnectionSocketPtr&& socket) PURE;
 
+  /**
+   * @return the dispatcher of the worker running this handler. Balancers can use it to schedule
+   *         work on the worker, or to observe its load.
+   */
+  virtual Event::Dispatcher& dispatcher() PURE;
+
   virtual void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                               bool hand_off_restored_destination_connections, bool rebalanced) PURE;
 };
@@ -471,6 +471,17 @@ public:
    */
   virtual RetryStatus shouldHedgeRetryPerTryTimeout(DoRetryCallback callback) PURE;
 
+  /**
+   * Determine whether a hedged request should be sent because the request has been outstanding
+   * for longer than the route's proactive hedging delay. Like a hedged retry on per try timeout,
+   * the original request is not canceled.
+   * @param callback supplies the callback that will be invoked when the hedged request should be
+   *                 sent. The callback will never be called inline.
+   * @return RetryStatus if a hedged request should be sent. @param callback will be called at
+   *         some point in the future. Otherwise the callback will never be called.
+   */
+  virtual RetryStatus shouldHedgeProactively(DoRetryCallback callback) PURE;
+
   /**
    * Called when a host was attempted but the request failed and is eligible for another retry.
    * Should be used to update whatever internal state depends on previously attempted hosts.
@@ -743,6 +754,37 @@ public:
 
 using VirtualHostConstSharedPtr = std::shared_ptr<const VirtualHost>;
 
+/**
+ * Latency based hedging state of a route. It is shared by all workers and must be thread safe.
+ */
+class ProactiveHedging {
+public:
+  virtual ~ProactiveHedging() = default;
+
+  /**
+   * @return the delay after which a hedged request should be sent if no response headers have
+   *         been received, or absl::nullopt if not enough latencies have been recorded yet.
+   */
+  virtual absl::optional<std::chrono::milliseconds> hedgeDelay() const PURE;
+
+  /**
+   * Record the time it took to receive response headers for a request routed to the route.
+   * @param latency supplies the latency measured from the end of the downstream request.
+   */
+  virtual void recordLatency(std::chrono::milliseconds latency) PURE;
+
+  /**
+   * Called for every request that may be hedged. Used to size the hedging budget.
+   */
+  virtual void onRequest() PURE;
+
+  /**
+   * Charge a hedged request against the hedging budget.
+   * @return bool false if the hedged request would exceed the budget and should not be sent.
+   */
+  virtual bool tryHedge() PURE;
+};
+
 /**
  * Route level hedging policy.
  */
@@ -767,6 +809,12 @@ public:
    * will be canceled immediately.
    */
   virtual bool hedgeOnPerTryTimeout() const PURE;
+
+  /**
+   * @return ProactiveHedging* the latency based hedging state of the route, or nullptr if requests
+   *         should not be hedged before a per try timeout.
+   */
+  virtual ProactiveHedging* proactiveHedging() const PURE;
 };
 
 class MetadataMatchCriterion {
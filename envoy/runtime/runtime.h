@@ -27,6 +27,45 @@ class ClusterManager;
 
 namespace Runtime {
 
+class KeyHandleRegistry;
+
+/**
+ * A runtime key resolved ahead of time to an index into the values of every snapshot, so that
+ * looking up the value of the key does not need to hash it. Handles are obtained once, e.g. at
+ * configuration time, from Runtime::KeyHandleRegistry, and shared by all the users of a key. The
+ * index of a key is released for another key once the last reference to its handle is gone.
+ */
+class KeyHandle {
+public:
+  /**
+   * @return const std::string& the runtime key.
+   */
+  const std::string& key() const { return key_; }
+
+  /**
+   * @return uint32_t the index of the key in the values of the snapshots.
+   */
+  uint32_t index() const { return index_; }
+
+  /**
+   * @return uint64_t the generation of the handle, which is unique to the handle among all the
+   *         handles that used its index.
+   */
+  uint64_t generation() const { return generation_; }
+
+private:
+  friend KeyHandleRegistry;
+
+  KeyHandle(absl::string_view key, uint32_t index, uint64_t generation)
+      : key_(key), index_(index), generation_(generation) {}
+
+  const std::string key_;
+  const uint32_t index_;
+  const uint64_t generation_;
+};
+
+using KeyHandleConstSharedPtr = std::shared_ptr<const KeyHandle>;
+
 /**
  * A snapshot of runtime data.
  */
@@ -201,6 +240,44 @@ public:
    */
   virtual bool getBoolean(absl::string_view key, bool default_value) const PURE;
 
+  /**
+   * Test if a feature is enabled using the built in random generator, looking up the runtime key
+   * through its handle. @see featureEnabled(absl::string_view, const FractionalPercent&)
+   * @param key supplies the handle of the feature key to lookup.
+   * @param default_value supplies the default value that will be used if either the feature key
+   *        does not exist or it is not a fractional percent.
+   * @return true if the feature is enabled.
+   */
+  virtual bool featureEnabled(const KeyHandle& key,
+                              const envoy::type::v3::FractionalPercent& default_value) const PURE;
+
+  /**
+   * Fetch an integer runtime key through its handle. @see getInteger(absl::string_view, uint64_t)
+   * @param key supplies the handle of the key to fetch.
+   * @param default_value supplies the value to return if the key does not exist or it does not
+   *        contain an integer.
+   * @return uint64_t the runtime value or the default value.
+   */
+  virtual uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const PURE;
+
+  /**
+   * Fetch a double runtime key through its handle.
+   * @param key supplies the handle of the key to fetch.
+   * @param default_value supplies the value to return if the key does not exist or it does not
+   *        contain a double.
+   * @return double the runtime value or the default value.
+   */
+  virtual double getDouble(const KeyHandle& key, double default_value) const PURE;
+
+  /**
+   * Fetch a boolean runtime key through its handle.
+   * @param key supplies the handle of the key to fetch.
+   * @param default_value supplies the value to return if the key does not exist or it does not
+   *        contain a boolean.
+   * @return bool the runtime value or the default value.
+   */
+  virtual bool getBoolean(const KeyHandle& key, bool default_value) const PURE;
+
   /**
    * Fetch the OverrideLayers that provide values in this snapshot. Layers are ordered from bottom
    * to top; for instance, the second layer's entries override the first layer's entries, and so on.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -38,6 +39,8 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/singleton/threadsafe_singleton.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 
 namespace Regex {
@@ -66,6 +69,16 @@ public:
    */
   virtual Event::Dispatcher& mainThreadDispatcher() PURE;
 
+  /**
+   * @param affinity if set, the health checkers created with the same affinity are run on the same
+   *        thread, e.g. so that they can share their probes. Otherwise the dedicated health check
+   *        threads are used in turn.
+   * @return Event::Dispatcher& the dispatcher to run the active health checks of a cluster on. This
+   *         is the dispatcher of one of the dedicated health check threads, or the main thread's
+   *         dispatcher if there are none.
+   */
+  virtual Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) PURE;
+
   /**
    * @return Api::Api& a reference to the api object.
    */
@@ -7,6 +7,8 @@
 #include "envoy/server/factory_context.h"
 #include "envoy/upstream/health_checker.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Server {
 namespace Configuration {
@@ -31,6 +33,15 @@ public:
    */
   virtual Event::Dispatcher& mainThreadDispatcher() PURE;
 
+  /**
+   * @param affinity if set, the health checkers created with the same affinity are run on the same
+   *        thread. @see ServerFactoryContext::healthCheckDispatcher()
+   * @return Event::Dispatcher& the dispatcher to run the health checks on. This is either the main
+   *         thread's dispatcher or the one of a dedicated health check thread. It should only be
+   *         called once per health checker.
+   */
+  virtual Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) PURE;
+
   /*
    * @return Upstream::HealthCheckEventLoggerPtr the health check event logger for the
    * created health checkers. This function may not be idempotent.
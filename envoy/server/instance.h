@@ -33,6 +33,8 @@
 #include "envoy/tracing/tracer.h"
 #include "envoy/upstream/cluster_manager.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 
 namespace Stats {
@@ -89,6 +91,16 @@ public:
    */
   virtual Event::Dispatcher& dispatcher() PURE;
 
+  /**
+   * @param affinity if set, the health checkers created with the same affinity are run on the same
+   *        thread, e.g. so that they can share their probes. Otherwise the dedicated health check
+   *        threads are used in turn.
+   * @return Event::Dispatcher& the dispatcher to run the active health checks of a cluster on. This
+   *         is the dispatcher of one of the dedicated health check threads, or the main thread's
+   *         dispatcher if there are none.
+   */
+  virtual Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) PURE;
+
   /**
    * @return Network::DnsResolverSharedPtr the singleton DNS resolver for the server.
    */
@@ -39,16 +39,20 @@ public:
   // Overload action to reset streams using excessive memory.
   const std::string ResetStreams = "envoy.overload_actions.reset_high_memory_stream";
 
+  // Overload action to reset the streams using the most memory.
+  const std::string ResetLargestStreams = "envoy.overload_actions.reset_largest_memory_streams";
+
   // This should be kept current with the Overload actions available.
   // This is the last member of this class to duplicating the strings with
   // proper lifetime guarantees.
-  const std::array<absl::string_view, 7> WellKnownActions = {StopAcceptingRequests,
+  const std::array<absl::string_view, 8> WellKnownActions = {StopAcceptingRequests,
                                                              DisableHttpKeepAlive,
                                                              StopAcceptingConnections,
                                                              RejectIncomingConnections,
                                                              ShrinkHeap,
                                                              ReduceTimeouts,
-                                                             ResetStreams};
+                                                             ResetStreams,
+                                                             ResetLargestStreams};
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
@@ -60,6 +64,10 @@ class OverloadActionStatsNameValues {
 public:
   // Count of the number of streams the reset streams action has reset
   const std::string ResetStreamsCount = "envoy.overload_actions.reset_high_memory_stream.count";
+
+  // Count of the number of streams the reset largest streams action has reset
+  const std::string ResetLargestStreamsCount =
+      "envoy.overload_actions.reset_largest_memory_streams.count";
 };
 
 using OverloadActionStatsNames = ConstSingleton<OverloadActionStatsNameValues>;
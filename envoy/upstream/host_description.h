@@ -225,6 +225,22 @@ public:
    */
   virtual HostStats& stats() const PURE;
 
+  /**
+   * @return host specific stats if they have been allocated. Implementations may only allocate
+   *         them on the first call to stats(), in which case a host without them has not used them
+   *         yet and all its stats are zero. This allows reading the stats of many hosts without
+   *         allocating them.
+   */
+  virtual OptRef<HostStats> statsIfAllocated() const PURE;
+
+  /**
+   * @return the number of active requests to the host, without allocating its stats.
+   */
+  uint64_t activeRequests() const {
+    const OptRef<HostStats> stats = statsIfAllocated();
+    return stats.has_value() ? stats->rq_active_.value() : 0;
+  }
+
   /**
    * @return custom stats for multi-dimensional load balancing.
    */
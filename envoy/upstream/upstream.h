@@ -636,9 +636,11 @@ public:
   COUNTER(assignment_stale)                                                                        \
   COUNTER(assignment_timeout_received)                                                             \
   COUNTER(assignment_use_cached)                                                                   \
+  COUNTER(health_update_merged)                                                                    \
   COUNTER(update_attempt)                                                                          \
   COUNTER(update_empty)                                                                            \
   COUNTER(update_failure)                                                                          \
+  COUNTER(update_incremental)                                                                      \
   COUNTER(update_no_rebuild)                                                                       \
   COUNTER(update_success)                                                                          \
   GAUGE(version, NeverImport)                                                                      \
@@ -713,6 +715,10 @@ public:
   COUNTER(upstream_internal_redirect_succeeded_total)                                              \
   COUNTER(upstream_rq_cancelled)                                                                   \
   COUNTER(upstream_rq_completed)                                                                   \
+  COUNTER(upstream_rq_hedge_budget_exceeded)                                                       \
+  COUNTER(upstream_rq_hedge_cancelled)                                                             \
+  COUNTER(upstream_rq_hedge_sent)                                                                  \
+  COUNTER(upstream_rq_hedge_won)                                                                   \
   COUNTER(upstream_rq_maintenance_mode)                                                            \
   COUNTER(upstream_rq_max_duration_reached)                                                        \
   COUNTER(upstream_rq_pending_failure_eject)                                                       \
@@ -824,6 +830,8 @@ using DeferredCreationCompatibleClusterTrafficStats =
 MAKE_STAT_NAMES_STRUCT(ClusterLoadReportStatNames, ALL_CLUSTER_LOAD_REPORT_STATS);
 MAKE_STATS_STRUCT(ClusterLoadReportStats, ClusterLoadReportStatNames,
                   ALL_CLUSTER_LOAD_REPORT_STATS);
+using DeferredCreationCompatibleClusterLoadReportStats =
+    Stats::DeferredCreationCompatibleStats<ClusterLoadReportStats>;
 
 // We can't use macros to make the Stats class for circuit breakers due to
 // the conditional inclusion of 'remaining' gauges. But we do auto-generate
@@ -1081,6 +1089,13 @@ public:
    */
   virtual TransportSocketMatcher& transportSocketMatcher() const PURE;
 
+  /**
+   * @return uint64_t a hash of the transport socket configuration of the cluster, including its
+   * transport socket matches. Clusters with the same hash create identical transport sockets for a
+   * given host, e.g. with the same SNI and certificates.
+   */
+  virtual uint64_t transportSocketConfigHash() const PURE;
+
   /**
    * @return ClusterConfigUpdateStats& config update stats for this cluster.
    */
@@ -1107,9 +1122,10 @@ public:
   virtual Stats::Scope& statsScope() const PURE;
 
   /**
-   * @return ClusterLoadReportStats& load report stats for this cluster.
+   * @return DeferredCreationCompatibleClusterLoadReportStats& load report stats for this cluster.
+   *         These may not be instantiated until the first drop is recorded.
    */
-  virtual ClusterLoadReportStats& loadReportStats() const PURE;
+  virtual DeferredCreationCompatibleClusterLoadReportStats& loadReportStats() const PURE;
 
   /**
    * @return absl::optional<std::reference_wrapper<ClusterRequestResponseSizeStats>> stats to track
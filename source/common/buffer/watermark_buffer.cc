@@ -1,5 +1,7 @@
 #include "source/common/buffer/watermark_buffer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 
@@ -7,8 +9,11 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Buffer {
 namespace {
@@ -18,6 +23,28 @@ constexpr uint32_t kEffectivelyDisableTrackingBitshift = 63;
 // 50 is an arbitrary limit, and is meant to both limit the number of streams
 // Envoy ends up resetting and avoid triggering the Watchdog system.
 constexpr uint32_t kMaxNumberOfStreamsToResetPerInvocation = 50;
+constexpr uint32_t kDefaultLargestAccountsToReset = 10;
+
+// The factories tracking accounts in the process, for largestAccounts().
+struct Registry {
+  Thread::MutexBasicLockable lock_;
+  std::vector<const WatermarkBufferFactory*> factories_ ABSL_GUARDED_BY(lock_);
+};
+
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+// Returns the first max_size elements of values once sorted with larger.
+template <class T, class Compare>
+std::vector<T> largest(std::vector<T> values, size_t max_size, Compare larger) {
+  if (values.size() > max_size) {
+    std::partial_sort(values.begin(), values.begin() + max_size, values.end(), larger);
+    values.resize(max_size);
+  } else {
+    std::sort(values.begin(), values.end(), larger);
+  }
+  return values;
+}
+
 } // end namespace
 
 void WatermarkBuffer::add(const void* data, uint64_t size) {
@@ -173,6 +200,7 @@ void WatermarkBufferFactory::updateAccountClass(const BufferMemoryAccountSharedP
                                                 absl::optional<uint32_t> new_class) {
   ASSERT(current_class != new_class, "Expected the current_class and new_class to be different");
 
+  Thread::LockGuard lock(accounts_lock_);
   if (!current_class.has_value()) {
     // Start tracking
     ASSERT(new_class.has_value());
@@ -192,9 +220,22 @@ void WatermarkBufferFactory::updateAccountClass(const BufferMemoryAccountSharedP
   }
 }
 
+void WatermarkBufferFactory::updateLargeAccount(const BufferMemoryAccountSharedPtr& account,
+                                                bool large) {
+  Thread::LockGuard lock(accounts_lock_);
+  if (large) {
+    ASSERT(!large_accounts_.contains(account));
+    large_accounts_.insert(account);
+  } else {
+    ASSERT(large_accounts_.contains(account));
+    large_accounts_.erase(account);
+  }
+}
+
 void WatermarkBufferFactory::unregisterAccount(const BufferMemoryAccountSharedPtr& account,
                                                absl::optional<uint32_t> current_class) {
   if (current_class.has_value()) {
+    Thread::LockGuard lock(accounts_lock_);
     ASSERT(size_class_account_sets_[current_class.value()].contains(account));
     size_class_account_sets_[current_class.value()].erase(account);
   }
@@ -238,17 +279,109 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   return num_streams_reset;
 }
 
+uint64_t WatermarkBufferFactory::resetLargestAccounts(float pressure) {
+  ASSERT(pressure >= 0.0 && pressure <= 1.0, "Provided pressure is out of range [0, 1].");
+
+  const uint32_t accounts_to_reset =
+      std::ceil(pressure * static_cast<float>(largest_accounts_to_reset_));
+  if (accounts_to_reset == 0) {
+    return 0;
+  }
+
+  // The buckets only order the accounts by their buffer balance, while they are
+  // reset by their whole balance, so every large account is a candidate.
+  std::vector<BufferMemoryAccountSharedPtr> candidates(large_accounts_.begin(),
+                                                       large_accounts_.end());
+  const uint32_t num_streams_reset = std::min<size_t>(accounts_to_reset, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + num_streams_reset, candidates.end(),
+                    [](const BufferMemoryAccountSharedPtr& lhs,
+                       const BufferMemoryAccountSharedPtr& rhs) {
+                      return static_cast<const BufferMemoryAccountImpl&>(*lhs).balance() >
+                             static_cast<const BufferMemoryAccountImpl&>(*rhs).balance();
+                    });
+
+  for (uint32_t i = 0; i < num_streams_reset; ++i) {
+    // This unregisters the account, which is kept alive by *candidates*.
+    candidates[i]->resetDownstream();
+  }
+  if (num_streams_reset > 0) {
+    ENVOY_LOG_MISC(warn, "resetting the {} streams using the most memory", num_streams_reset);
+  }
+  return num_streams_reset;
+}
+
+WatermarkBufferFactory::AccountsSummary
+WatermarkBufferFactory::largestAccounts(size_t max_accounts) {
+  std::vector<AccountSummary> accounts;
+  {
+    Registry& factories = registry();
+    Thread::LockGuard lock(factories.lock_);
+    for (const WatermarkBufferFactory* factory : factories.factories_) {
+      Thread::LockGuard accounts_lock(factory->accounts_lock_);
+      for (const BufferMemoryAccountSharedPtr& account : factory->large_accounts_) {
+        const auto& account_impl = static_cast<const BufferMemoryAccountImpl&>(*account);
+        accounts.push_back({account_impl.connectionId(), account_impl.streamId(),
+                            account_impl.bufferBalance(), account_impl.nonBufferBalance()});
+      }
+    }
+  }
+
+  // The connections are totaled over all the tracked accounts, including those
+  // that are not among the largest.
+  absl::flat_hash_map<uint64_t, ConnectionSummary> connections_by_id;
+  for (const AccountSummary& account : accounts) {
+    ConnectionSummary& connection = connections_by_id[account.connection_id_];
+    connection.connection_id_ = account.connection_id_;
+    connection.bytes_ += account.buffer_bytes_ + account.non_buffer_bytes_;
+    ++connection.streams_;
+  }
+  std::vector<ConnectionSummary> connections;
+  connections.reserve(connections_by_id.size());
+  for (const auto& [_, connection] : connections_by_id) {
+    connections.push_back(connection);
+  }
+
+  AccountsSummary summary;
+  summary.accounts_ = largest(std::move(accounts), max_accounts,
+                              [](const AccountSummary& lhs, const AccountSummary& rhs) {
+                                return lhs.buffer_bytes_ + lhs.non_buffer_bytes_ >
+                                       rhs.buffer_bytes_ + rhs.non_buffer_bytes_;
+                              });
+  summary.connections_ = largest(std::move(connections), max_accounts,
+                                 [](const ConnectionSummary& lhs, const ConnectionSummary& rhs) {
+                                   return lhs.bytes_ > rhs.bytes_;
+                                 });
+  return summary;
+}
+
 WatermarkBufferFactory::WatermarkBufferFactory(
     const envoy::config::overload::v3::BufferFactoryConfig& config)
     : bitshift_(config.minimum_account_to_track_power_of_two()
                     ? config.minimum_account_to_track_power_of_two() - 1
-                    : kEffectivelyDisableTrackingBitshift) {}
+                    : kEffectivelyDisableTrackingBitshift),
+      largest_accounts_to_reset_(config.has_largest_streams_to_reset()
+                                     ? config.largest_streams_to_reset().value()
+                                     : kDefaultLargestAccountsToReset) {
+  if (bitshift_ != kEffectivelyDisableTrackingBitshift) {
+    Registry& factories = registry();
+    Thread::LockGuard lock(factories.lock_);
+    factories.factories_.push_back(this);
+  }
+}
 
 WatermarkBufferFactory::~WatermarkBufferFactory() {
+  if (bitshift_ != kEffectivelyDisableTrackingBitshift) {
+    Registry& factories = registry();
+    Thread::LockGuard lock(factories.lock_);
+    factories.factories_.erase(
+        std::find(factories.factories_.begin(), factories.factories_.end(), this));
+  }
   for (auto& account_set : size_class_account_sets_) {
     ASSERT(account_set.empty(),
            "Expected all Accounts to have unregistered from the Watermark Factory.");
   }
+  ASSERT(large_accounts_.empty(),
+         "Expected all Accounts to have unregistered from the Watermark Factory.");
 }
 
 BufferMemoryAccountSharedPtr
@@ -265,7 +398,7 @@ BufferMemoryAccountImpl::createAccount(WatermarkBufferFactory* factory,
 }
 
 absl::optional<uint32_t> BufferMemoryAccountImpl::balanceToClassIndex() {
-  const uint64_t shifted_balance = buffer_memory_allocated_ >> factory_->bitshift();
+  const uint64_t shifted_balance = bufferBalance() >> factory_->bitshift();
 
   if (shifted_balance == 0) {
     return {}; // Not worth tracking anything < configured minimum threshold
@@ -283,22 +416,53 @@ void BufferMemoryAccountImpl::updateAccountClass() {
   }
 }
 
+void BufferMemoryAccountImpl::updateLargeAccount() {
+  const bool large = (balance() >> factory_->bitshift()) != 0;
+  if (shared_this_ && large != large_account_) {
+    factory_->updateLargeAccount(shared_this_, large);
+    large_account_ = large;
+  }
+}
+
 void BufferMemoryAccountImpl::credit(uint64_t amount) {
-  ASSERT(buffer_memory_allocated_ >= amount);
-  buffer_memory_allocated_ -= amount;
+  const uint64_t allocated = bufferBalance();
+  ASSERT(allocated >= amount);
+  buffer_memory_allocated_.store(allocated - amount, std::memory_order_relaxed);
   updateAccountClass();
+  updateLargeAccount();
 }
 
 void BufferMemoryAccountImpl::charge(uint64_t amount) {
+  const uint64_t allocated = bufferBalance();
   // Check overflow
-  ASSERT(std::numeric_limits<uint64_t>::max() - buffer_memory_allocated_ >= amount);
-  buffer_memory_allocated_ += amount;
+  ASSERT(std::numeric_limits<uint64_t>::max() - allocated >= amount);
+  buffer_memory_allocated_.store(allocated + amount, std::memory_order_relaxed);
   updateAccountClass();
+  updateLargeAccount();
+}
+
+void BufferMemoryAccountImpl::creditNonBuffer(uint64_t amount) {
+  const uint64_t allocated = nonBufferBalance();
+  ASSERT(allocated >= amount);
+  non_buffer_memory_allocated_.store(allocated - amount, std::memory_order_relaxed);
+  updateLargeAccount();
+}
+
+void BufferMemoryAccountImpl::chargeNonBuffer(uint64_t amount) {
+  const uint64_t allocated = nonBufferBalance();
+  // Check overflow
+  ASSERT(std::numeric_limits<uint64_t>::max() - allocated >= amount);
+  non_buffer_memory_allocated_.store(allocated + amount, std::memory_order_relaxed);
+  updateLargeAccount();
 }
 
 void BufferMemoryAccountImpl::clearDownstream() {
   if (reset_handler_.has_value()) {
     reset_handler_.reset();
+    if (large_account_) {
+      factory_->updateLargeAccount(shared_this_, false);
+      large_account_ = false;
+    }
     factory_->unregisterAccount(shared_this_, current_bucket_idx_);
     current_bucket_idx_.reset();
     shared_this_ = nullptr;
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
 #include "envoy/config/overload/v3/overload.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/thread.h"
 
 namespace Envoy {
 namespace Buffer {
@@ -102,6 +105,7 @@ public:
     // any slices which charge and credit the account should have credited the
     // account when they were deleted, maintaining this invariant.
     ASSERT(buffer_memory_allocated_ == 0);
+    ASSERT(non_buffer_memory_allocated_ == 0);
     ASSERT(!reset_handler_.has_value());
   }
 
@@ -113,9 +117,25 @@ public:
   BufferMemoryAccountImpl(BufferMemoryAccountImpl&&) = delete;
   BufferMemoryAccountImpl& operator=(BufferMemoryAccountImpl&&) = delete;
 
-  uint64_t balance() const { return buffer_memory_allocated_; }
+  // The balances can be read from any thread, but are only updated on the thread of the stream.
+  uint64_t balance() const { return bufferBalance() + nonBufferBalance(); }
+  uint64_t bufferBalance() const {
+    return buffer_memory_allocated_.load(std::memory_order_relaxed);
+  }
+  uint64_t nonBufferBalance() const {
+    return non_buffer_memory_allocated_.load(std::memory_order_relaxed);
+  }
+  uint64_t connectionId() const { return connection_id_.load(std::memory_order_relaxed); }
+  uint64_t streamId() const { return stream_id_.load(std::memory_order_relaxed); }
+
   void charge(uint64_t amount) override;
   void credit(uint64_t amount) override;
+  void chargeNonBuffer(uint64_t amount) override;
+  void creditNonBuffer(uint64_t amount) override;
+  void setOwner(uint64_t connection_id, uint64_t stream_id) override {
+    connection_id_.store(connection_id, std::memory_order_relaxed);
+    stream_id_.store(stream_id, std::memory_order_relaxed);
+  }
 
   // Clear the associated downstream, preparing the account to be destroyed.
   // This is idempotent.
@@ -135,16 +155,29 @@ private:
   BufferMemoryAccountImpl(WatermarkBufferFactory* factory, Http::StreamResetHandler& reset_handler)
       : factory_(factory), reset_handler_(reset_handler) {}
 
-  // Returns the class index based off of the buffer_memory_allocated_
+  // Returns the class index based off of the buffer_memory_allocated_.
   // This can differ with current_bucket_idx_ if buffer_memory_allocated_ was
-  // just modified.
+  // just modified. Memory charged outside of buffers does not count towards
+  // the class, so that the streams reset by resetAccountsGivenPressure() only
+  // depend on their buffers.
   // Returned class index, if present, is in the range [0, NUM_MEMORY_CLASSES_).
   absl::optional<uint32_t> balanceToClassIndex();
   void updateAccountClass();
-
-  uint64_t buffer_memory_allocated_ = 0;
+  // Updates whether the whole balance, including the memory charged outside of
+  // buffers, is large enough for the account to be tracked by the factory.
+  void updateLargeAccount();
+
+  // Only the thread of the stream writes these, so they are updated with a
+  // relaxed load and store rather than an atomic read-modify-write. They are
+  // atomic so that the admin interface can read them from the main thread.
+  std::atomic<uint64_t> buffer_memory_allocated_ = 0;
+  std::atomic<uint64_t> non_buffer_memory_allocated_ = 0;
+  std::atomic<uint64_t> connection_id_ = 0;
+  std::atomic<uint64_t> stream_id_ = 0;
   // Current bucket index where the account is being tracked in.
   absl::optional<uint32_t> current_bucket_idx_{};
+  // Whether the account is tracked in *WatermarkBufferFactory::large_accounts_*.
+  bool large_account_{};
 
   WatermarkBufferFactory* factory_ = nullptr;
 
@@ -184,6 +217,19 @@ private:
  *    *BufferMemoryAccountImpl::balanceToClassIndex()* for details on the memory
  *    class for a given account balance.
  *
+ * The tracked accounts can be reset by pressure, clearing buckets from the
+ * largest one. The buckets only account for the memory of buffers.
+ *
+ * Accounts are also tracked by their whole balance, including the memory
+ * charged outside of buffers, once it is above the minimum threshold. The
+ * largest of these accounts by exact balance can be reset, so that streams
+ * using memory mostly for their headers can be reset too.
+ *
+ * The tracked accounts of every factory in the process can also be read from
+ * any thread with *largestAccounts()*, for the admin interface. For this, the
+ * buckets and *large_accounts_* are only modified with *accounts_lock_* held,
+ * while the thread of the factory can read them without it.
+ *
  * TODO(kbaichoo): Update this documentation when we make the minimum account
  * threshold configurable.
  *
@@ -203,12 +249,14 @@ public:
 
   BufferMemoryAccountSharedPtr createAccount(Http::StreamResetHandler& reset_handler) override;
   uint64_t resetAccountsGivenPressure(float pressure) override;
+  uint64_t resetLargestAccounts(float pressure) override;
 
   // Called by BufferMemoryAccountImpls created by the factory on account class
   // updated.
   void updateAccountClass(const BufferMemoryAccountSharedPtr& account,
                           absl::optional<uint32_t> current_class,
                           absl::optional<uint32_t> new_class);
+  void updateLargeAccount(const BufferMemoryAccountSharedPtr& account, bool large);
 
   uint32_t bitshift() const { return bitshift_; }
 
@@ -216,14 +264,52 @@ public:
   virtual void unregisterAccount(const BufferMemoryAccountSharedPtr& account,
                                  absl::optional<uint32_t> current_class);
 
+  struct AccountSummary {
+    uint64_t connection_id_;
+    uint64_t stream_id_;
+    uint64_t buffer_bytes_;
+    uint64_t non_buffer_bytes_;
+  };
+
+  struct ConnectionSummary {
+    uint64_t connection_id_{};
+    // The balances of all the tracked accounts of the connection.
+    uint64_t bytes_{};
+    uint32_t streams_{};
+  };
+
+  struct AccountsSummary {
+    std::vector<AccountSummary> accounts_;
+    std::vector<ConnectionSummary> connections_;
+  };
+
+  /**
+   * @return the tracked accounts with the largest balances across every factory
+   * in the process, and the connections whose tracked accounts have the
+   * largest balances in total, both largest first. The connection totals
+   * include all their tracked accounts, not only the returned ones. This is
+   * safe to call from any thread.
+   * @param max_accounts the maximum number of accounts, and of connections, to
+   * return.
+   */
+  static AccountsSummary largestAccounts(size_t max_accounts);
+
 protected:
   // Enable subclasses to inspect the mapping.
   using MemoryClassesToAccountsSet = std::array<absl::flat_hash_set<BufferMemoryAccountSharedPtr>,
                                                 BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_>;
   MemoryClassesToAccountsSet size_class_account_sets_;
+  // The accounts whose whole balance is above the minimum threshold for
+  // tracking, including accounts only above it with the memory charged outside
+  // of buffers, e.g. for headers. These are the candidates of
+  // resetLargestAccounts() and largestAccounts().
+  absl::flat_hash_set<BufferMemoryAccountSharedPtr> large_accounts_;
   // How much to bit shift right balances to test whether the account should be
   // tracked in *size_class_account_sets_*.
   const uint32_t bitshift_;
+  // The maximum number of accounts resetLargestAccounts() resets.
+  const uint32_t largest_accounts_to_reset_;
+  mutable Thread::MutexBasicLockable accounts_lock_;
 };
 
 } // namespace Buffer
@@ -0,0 +1,40 @@
+#include "source/common/config/xds_decoding_pool.h"
+
+#include <atomic>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Config {
+
+XdsDecodingPool::XdsDecodingPool(uint32_t num_threads, ThreadLocal::Instance& tls, Api::Api& api)
+    : threads_("xds_decoding", "xds", num_threads, tls, api) {}
+
+void XdsDecodingPool::run(uint32_t num_tasks, std::function<void(uint32_t)> task,
+                          Event::Dispatcher& dispatcher, Event::PostCb on_done) {
+  ASSERT(num_tasks > 0);
+  struct State {
+    State(uint32_t num_tasks, std::function<void(uint32_t)> task, Event::Dispatcher& dispatcher,
+          Event::PostCb on_done)
+        : task_(std::move(task)), dispatcher_(dispatcher), on_done_(std::move(on_done)),
+          remaining_(num_tasks) {}
+
+    std::function<void(uint32_t)> task_;
+    Event::Dispatcher& dispatcher_;
+    Event::PostCb on_done_;
+    std::atomic<uint32_t> remaining_;
+  };
+  auto state =
+      std::make_shared<State>(num_tasks, std::move(task), dispatcher, std::move(on_done));
+  for (uint32_t i = 0; i < num_tasks; ++i) {
+    threads_.nextDispatcher().post([state, i]() {
+      state->task_(i);
+      if (--state->remaining_ == 0) {
+        state->dispatcher_.post(std::move(state->on_done_));
+      }
+    });
+  }
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/stats/scope.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/event/dispatcher_threads.h"
+#include "source/common/singleton/threadsafe_singleton.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * A pool of threads that the resources of large xDS responses are decoded and validated on, so
+ * that the main thread only has to apply them. The pool is created by the server when
+ * bootstrap xds_decoding_threads is set, and found by the gRPC muxes through
+ * XdsDecodingPoolSingleton.
+ */
+class XdsDecodingPool {
+public:
+  XdsDecodingPool(uint32_t num_threads, ThreadLocal::Instance& tls, Api::Api& api);
+
+  /**
+   * @return the number of threads of the pool.
+   */
+  uint32_t concurrency() const { return threads_.size(); }
+
+  /**
+   * Runs task(0), ..., task(num_tasks - 1) across the threads of the pool, and posts on_done to
+   * dispatcher once all of them have run. The tasks run concurrently, so they must only share
+   * state that is safe to access from several threads.
+   * @param num_tasks the number of tasks, which must be greater than 0.
+   * @param task the task to run, given the index of the task.
+   * @param dispatcher the dispatcher to post on_done to.
+   * @param on_done the callback to post once all tasks have run.
+   */
+  void run(uint32_t num_tasks, std::function<void(uint32_t)> task, Event::Dispatcher& dispatcher,
+           Event::PostCb on_done);
+
+  /**
+   * Initializes the dispatcher stats of each thread. @see Dispatcher::initializeStats()
+   */
+  void initializeStats(Stats::Scope& scope, bool callback_stats) {
+    threads_.initializeStats(scope, callback_stats);
+  }
+
+  /**
+   * Runs what was handed to the threads, and stops them. Must be called before thread local
+   * storage is shut down.
+   */
+  void stop() { threads_.stop(); }
+
+private:
+  Event::DispatcherThreads threads_;
+};
+
+using XdsDecodingPoolSingleton = InjectableSingleton<XdsDecodingPool>;
+using XdsDecodingPoolLoader = ScopedInjectableLoader<XdsDecodingPool>;
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,123 @@
+#include "source/common/event/callback_profiler.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace Envoy {
+namespace Event {
+
+namespace {
+
+struct Registry {
+  Thread::MutexBasicLockable lock_;
+  std::vector<const CallbackProfiler*> profilers_ ABSL_GUARDED_BY(lock_);
+};
+
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+} // namespace
+
+CallbackProfiler::CallbackProfiler(const std::string& dispatcher_name, Stats::Scope& scope,
+                                   const std::string& prefix, TimeSource& time_source)
+    : dispatcher_name_(dispatcher_name), time_source_(time_source),
+      stats_{ALL_DISPATCHER_CALLBACK_STATS(POOL_HISTOGRAM_PREFIX(scope, prefix))} {
+  Registry& profilers = registry();
+  Thread::LockGuard lock(profilers.lock_);
+  profilers.profilers_.push_back(this);
+}
+
+CallbackProfiler::~CallbackProfiler() {
+  Registry& profilers = registry();
+  Thread::LockGuard lock(profilers.lock_);
+  profilers.profilers_.erase(
+      std::find(profilers.profilers_.begin(), profilers.profilers_.end(), this));
+}
+
+bool CallbackProfiler::start(const ScopeTrackedObject* tracked_object) {
+  if (running_) {
+    return false;
+  }
+  running_ = true;
+  if (tracked_object != nullptr) {
+    tracked_object_type_ = typeid(*tracked_object).name();
+  }
+  start_time_ = time_source_.monotonicTime();
+  return true;
+}
+
+void CallbackProfiler::stop(CallbackCategory category) {
+  ASSERT(running_);
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      time_source_.monotonicTime() - start_time_);
+  histogram(category).recordValue(duration.count());
+
+  if (duration > slow_threshold_) {
+    Thread::LockGuard lock(slowest_lock_);
+    if (slowest_.size() == MaxSlowCallbacks) {
+      slowest_.pop_back();
+    }
+    const auto it = std::find_if(slowest_.begin(), slowest_.end(),
+                                 [&duration](const SlowCallback& slow_callback) {
+                                   return slow_callback.duration_ < duration;
+                                 });
+    slowest_.insert(it, {category, duration, tracked_object_type_, time_source_.systemTime()});
+    if (slowest_.size() == MaxSlowCallbacks) {
+      slow_threshold_ = slowest_.back().duration_;
+    }
+  }
+
+  running_ = false;
+  tracked_object_type_ = nullptr;
+}
+
+Stats::Histogram& CallbackProfiler::histogram(CallbackCategory category) {
+  switch (category) {
+  case CallbackCategory::FileEvent:
+    return stats_.file_event_duration_us_;
+  case CallbackCategory::Timer:
+    return stats_.timer_duration_us_;
+  case CallbackCategory::PostCallback:
+    return stats_.post_callback_duration_us_;
+  case CallbackCategory::DeferredDelete:
+    return stats_.deferred_delete_duration_us_;
+  case CallbackCategory::SchedulableCallback:
+    return stats_.schedulable_callback_duration_us_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+std::vector<CallbackProfiler::SlowCallback> CallbackProfiler::slowestCallbacks() const {
+  Thread::LockGuard lock(slowest_lock_);
+  return slowest_;
+}
+
+void CallbackProfiler::forEach(const std::function<void(const CallbackProfiler&)>& cb) {
+  Registry& profilers = registry();
+  Thread::LockGuard lock(profilers.lock_);
+  for (const CallbackProfiler* profiler : profilers.profilers_) {
+    cb(*profiler);
+  }
+}
+
+std::string CallbackProfiler::typeName(const char* mangled_name) {
+#if defined(__GNUC__)
+  int status;
+  char* demangled = abi::__cxa_demangle(mangled_name, nullptr, nullptr, &status);
+  if (status == 0) {
+    std::string name(demangled);
+    ::free(demangled);
+    return name;
+  }
+#endif
+  return mangled_name;
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "envoy/common/scope_tracker.h"
+#include "envoy/common/time.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * All dispatcher callback stats. @see stats_macros.h
+ */
+#define ALL_DISPATCHER_CALLBACK_STATS(HISTOGRAM)                                                   \
+  HISTOGRAM(deferred_delete_duration_us, Microseconds)                                             \
+  HISTOGRAM(file_event_duration_us, Microseconds)                                                  \
+  HISTOGRAM(post_callback_duration_us, Microseconds)                                               \
+  HISTOGRAM(post_queue_depth, Unspecified)                                                         \
+  HISTOGRAM(schedulable_callback_duration_us, Microseconds)                                        \
+  HISTOGRAM(timer_duration_us, Microseconds)
+
+/**
+ * Struct definition for all dispatcher callback stats. @see stats_macros.h
+ */
+struct DispatcherCallbackStats {
+  ALL_DISPATCHER_CALLBACK_STATS(GENERATE_HISTOGRAM_STRUCT)
+};
+
+enum class CallbackCategory {
+  FileEvent,
+  Timer,
+  PostCallback,
+  DeferredDelete,
+  SchedulableCallback,
+};
+
+/**
+ * Records the time spent in each callback of a dispatcher, and keeps the slowest callbacks along
+ * with the type of the first object they tracked with the dispatcher, so that the callbacks
+ * stalling an event loop can be found from the admin interface. The durations are recorded on the
+ * thread of the dispatcher, while the slowest callbacks can be read from any thread.
+ */
+class CallbackProfiler {
+public:
+  static constexpr size_t MaxSlowCallbacks = 10;
+
+  struct SlowCallback {
+    CallbackCategory category_;
+    std::chrono::microseconds duration_;
+    // Mangled name of the type of the first object tracked by the callback, or nullptr if it did
+    // not track any. @see typeName()
+    const char* tracked_object_type_;
+    SystemTime time_;
+  };
+
+  /**
+   * Profiles the callback run during its lifetime, unless it is nested in another profiled
+   * callback, whose duration already includes it. The callback is attributed to the object tracked
+   * by the dispatcher when it starts, if any, or else to the first object it tracks.
+   */
+  class ScopedCallback {
+  public:
+    ScopedCallback(CallbackProfiler* profiler, CallbackCategory category,
+                   const ScopeTrackedObject* tracked_object)
+        : profiler_(profiler != nullptr && profiler->start(tracked_object) ? profiler : nullptr),
+          category_(category) {}
+    ScopedCallback(const ScopedCallback&) = delete;
+    ScopedCallback& operator=(const ScopedCallback&) = delete;
+    ~ScopedCallback() {
+      if (profiler_ != nullptr) {
+        profiler_->stop(category_);
+      }
+    }
+
+  private:
+    CallbackProfiler* const profiler_;
+    const CallbackCategory category_;
+  };
+
+  CallbackProfiler(const std::string& dispatcher_name, Stats::Scope& scope,
+                   const std::string& prefix, TimeSource& time_source);
+  ~CallbackProfiler();
+
+  /**
+   * Called when the dispatcher starts tracking an object, to attribute the running callback to it.
+   */
+  void onTrackedObject(const ScopeTrackedObject& object) {
+    if (running_ && tracked_object_type_ == nullptr) {
+      tracked_object_type_ = typeid(object).name();
+    }
+  }
+
+  /**
+   * Records the number of callbacks taken from the post queue at once.
+   */
+  void recordPostQueueDepth(uint64_t depth) { stats_.post_queue_depth_.recordValue(depth); }
+
+  const std::string& dispatcherName() const { return dispatcher_name_; }
+
+  /**
+   * @return the slowest callbacks so far, slowest first. This is safe to call from any thread.
+   */
+  std::vector<SlowCallback> slowestCallbacks() const;
+
+  /**
+   * Calls cb with each profiler in the process. This is safe to call from any thread, and the
+   * profilers are not destroyed until cb returns.
+   */
+  static void forEach(const std::function<void(const CallbackProfiler&)>& cb);
+
+  /**
+   * @return the human readable name of a type from the mangled one of a SlowCallback.
+   */
+  static std::string typeName(const char* mangled_name);
+
+private:
+  bool start(const ScopeTrackedObject* tracked_object);
+  void stop(CallbackCategory category);
+  Stats::Histogram& histogram(CallbackCategory category);
+
+  const std::string dispatcher_name_;
+  TimeSource& time_source_;
+  DispatcherCallbackStats stats_;
+  bool running_{};
+  MonotonicTime start_time_;
+  const char* tracked_object_type_{};
+  // Duration a callback must exceed to be one of the slowest, only accessed on the dispatcher
+  // thread so that the lock is only taken for the callbacks that are.
+  std::chrono::microseconds slow_threshold_{};
+  mutable Thread::MutexBasicLockable slowest_lock_;
+  std::vector<SlowCallback> slowest_ ABSL_GUARDED_BY(slowest_lock_);
+};
+
+using CallbackProfilerPtr = std::unique_ptr<CallbackProfiler>;
+
+} // namespace Event
+} // namespace Envoy
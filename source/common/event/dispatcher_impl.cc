@@ -23,6 +23,7 @@
 #include "source/common/event/scaled_range_timer_manager_impl.h"
 #include "source/common/event/signal_impl.h"
 #include "source/common/event/timer_impl.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/filesystem/watcher_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_impl.h"
@@ -71,6 +72,10 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
     : name_(name), thread_factory_(thread_factory), time_source_(time_source),
       file_system_(file_system), buffer_factory_(watermark_factory),
       scheduler_(time_system.createScheduler(base_scheduler_, base_scheduler_)),
+      timer_wheel_(
+          Runtime::runtimeFeatureEnabled("envoy.restart_features.dispatcher_timer_wheel")
+              ? std::make_unique<TimerWheel>(*scheduler_, time_source_, *this)
+              : nullptr),
       thread_local_delete_cb_(
           base_scheduler_.createSchedulableCallback([this]() -> void { runThreadLocalDelete(); })),
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
@@ -111,6 +116,15 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
   });
 }
 
+void DispatcherImpl::initializeCallbackStats(Stats::Scope& scope) {
+  // Posted after the callback of initializeStats(), which sets the prefix.
+  post([this, &scope] {
+    ASSERT(!stats_prefix_.empty());
+    callback_profiler_ =
+        std::make_unique<CallbackProfiler>(name_, scope, stats_prefix_ + ".", time_source_);
+  });
+}
+
 void DispatcherImpl::clearDeferredDeleteList() {
   ASSERT(isThreadSafe());
   std::vector<DeferredDeletablePtr>* to_delete = current_to_delete_;
@@ -136,8 +150,11 @@ void DispatcherImpl::clearDeferredDeleteList() {
   // Calling clear() on the vector does not specify which order destructors run in. We want to
   // destroy in FIFO order so just do it manually. This required 2 passes over the vector which is
   // not optimal but can be cleaned up later if needed.
-  for (size_t i = 0; i < num_to_delete; i++) {
-    (*to_delete)[i].reset();
+  {
+    const auto profiled = profileCallback(CallbackCategory::DeferredDelete);
+    for (size_t i = 0; i < num_to_delete; i++) {
+      (*to_delete)[i].reset();
+    }
   }
 
   to_delete->clear();
@@ -199,6 +216,7 @@ FileEventPtr DispatcherImpl::createFileEvent(os_fd_t fd, FileReadyCb cb, FileTri
       *this, fd,
       [this, cb](uint32_t events) {
         touchWatchdog();
+        const auto profiled = profileCallback(CallbackCategory::FileEvent);
         return cb(events);
       },
       trigger, events)};
@@ -228,14 +246,17 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
   ASSERT(isThreadSafe());
   return base_scheduler_.createSchedulableCallback([this, cb]() {
     touchWatchdog();
+    const auto profiled = profileCallback(CallbackCategory::SchedulableCallback);
     cb();
   });
 }
 
 TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
-  return scheduler_->createTimer(
+  Scheduler& scheduler = timer_wheel_ != nullptr ? *timer_wheel_ : *scheduler_;
+  return scheduler.createTimer(
       [this, cb]() {
         touchWatchdog();
+        const auto profiled = profileCallback(CallbackCategory::Timer);
         cb();
       },
       *this);
@@ -261,14 +282,9 @@ SignalEventPtr DispatcherImpl::listenForSignal(signal_t signal_num, SignalCb cb)
 }
 
 void DispatcherImpl::post(PostCb callback) {
-  bool do_post;
-  {
-    Thread::LockGuard lock(post_lock_);
-    do_post = post_callbacks_.empty();
-    post_callbacks_.push_back(std::move(callback));
-  }
-
-  if (do_post) {
+  // Only the first of a burst of posts wakes the event loop up, as runPostCallbacks() takes all the
+  // callbacks posted until it runs at once.
+  if (post_queue_.push(std::move(callback))) {
     post_cb_->scheduleCallbackCurrentIteration();
   }
 }
@@ -308,11 +324,7 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
-  {
-    Thread::LockGuard lock(post_lock_);
-    post_callbacks_size = post_callbacks_.size();
-  }
+  auto post_callbacks_size = post_queue_.size();
 
   std::list<DispatcherThreadDeletableConstPtr> local_deletables;
   {
@@ -358,27 +370,23 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
-  std::list<PostCb> callbacks;
-  {
-    // Take ownership of the callbacks under the post_lock_. The lock must be released before
-    // callbacks execute. Callbacks added after this transfer will re-arm post_cb_ and will execute
-    // later in the event loop.
-    Thread::LockGuard lock(post_lock_);
-    callbacks = std::move(post_callbacks_);
-    // post_callbacks_ should be empty after the move.
-    ASSERT(post_callbacks_.empty());
+  // Take ownership of the callbacks posted so far. Callbacks added after this will re-arm post_cb_
+  // and will execute later in the event loop, which includes the callbacks posted by the invocation
+  // or destructor of the callbacks of this batch.
+  PostQueue::Batch callbacks = post_queue_.takeAll();
+  if (callback_profiler_ != nullptr) {
+    callback_profiler_->recordPostQueueDepth(callbacks.size());
   }
-  // It is important that the execution and deletion of the callback happen while post_lock_ is not
-  // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
   while (!callbacks.empty()) {
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
+    const auto profiled = profileCallback(CallbackCategory::PostCallback);
     // Run the callback.
     callbacks.front()();
     // Pop the front so that the destructor of the callback that just executed runs before the next
     // callback executes.
-    callbacks.pop_front();
+    callbacks.popFront();
   }
 }
 
@@ -405,6 +413,11 @@ void DispatcherImpl::runFatalActionsOnTrackedObject(
   }
 }
 
+CallbackProfiler::ScopedCallback DispatcherImpl::profileCallback(CallbackCategory category) {
+  return {callback_profiler_.get(), category,
+          tracked_object_stack_.empty() ? nullptr : tracked_object_stack_.back()};
+}
+
 void DispatcherImpl::touchWatchdog() {
   if (watchdog_registration_) {
     watchdog_registration_->touchWatchdog();
@@ -415,6 +428,9 @@ void DispatcherImpl::pushTrackedObject(const ScopeTrackedObject* object) {
   ASSERT(isThreadSafe());
   ASSERT(object != nullptr);
   tracked_object_stack_.push_back(object);
+  if (callback_profiler_ != nullptr) {
+    callback_profiler_->onTrackedObject(*object);
+  }
   ASSERT(tracked_object_stack_.size() <= ExpectedMaxTrackedObjectStackDepth);
 }
 
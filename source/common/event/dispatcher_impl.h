@@ -16,8 +16,10 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/post_queue.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
@@ -25,6 +27,8 @@
 namespace Envoy {
 namespace Event {
 
+class TimerWheel;
+
 // The tracked object stack likely won't grow larger than this initial
 // reservation; this should make appends constant time since the stack
 // shouldn't have to grow larger.
@@ -61,6 +65,8 @@ public:
                         std::chrono::milliseconds min_touch_interval) override;
   TimeSource& timeSource() override { return time_source_; }
   void initializeStats(Stats::Scope& scope, const absl::optional<std::string>& prefix) override;
+  void initializeCallbackStats(Stats::Scope& scope) override;
+  std::chrono::microseconds loopBusyTime() const override { return base_scheduler_.busyTime(); }
   void clearDeferredDeleteList() override;
   Network::ServerConnectionPtr
   createServerConnection(Network::ConnectionSocketPtr&& socket,
@@ -130,6 +136,10 @@ private:
   void runPostCallbacks();
   void runThreadLocalDelete();
 
+  // Profiles the callback run during the lifetime of the returned object, if callback stats are
+  // initialized.
+  CallbackProfiler::ScopedCallback profileCallback(CallbackCategory category);
+
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
   void touchWatchdog();
 
@@ -146,10 +156,15 @@ private:
   Filesystem::Instance& file_system_;
   std::string stats_prefix_;
   DispatcherStatsPtr stats_;
+  // Only set once callback stats are initialized.
+  CallbackProfilerPtr callback_profiler_;
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
   SchedulerPtr scheduler_;
+  // Only set if the timer wheel is enabled, in which case the timers are created from it rather
+  // than from scheduler_. It must outlive all the timers of the dispatcher.
+  std::unique_ptr<TimerWheel> timer_wheel_;
 
   SchedulableCallbackPtr thread_local_delete_cb_;
   Thread::MutexBasicLockable thread_local_deletable_lock_;
@@ -161,8 +176,7 @@ private:
   SchedulableCallbackPtr deferred_delete_cb_;
 
   SchedulableCallbackPtr post_cb_;
-  Thread::MutexBasicLockable post_lock_;
-  std::list<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  PostQueue post_queue_;
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
@@ -0,0 +1,63 @@
+#include "source/common/event/dispatcher_threads.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Event {
+
+DispatcherThreads::DispatcherThreads(const std::string& name, const std::string& thread_name,
+                                     uint32_t num_threads, ThreadLocal::Instance& tls,
+                                     Api::Api& api)
+    : tls_(tls) {
+  ASSERT(num_threads > 0);
+  threads_.reserve(num_threads);
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    DispatcherThread& thread = threads_.emplace_back();
+    thread.dispatcher_ = api.allocateDispatcher(absl::StrCat(name, "_", i));
+    tls_.registerThread(*thread.dispatcher_, false);
+    Dispatcher& dispatcher = *thread.dispatcher_;
+    thread.thread_ = api.threadFactory().createThread(
+        [this, &dispatcher]() -> void {
+          ENVOY_LOG(debug, "{} entering dispatch loop", dispatcher.name());
+          dispatcher.run(Dispatcher::RunType::RunUntilExit);
+          ENVOY_LOG(debug, "{} exited dispatch loop", dispatcher.name());
+          dispatcher.shutdown();
+          tls_.shutdownThread();
+        },
+        Thread::Options{absl::StrCat(thread_name, ":", i)});
+  }
+}
+
+DispatcherThreads::~DispatcherThreads() { stop(); }
+
+Dispatcher& DispatcherThreads::nextDispatcher() {
+  return *threads_[next_++ % threads_.size()].dispatcher_;
+}
+
+Dispatcher& DispatcherThreads::dispatcherFor(uint64_t affinity) {
+  return *threads_[affinity % threads_.size()].dispatcher_;
+}
+
+void DispatcherThreads::initializeStats(Stats::Scope& scope, bool callback_stats) {
+  for (DispatcherThread& thread : threads_) {
+    thread.dispatcher_->initializeStats(scope);
+    if (callback_stats) {
+      thread.dispatcher_->initializeCallbackStats(scope);
+    }
+  }
+}
+
+void DispatcherThreads::stop() {
+  for (DispatcherThread& thread : threads_) {
+    if (thread.thread_ != nullptr) {
+      // The exit is posted so that what was posted before runs first.
+      Dispatcher& dispatcher = *thread.dispatcher_;
+      dispatcher.post([&dispatcher]() { dispatcher.exit(); });
+      thread.thread_->join();
+      thread.thread_.reset();
+    }
+  }
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A set of threads, each running its own dispatcher, that work is handed to in turn. They serve
+ * work that should not compete with xDS processing, stats flushing or the admin interface on the
+ * main thread, such as active health checking.
+ *
+ * The threads are registered for thread local updates, and start right away, as unlike workers
+ * they may be needed while the server initializes. They must be stopped before thread local
+ * storage is shut down.
+ */
+class DispatcherThreads : Logger::Loggable<Logger::Id::main> {
+public:
+  /**
+   * @param name the prefix of the names of the dispatchers, e.g. "health_check" for
+   *        "health_check_0", "health_check_1", ...
+   * @param thread_name the prefix of the names of the threads.
+   * @param num_threads the number of threads, which must be greater than 0.
+   */
+  DispatcherThreads(const std::string& name, const std::string& thread_name, uint32_t num_threads,
+                    ThreadLocal::Instance& tls, Api::Api& api);
+  ~DispatcherThreads();
+
+  /**
+   * @return the dispatcher of the next thread to hand work to.
+   */
+  Dispatcher& nextDispatcher();
+
+  /**
+   * @return the dispatcher of the thread to hand work with the given affinity to. Work with the same
+   *         affinity is always handed to the same thread.
+   */
+  Dispatcher& dispatcherFor(uint64_t affinity);
+
+  /**
+   * @return the number of threads.
+   */
+  uint32_t size() const { return threads_.size(); }
+
+  /**
+   * Initializes the dispatcher stats of each thread. @see Dispatcher::initializeStats()
+   */
+  void initializeStats(Stats::Scope& scope, bool callback_stats);
+
+  /**
+   * Exits the event loop of each thread, once it has run what was posted to it, and waits for it
+   * to complete.
+   */
+  void stop();
+
+private:
+  struct DispatcherThread {
+    DispatcherPtr dispatcher_;
+    Thread::ThreadPtr thread_;
+  };
+
+  ThreadLocal::Instance& tls_;
+  std::vector<DispatcherThread> threads_;
+  std::atomic<uint32_t> next_{};
+};
+
+using DispatcherThreadsPtr = std::unique_ptr<DispatcherThreads>;
+
+} // namespace Event
+} // namespace Envoy
@@ -10,8 +10,10 @@ namespace Envoy {
 namespace Event {
 
 namespace {
+uint64_t toMicroseconds(const timeval& tv) { return tv.tv_sec * 1000000 + tv.tv_usec; }
+
 void recordTimeval(Stats::Histogram& histogram, const timeval& tv) {
-  histogram.recordValue(tv.tv_sec * 1000000 + tv.tv_usec);
+  histogram.recordValue(toMicroseconds(tv));
 }
 } // namespace
 
@@ -116,6 +118,9 @@ void LibeventScheduler::onPrepareForStats(evwatch*, const evwatch_prepare_cb_inf
     timeval delta;
     evutil_timersub(&self->prepare_time_, &self->check_time_, &delta);
     recordTimeval(self->stats_->loop_duration_us_, delta);
+    self->busy_time_us_.store(self->busy_time_us_.load(std::memory_order_relaxed) +
+                                  toMicroseconds(delta),
+                              std::memory_order_relaxed);
   }
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 #include "envoy/event/dispatcher.h"
@@ -109,6 +111,14 @@ public:
    */
   void initializeStats(DispatcherStats* stats);
 
+  /**
+   * @return the cumulative time spent between polls, once stats are initialized. This is safe to
+   *         call from any thread.
+   */
+  std::chrono::microseconds busyTime() const {
+    return std::chrono::microseconds(busy_time_us_.load(std::memory_order_relaxed));
+  }
+
 private:
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onCheckForCallback(evwatch*, const evwatch_check_cb_info* info, void* arg);
@@ -133,6 +143,8 @@ private:
   timeval check_time_{};     // timestamp immediately after polling
   OnPrepareCallback prepare_callback_; // callback to be called from onPrepareForCallback()
   OnCheckCallback check_callback_;     // callback to be called from onCheckForCallback()
+  // Sum of the loop durations. Only written by the event loop, but read from any thread.
+  std::atomic<uint64_t> busy_time_us_{};
 };
 
 } // namespace Event
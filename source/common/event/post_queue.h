@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Multiple producer, single consumer queue of the callbacks posted to a dispatcher. Producers push
+ * onto the head of a singly linked list with a compare-and-swap rather than under a lock, and the
+ * consumer takes all the callbacks posted so far with a single exchange. This keeps the bursts of
+ * posts to every worker, e.g. from ThreadLocal::Slot::runOnAllThreads(), from serializing the
+ * posting threads on the lock of each worker in turn.
+ */
+class PostQueue {
+private:
+  struct Node {
+    PostCb callback_;
+    Node* next_;
+  };
+
+public:
+  /**
+   * Callbacks taken from the queue at once, in the order they were posted.
+   */
+  class Batch {
+  public:
+    Batch() = default;
+    Batch(Batch&& other) noexcept : front_(other.front_), size_(other.size_) {
+      other.front_ = nullptr;
+      other.size_ = 0;
+    }
+    Batch& operator=(Batch&&) = delete;
+    ~Batch() {
+      while (!empty()) {
+        popFront();
+      }
+    }
+
+    bool empty() const { return front_ == nullptr; }
+    size_t size() const { return size_; }
+
+    PostCb& front() {
+      ASSERT(!empty());
+      return front_->callback_;
+    }
+
+    /**
+     * Destroys the callback at the front of the batch.
+     */
+    void popFront() {
+      ASSERT(!empty());
+      Node* node = front_;
+      front_ = node->next_;
+      --size_;
+      delete node;
+    }
+
+  private:
+    friend class PostQueue;
+
+    // Reverses the list taken from the queue, whose head is the last posted callback.
+    explicit Batch(Node* head) {
+      while (head != nullptr) {
+        Node* next = head->next_;
+        head->next_ = front_;
+        front_ = head;
+        head = next;
+        ++size_;
+      }
+    }
+
+    Node* front_{};
+    size_t size_{};
+  };
+
+  PostQueue() = default;
+  PostQueue(const PostQueue&) = delete;
+  PostQueue& operator=(const PostQueue&) = delete;
+  ~PostQueue() { Batch{head_.exchange(nullptr, std::memory_order_acquire)}; }
+
+  /**
+   * Adds a callback to the queue. This is safe to call from any thread.
+   * @return true if the queue was empty, in which case the consumer needs to be woken up to take
+   *         the callbacks. Otherwise, it already is.
+   */
+  bool push(PostCb callback) {
+    Node* node = new Node{std::move(callback), nullptr};
+    Node* head = head_.load(std::memory_order_relaxed);
+    // The release order publishes the callback along with the node to the consumer. The node must
+    // not be accessed once published, as the consumer can take and delete it at any time.
+    do {
+      node->next_ = head;
+    } while (!head_.compare_exchange_weak(head, node, std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return head == nullptr;
+  }
+
+  /**
+   * Takes all the callbacks posted so far. Callbacks posted after this, including by the callbacks
+   * of the batch, are left for the next batch. This must only be called from the consumer thread.
+   */
+  Batch takeAll() { return Batch{head_.exchange(nullptr, std::memory_order_acquire)}; }
+
+  /**
+   * @return the number of callbacks in the queue. This must only be called from the consumer
+   *         thread, as the nodes are only deleted on this thread.
+   */
+  size_t size() const {
+    size_t size = 0;
+    for (const Node* node = head_.load(std::memory_order_acquire); node != nullptr;
+         node = node->next_) {
+      ++size;
+    }
+    return size;
+  }
+
+private:
+  // Last posted callback, linked to the ones posted before it.
+  std::atomic<Node*> head_{};
+};
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,275 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+
+namespace {
+
+constexpr std::chrono::microseconds Tick = std::chrono::milliseconds(1);
+
+} // namespace
+
+class TimerWheel::WheelTimerImpl final : public Timer, public Entry {
+public:
+  WheelTimerImpl(TimerWheel& wheel, TimerCb cb, Dispatcher& dispatcher)
+      : wheel_(wheel), cb_(cb), dispatcher_(dispatcher) {
+    ASSERT(cb_);
+  }
+
+  ~WheelTimerImpl() override { wheel_.unlink(*this); }
+
+  // Timer
+  void disableTimer() override {
+    ASSERT(dispatcher_.isThreadSafe());
+    wheel_.unlink(*this);
+    if (hr_timer_ != nullptr) {
+      hr_timer_->disableTimer();
+    }
+  }
+
+  void enableTimer(std::chrono::milliseconds duration, const ScopeTrackedObject* object) override {
+    ASSERT(dispatcher_.isThreadSafe());
+    if (hr_timer_ != nullptr) {
+      hr_timer_->disableTimer();
+    }
+    object_ = object;
+    wheel_.enable(*this, duration);
+  }
+
+  void enableHRTimer(std::chrono::microseconds duration,
+                     const ScopeTrackedObject* object) override {
+    ASSERT(dispatcher_.isThreadSafe());
+    wheel_.unlink(*this);
+    if (hr_timer_ == nullptr) {
+      hr_timer_ = wheel_.base_scheduler_.createTimer([this]() { fire(); }, dispatcher_);
+    }
+    object_ = object;
+    hr_timer_->enableHRTimer(duration);
+  }
+
+  bool enabled() override {
+    ASSERT(dispatcher_.isThreadSafe());
+    return bucket_ != nullptr || (hr_timer_ != nullptr && hr_timer_->enabled());
+  }
+
+  void fire() {
+    if (object_ == nullptr) {
+      cb_();
+      return;
+    }
+    ScopeTrackerScopeState scope(object_, dispatcher_);
+    object_ = nullptr;
+    cb_();
+  }
+
+private:
+  TimerWheel& wheel_;
+  const TimerCb cb_;
+  Dispatcher& dispatcher_;
+  const ScopeTrackedObject* object_{};
+  // Only created if the timer is enabled with enableHRTimer().
+  TimerPtr hr_timer_;
+};
+
+TimerWheel::TimerWheel(Scheduler& base_scheduler, TimeSource& time_source, Dispatcher& dispatcher)
+    : base_scheduler_(base_scheduler), time_source_(time_source),
+      start_(time_source.monotonicTime()),
+      tick_timer_(base_scheduler.createTimer([this]() { onTick(); }, dispatcher)) {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    slots_[i].index_ = static_cast<int32_t>(i);
+  }
+}
+
+TimerPtr TimerWheel::createTimer(const TimerCb& cb, Dispatcher& dispatcher) {
+  return std::make_unique<WheelTimerImpl>(*this, cb, dispatcher);
+}
+
+void TimerWheel::enable(Entry& entry, std::chrono::milliseconds duration) {
+  unlink(entry);
+  if (duration.count() < 0) {
+    IS_ENVOY_BUG(fmt::format("Negative duration passed to enableTimer(): {}", duration.count()));
+    duration = std::chrono::milliseconds(500);
+  }
+  // Same clipping as TimerUtils::durationToTimeval(), which also keeps the tick computation below
+  // from overflowing.
+  duration = std::min<std::chrono::milliseconds>(duration, std::chrono::seconds(INT32_MAX));
+
+  // Round up, so that the timer never fires early.
+  const auto expiry_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      time_source_.monotonicTime() - start_ + duration);
+  const uint64_t expiry_tick = (expiry_time + Tick - std::chrono::microseconds(1)) / Tick;
+  if (expiry_tick <= current_tick_) {
+    link(entry, ready_);
+    wakeUpAt(current_tick_);
+    return;
+  }
+  entry.expiry_tick_ = expiry_tick;
+  place(entry);
+}
+
+void TimerWheel::place(Entry& entry) {
+  ASSERT(entry.expiry_tick_ >= current_tick_);
+  // The level is the lowest one where the expiry tick and the current tick only differ by their
+  // slot, so that the slot is only reached once.
+  for (uint32_t level = 0; level < NumLevels; ++level) {
+    const uint32_t shift = level * LevelBits;
+    if ((entry.expiry_tick_ >> (shift + LevelBits)) == (current_tick_ >> (shift + LevelBits))) {
+      link(entry,
+           slots_[level * SlotsPerLevel + ((entry.expiry_tick_ >> shift) & (SlotsPerLevel - 1))]);
+      wakeUpAt((entry.expiry_tick_ >> shift) << shift);
+      return;
+    }
+  }
+  link(entry, overflow_);
+  constexpr uint32_t range_bits = NumLevels * LevelBits;
+  wakeUpAt(((current_tick_ >> range_bits) + 1) << range_bits);
+}
+
+void TimerWheel::link(Entry& entry, Bucket& bucket) {
+  ASSERT(entry.bucket_ == nullptr);
+  entry.prev_ = bucket.head_.prev_;
+  entry.next_ = &bucket.head_;
+  bucket.head_.prev_->next_ = &entry;
+  bucket.head_.prev_ = &entry;
+  entry.bucket_ = &bucket;
+  if (bucket.index_ >= 0) {
+    occupied_[bucket.index_ / 64] |= uint64_t(1) << (bucket.index_ % 64);
+  }
+}
+
+void TimerWheel::unlink(Entry& entry) {
+  Bucket* bucket = entry.bucket_;
+  if (bucket == nullptr) {
+    return;
+  }
+  entry.prev_->next_ = entry.next_;
+  entry.next_->prev_ = entry.prev_;
+  entry.prev_ = entry.next_ = &entry;
+  entry.bucket_ = nullptr;
+  if (bucket->index_ >= 0 && bucket->empty()) {
+    occupied_[bucket->index_ / 64] &= ~(uint64_t(1) << (bucket->index_ % 64));
+  }
+}
+
+void TimerWheel::cascade(Bucket& bucket) {
+  // The entries are detached first, as those of the overflow bucket can be placed back into it.
+  while (!bucket.empty()) {
+    Entry& entry = *bucket.head_.next_;
+    unlink(entry);
+    link(entry, pending_);
+  }
+  while (!pending_.empty()) {
+    Entry& entry = *pending_.head_.next_;
+    unlink(entry);
+    place(entry);
+  }
+}
+
+void TimerWheel::runExpired(Bucket& bucket) {
+  while (!bucket.empty()) {
+    Entry& entry = *bucket.head_.next_;
+    unlink(entry);
+    link(entry, pending_);
+  }
+  // Callbacks can disable or delete the timers that have not run yet, which unlinks them.
+  while (!pending_.empty()) {
+    Entry& entry = *pending_.head_.next_;
+    unlink(entry);
+    static_cast<WheelTimerImpl&>(entry).fire();
+  }
+}
+
+void TimerWheel::onTick() {
+  in_tick_ = true;
+  wake_up_enabled_ = false;
+  runExpired(ready_);
+
+  const uint64_t now_tick = nowTick();
+  for (uint64_t tick = nextEventTick(); tick <= now_tick; tick = nextEventTick()) {
+    current_tick_ = tick;
+    constexpr uint32_t range_bits = NumLevels * LevelBits;
+    if ((tick & ((uint64_t(1) << range_bits) - 1)) == 0) {
+      cascade(overflow_);
+    }
+    for (uint32_t level = NumLevels - 1; level > 0; --level) {
+      const uint32_t shift = level * LevelBits;
+      if ((tick & ((uint64_t(1) << shift) - 1)) == 0) {
+        cascade(slots_[level * SlotsPerLevel + ((tick >> shift) & (SlotsPerLevel - 1))]);
+      }
+    }
+    runExpired(slots_[tick & (SlotsPerLevel - 1)]);
+  }
+  // No slot is reached between the last processed tick and now, so skipping to now does not
+  // change the slot of any timer.
+  current_tick_ = std::max(current_tick_, now_tick);
+  in_tick_ = false;
+
+  if (!ready_.empty()) {
+    wakeUpAt(current_tick_);
+  } else if (const uint64_t tick = nextEventTick(); tick != std::numeric_limits<uint64_t>::max()) {
+    wakeUpAt(tick);
+  }
+}
+
+uint64_t TimerWheel::nowTick() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                               start_) /
+         Tick;
+}
+
+uint64_t TimerWheel::nextEventTick() const {
+  uint64_t next = std::numeric_limits<uint64_t>::max();
+  // The slot of the current tick is included for the timers cascaded into it, which expire now.
+  const int32_t slot = findOccupiedSlot(0, current_tick_ & (SlotsPerLevel - 1));
+  if (slot >= 0) {
+    return (current_tick_ & ~uint64_t(SlotsPerLevel - 1)) | slot;
+  }
+  for (uint32_t level = 1; level < NumLevels; ++level) {
+    const uint32_t shift = level * LevelBits;
+    const int32_t slot =
+        findOccupiedSlot(level, ((current_tick_ >> shift) & (SlotsPerLevel - 1)) + 1);
+    if (slot >= 0) {
+      next = std::min(next, ((current_tick_ >> (shift + LevelBits)) << (shift + LevelBits)) |
+                                (uint64_t(slot) << shift));
+    }
+  }
+  if (!overflow_.empty()) {
+    constexpr uint32_t range_bits = NumLevels * LevelBits;
+    next = std::min(next, ((current_tick_ >> range_bits) + 1) << range_bits);
+  }
+  return next;
+}
+
+int32_t TimerWheel::findOccupiedSlot(uint32_t level, uint32_t from) const {
+  for (uint32_t slot = from; slot < SlotsPerLevel; slot = (slot | 63) + 1) {
+    const uint32_t index = level * SlotsPerLevel + slot;
+    const uint64_t bits = occupied_[index / 64] >> (index % 64);
+    if (bits != 0) {
+      return slot + absl::countr_zero(bits);
+    }
+  }
+  return -1;
+}
+
+void TimerWheel::wakeUpAt(uint64_t tick) {
+  // onTick() schedules the next wake up once it is done.
+  if (in_tick_ || (wake_up_enabled_ && wake_up_tick_ <= tick)) {
+    return;
+  }
+  wake_up_enabled_ = true;
+  wake_up_tick_ = tick;
+  const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(
+      start_ + Tick * static_cast<int64_t>(tick) - time_source_.monotonicTime());
+  tick_timer_->enableHRTimer(std::max(delay, std::chrono::microseconds::zero()));
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Hierarchical timing wheel implementation of Scheduler, for dispatchers with a very large number
+ * of timers, e.g. the idle and stream timeouts of a million connections. Enabling and disabling a
+ * timer are O(1), where libevent keeps its timers in a min-heap and rebalances it on every change.
+ *
+ * Time is divided in ticks of a millisecond, and the wheel has 4 levels of 256 slots. A timer is
+ * put in the slot of the lowest level whose range covers its expiry tick. When the wheel gets to a
+ * slot of a higher level, its timers are moved to the lower levels, so that each timer is moved at
+ * most 3 times before it expires. A single timer of the underlying scheduler wakes the event loop
+ * up at the next tick with a slot to process, rather than on every tick.
+ *
+ * Timers fire no earlier than requested, and at most one tick later. High resolution timers are
+ * delegated to the underlying scheduler, as they need a finer resolution than the ticks.
+ */
+class TimerWheel : public Scheduler {
+public:
+  TimerWheel(Scheduler& base_scheduler, TimeSource& time_source, Dispatcher& dispatcher);
+
+  // Scheduler
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher& dispatcher) override;
+
+private:
+  class WheelTimerImpl;
+  struct Bucket;
+
+  static constexpr uint32_t LevelBits = 8;
+  static constexpr uint32_t SlotsPerLevel = 1 << LevelBits;
+  static constexpr uint32_t NumLevels = 4;
+
+  // Intrusive list node, so that a timer is unlinked from its slot in constant time.
+  struct Entry {
+    Entry* prev_{this};
+    Entry* next_{this};
+    // The bucket the entry is linked into, or nullptr if the timer is disabled.
+    Bucket* bucket_{};
+    uint64_t expiry_tick_{};
+  };
+
+  struct Bucket {
+    Bucket() = default;
+    Bucket(const Bucket&) = delete;
+    Bucket& operator=(const Bucket&) = delete;
+
+    bool empty() const { return head_.next_ == &head_; }
+
+    Entry head_;
+    // Index of the bucket in occupied_, or -1 for the buckets that are not wheel slots.
+    int32_t index_{-1};
+  };
+
+  void enable(Entry& entry, std::chrono::milliseconds duration);
+  void place(Entry& entry);
+  void link(Entry& entry, Bucket& bucket);
+  void unlink(Entry& entry);
+  void cascade(Bucket& bucket);
+  void runExpired(Bucket& bucket);
+  void onTick();
+  uint64_t nowTick() const;
+  uint64_t nextEventTick() const;
+  int32_t findOccupiedSlot(uint32_t level, uint32_t from) const;
+  void wakeUpAt(uint64_t tick);
+
+  Scheduler& base_scheduler_;
+  TimeSource& time_source_;
+  const MonotonicTime start_;
+  const TimerPtr tick_timer_;
+  // Tick the wheel has been advanced to.
+  uint64_t current_tick_{};
+  // Tick at which tick_timer_ is set to fire, if it is enabled.
+  uint64_t wake_up_tick_{};
+  bool wake_up_enabled_{};
+  bool in_tick_{};
+  std::array<Bucket, NumLevels * SlotsPerLevel> slots_;
+  std::array<uint64_t, NumLevels * SlotsPerLevel / 64> occupied_{};
+  // Timers expiring beyond the range of the highest level.
+  Bucket overflow_;
+  // Timers enabled for the current tick, which run on the next event loop iteration like libevent
+  // timers enabled for a zero duration.
+  Bucket ready_;
+  // Timers being moved or run.
+  Bucket pending_;
+};
+
+} // namespace Event
+} // namespace Envoy
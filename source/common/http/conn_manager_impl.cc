@@ -953,6 +953,36 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
     });
     refreshAccessLogFlushTimer();
   }
+
+  if (const auto& account = filter_manager_.account(); account != nullptr) {
+    account->setOwner(connection_manager_.read_callbacks_->connection().id(), stream_id_);
+  }
+}
+
+ConnectionManagerImpl::ActiveStream::~ActiveStream() {
+  uint64_t charged_bytes = 0;
+  for (const uint64_t bytes : charged_header_bytes_) {
+    charged_bytes += bytes;
+  }
+  if (charged_bytes > 0) {
+    filter_manager_.account()->creditNonBuffer(charged_bytes);
+  }
+}
+
+void ConnectionManagerImpl::ActiveStream::chargeHeaderBytes(ChargedHeaderMap map,
+                                                            const HeaderMap& headers) {
+  const auto& account = filter_manager_.account();
+  if (account == nullptr) {
+    return;
+  }
+  uint64_t& charged_bytes = charged_header_bytes_[static_cast<size_t>(map)];
+  const uint64_t bytes = headers.byteSize();
+  if (bytes > charged_bytes) {
+    account->chargeNonBuffer(bytes - charged_bytes);
+  } else if (bytes < charged_bytes) {
+    account->creditNonBuffer(charged_bytes - bytes);
+  }
+  charged_bytes = bytes;
 }
 
 void ConnectionManagerImpl::ActiveStream::log(AccessLog::AccessLogType type) {
@@ -1298,6 +1328,7 @@ void ConnectionManagerImpl::ActiveStream::decodeHeaders(RequestHeaderMapSharedPt
   ScopeTrackerScopeState scope(this,
                                connection_manager_.read_callbacks_->connection().dispatcher());
   request_headers_ = std::move(headers);
+  chargeHeaderBytes(ChargedHeaderMap::RequestHeaders, *request_headers_);
   filter_manager_.requestHeadersInitialized();
   if (request_header_timer_ != nullptr) {
     request_header_timer_->disableTimer();
@@ -1591,6 +1622,7 @@ void ConnectionManagerImpl::ActiveStream::decodeTrailers(RequestTrailerMapPtr&&
     return;
   }
   maybeRecordLastByteReceived(true);
+  chargeHeaderBytes(ChargedHeaderMap::RequestTrailers, *trailers);
   if (!state_.deferred_to_next_io_iteration_) {
     request_trailers_ = std::move(trailers);
     filter_manager_.decodeTrailers(*request_trailers_);
@@ -1949,6 +1981,7 @@ void ConnectionManagerImpl::ActiveStream::encodeHeaders(ResponseHeaderMap& heade
 
   filter_manager_.streamInfo().downstreamTiming().onFirstDownstreamTxByteSent(
       connection_manager_.time_source_);
+  chargeHeaderBytes(ChargedHeaderMap::ResponseHeaders, headers);
 
   if (header_validator_) {
     auto result = header_validator_->transformResponseHeaders(headers);
@@ -1978,6 +2011,7 @@ void ConnectionManagerImpl::ActiveStream::encodeData(Buffer::Instance& data, boo
 void ConnectionManagerImpl::ActiveStream::encodeTrailers(ResponseTrailerMap& trailers) {
   ENVOY_EXECUTION_SCOPE(trackedStream(), active_span_.get());
   ENVOY_STREAM_LOG(debug, "encoding trailers via codec:\n{}", *this, trailers);
+  chargeHeaderBytes(ChargedHeaderMap::ResponseTrailers, trailers);
 
   response_encoder_->encodeTrailers(trailers);
 }
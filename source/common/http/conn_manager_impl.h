@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -150,6 +151,7 @@ private:
                               public RouteCache {
     ActiveStream(ConnectionManagerImpl& connection_manager, uint32_t buffer_limit,
                  Buffer::BufferMemoryAccountSharedPtr account);
+    ~ActiveStream() override;
 
     // Event::DeferredDeletable
     void deleteIsPending() override {
@@ -435,6 +437,21 @@ private:
     // present). Return false if this stream was not deferred.
     bool onDeferredRequestProcessing();
 
+    // The header maps of the stream charged to its account.
+    enum class ChargedHeaderMap {
+      RequestHeaders,
+      RequestTrailers,
+      ResponseHeaders,
+      ResponseTrailers,
+      Count
+    };
+
+    // Charges the account of the stream, if any, for the current bytes of a header map of the
+    // stream. Only the difference with the bytes previously charged for the same map is charged or
+    // credited, so a map charged again is not counted twice. The charges are credited back when the
+    // stream is destroyed.
+    void chargeHeaderBytes(ChargedHeaderMap map, const HeaderMap& headers);
+
     ConnectionManagerImpl& connection_manager_;
     OptRef<const TracingConnectionManagerConfig> connection_manager_tracing_config_;
     // TODO(snowp): It might make sense to move this to the FilterManager to avoid storing it in
@@ -529,6 +546,7 @@ private:
     std::queue<MetadataMapPtr> deferred_metadata_;
     RequestTrailerMapPtr deferred_request_trailers_;
     const bool trace_refresh_after_route_refresh_{true};
+    std::array<uint64_t, static_cast<size_t>(ChargedHeaderMap::Count)> charged_header_bytes_{};
   };
 
   using ActiveStreamPtr = std::unique_ptr<ActiveStream>;
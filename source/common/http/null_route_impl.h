@@ -18,6 +18,7 @@ struct NullHedgePolicy : public Router::HedgePolicy {
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return false; }
+  Router::ProactiveHedging* proactiveHedging() const override { return nullptr; }
 
   const envoy::type::v3::FractionalPercent additional_request_chance_;
 };
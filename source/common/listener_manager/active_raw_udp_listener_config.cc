@@ -9,8 +9,23 @@
 namespace Envoy {
 namespace Server {
 
-ActiveRawUdpListenerFactory::ActiveRawUdpListenerFactory(uint32_t concurrency)
-    : concurrency_(concurrency) {}
+ActiveRawUdpListenerFactory::ActiveRawUdpListenerFactory(uint32_t concurrency,
+                                                         bool steer_by_peer_address)
+    : concurrency_(concurrency) {
+  if (!steer_by_peer_address || concurrency_ <= 1) {
+    return;
+  }
+
+  peer_address_steering_ = std::make_unique<Network::UdpPeerAddressSteering>(concurrency_);
+  Network::Socket::OptionConstSharedPtr option =
+      peer_address_steering_->createReusePortBpfSocketOption();
+  if (option != nullptr) {
+    options_->push_back(std::move(option));
+  } else {
+    ENVOY_LOG_MISC(warn, "Steering UDP datagrams by peer address in the kernel is not supported on "
+                         "this platform. Datagrams will be forwarded between workers instead.");
+  }
+}
 
 Network::ConnectionHandler::ActiveUdpListenerPtr
 ActiveRawUdpListenerFactory::createActiveUdpListener(Runtime::Loader&, uint32_t worker_index,
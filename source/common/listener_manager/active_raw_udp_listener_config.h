@@ -2,12 +2,14 @@
 
 #include "envoy/network/connection_handler.h"
 
+#include "source/common/network/udp_peer_address_steering.h"
+
 namespace Envoy {
 namespace Server {
 
 class ActiveRawUdpListenerFactory : public Network::ActiveUdpListenerFactory {
 public:
-  ActiveRawUdpListenerFactory(uint32_t concurrency);
+  ActiveRawUdpListenerFactory(uint32_t concurrency, bool steer_by_peer_address = false);
 
   Network::ConnectionHandler::ActiveUdpListenerPtr
   createActiveUdpListener(Runtime::Loader&, uint32_t worker_index,
@@ -20,6 +22,8 @@ public:
 private:
   const uint32_t concurrency_;
   const Network::Socket::OptionsSharedPtr options_{std::make_shared<Network::Socket::Options>()};
+  // Owns the BPF program referenced by the steering socket option in options_.
+  std::unique_ptr<Network::UdpPeerAddressSteering> peer_address_steering_;
 };
 
 } // namespace Server
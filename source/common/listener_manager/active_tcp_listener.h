@@ -73,6 +73,7 @@ public:
     config_->openConnections().inc();
   }
   void post(Network::ConnectionSocketPtr&& socket) override;
+  Event::Dispatcher& dispatcher() override { return ActiveStreamListenerBase::dispatcher(); }
   void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                       bool hand_off_restored_destination_connections, bool rebalanced) override;
 
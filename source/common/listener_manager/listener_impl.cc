@@ -21,7 +21,6 @@
 #include "source/common/listener_manager/active_raw_udp_listener_config.h"
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
 #include "source/common/listener_manager/listener_manager_impl.h"
-#include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/resolver_impl.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
@@ -541,7 +540,8 @@ ListenerImpl::buildInternalListener(const envoy::config::listener::v3::Listener&
                       name_));
     }
     if ((config.has_connection_balance_config() &&
-         config.connection_balance_config().has_exact_balance()) ||
+         (config.connection_balance_config().has_exact_balance() ||
+          config.connection_balance_config().has_load_aware_balance())) ||
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
@@ -652,7 +652,8 @@ ListenerImpl::buildUdpListenerFactory(const envoy::config::listener::v3::Listene
 #endif
   } else {
     udp_listener_config_->listener_factory_ =
-        std::make_unique<Server::ActiveRawUdpListenerFactory>(concurrency);
+        std::make_unique<Server::ActiveRawUdpListenerFactory>(
+            concurrency, config.udp_listener_config().steer_by_peer_address());
   }
   if (udp_listener_config_->writer_factory_ == nullptr) {
     udp_listener_config_->writer_factory_ = std::make_unique<Network::UdpDefaultWriterFactory>();
@@ -827,6 +828,26 @@ ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Listene
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kLoadAwareBalance: {
+        Server::Configuration::ServerFactoryContext& server_context =
+            listener_factory_context_->serverFactoryContext();
+        if (!server_context.bootstrap().enable_dispatcher_stats()) {
+          return absl::InvalidArgumentError(
+              fmt::format("error adding listener '{}': load aware connection balancing requires "
+                          "enable_dispatcher_stats to be set in the bootstrap",
+                          name_));
+        }
+        const auto& load_aware_config = config.connection_balance_config().load_aware_balance();
+        auto balancer = std::make_shared<Network::LoadAwareConnectionBalancerImpl>(
+            load_aware_config, server_context.api().randomGenerator(),
+            listener_factory_context_->listenerScope());
+        if (load_aware_config.has_connection_migration()) {
+          listener_factory_context_->parentFactoryContext().migration_balancers_.push_back(
+              balancer);
+        }
+        connection_balancers_.emplace(address.asString(), std::move(balancer));
+        break;
+      }
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
@@ -22,6 +22,7 @@
 #include "source/common/init/target_impl.h"
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
 #include "source/common/listener_manager/listener_info_impl.h"
+#include "source/common/network/connection_balancer_impl.h"
 #include "source/common/quic/quic_stat_names.h"
 #include "source/server/factory_context_impl.h"
 #include "source/server/transport_socket_config_impl.h"
@@ -145,7 +146,15 @@ public:
 
   // DrainDecision
   bool drainClose(Network::DrainDirection scope) const override {
-    return drain_manager_->drainClose(scope) || server_.drainManager().drainClose(scope);
+    if (drain_manager_->drainClose(scope) || server_.drainManager().drainClose(scope)) {
+      return true;
+    }
+    for (const auto& balancer : migration_balancers_) {
+      if (balancer->shouldMigrateConnection()) {
+        return true;
+      }
+    }
+    return false;
   }
   Common::CallbackHandlePtr addOnDrainCloseCb(Network::DrainDirection,
                                               DrainCloseCb) const override {
@@ -157,6 +166,8 @@ public:
 
 private:
   const Server::DrainManagerPtr drain_manager_;
+  // Balancers with connection migration enabled. Connections are drained when they ask for it.
+  std::vector<std::shared_ptr<Network::LoadAwareConnectionBalancerImpl>> migration_balancers_;
 };
 
 // TODO(lambdai): Strip the interface since ListenerFactoryContext only need to support
@@ -1,5 +1,9 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include "source/common/protobuf/utility.h"
+
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +38,161 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    const envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance& config,
+    Random::RandomGenerator& random, Stats::Scope& scope)
+    : random_(random), stats_({ALL_LOAD_AWARE_CONNECTION_BALANCER_STATS(
+                           POOL_COUNTER_PREFIX(scope, "load_aware_connection_balancer."))}),
+      load_update_interval_(PROTOBUF_GET_MS_OR_DEFAULT(config, load_update_interval, 100)),
+      imbalance_threshold_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, imbalance_threshold_percent, 10) * 10),
+      migration_enabled_(config.has_connection_migration()),
+      migration_threshold_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.connection_migration(),
+                                                           imbalance_threshold_percent, 20) *
+                           10),
+      max_migrations_per_interval_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          config.connection_migration(), max_connections_per_interval, 1)) {}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  Event::Dispatcher& dispatcher = handler.dispatcher();
+  ASSERT(dispatcher.isThreadSafe());
+
+  absl::MutexLock lock(lock_);
+  Slot* slot = nullptr;
+  for (const auto& candidate : slots_) {
+    if (candidate->handler_.load(std::memory_order_relaxed) == nullptr) {
+      slot = candidate.get();
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    // New slots are pushed at the head of the list, which only ever grows.
+    slot = slots_.emplace_back(std::make_unique<Slot>()).get();
+    slot->next_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head_.store(slot, std::memory_order_release);
+  }
+
+  slot->last_sample_time_ = dispatcher.approximateMonotonicTime();
+  slot->last_busy_time_ = dispatcher.loopBusyTime();
+  slot->timer_ = dispatcher.createTimer([this, slot, &dispatcher]() {
+    sampleLoad(*slot, dispatcher);
+    slot->timer_->enableTimer(load_update_interval_);
+  });
+  slot->timer_->enableTimer(load_update_interval_);
+  slot->load_.store(0, std::memory_order_relaxed);
+  slot->dispatcher_.store(&dispatcher, std::memory_order_relaxed);
+  slot->handler_.store(&handler, std::memory_order_release);
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(lock_);
+  for (const auto& slot : slots_) {
+    if (slot->handler_.load(std::memory_order_relaxed) == &handler) {
+      slot->timer_.reset();
+      setMigrationBudget(*slot, 0);
+      slot->handler_.store(nullptr, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  uint32_t current_load = 0;
+  absl::InlinedVector<std::pair<BalancedConnectionHandler*, uint32_t>, 16> others;
+  for (Slot* slot = head_.load(std::memory_order_acquire); slot != nullptr;
+       slot = slot->next_.load(std::memory_order_relaxed)) {
+    BalancedConnectionHandler* handler = slot->handler_.load(std::memory_order_acquire);
+    if (handler == nullptr) {
+      continue;
+    }
+    const uint32_t load = slot->load_.load(std::memory_order_relaxed);
+    if (handler == &current_handler) {
+      current_load = load;
+    } else {
+      others.emplace_back(handler, load);
+    }
+  }
+
+  // Reservoir sampling of the workers that are sufficiently less loaded than the current one.
+  BalancedConnectionHandler* target = &current_handler;
+  uint64_t num_eligible = 0;
+  for (const auto& [handler, load] : others) {
+    if (load + imbalance_threshold_ < current_load && random_.random() % ++num_eligible == 0) {
+      target = handler;
+    }
+  }
+
+  if (target != &current_handler) {
+    stats_.connections_handed_off_.inc();
+  }
+  target->incNumConnections();
+  return *target;
+}
+
+bool LoadAwareConnectionBalancerImpl::shouldMigrateConnection() {
+  if (num_migrating_workers_.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  for (Slot* slot = head_.load(std::memory_order_acquire); slot != nullptr;
+       slot = slot->next_.load(std::memory_order_relaxed)) {
+    if (slot->handler_.load(std::memory_order_acquire) == nullptr) {
+      continue;
+    }
+    Event::Dispatcher* dispatcher = slot->dispatcher_.load(std::memory_order_relaxed);
+    if (dispatcher->isThreadSafe()) {
+      // This is the slot of the current worker, so its budget can be used.
+      if (slot->migration_budget_ == 0) {
+        return false;
+      }
+      setMigrationBudget(*slot, slot->migration_budget_ - 1);
+      stats_.connections_migrated_.inc();
+      return true;
+    }
+  }
+  return false;
+}
+
+void LoadAwareConnectionBalancerImpl::sampleLoad(Slot& slot, Event::Dispatcher& dispatcher) {
+  const MonotonicTime now = dispatcher.approximateMonotonicTime();
+  const std::chrono::microseconds busy_time = dispatcher.loopBusyTime();
+  const auto elapsed =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - slot.last_sample_time_);
+  if (elapsed.count() > 0) {
+    const uint64_t load = std::min<uint64_t>(
+        1000, (busy_time - slot.last_busy_time_).count() * 1000 / elapsed.count());
+    // Average with the previous samples, so that a single long loop iteration does not make the
+    // worker look overloaded.
+    slot.load_.store((slot.load_.load(std::memory_order_relaxed) + load) / 2,
+                     std::memory_order_relaxed);
+  }
+  slot.last_sample_time_ = now;
+  slot.last_busy_time_ = busy_time;
+
+  if (migration_enabled_) {
+    const uint32_t load = slot.load_.load(std::memory_order_relaxed);
+    uint32_t min_load = load;
+    for (Slot* other = head_.load(std::memory_order_acquire); other != nullptr;
+         other = other->next_.load(std::memory_order_relaxed)) {
+      if (other->handler_.load(std::memory_order_acquire) != nullptr) {
+        min_load = std::min(min_load, other->load_.load(std::memory_order_relaxed));
+      }
+    }
+    // Unused budget is not carried over, so that a worker drains at most a bounded number of
+    // connections per interval.
+    setMigrationBudget(slot, load > min_load + migration_threshold_ ? max_migrations_per_interval_
+                                                                    : 0);
+  }
+}
+
+void LoadAwareConnectionBalancerImpl::setMigrationBudget(Slot& slot, uint32_t budget) {
+  if (slot.migration_budget_ == 0 && budget > 0) {
+    num_migrating_workers_.fetch_add(1, std::memory_order_relaxed);
+  } else if (slot.migration_budget_ > 0 && budget == 0) {
+    num_migrating_workers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  slot.migration_budget_ = budget;
+}
+
 } // namespace Network
 } // namespace Envoy
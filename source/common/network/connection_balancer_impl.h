@@ -1,9 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/common/time.h"
 #include "envoy/config/listener/v3/listener.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
 #include "envoy/server/filter_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/protobuf/protobuf.h"
 
@@ -44,6 +55,90 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * All load aware connection balancer stats. @see stats_macros.h
+ */
+#define ALL_LOAD_AWARE_CONNECTION_BALANCER_STATS(COUNTER)                                          \
+  COUNTER(connections_handed_off)                                                                  \
+  COUNTER(connections_migrated)
+
+/**
+ * Struct definition for all load aware connection balancer stats. @see stats_macros.h
+ */
+struct LoadAwareConnectionBalancerStats {
+  ALL_LOAD_AWARE_CONNECTION_BALANCER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Implementation of connection balancer that steers new connections away from busy workers. The
+ * load of a worker is the fraction of time its event loop spends processing events, which each
+ * worker samples periodically from Event::Dispatcher::loopBusyTime(). A worker accepting a
+ * connection keeps it, unless other workers are less loaded by more than the imbalance threshold.
+ * The connection is then handed off to one of them at random rather than to the least loaded one,
+ * as the loads are only updated periodically and all the workers would otherwise pick the same
+ * target in between. Picking a target handler only reads atomics and does not take any lock.
+ *
+ * With connection migration, a worker much busier than the least loaded one also gets a budget of
+ * connections to drain on each load update, see shouldMigrateConnection().
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  LoadAwareConnectionBalancerImpl(
+      const envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance&
+          config,
+      Random::RandomGenerator& random, Stats::Scope& scope);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+  /**
+   * Decides whether a connection of the current worker should be drained, so that its client
+   * reconnects to a less loaded worker. Each true result uses one unit of the migration budget of
+   * the worker. Must be called on a worker running a registered handler.
+   * @return true if the connection should be drained.
+   */
+  bool shouldMigrateConnection();
+
+private:
+  // State of a registered handler. Slots are only freed with the balancer, so that
+  // pickTargetHandler() can walk them while handlers are registered and unregistered. The slot of
+  // an unregistered handler is reused by the next registered one.
+  struct Slot {
+    std::atomic<BalancedConnectionHandler*> handler_{};
+    std::atomic<Event::Dispatcher*> dispatcher_{};
+    // Smoothed load of the worker, in permille of the wall time.
+    std::atomic<uint32_t> load_{};
+    std::atomic<Slot*> next_{};
+
+    // Only used on the worker of the handler.
+    Event::TimerPtr timer_;
+    MonotonicTime last_sample_time_;
+    std::chrono::microseconds last_busy_time_{};
+    // Connections left to drain until the next load update.
+    uint32_t migration_budget_{};
+  };
+
+  void sampleLoad(Slot& slot, Event::Dispatcher& dispatcher);
+  void setMigrationBudget(Slot& slot, uint32_t budget);
+
+  Random::RandomGenerator& random_;
+  LoadAwareConnectionBalancerStats stats_;
+  const std::chrono::milliseconds load_update_interval_;
+  // Thresholds are in permille, like the loads.
+  const uint32_t imbalance_threshold_;
+  const bool migration_enabled_;
+  const uint32_t migration_threshold_;
+  const uint32_t max_migrations_per_interval_;
+  // Number of workers with a migration budget, so that shouldMigrateConnection() can return early
+  // when the load is balanced.
+  std::atomic<uint32_t> num_migrating_workers_{};
+  std::atomic<Slot*> head_{};
+  absl::Mutex lock_;
+  std::vector<std::unique_ptr<Slot>> slots_ ABSL_GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
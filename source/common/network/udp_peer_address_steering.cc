@@ -0,0 +1,93 @@
+#include "source/common/network/udp_peer_address_steering.h"
+
+#include <cstring>
+
+#include "envoy/config/core/v3/socket_option.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/network/socket_option_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+UdpPeerAddressSteering::UdpPeerAddressSteering(uint32_t concurrency) : concurrency_(concurrency) {
+  ASSERT(concurrency_ > 0);
+}
+
+uint32_t UdpPeerAddressSteering::hash(const Address::Instance& peer_address) {
+  const Address::Ip* ip = peer_address.ip();
+  ASSERT(ip != nullptr);
+  uint32_t result = ip->port();
+  if (ip->version() == Address::IpVersion::v4) {
+    return result ^ ntohl(ip->ipv4()->address());
+  }
+
+  const absl::uint128 address = ip->ipv6()->address();
+  uint32_t words[4];
+  static_assert(sizeof(words) == sizeof(address));
+  memcpy(words, &address, sizeof(words));
+  for (const uint32_t word : words) {
+    result ^= ntohl(word);
+  }
+  return result;
+}
+
+Socket::OptionConstSharedPtr UdpPeerAddressSteering::createReusePortBpfSocketOption() {
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // This BPF filter reads the source address and port from the IP and UDP headers of the datagram
+  // and computes the same hash as hash() above. The hash modulo the number of workers is the index
+  // of the socket in the SO_REUSEPORT group, which is also the index of the worker owning it.
+  // Datagrams which are neither IPv4 nor IPv6 are dispatched based on the kernel's flow hash.
+  // IPv6 extension headers are not skipped; the port is read at the fixed header length.
+  constexpr uint32_t NetOff = static_cast<uint32_t>(SKF_NET_OFF);
+  constexpr uint32_t AdRxHash = static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_RXHASH);
+  // SPELLCHECKER(off)
+  filter_ = {
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, NetOff),              //       ldb [net]
+      BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 4),                  //       rsh #4
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 4, 0, 8),            //       jne #4, ipv6
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, NetOff),              //       ldb [net]
+      BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0xf),                //       and #0xf
+      BPF_STMT(BPF_ALU | BPF_LSH | BPF_K, 2),                  //       lsh #2
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),                         //       tax
+      BPF_STMT(BPF_LD | BPF_H | BPF_IND, NetOff),              //       ldh [x + net]
+      BPF_STMT(BPF_ST, 0),                                     //       st M[0]
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, NetOff + 12),         //       ld [net + 12]
+      BPF_STMT(BPF_JMP | BPF_JA, 13),                          //       ja port
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 6, 0, 16),           // ipv6: jne #6, other
+      BPF_STMT(BPF_LD | BPF_H | BPF_ABS, NetOff + 40),         //       ldh [net + 40]
+      BPF_STMT(BPF_ST, 0),                                     //       st M[0]
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, NetOff + 8),          //       ld [net + 8]
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),                         //       tax
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, NetOff + 12),         //       ld [net + 12]
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),                  //       xor x
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),                         //       tax
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, NetOff + 16),         //       ld [net + 16]
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),                  //       xor x
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),                         //       tax
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, NetOff + 20),         //       ld [net + 20]
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),                  //       xor x
+      BPF_STMT(BPF_LDX | BPF_MEM, 0),                          // port: ldx M[0]
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),                  //       xor x
+      BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, concurrency_),       //       mod #socket_count
+      BPF_STMT(BPF_RET | BPF_A, 0),                            //       ret a
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, AdRxHash),            // other: ld rxhash
+      BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, concurrency_),       //       mod #socket_count
+      BPF_STMT(BPF_RET | BPF_A, 0),                            //       ret a
+  };
+  // SPELLCHECKER(on)
+
+  // Note that this option refers to the BPF program data above, which must live until the
+  // option is used. The program is kept as a member variable for this purpose.
+  prog_.len = filter_.size();
+  prog_.filter = filter_.data();
+  return std::make_shared<SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_BOUND, ENVOY_ATTACH_REUSEPORT_CBPF,
+      absl::string_view(reinterpret_cast<char*>(&prog_), sizeof(prog_)));
+#else
+  return nullptr;
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
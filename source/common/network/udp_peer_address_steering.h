@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/network/address.h"
+#include "envoy/network/socket.h"
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Assigns UDP datagrams to workers by hashing the downstream peer IP address and port, so that
+ * all datagrams from a given peer are handled by the same worker. The same assignment can be
+ * performed by the kernel for a SO_REUSEPORT socket group via a classic BPF program, which avoids
+ * handing datagrams between workers in user space.
+ */
+class UdpPeerAddressSteering {
+public:
+  explicit UdpPeerAddressSteering(uint32_t concurrency);
+
+  /**
+   * @return the hash of the peer address, identical to the value computed by the BPF program.
+   * For IPv4 this is the address xor the port. For IPv6 this is the xor of the four 32-bit words
+   * of the address and the port. All values are taken in host byte order.
+   */
+  static uint32_t hash(const Address::Instance& peer_address);
+
+  /**
+   * @return the index of the worker which owns datagrams from the given peer.
+   */
+  uint32_t workerIndex(const Address::Instance& peer_address) const {
+    return hash(peer_address) % concurrency_;
+  }
+
+  /**
+   * @return a socket option which attaches the steering BPF program to the SO_REUSEPORT group of
+   * the socket, or nullptr if this is not supported on the platform. The returned option refers
+   * to program data owned by this object, which must outlive any use of the option.
+   */
+  Socket::OptionConstSharedPtr createReusePortBpfSocketOption();
+
+private:
+  const uint32_t concurrency_;
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  sock_fprog prog_;
+  std::vector<sock_filter> filter_;
+#endif
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -46,6 +46,7 @@ void WipCounterBase::onWorkInProgressCommon(absl::string_view description) {
 
 void WarningValidationVisitorImpl::setCounters(Stats::Counter& unknown_counter,
                                                Stats::Counter& wip_counter) {
+  absl::MutexLock lock(&mutex_);
   setWipCounter(wip_counter);
   ASSERT(unknown_counter_ == nullptr);
   unknown_counter_ = &unknown_counter;
@@ -54,6 +55,7 @@ void WarningValidationVisitorImpl::setCounters(Stats::Counter& unknown_counter,
 
 absl::Status WarningValidationVisitorImpl::onUnknownField(absl::string_view description) {
   const uint64_t hash = HashUtil::xxHash64(description);
+  absl::MutexLock lock(&mutex_);
   auto it = descriptions_.insert(hash);
   // If we've seen this before, skip.
   if (!it.second) {
@@ -76,6 +78,7 @@ absl::Status WarningValidationVisitorImpl::onDeprecatedField(absl::string_view d
 }
 
 void WarningValidationVisitorImpl::onWorkInProgress(absl::string_view description) {
+  absl::MutexLock lock(&mutex_);
   onWorkInProgressCommon(description);
 }
 
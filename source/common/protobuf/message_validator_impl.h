@@ -7,6 +7,7 @@
 #include "source/common/common/logger.h"
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace ProtobufMessage {
@@ -60,13 +61,16 @@ public:
   void onWorkInProgress(absl::string_view description) override;
 
 private:
+  // Resources may be decoded on the xDS decoding threads, so unknown fields and work in progress
+  // can be reported from several threads at once, including while the counters are set.
+  absl::Mutex mutex_;
   // Track hashes of descriptions we've seen, to avoid log spam. A hash is used here to avoid
   // wasting memory with unused strings.
-  absl::flat_hash_set<uint64_t> descriptions_;
+  absl::flat_hash_set<uint64_t> descriptions_ ABSL_GUARDED_BY(mutex_);
   // This can be late initialized via setUnknownCounter(), enabling the server bootstrap loading
   // which occurs prior to the initialization of the stats subsystem.
-  Stats::Counter* unknown_counter_{};
-  uint64_t prestats_unknown_count_{};
+  Stats::Counter* unknown_counter_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t prestats_unknown_count_ ABSL_GUARDED_BY(mutex_){};
 };
 
 class StrictValidationVisitorImpl : public ValidationVisitorBase, public WipCounterBase {
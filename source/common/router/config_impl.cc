@@ -209,6 +209,10 @@ std::string SslRedirector::newUri(const Http::RequestHeaderMap& headers) const {
 
 HedgePolicyImpl::HedgePolicyImpl(const envoy::config::route::v3::HedgePolicy& hedge_policy)
     : additional_request_chance_(hedge_policy.additional_request_chance()),
+      proactive_hedging_(hedge_policy.has_proactive_hedging()
+                             ? std::make_unique<ProactiveHedgingImpl>(
+                                   hedge_policy.proactive_hedging())
+                             : nullptr),
       initial_requests_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(hedge_policy, initial_requests, 1)),
       hedge_on_per_try_timeout_(hedge_policy.hedge_on_per_try_timeout()) {}
 
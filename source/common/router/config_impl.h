@@ -33,6 +33,7 @@
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
+#include "source/common/router/proactive_hedging_impl.h"
 #include "source/common/router/retry_policy_impl.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
@@ -451,9 +452,11 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  ProactiveHedging* proactiveHedging() const override { return proactive_hedging_.get(); }
 
 private:
   const envoy::type::v3::FractionalPercent additional_request_chance_;
+  const std::unique_ptr<ProactiveHedgingImpl> proactive_hedging_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const uint32_t initial_requests_;
   const bool hedge_on_per_try_timeout_;
@@ -0,0 +1,116 @@
+#include "source/common/router/proactive_hedging_impl.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Router {
+
+ProactiveHedgingImpl::ProactiveHedgingImpl(
+    const envoy::config::route::v3::HedgePolicy::ProactiveHedging& config)
+    : percentile_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, latency_percentile, 95.0) / 100.0),
+      min_delay_(PROTOBUF_GET_MS_OR_DEFAULT(config, min_delay, 0)),
+      max_hedged_fraction_(
+          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(config, max_hedged_requests, 5.0) / 100.0),
+      min_samples_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, min_samples, 100)) {}
+
+uint32_t ProactiveHedgingImpl::bucketIndex(uint64_t latency_ms) {
+  if (latency_ms < SubBuckets) {
+    return latency_ms;
+  }
+  const uint32_t exponent = absl::bit_width(latency_ms) - 1;
+  const uint64_t sub_bucket = (latency_ms >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+  const uint64_t index = (exponent - SubBucketBits + 1) * SubBuckets + sub_bucket;
+  return std::min<uint64_t>(index, NumBuckets - 1);
+}
+
+uint64_t ProactiveHedgingImpl::bucketUpperBound(uint32_t index) {
+  if (index < SubBuckets) {
+    return index;
+  }
+  const uint32_t shift = index / SubBuckets - 1;
+  const uint64_t sub_bucket = index % SubBuckets;
+  return ((SubBuckets + sub_bucket + 1) << shift) - 1;
+}
+
+absl::optional<std::chrono::milliseconds> ProactiveHedgingImpl::hedgeDelay() const {
+  const int64_t delay_ms = delay_ms_.load(std::memory_order_relaxed);
+  if (delay_ms < 0) {
+    return absl::nullopt;
+  }
+  return std::chrono::milliseconds(delay_ms);
+}
+
+void ProactiveHedgingImpl::recordLatency(std::chrono::milliseconds latency) {
+  buckets_[bucketIndex(std::max<int64_t>(latency.count(), 0))].fetch_add(
+      1, std::memory_order_relaxed);
+  // Each value returned by fetch_add() is seen by exactly one thread, so only one thread decays
+  // the histogram when the threshold is crossed.
+  const uint64_t samples = samples_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (samples == DecayFactor * min_samples_) {
+    decayLatencies();
+  }
+  if (samples == min_samples_ || samples % DelayUpdateInterval == 0) {
+    updateDelay();
+  }
+}
+
+void ProactiveHedgingImpl::onRequest() {
+  if (requests_.fetch_add(1, std::memory_order_relaxed) + 1 == BudgetWindow) {
+    requests_.fetch_sub(BudgetWindow / 2, std::memory_order_relaxed);
+    hedges_.store(hedges_.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+  }
+}
+
+bool ProactiveHedgingImpl::tryHedge() {
+  const uint64_t hedges = hedges_.load(std::memory_order_relaxed);
+  const uint64_t requests = requests_.load(std::memory_order_relaxed);
+  if (static_cast<double>(hedges + 1) > requests * max_hedged_fraction_) {
+    return false;
+  }
+  hedges_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ProactiveHedgingImpl::updateDelay() {
+  std::array<uint64_t, NumBuckets> counts;
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < NumBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total < min_samples_) {
+    delay_ms_.store(-1, std::memory_order_relaxed);
+    return;
+  }
+
+  const uint64_t rank =
+      std::max<uint64_t>(static_cast<uint64_t>(std::ceil(total * percentile_)), 1);
+  uint64_t cumulative = 0;
+  uint32_t index = 0;
+  for (; index < NumBuckets - 1; ++index) {
+    cumulative += counts[index];
+    if (cumulative >= rank) {
+      break;
+    }
+  }
+  delay_ms_.store(std::max<int64_t>(bucketUpperBound(index), min_delay_.count()),
+                  std::memory_order_relaxed);
+}
+
+void ProactiveHedgingImpl::decayLatencies() {
+  uint64_t removed = 0;
+  for (auto& bucket : buckets_) {
+    const uint64_t half = bucket.load(std::memory_order_relaxed) / 2;
+    bucket.fetch_sub(half, std::memory_order_relaxed);
+    removed += half;
+  }
+  samples_.fetch_sub(removed, std::memory_order_relaxed);
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+#include "envoy/router/router.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Implementation of ProactiveHedging that estimates a latency percentile from a decaying histogram
+ * of the latencies observed on a route. All state is kept in relaxed atomics so that workers never
+ * contend on a lock; concurrent updates may make the estimate and the budget slightly imprecise.
+ */
+class ProactiveHedgingImpl : public ProactiveHedging {
+public:
+  explicit ProactiveHedgingImpl(
+      const envoy::config::route::v3::HedgePolicy::ProactiveHedging& config);
+
+  // Router::ProactiveHedging
+  absl::optional<std::chrono::milliseconds> hedgeDelay() const override;
+  void recordLatency(std::chrono::milliseconds latency) override;
+  void onRequest() override;
+  bool tryHedge() override;
+
+  // Latencies are recorded in milliseconds into log-linear buckets: values below SubBuckets have
+  // a bucket of their own and every following power of two is split into SubBuckets buckets,
+  // which bounds the relative error of the estimate to 1 / SubBuckets.
+  static constexpr uint32_t SubBucketBits = 2;
+  static constexpr uint32_t SubBuckets = 1 << SubBucketBits;
+  static constexpr uint32_t NumBuckets = 64;
+
+  static uint32_t bucketIndex(uint64_t latency_ms);
+  static uint64_t bucketUpperBound(uint32_t index);
+
+private:
+  void updateDelay();
+  void decayLatencies();
+
+  // The delay is recomputed every DelayUpdateInterval recorded latencies.
+  static constexpr uint64_t DelayUpdateInterval = 16;
+  // Histogram counts and the budget are halved every DecayFactor * min_samples_ latencies and
+  // BudgetWindow requests respectively, so that both follow recent traffic.
+  static constexpr uint64_t DecayFactor = 10;
+  static constexpr uint64_t BudgetWindow = 1000;
+
+  const double percentile_;
+  const std::chrono::milliseconds min_delay_;
+  const double max_hedged_fraction_;
+  const uint64_t min_samples_;
+
+  std::array<std::atomic<uint64_t>, NumBuckets> buckets_{};
+  std::atomic<uint64_t> samples_{};
+  // Negative until min_samples_ latencies have been recorded.
+  std::atomic<int64_t> delay_ms_{-1};
+  std::atomic<uint64_t> requests_{};
+  std::atomic<uint64_t> hedges_{};
+};
+
+} // namespace Router
+} // namespace Envoy
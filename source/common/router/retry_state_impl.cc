@@ -379,6 +379,12 @@ RetryStatus RetryStateImpl::shouldHedgeRetryPerTryTimeout(DoRetryCallback callba
   return shouldRetry(RetryState::RetryDecision::RetryWithBackoff, callback);
 }
 
+RetryStatus RetryStateImpl::shouldHedgeProactively(DoRetryCallback callback) {
+  // The hedge delay already accounts for the time spent waiting on the original request, so the
+  // hedged request is sent without backoff.
+  return shouldRetry(RetryState::RetryDecision::RetryImmediately, callback);
+}
+
 RetryState::RetryDecision
 RetryStateImpl::wouldRetryFromHeaders(const Http::ResponseHeaderMap& response_headers,
                                       const Http::RequestHeaderMap& original_request,
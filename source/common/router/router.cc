@@ -420,7 +420,7 @@ void Filter::chargeUpstreamCode(uint64_t response_status_code,
     }
 
     if (dropped) {
-      cluster_->loadReportStats().upstream_rq_dropped_.inc();
+      cluster_->loadReportStats()->upstream_rq_dropped_.inc();
     }
     if (upstream_host && Http::CodeUtility::is5xx(response_status_code)) {
       upstream_host->stats().rq_error_.inc();
@@ -1136,6 +1136,7 @@ void Filter::cleanup() {
     response_timeout_->disableTimer();
     response_timeout_.reset();
   }
+  hedge_timer_.reset();
 }
 
 absl::optional<absl::string_view> Filter::getShadowCluster(const ShadowPolicy& policy,
@@ -1205,7 +1206,64 @@ void Filter::onRequestComplete() {
         upstream_request->setupPerTryTimeout();
       }
     }
+
+    maybeStartHedgeTimer();
+  }
+}
+
+void Filter::maybeStartHedgeTimer() {
+  ProactiveHedging* proactive_hedging = route_entry_->hedgePolicy().proactiveHedging();
+  if (proactive_hedging == nullptr || !retry_state_) {
+    return;
+  }
+
+  proactive_hedging->onRequest();
+  const absl::optional<std::chrono::milliseconds> hedge_delay = proactive_hedging->hedgeDelay();
+  if (!hedge_delay.has_value()) {
+    return;
+  }
+  hedge_timer_ = callbacks_->dispatcher().createTimer([this]() -> void { onHedgeTimeout(); });
+  hedge_timer_->enableTimer(hedge_delay.value());
+}
+
+void Filter::onHedgeTimeout() {
+  // Only a single request is hedged, and only while it is the only one in flight.
+  if (downstream_response_started_ || !retry_state_ || upstream_requests_.size() != 1 ||
+      pending_retries_ > 0) {
+    return;
+  }
+  UpstreamRequest& upstream_request = *upstream_requests_.front();
+  if (upstream_request.retried()) {
+    return;
+  }
+
+  if (!route_entry_->hedgePolicy().proactiveHedging()->tryHedge()) {
+    cluster_->trafficStats()->upstream_rq_hedge_budget_exceeded_.inc();
+    return;
+  }
+
+  const RetryStatus retry_status = retry_state_->shouldHedgeProactively(
+      [this, can_use_http3 = upstream_request.upstreamStreamOptions().can_use_http3_]() -> void {
+        doRetry(/*can_send_early_data*/ false, can_use_http3, TimeoutRetry::No);
+      });
+  if (retry_status == RetryStatus::Yes) {
+    runRetryOptionsPredicates(upstream_request);
+    pending_retries_++;
+    proactive_hedge_sent_ = true;
+    // As for hedging on per try timeout, the response of the original request is only used if it
+    // is not an error, since the hedged request may still succeed.
+    upstream_request.retried(true);
+    cluster_->trafficStats()->upstream_rq_hedge_sent_.inc();
+  }
+}
+
+bool Filter::hasUpstreamRequestTo(const Upstream::Host& host) const {
+  for (const auto& upstream_request : upstream_requests_) {
+    if (upstream_request->upstreamHost().get() == &host) {
+      return true;
+    }
   }
+  return false;
 }
 
 void Filter::onDestroy() {
@@ -1276,13 +1334,17 @@ void Filter::onResponseTimeout() {
 // Called when the per try timeout is hit but we didn't reset the request
 // (hedge_on_per_try_timeout enabled).
 void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
-  ASSERT(!upstream_request.retried());
   // Track this as a timeout for outlier detection purposes even though we didn't
   // cancel the request yet and might get a 2xx later.
   updateOutlierDetection(Upstream::Outlier::Result::LocalOriginTimeout, upstream_request,
                          absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
   upstream_request.outlierDetectionTimeoutRecorded(true);
 
+  // The request may already have been hedged proactively, see onHedgeTimeout().
+  if (upstream_request.retried()) {
+    return;
+  }
+
   if (!downstream_response_started_ && retry_state_) {
     RetryStatus retry_status = retry_state_->shouldHedgeRetryPerTryTimeout(
         [this, can_use_http3 = upstream_request.upstreamStreamOptions().can_use_http3_]() -> void {
@@ -1301,7 +1363,7 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
       // back.
       upstream_request.retried(true);
 
-      // TODO: cluster stat for hedge attempted.
+      cluster_->trafficStats()->upstream_rq_hedge_sent_.inc();
     } else if (retry_status == RetryStatus::NoOverflow) {
       callbacks_->streamInfo().setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamOverflow);
     } else if (retry_status == RetryStatus::NoRetryLimitExceeded) {
@@ -1343,10 +1405,16 @@ void Filter::onPerTryTimeoutCommon(UpstreamRequest& upstream_request, Stats::Cou
     return;
   }
 
+  const bool hedged = upstream_request.retried();
   chargeUpstreamAbort(timeout_response_code_, false, upstream_request);
 
   // Remove this upstream request from the list now that we're done with it.
   upstream_request.removeFromList(upstream_requests_);
+
+  // A proactively hedged request is still in flight and may succeed.
+  if (hedged && (numRequestsAwaitingHeaders() > 0 || pending_retries_ > 0)) {
+    return;
+  }
   onUpstreamTimeoutAbort(StreamInfo::CoreResponseFlag::UpstreamRequestTimeout,
                          response_code_details);
 }
@@ -1452,8 +1520,11 @@ void Filter::onUpstreamAbort(Http::Code code, StreamInfo::CoreResponseFlag respo
 bool Filter::maybeRetryReset(Http::StreamResetReason reset_reason,
                              UpstreamRequest& upstream_request, TimeoutRetry is_timeout_retry) {
   // We don't retry if we already started the response, don't have a retry policy defined,
-  // or if we've already retried this upstream request (currently only possible if a per
-  // try timeout occurred and hedge_on_per_try_timeout is enabled).
+  // or if we've already retried this upstream request. An upstream request is marked as retried
+  // once a hedged request was sent for it, either because a per try timeout occurred and
+  // hedge_on_per_try_timeout is enabled, or because it was proactively hedged after exceeding the
+  // route's latency percentile. The hedged request is still in flight and takes the place of a
+  // retry.
   if (downstream_response_started_ || !retry_state_ || upstream_request.retried()) {
     return false;
   }
@@ -1671,7 +1742,7 @@ void Filter::resetOtherUpstreams(UpstreamRequest& upstream_request) {
     if (upstream_request_tmp.get() != &upstream_request) {
       upstream_request_tmp->resetStream();
       // TODO: per-host stat for hedge abandoned.
-      // TODO: cluster stat for hedge abandoned.
+      cluster_->trafficStats()->upstream_rq_hedge_cancelled_.inc();
     } else {
       final_upstream_request = std::move(upstream_request_tmp);
     }
@@ -1811,6 +1882,7 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
   if (retry_state_) {
     retry_state_.reset();
   }
+  hedge_timer_.reset();
 
   // Only send upstream service time if we received the complete request and this is not a
   // premature response.
@@ -1822,6 +1894,11 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
     if (!config_->suppress_envoy_headers_) {
       headers->setEnvoyUpstreamServiceTime(ms.count());
     }
+
+    ProactiveHedging* proactive_hedging = route_entry_->hedgePolicy().proactiveHedging();
+    if (proactive_hedging != nullptr && !Http::CodeUtility::is5xx(response_code)) {
+      proactive_hedging->recordLatency(ms);
+    }
   }
 
   upstream_request.upstreamCanary(
@@ -1843,6 +1920,10 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
   callbacks_->streamInfo().setResponseCode(response_code);
   downstream_response_started_ = true;
   final_upstream_request_ = &upstream_request;
+  // Requests are added to the front of the list, so the oldest one in flight is at the back.
+  if (upstream_requests_.size() > 1 && upstream_requests_.back().get() != &upstream_request) {
+    cluster_->trafficStats()->upstream_rq_hedge_won_.inc();
+  }
   // Make sure that for request hedging, we end up with the correct final upstream info.
   callbacks_->streamInfo().setUpstreamInfo(final_upstream_request_->streamInfo().upstreamInfo());
   resetOtherUpstreams(upstream_request);
@@ -2304,7 +2385,7 @@ bool Filter::checkDropOverload(Upstream::ThreadLocalCluster& cluster) {
           },
           absl::nullopt, StreamInfo::ResponseCodeDetails::get().UnconditionalDropOverload);
 
-      cluster.info()->loadReportStats().upstream_rq_drop_overload_.inc();
+      cluster.info()->loadReportStats()->upstream_rq_drop_overload_.inc();
       return true;
     }
 
@@ -2323,7 +2404,7 @@ bool Filter::checkDropOverload(Upstream::ThreadLocalCluster& cluster) {
           },
           absl::nullopt, StreamInfo::ResponseCodeDetails::get().DropOverload);
 
-      cluster.info()->loadReportStats().upstream_rq_drop_overload_.inc();
+      cluster.info()->loadReportStats()->upstream_rq_drop_overload_.inc();
       return true;
     }
   }
@@ -306,7 +306,8 @@ public:
         request_buffer_overflowed_(false),
         allow_multiplexed_upstream_half_close_(Runtime::runtimeFeatureEnabled(
             "envoy.reloadable_features.allow_multiplexed_upstream_half_close")),
-        upstream_request_started_(false), orca_load_report_received_(false) {}
+        upstream_request_started_(false), orca_load_report_received_(false),
+        proactive_hedge_sent_(false) {}
 
   ~Filter() override;
 
@@ -434,6 +435,9 @@ public:
     }
 
     ASSERT(retry_state_);
+    if (proactive_hedge_sent_ && hasUpstreamRequestTo(host)) {
+      return true;
+    }
     return retry_state_->shouldSelectAnotherHost(host);
   }
 
@@ -587,6 +591,9 @@ private:
   // Handle an upstream request aborted due to a local timeout.
   void onSoftPerTryTimeout();
   void onSoftPerTryTimeout(UpstreamRequest& upstream_request);
+  void onHedgeTimeout();
+  void maybeStartHedgeTimer();
+  bool hasUpstreamRequestTo(const Upstream::Host& host) const;
   void onUpstreamTimeoutAbort(StreamInfo::CoreResponseFlag response_flag,
                               absl::string_view details);
   // Handle an "aborted" upstream request, meaning we didn't see response
@@ -638,6 +645,7 @@ private:
   std::function<void(Upstream::HostConstSharedPtr&& host, std::string details)> on_host_selected_;
   std::unique_ptr<Upstream::AsyncHostSelectionHandle> host_selection_cancelable_;
   Event::TimerPtr response_timeout_;
+  Event::TimerPtr hedge_timer_;
   TimeoutData timeout_;
   std::list<UpstreamRequestPtr> upstream_requests_;
   FilterStats stats_;
@@ -684,6 +692,9 @@ private:
   // Indicate that ORCA report is received to process it only once in either response headers or
   // trailers.
   bool orca_load_report_received_ : 1;
+  // Indicate that a proactive hedged request has been sent, which then avoids the hosts of the
+  // requests already in flight.
+  bool proactive_hedge_sent_ : 1;
 };
 
 class ProdFilter : public Filter {
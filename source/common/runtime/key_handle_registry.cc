@@ -0,0 +1,75 @@
+#include "source/common/runtime/key_handle_registry.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Runtime {
+
+KeyHandleRegistry& KeyHandleRegistry::get() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(KeyHandleRegistry);
+}
+
+KeyHandleConstSharedPtr KeyHandleRegistry::handle(absl::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  const auto it = handles_by_key_.find(key);
+  if (it != handles_by_key_.end()) {
+    if (KeyHandleConstSharedPtr handle = it->second.lock()) {
+      return handle;
+    }
+  }
+  uint32_t index;
+  if (free_indexes_.empty()) {
+    index = static_cast<uint32_t>(handles_.size());
+    handles_.push_back(nullptr);
+  } else {
+    index = free_indexes_.back();
+    free_indexes_.pop_back();
+  }
+  // KeyHandle can only be constructed by the registry, so it can't go through make_shared.
+  KeyHandleConstSharedPtr handle(new KeyHandle(key, index, next_generation_++),
+                                 [this](const KeyHandle* ptr) { release(ptr); });
+  handles_[index] = handle.get();
+  handles_by_key_.insert_or_assign(key, handle);
+  return handle;
+}
+
+void KeyHandleRegistry::release(const KeyHandle* handle) {
+  {
+    absl::MutexLock lock(&mutex_);
+    // The key may already have a new handle if handle() raced with the release of the last
+    // reference to this one, in which case the new handle must be kept.
+    const auto it = handles_by_key_.find(handle->key());
+    if (it != handles_by_key_.end() && it->second.expired()) {
+      handles_by_key_.erase(it);
+    }
+    ASSERT(handles_[handle->index()] == handle);
+    handles_[handle->index()] = nullptr;
+    free_indexes_.push_back(handle->index());
+  }
+  delete handle;
+}
+
+std::vector<KeyHandleRegistry::ResolvedEntry>
+KeyHandleRegistry::resolve(const Snapshot::EntryMap& values) const {
+  absl::MutexLock lock(&mutex_);
+  std::vector<ResolvedEntry> entries;
+  entries.reserve(handles_.size());
+  for (const KeyHandle* handle : handles_) {
+    if (handle == nullptr) {
+      entries.push_back({0, nullptr});
+      continue;
+    }
+    const auto it = handle->key().empty() ? values.end() : values.find(handle->key());
+    entries.push_back({handle->generation(), it == values.end() ? nullptr : &it->second});
+  }
+  return entries;
+}
+
+size_t KeyHandleRegistry::size() const {
+  absl::MutexLock lock(&mutex_);
+  return handles_.size() - free_indexes_.size();
+}
+
+} // namespace Runtime
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/runtime/runtime.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Runtime {
+
+/**
+ * Process-wide registry of runtime key handles. Each key in use has an index, and every snapshot
+ * resolves all the keys in use when it is created into a flat array of entries indexed by handle,
+ * so that handle lookups on the data path are a single indexed load. Keys are unregistered when
+ * the last reference to their handle is gone, and their index is reused by the next key
+ * registered, so the registry and the arrays of the snapshots are bounded by the number of keys
+ * in use rather than by every key ever configured.
+ */
+class KeyHandleRegistry {
+public:
+  /**
+   * The entry of a key in the values of a snapshot, along with the generation of the handle it
+   * was resolved for, so that a handle that reused the index of a released handle after the
+   * snapshot was created does not get the entry of the released key.
+   */
+  struct ResolvedEntry {
+    uint64_t generation_;
+    const Snapshot::Entry* entry_;
+  };
+
+  /**
+   * @return KeyHandleRegistry& the registry of the process.
+   */
+  static KeyHandleRegistry& get();
+
+  /**
+   * Returns the handle of a runtime key, registering the key if it has no handle in use. This
+   * takes a lock, so handles should be obtained once, e.g. at configuration time, and kept.
+   * @param key supplies the runtime key.
+   * @return KeyHandleConstSharedPtr the handle of the key, shared with the other users of the key.
+   */
+  KeyHandleConstSharedPtr handle(absl::string_view key);
+
+  /**
+   * Resolves the registered keys against the values of a snapshot.
+   * @param values supplies the values of the snapshot.
+   * @return the entry of each registered key in values, indexed by handle, with a nullptr entry
+   *         for the keys without an entry and a zero generation for the unused indexes. The
+   *         pointers are valid as long as values is not modified.
+   */
+  std::vector<ResolvedEntry> resolve(const Snapshot::EntryMap& values) const;
+
+  /**
+   * @return size_t the number of keys with a handle in use.
+   */
+  size_t size() const;
+
+private:
+  void release(const KeyHandle* handle);
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<const KeyHandle>>
+      handles_by_key_ ABSL_GUARDED_BY(mutex_);
+  // The handle using each index, or nullptr for the released indexes, which are in free_indexes_.
+  std::vector<const KeyHandle*> handles_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> free_indexes_ ABSL_GUARDED_BY(mutex_);
+  uint64_t next_generation_ ABSL_GUARDED_BY(mutex_){1};
+};
+
+} // namespace Runtime
+} // namespace Envoy
@@ -187,6 +187,15 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_abort_when_accessing_dead_decoder)
 // TODO(pradeepcrao): Create a config option to enable this instead after
 // testing.
 FALSE_RUNTIME_GUARD(envoy_restart_features_use_cached_grpc_client_for_xds);
+// Creates the dispatcher timers from a timing wheel rather than from libevent. Evaluate and flip to
+// true after testing with large numbers of connections.
+FALSE_RUNTIME_GUARD(envoy_restart_features_dispatcher_timer_wheel);
+// Reuses the decoded resources of state-of-the-world gRPC xDS responses for identical resources of
+// the next response, at the cost of keeping them in memory. Evaluate and make this a config knob.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_xds_reuse_unchanged_resources);
+// Reuses the hosts of unchanged endpoints of EDS updates, and applies the added, removed and
+// changed hosts of a priority as a delta to its host set. Evaluate and flip to true.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_eds_incremental_updates);
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
 ABSL_FLAG(uint64_t, re2_max_program_size_warn_level,            // NOLINT
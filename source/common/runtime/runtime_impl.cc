@@ -20,6 +20,7 @@
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/key_handle_registry.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/node_hash_map.h"
@@ -134,11 +135,11 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
 
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  auto entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end()) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr) {
     return absl::nullopt;
   } else {
-    return entry->second.raw_string_value_;
+    return entry->raw_string_value_;
   }
 }
 
@@ -150,22 +151,32 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
+  return fractionalPercentEnabled(key, findEntry(key), default_value, random_value);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key,
+                                  const envoy::type::v3::FractionalPercent& default_value) const {
+  return fractionalPercentEnabled(key.key(), findEntry(key), default_value, generator_.random());
+}
+
+bool SnapshotImpl::fractionalPercentEnabled(absl::string_view key, const Entry* entry,
+                                            const envoy::type::v3::FractionalPercent& default_value,
+                                            uint64_t random_value) const {
   envoy::type::v3::FractionalPercent percent;
-  if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
-  } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
+  if (entry != nullptr && entry->fractional_percent_value_.has_value()) {
+    percent = entry->fractional_percent_value_.value();
+  } else if (entry != nullptr && entry->uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
     // value into a uint32_t percent numerator later is safe
-    if (entry->second.uint_value_.value() > 100) {
+    if (entry->uint_value_.value() > 100) {
       return true;
     }
 
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
+    percent.set_numerator(entry->uint_value_.value());
     percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
   } else {
     percent = default_value;
@@ -189,31 +200,77 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 
 uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
   ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->uint_value_) {
     return default_value;
   } else {
-    return entry->second.uint_value_.value();
+    return entry->uint_value_.value();
+  }
+}
+
+uint64_t SnapshotImpl::getInteger(const KeyHandle& key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key.key()));
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->uint_value_) {
+    return default_value;
+  } else {
+    return entry->uint_value_.value();
   }
 }
 
 double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.double_value_) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->double_value_) {
+    return default_value;
+  } else {
+    return entry->double_value_.value();
+  }
+}
+
+double SnapshotImpl::getDouble(const KeyHandle& key, double default_value) const {
+  ASSERT(!isRuntimeFeature(key.key())); // Make sure runtime guarding is only used for getBoolean
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->double_value_) {
     return default_value;
   } else {
-    return entry->second.double_value_.value();
+    return entry->double_value_.value();
   }
 }
 
 bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
+    return default_value;
+  } else {
+    return entry->bool_value_.value();
+  }
+}
+
+bool SnapshotImpl::getBoolean(const KeyHandle& key, bool default_value) const {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
     return default_value;
   } else {
-    return entry->second.bool_value_.value();
+    return entry->bool_value_.value();
+  }
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(absl::string_view key) const {
+  if (key.empty()) {
+    return nullptr;
+  }
+  const auto entry = values_.find(key);
+  return entry == values_.end() ? nullptr : &entry->second;
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(const KeyHandle& key) const {
+  if (key.index() < entries_by_handle_.size() &&
+      entries_by_handle_[key.index()].generation_ == key.generation()) {
+    return entries_by_handle_[key.index()].entry_;
   }
+  // The handle was created after this snapshot, fall back to looking up its key.
+  return findEntry(key.key());
 }
 
 const std::vector<Snapshot::OverrideLayerConstPtr>& SnapshotImpl::getLayers() const {
@@ -231,6 +288,7 @@ SnapshotImpl::SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& sta
       values_.emplace(kv.first, kv.second);
     }
   }
+  entries_by_handle_ = KeyHandleRegistry::get().resolve(values_);
   stats.num_keys_.set(values_.size());
 }
 
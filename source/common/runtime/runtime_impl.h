@@ -27,6 +27,7 @@
 #include "source/common/config/subscription_base.h"
 #include "source/common/init/manager_impl.h"
 #include "source/common/init/target_impl.h"
+#include "source/common/runtime/key_handle_registry.h"
 #include "source/common/singleton/threadsafe_singleton.h"
 
 #include "absl/container/node_hash_map.h"
@@ -84,6 +85,11 @@ public:
   uint64_t getInteger(absl::string_view key, uint64_t default_value) const override;
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override;
+  uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const override;
+  double getDouble(const KeyHandle& key, double default_value) const override;
+  bool getBoolean(const KeyHandle& key, bool default_value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
 
   const EntryMap& values() const;
@@ -93,8 +99,16 @@ public:
                        const Protobuf::Value& value, absl::string_view raw_string = "");
 
 private:
+  const Entry* findEntry(absl::string_view key) const;
+  const Entry* findEntry(const KeyHandle& key) const;
+  bool fractionalPercentEnabled(absl::string_view key, const Entry* entry,
+                                const envoy::type::v3::FractionalPercent& default_value,
+                                uint64_t random_value) const;
+
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
+  // The entries of the keys that had a handle when the snapshot was created, indexed by handle.
+  std::vector<KeyHandleRegistry::ResolvedEntry> entries_by_handle_;
   Random::RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
@@ -6,6 +6,7 @@
 
 #include "source/common/common/cleanup.h"
 #include "source/common/common/thread.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 
@@ -99,6 +100,62 @@ private:
   StatsStructType stats_;
 };
 
+// A StatsStructType kept in an isolated store of its own, e.g. so that its stats are not flushed
+// to sinks. The store is allocated together with the stats.
+template <typename StatsStructType> class IsolatedStats {
+public:
+  IsolatedStats(SymbolTable& symbol_table,
+                const typename StatsStructType::StatNameType& stat_names)
+      : store_(symbol_table), stats_(stat_names, *store_.rootScope()) {}
+
+  StatsStructType& stats() { return stats_; }
+
+private:
+  IsolatedStoreImpl store_;
+  StatsStructType stats_;
+};
+
+/**
+ * Lazy-initialization wrapper for a StatsStructType kept in an isolated store. Unlike
+ * DeferredStats, the values of isolated stats are not shared with a previous generation of the
+ * owner, so the store itself is only allocated once the stats are first referenced.
+ */
+template <typename StatsStructType>
+class DeferredIsolatedStats : public DeferredCreationCompatibleInterface<StatsStructType> {
+public:
+  // Caller should make sure symbol_table and stat_names outlive this object.
+  DeferredIsolatedStats(SymbolTable& symbol_table,
+                        const typename StatsStructType::StatNameType& stat_names)
+      : symbol_table_(symbol_table), stat_names_(stat_names) {}
+
+  StatsStructType& getOrCreate() override {
+    return internal_stats_
+        .get([this]() { return new IsolatedStats<StatsStructType>(symbol_table_, stat_names_); })
+        ->stats();
+  }
+  bool isPresent() const override { return !internal_stats_.isNull(); }
+
+private:
+  SymbolTable& symbol_table_;
+  const typename StatsStructType::StatNameType& stat_names_;
+  Thread::AtomicPtr<IsolatedStats<StatsStructType>, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      internal_stats_;
+};
+
+// Non-deferred wrapper over an isolated StatsStructType.
+template <typename StatsStructType>
+class DirectIsolatedStats : public DeferredCreationCompatibleInterface<StatsStructType> {
+public:
+  DirectIsolatedStats(SymbolTable& symbol_table,
+                      const typename StatsStructType::StatNameType& stat_names)
+      : stats_(symbol_table, stat_names) {}
+  StatsStructType& getOrCreate() override { return stats_.stats(); }
+  bool isPresent() const override { return true; }
+
+private:
+  IsolatedStats<StatsStructType> stats_;
+};
+
 // Template that lazily initializes a StatsStruct.
 // The bootstrap config :ref:`enable_deferred_creation_stats
 // <envoy_v3_api_field_config.bootstrap.v3.Bootstrap.deferred_stat_options>` decides if
@@ -117,5 +174,20 @@ createDeferredCompatibleStats(Stats::ScopeSharedPtr scope,
   }
 }
 
+// Same as createDeferredCompatibleStats, for a StatsStruct kept in an isolated store.
+template <typename StatsStructType>
+DeferredCreationCompatibleStats<StatsStructType>
+createDeferredCompatibleIsolatedStats(SymbolTable& symbol_table,
+                                      const typename StatsStructType::StatNameType& stat_names,
+                                      bool defer_creation) {
+  if (defer_creation) {
+    return DeferredCreationCompatibleStats<StatsStructType>(
+        std::make_unique<DeferredIsolatedStats<StatsStructType>>(symbol_table, stat_names));
+  } else {
+    return DeferredCreationCompatibleStats<StatsStructType>(
+        std::make_unique<DirectIsolatedStats<StatsStructType>>(symbol_table, stat_names));
+  }
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -286,11 +287,151 @@ void SymbolTable::Encoding::appendToMemBlock(StatName stat_name,
   }
 }
 
+/**
+ * Cache of the names recently encoded by one thread. When it is full, the least
+ * recently encoded name is evicted. Only the owning thread looks up and updates
+ * the entries. The mutex is only taken to drain the cache, which happens either
+ * when the thread exits or when the table is destroyed.
+ */
+class SymbolTable::EncodeCache {
+public:
+  // References acquired or returned at once when the reserve of an entry is
+  // exhausted or full.
+  static constexpr int64_t ReferenceBatchSize = 64;
+
+  explicit EncodeCache(SymbolTable& table) : table_(&table) {}
+
+  StoragePtr encode(absl::string_view name, uint32_t capacity) {
+    auto iter = entries_.find(name);
+    if (iter == entries_.end()) {
+      while (entries_.size() >= capacity) {
+        evict(std::prev(lru_.end()));
+      }
+      StoragePtr storage = table_->encodeUncached(name);
+      Entry& entry = lru_.emplace_front();
+      entry.name_ = std::string(name);
+      entry.storage_ = copy(StatName(storage.get()));
+      // The reference of the entry itself.
+      table_->incRefCount(entry.statName());
+      by_stat_name_[entry.statName()] = &entry;
+      entries_.emplace(entry.name_, lru_.begin());
+      return storage;
+    }
+
+    // Move the entry to the front, so that the least recently encoded name is
+    // evicted first.
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    Entry& entry = *iter->second;
+    if (entry.reserved_ == 0) {
+      table_->adjustRefCount(entry.statName(), ReferenceBatchSize);
+      entry.reserved_ = ReferenceBatchSize;
+    }
+    --entry.reserved_;
+    return copy(entry.statName());
+  }
+
+  // Takes back a reference on a cached name, returning false if the name is
+  // not cached.
+  bool free(StatName stat_name) {
+    auto iter = by_stat_name_.find(stat_name);
+    if (iter == by_stat_name_.end()) {
+      return false;
+    }
+    Entry& entry = *iter->second;
+    if (++entry.reserved_ == 2 * ReferenceBatchSize) {
+      table_->adjustRefCount(entry.statName(), -ReferenceBatchSize);
+      entry.reserved_ = ReferenceBatchSize;
+    }
+    return true;
+  }
+
+  void clear() {
+    while (!lru_.empty()) {
+      evict(lru_.begin());
+    }
+  }
+
+  // Releases all references held by the cache, and detaches it from the table.
+  // When the owning thread exits, the cache is also removed from the table.
+  void release(bool thread_exit) {
+    Thread::LockGuard lock(mutex_);
+    if (table_ == nullptr) {
+      return;
+    }
+    clear();
+    if (thread_exit) {
+      Thread::LockGuard table_lock(table_->lock_);
+      std::erase_if(table_->encode_caches_,
+                    [this](const EncodeCacheSharedPtr& cache) { return cache.get() == this; });
+    }
+    table_ = nullptr;
+  }
+
+  bool released() {
+    Thread::LockGuard lock(mutex_);
+    return table_ == nullptr;
+  }
+
+private:
+  struct Entry {
+    StatName statName() const { return StatName(storage_.get()); }
+
+    std::string name_;
+    StoragePtr storage_;
+    // References held on the symbols of storage_ and not handed out. The entry
+    // keeps one more reference, so that the symbols are not reused while cached.
+    int64_t reserved_{};
+  };
+  // Ordered from the most to the least recently encoded name.
+  using EntryList = std::list<Entry>;
+
+  static StoragePtr copy(StatName stat_name) {
+    MemBlockBuilder<uint8_t> mem_block(stat_name.size());
+    stat_name.copyToMemBlock(mem_block);
+    return mem_block.release();
+  }
+
+  void evict(EntryList::iterator iter) {
+    by_stat_name_.erase(iter->statName());
+    table_->adjustRefCount(iter->statName(), -(iter->reserved_ + 1));
+    entries_.erase(iter->name_);
+    lru_.erase(iter);
+  }
+
+  Thread::MutexBasicLockable mutex_;
+  SymbolTable* table_;
+  EntryList lru_;
+  // Indexes the entries by name. The keys reference the names held by the
+  // entries, which do not move within the list.
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> entries_;
+  // Indexes the entries by their encoding, to take back the references freed on
+  // this thread.
+  absl::flat_hash_map<StatName, Entry*> by_stat_name_;
+};
+
+namespace {
+
+std::atomic<uint64_t> next_symbol_table_id{1};
+
+} // namespace
+
 SymbolTable::SymbolTable()
     // Have to be explicitly initialized, if we want to use the ABSL_GUARDED_BY macro.
-    : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
+    : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol),
+      id_(next_symbol_table_id.fetch_add(1, std::memory_order_relaxed)) {}
 
 SymbolTable::~SymbolTable() {
+  // Return the references held by the encode caches. The threads owning them
+  // must not use the table anymore, but they might exit concurrently.
+  std::vector<EncodeCacheSharedPtr> encode_caches;
+  {
+    Thread::LockGuard lock(lock_);
+    encode_caches.swap(encode_caches_);
+  }
+  for (const EncodeCacheSharedPtr& encode_cache : encode_caches) {
+    encode_cache->release(false);
+  }
+
   // To avoid leaks into the symbol table, we expect all StatNames to be freed.
   // Note: this could potentially be short-circuited if we decide a fast exit
   // is needed in production. But it would be good to ensure clean up during
@@ -340,7 +481,7 @@ std::string SymbolTable::toString(const StatName& stat_name) const {
   return absl::StrJoin(decodeStrings(stat_name), ".");
 }
 
-void SymbolTable::incRefCount(const StatName& stat_name) {
+void SymbolTable::adjustRefCount(const StatName& stat_name, int64_t count) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
@@ -358,11 +499,24 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
 
-    ++encode_search->second.ref_count_;
+    ASSERT(count >= 0 || encode_search->second.ref_count_ >= -count);
+    encode_search->second.ref_count_ += count;
+    if (encode_search->second.ref_count_ == 0) {
+      decode_map_.erase(decode_search);
+      encode_map_.erase(encode_search);
+      pool_.push(symbol);
+    }
   }
 }
 
 void SymbolTable::free(const StatName& stat_name) {
+  if (encode_cache_capacity_.load(std::memory_order_relaxed) > 0) {
+    EncodeCache* encode_cache = threadEncodeCache();
+    if (encode_cache != nullptr && encode_cache->free(stat_name)) {
+      return;
+    }
+  }
+
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
@@ -446,6 +600,7 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
   Thread::LockGuard lock(lock_);
   recent_lookups_.setCapacity(capacity);
+  recent_lookups_enabled_.store(capacity > 0, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
@@ -563,6 +718,17 @@ void SymbolTable::debugPrint() const {
 
 SymbolTable::StoragePtr SymbolTable::encode(absl::string_view name) {
   name = StringUtil::removeTrailingCharacters(name, '.');
+  const uint32_t encode_cache_capacity = encode_cache_capacity_.load(std::memory_order_relaxed);
+  if (encode_cache_capacity > 0 && !recent_lookups_enabled_.load(std::memory_order_relaxed)) {
+    EncodeCache* encode_cache = threadEncodeCache();
+    if (encode_cache != nullptr) {
+      return encode_cache->encode(name, encode_cache_capacity);
+    }
+  }
+  return encodeUncached(name);
+}
+
+SymbolTable::StoragePtr SymbolTable::encodeUncached(absl::string_view name) {
   Encoding encoding;
   addTokensToEncoding(name, encoding);
   MemBlockBuilder<uint8_t> mem_block(Encoding::totalSizeBytes(encoding.bytesRequired()));
@@ -570,6 +736,48 @@ SymbolTable::StoragePtr SymbolTable::encode(absl::string_view name) {
   return mem_block.release();
 }
 
+SymbolTable::EncodeCache* SymbolTable::threadEncodeCache() {
+  // Set once the caches of the thread are destroyed, after which stat names may
+  // still be encoded or freed by other thread local destructors.
+  static thread_local bool exited = false;
+  // The encode caches of the calling thread, keyed by the id of their table.
+  struct ThreadEncodeCaches {
+    ~ThreadEncodeCaches() {
+      exited = true;
+      for (auto& id_and_cache : caches_) {
+        id_and_cache.second->release(true);
+      }
+    }
+
+    absl::flat_hash_map<uint64_t, EncodeCacheSharedPtr> caches_;
+  };
+  if (exited) {
+    return nullptr;
+  }
+  static thread_local ThreadEncodeCaches thread_caches;
+  auto iter = thread_caches.caches_.find(id_);
+  if (iter != thread_caches.caches_.end()) {
+    return iter->second.get();
+  }
+
+  // Forget the caches of destroyed tables before adding a new one.
+  absl::erase_if(thread_caches.caches_, [](const auto& entry) { return entry.second->released(); });
+  auto cache = std::make_shared<EncodeCache>(*this);
+  {
+    Thread::LockGuard lock(lock_);
+    encode_caches_.push_back(cache);
+  }
+  return thread_caches.caches_.emplace(id_, std::move(cache)).first->second.get();
+}
+
+void SymbolTable::setEncodeCacheCapacity(uint32_t capacity) {
+  encode_cache_capacity_.store(capacity, std::memory_order_relaxed);
+  EncodeCache* encode_cache = capacity == 0 ? threadEncodeCache() : nullptr;
+  if (encode_cache != nullptr) {
+    encode_cache->clear();
+  }
+}
+
 StatNameStorage::StatNameStorage(absl::string_view name, SymbolTable& table)
     : StatNameStorageBase(table.encode(name)) {}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -311,6 +312,19 @@ public:
    */
   uint64_t recentLookupCapacity() const;
 
+  /**
+   * Sets the number of recently encoded names cached by each thread. Encoding
+   * a cached name takes no lock: each cached name holds a reserve of references
+   * on its symbols, which is refilled in batches. As a consequence, the symbols
+   * of cached names stay in the table until they are evicted from the cache, or
+   * until the thread exits. Setting the capacity to 0 (the default) disables
+   * the cache and drains the cache of the calling thread. The caches are
+   * bypassed while recent lookups are tracked.
+   *
+   * @param capacity the maximum number of names cached by each thread.
+   */
+  void setEncodeCacheCapacity(uint32_t capacity);
+
   /**
    * Identifies the dynamic components of a stat_name into an array of integer
    * pairs, indicating the begin/end of spans of tokens in the stat-name that
@@ -393,7 +407,33 @@ private:
    *
    * @param stat_name the stat name.
    */
-  void incRefCount(const StatName& stat_name);
+  void incRefCount(const StatName& stat_name) { adjustRefCount(stat_name, 1); }
+
+  /**
+   * Adds or releases `count` references on each of the symbols of stat_name,
+   * taking the lock once.
+   *
+   * @param stat_name the stat name.
+   * @param count the number of references to add, or to release if negative.
+   */
+  void adjustRefCount(const StatName& stat_name, int64_t count);
+
+  /**
+   * Per-thread cache of encoded names, see setEncodeCacheCapacity().
+   */
+  class EncodeCache;
+  using EncodeCacheSharedPtr = std::shared_ptr<EncodeCache>;
+
+  /**
+   * Encodes name into the table, bypassing the encode caches.
+   */
+  StoragePtr encodeUncached(absl::string_view name);
+
+  /**
+   * @return the encode cache of the calling thread for this table, creating it
+   *         if needed, or nullptr if the thread is exiting.
+   */
+  EncodeCache* threadEncodeCache();
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
@@ -475,6 +515,14 @@ private:
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
   RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+
+  // Identifies the table in the per-thread encode caches. Never reused, so that
+  // a cache of a destroyed table is never found again.
+  const uint64_t id_;
+  std::atomic<uint32_t> encode_cache_capacity_{0};
+  std::atomic<bool> recent_lookups_enabled_{false};
+  // The encode caches of all threads, drained when the table is destroyed.
+  std::vector<EncodeCacheSharedPtr> encode_caches_ ABSL_GUARDED_BY(lock_);
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -1,5 +1,6 @@
 #include "source/common/stats/tag_extractor_impl.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -33,6 +34,107 @@ const std::vector<absl::string_view>& TagExtractionContext::tokens() {
   return tokens_;
 }
 
+const std::vector<bool>&
+TagExtractionContext::tokenSetMatches(const TagExtractorTokenSet& token_set) {
+  if (token_set_ == nullptr) {
+    token_set_ = &token_set;
+    token_set.match(tokens(), token_set_matches_);
+  }
+  ASSERT(token_set_ == &token_set);
+  return token_set_matches_;
+}
+
+absl::optional<uint32_t> TagExtractorTokenSet::addPattern(absl::string_view tokens) {
+  const std::vector<absl::string_view> pattern = absl::StrSplit(tokens, '.');
+  for (const absl::string_view token : pattern) {
+    if (token == "$") {
+      break;
+    }
+    if (token == "**") {
+      return absl::nullopt;
+    }
+  }
+
+  uint32_t node = 0;
+  for (const absl::string_view token : pattern) {
+    uint32_t& child = childIndex(nodes_[node], token);
+    if (child == 0) {
+      // Assign the index before growing nodes_, which invalidates the reference.
+      child = nodes_.size();
+      node = child;
+      nodes_.emplace_back();
+      nodes_.back().loop_ = token == "**";
+    } else {
+      node = child;
+    }
+  }
+  nodes_[node].patterns_.push_back(num_patterns_);
+  return num_patterns_++;
+}
+
+uint32_t& TagExtractorTokenSet::childIndex(Node& node, absl::string_view token) {
+  if (token == "**") {
+    return node.any_tokens_;
+  }
+  if (token == "*" || token == "$") {
+    return node.any_token_;
+  }
+  return node.children_[token];
+}
+
+void TagExtractorTokenSet::match(const std::vector<absl::string_view>& tokens,
+                                 std::vector<bool>& matches) const {
+  matches.assign(num_patterns_, false);
+
+  // A state is a node index shifted left by one, with the low bit set once a "**" node has
+  // consumed a token: as in TagExtractorTokensImpl::searchTags, a trailing "**" must match at
+  // least one token while a "**" followed by more tokens may match none.
+  std::vector<uint32_t> states, next_states;
+  addState(0, false, states);
+  for (const absl::string_view token : tokens) {
+    next_states.clear();
+    for (const uint32_t state : states) {
+      const Node& node = nodes_[state >> 1];
+      if (node.loop_) {
+        addState(state >> 1, true, next_states);
+      }
+      if (node.any_token_ != 0) {
+        addState(node.any_token_, false, next_states);
+      }
+      const auto iter = node.children_.find(token);
+      if (iter != node.children_.end()) {
+        addState(iter->second, false, next_states);
+      }
+    }
+    if (next_states.empty()) {
+      return;
+    }
+    states.swap(next_states);
+  }
+
+  for (const uint32_t state : states) {
+    const Node& node = nodes_[state >> 1];
+    if (!node.loop_ || (state & 1) != 0) {
+      for (const uint32_t pattern_id : node.patterns_) {
+        matches[pattern_id] = true;
+      }
+    }
+  }
+}
+
+void TagExtractorTokenSet::addState(uint32_t node, bool consumed,
+                                    std::vector<uint32_t>& states) const {
+  const uint32_t state = (node << 1) | (consumed ? 1 : 0);
+  if (std::find(states.begin(), states.end(), state) != states.end()) {
+    return;
+  }
+  states.push_back(state);
+  // A "**" may match no token, in which case the node following it is active as well.
+  if (nodes_[node].any_tokens_ != 0) {
+    addState(nodes_[node].any_tokens_, false, states);
+  }
+}
+
 namespace {
 
 bool regexStartsWithDot(absl::string_view regex) {
@@ -202,6 +304,16 @@ TagExtractorTokensImpl::TagExtractorTokensImpl(absl::string_view name, absl::str
   }
 }
 
+TagExtractorTokensImpl::TagExtractorTokensImpl(absl::string_view name, absl::string_view tokens,
+                                               TagExtractorTokenSet& token_set)
+    : TagExtractorTokensImpl(name, tokens) {
+  const absl::optional<uint32_t> pattern_id = token_set.addPattern(tokens);
+  if (pattern_id.has_value()) {
+    token_set_ = &token_set;
+    pattern_id_ = pattern_id.value();
+  }
+}
+
 uint32_t TagExtractorTokensImpl::findMatchIndex(const std::vector<std::string>& tokens) {
   for (uint32_t i = 0; i < tokens.size(); ++i) {
     if (tokens[i] == "$") {
@@ -217,7 +329,19 @@ bool TagExtractorTokensImpl::extractTag(TagExtractionContext& context, std::vect
   PERF_OPERATION(perf);
   const std::vector<absl::string_view>& input_tokens = context.tokens();
   uint32_t match_input_index = input_tokens.size(), start = 0;
-  if (!searchTags(input_tokens, 0, 0, 0, start, match_input_index)) {
+  bool matched;
+  if (token_set_ != nullptr) {
+    // Patterns in the set have no "**" before the "$", so the index of the tag value token is
+    // fixed by the pattern.
+    matched = context.tokenSetMatches(*token_set_)[pattern_id_];
+    if (matched) {
+      match_input_index = match_index_;
+      start = input_tokens[match_index_].data() - context.name().data();
+    }
+  } else {
+    matched = searchTags(input_tokens, 0, 0, 0, start, match_input_index);
+  }
+  if (!matched) {
     PERF_RECORD(perf, "tokens-miss", name_);
     PERF_TAG_INC(missed_);
     return false;
@@ -12,12 +12,16 @@
 
 #include "source/common/common/regex.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "re2/re2.h"
 
 namespace Envoy {
 namespace Stats {
 
+class TagExtractorTokenSet;
+
 // Carries state across tag extractions.
 class TagExtractionContext {
 public:
@@ -26,9 +30,67 @@ public:
   absl::string_view name() { return name_; }
   const std::vector<absl::string_view>& tokens();
 
+  /**
+   * @param token_set the token patterns to match. All extractors sharing a context must use
+   *                  the same set.
+   * @return which patterns of token_set match the name, indexed by pattern id. This is
+   *         computed on first use, so that all patterns are matched in a single pass.
+   */
+  const std::vector<bool>& tokenSetMatches(const TagExtractorTokenSet& token_set);
+
 private:
   absl::string_view name_;
   std::vector<absl::string_view> tokens_;
+  const TagExtractorTokenSet* token_set_{};
+  std::vector<bool> token_set_matches_;
+};
+
+/**
+ * Compiles the token patterns of several TagExtractorTokensImpl into a trie, so that a stat
+ * name can be matched against all of them with a single walk over its tokens rather than one
+ * backtracking search per pattern. The trie is run as a non-deterministic automaton: each
+ * input token advances every active state along its literal, "*" and "$" edges, and "**" nodes
+ * loop on any token.
+ */
+class TagExtractorTokenSet {
+public:
+  TagExtractorTokenSet() : nodes_(1) {}
+
+  /**
+   * Adds a pattern to the set. Only patterns whose "$" is not preceded by "**" can be added,
+   * as the index of the tag value token is then fixed by the pattern.
+   * @param tokens the pattern, in the TagExtractorTokensImpl syntax.
+   * @return the id of the pattern, or absl::nullopt if it cannot be added.
+   */
+  absl::optional<uint32_t> addPattern(absl::string_view tokens);
+
+  /**
+   * @param tokens the dot-separated tokens of a stat name.
+   * @param matches filled with whether each pattern matches, indexed by pattern id.
+   */
+  void match(const std::vector<absl::string_view>& tokens, std::vector<bool>& matches) const;
+
+  uint32_t size() const { return num_patterns_; }
+
+private:
+  struct Node {
+    absl::flat_hash_map<std::string, uint32_t> children_;
+    // Index of the node reached through "*" or "$", or 0 if there is none.
+    uint32_t any_token_{0};
+    // Index of the node reached through "**", or 0 if there is none.
+    uint32_t any_tokens_{0};
+    // Whether this node is reached through "**", and thus consumes any number of tokens.
+    bool loop_{false};
+    // Ids of the patterns ending at this node.
+    std::vector<uint32_t> patterns_;
+  };
+
+  static uint32_t& childIndex(Node& node, absl::string_view token);
+  void addState(uint32_t node, bool consumed, std::vector<uint32_t>& states) const;
+
+  // Node 0 is the root, so 0 is never a valid child index.
+  std::vector<Node> nodes_;
+  uint32_t num_patterns_{0};
 };
 
 // To check if a tag extractor is actually used you can run
@@ -157,6 +219,14 @@ class TagExtractorTokensImpl : public TagExtractorImplBase {
 public:
   TagExtractorTokensImpl(absl::string_view name, absl::string_view tokens);
 
+  /**
+   * Creates an extractor whose pattern is matched through token_set when possible, falling back
+   * to a standalone search otherwise.
+   * @param token_set the set the pattern is added to, which must outlive the extractor.
+   */
+  TagExtractorTokensImpl(absl::string_view name, absl::string_view tokens,
+                         TagExtractorTokenSet& token_set);
+
   bool extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                   IntervalSet<size_t>& remove_characters) const override;
 
@@ -168,6 +238,8 @@ private:
 
   const std::vector<std::string> tokens_;
   const uint32_t match_index_;
+  const TagExtractorTokenSet* token_set_{};
+  uint32_t pattern_id_{0};
 };
 
 /**
@@ -76,7 +76,8 @@ absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
   }
   for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
     if (desc.name_ == name) {
-      addExtractor(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+      addExtractor(
+          std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_, token_set_));
       ++num_found;
     }
   }
@@ -162,7 +163,8 @@ TagProducerImpl::addDefaultExtractors(const envoy::config::metrics::v3::StatsCon
       addExtractor(std::move(extractor_or_error.value()));
     }
     for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
-      addExtractor(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+      addExtractor(
+          std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_, token_set_));
     }
   }
   return absl::OkStatus();
@@ -14,6 +14,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/tag_extractor_impl.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
@@ -104,6 +105,10 @@ private:
   void forEachExtractorMatching(absl::string_view stat_name,
                                 std::function<void(const TagExtractorPtr&)> f) const;
 
+  // Matches the patterns of all default token extractors in a single pass over the tokens of
+  // a stat name. Declared before the extractors, which refer to it.
+  TagExtractorTokenSet token_set_;
+
   std::vector<TagExtractorPtr> tag_extractors_without_prefix_;
 
   // Maps a prefix word extracted out of a regex to a vector of TagExtractors. Note that
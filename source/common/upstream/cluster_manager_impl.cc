@@ -37,6 +37,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/shadow_writer_impl.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/common/stats/timespan_impl.h"
 #include "source/common/tcp/conn_pool.h"
 #include "source/common/upstream/cds_api_impl.h"
 #include "source/common/upstream/cluster_factory_impl.h"
@@ -542,7 +543,8 @@ ThreadLocalClusterManagerStats
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::generateStats(Stats::Scope& scope,
                                                                  const std::string& thread_name) {
   const std::string final_prefix = absl::StrCat("thread_local_cluster_manager.", thread_name);
-  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_GAUGE_PREFIX(scope, final_prefix))};
+  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_GAUGE_PREFIX(scope, final_prefix),
+                                                 POOL_HISTOGRAM_PREFIX(scope, final_prefix))};
 }
 
 absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster) {
@@ -1258,12 +1260,16 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
         cluster_manager->thread_local_clusters_[info->name()]->setDropOverload(drop_overload);
         cluster_manager->thread_local_clusters_[info->name()]->setDropCategory(drop_category);
       }
+      Stats::HistogramCompletableTimespanImpl update_timespan(
+          cluster_manager->local_stats_.cluster_update_duration_us_,
+          cluster_manager->thread_local_dispatcher_.timeSource());
       for (const auto& per_priority : params.per_priority_update_params_) {
         cluster_manager->updateClusterMembership(
             info->name(), per_priority.priority_, per_priority.update_hosts_params_,
             per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
             per_priority.weighted_priority_health_, per_priority.overprovisioning_factor_, map);
       }
+      update_timespan.complete();
 
       if (new_cluster != nullptr) {
         ThreadLocalClusterCommand command = [&new_cluster]() -> ThreadLocalCluster& {
@@ -214,13 +214,15 @@ struct ClusterManagerStats {
 /**
  * All thread local cluster manager stats. @see stats_macros.h
  */
-#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GAUGE) GAUGE(clusters_inflated, NeverImport)
+#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GAUGE, HISTOGRAM)                                   \
+  GAUGE(clusters_inflated, NeverImport)                                                            \
+  HISTOGRAM(cluster_update_duration_us, Microseconds)
 
 /**
  * Struct definition for all cluster manager stats. @see stats_macros.h
  */
 struct ThreadLocalClusterManagerStats {
-  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_GAUGE_STRUCT)
+  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 /**
@@ -62,6 +62,11 @@ public:
   Upstream::Cluster& cluster() override { return cluster_; }
   Envoy::Runtime::Loader& runtime() override { return runtime_; }
   Event::Dispatcher& mainThreadDispatcher() override { return dispatcher_; }
+  // The dispatcher is only picked once the health checker asks for it, as the Redis and Thrift
+  // health checkers stay on the main thread.
+  Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) override {
+    return server_context_.healthCheckDispatcher(affinity);
+  }
   HealthCheckEventLoggerPtr eventLogger() override { return std::move(event_logger_); }
   ProtobufMessage::ValidationVisitor& messageValidationVisitor() override {
     return validation_visitor_;
@@ -91,6 +91,10 @@ void LoadStatsReporter::sendLoadStatsRequest() {
         locality_stats.set_priority(host_set->priority());
 
         for (const HostSharedPtr& host : hosts) {
+          // A host that has not allocated its stats has no load stats updates.
+          if (!host->statsIfAllocated().has_value()) {
+            continue;
+          }
           uint64_t host_rq_success = host->stats().rq_success_.latch();
           uint64_t host_rq_error = host->stats().rq_error_.latch();
           uint64_t host_rq_active = host->stats().rq_active_.value();
@@ -166,10 +170,15 @@ void LoadStatsReporter::sendLoadStatsRequest() {
         }
       }
     }
-    cluster_stats->set_total_dropped_requests(
-        cluster.info()->loadReportStats().upstream_rq_dropped_.latch());
-    const uint64_t drop_overload_count =
-        cluster.info()->loadReportStats().upstream_rq_drop_overload_.latch();
+    // Load report stats are only instantiated once a request is dropped when their creation is
+    // deferred, so that idle clusters report no drops without allocating them.
+    DeferredCreationCompatibleClusterLoadReportStats& load_report_stats =
+        cluster.info()->loadReportStats();
+    uint64_t drop_overload_count = 0;
+    if (load_report_stats.isPresent()) {
+      cluster_stats->set_total_dropped_requests(load_report_stats->upstream_rq_dropped_.latch());
+      drop_overload_count = load_report_stats->upstream_rq_drop_overload_.latch();
+    }
     if (drop_overload_count > 0) {
       auto* dropped_request = cluster_stats->add_dropped_requests();
       dropped_request->set_category(cluster.dropCategory());
@@ -264,8 +273,12 @@ void LoadStatsReporter::startLoadReportPeriod() {
         host->stats().rq_total_.latch();
       }
     }
-    cluster.info()->loadReportStats().upstream_rq_dropped_.latch();
-    cluster.info()->loadReportStats().upstream_rq_drop_overload_.latch();
+    DeferredCreationCompatibleClusterLoadReportStats& load_report_stats =
+        cluster.info()->loadReportStats();
+    if (load_report_stats.isPresent()) {
+      load_report_stats->upstream_rq_dropped_.latch();
+      load_report_stats->upstream_rq_drop_overload_.latch();
+    }
   };
   if (message_->send_all_clusters()) {
     for (const auto& p : all_clusters.active_clusters_) {
@@ -58,6 +58,7 @@
 #include "source/common/upstream/health_checker_impl.h"
 #include "source/server/transport_socket_config_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/str_cat.h"
 
@@ -83,6 +84,13 @@ std::string addressToString(Network::Address::InstanceConstSharedPtr address) {
   return address->asString();
 }
 
+uint64_t transportSocketConfigHash(const envoy::config::cluster::v3::Cluster& config) {
+  envoy::config::cluster::v3::Cluster transport_socket_config;
+  *transport_socket_config.mutable_transport_socket() = config.transport_socket();
+  *transport_socket_config.mutable_transport_socket_matches() = config.transport_socket_matches();
+  return MessageUtil::hash(transport_socket_config);
+}
+
 Network::TcpKeepaliveConfig
 parseTcpKeepaliveConfig(const envoy::config::cluster::v3::Cluster& config) {
   const envoy::config::core::v3::TcpKeepalive& options =
@@ -415,6 +423,61 @@ createUpstreamLocalAddressSelector(
   return selector_or_error.value();
 }
 
+// Interns the localities of hosts. Unlike SharedPool::ObjectSharedPool, which is bound to the main
+// thread, the pool is guarded by a mutex, as hosts are also created and destroyed on workers (e.g.
+// by ORIGINAL_DST clusters). Localities are interned per symbol table, as the zone stat name is
+// encoded with the symbol table of the cluster it was created for.
+class SharedLocalityPool {
+public:
+  SharedLocalityConstSharedPtr get(const envoy::config::core::v3::Locality& locality,
+                                   Stats::SymbolTable& symbol_table) {
+    absl::MutexLock lock(&mutex_);
+    LocalityMap& localities = pool_[&symbol_table];
+    auto it = localities.find(locality);
+    if (it != localities.end()) {
+      if (SharedLocalityConstSharedPtr shared_locality = it->second.lock()) {
+        return shared_locality;
+      }
+    }
+    SharedLocalityConstSharedPtr shared_locality(
+        new SharedLocality(locality, symbol_table),
+        [this, &symbol_table](const SharedLocality* ptr) { release(symbol_table, ptr); });
+    localities.insert_or_assign(locality, shared_locality);
+    return shared_locality;
+  }
+
+  static SharedLocalityPool& instance() { MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedLocalityPool); }
+
+private:
+  using LocalityMap =
+      absl::flat_hash_map<envoy::config::core::v3::Locality, std::weak_ptr<const SharedLocality>,
+                          LocalityHash, LocalityEqualTo>;
+
+  void release(const Stats::SymbolTable& symbol_table, const SharedLocality* ptr) {
+    {
+      absl::MutexLock lock(&mutex_);
+      // The entry may already have been replaced by get() racing with the release of the last
+      // reference to ptr, in which case it must be kept. The replacing entry may even have been
+      // released since, together with the localities of the symbol table.
+      auto pool_it = pool_.find(&symbol_table);
+      if (pool_it != pool_.end()) {
+        LocalityMap& localities = pool_it->second;
+        auto it = localities.find(ptr->locality_);
+        if (it != localities.end() && it->second.expired()) {
+          localities.erase(it);
+          if (localities.empty()) {
+            pool_.erase(pool_it);
+          }
+        }
+      }
+    }
+    delete ptr;
+  }
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<const Stats::SymbolTable*, LocalityMap> pool_ ABSL_GUARDED_BY(mutex_);
+};
+
 } // namespace
 
 // Allow disabling ALPN checks for transport sockets. See
@@ -486,8 +549,7 @@ HostDescriptionImplBase::HostDescriptionImplBase(
                                               Config::MetadataEnvoyLbKeys::get().CANARY)
                   .bool_value()),
       endpoint_metadata_(endpoint_metadata), locality_metadata_(locality_metadata),
-      locality_(locality),
-      locality_zone_stat_name_(locality.zone(), cluster->statsScope().symbolTable()),
+      locality_(SharedLocalityPool::instance().get(locality, cluster->statsScope().symbolTable())),
       priority_(priority),
       socket_factory_(resolveTransportSocketFactory(dest_address, endpoint_metadata_.get())) {
   if (health_check_config.port_value() != 0 && dest_address->type() != Network::Address::Type::Ip) {
@@ -792,6 +854,122 @@ HostSetImpl::partitionHosts(HostVectorConstSharedPtr hosts,
                            std::move(std::get<2>(healthy_degraded_excluded_hosts_per_locality)));
 }
 
+namespace {
+
+// Returns hosts without the hosts in dropped, followed by added.
+HostVector mergeHosts(const HostVector& hosts, const absl::flat_hash_set<const Host*>& dropped,
+                      const HostVector& added) {
+  HostVector merged;
+  merged.reserve(hosts.size() + added.size());
+  for (const HostSharedPtr& host : hosts) {
+    if (!dropped.contains(host.get())) {
+      merged.push_back(host);
+    }
+  }
+  merged.insert(merged.end(), added.begin(), added.end());
+  return merged;
+}
+
+HostsPerLocalityConstSharedPtr mergeHostsPerLocality(const HostsPerLocality& hosts,
+                                                     const absl::flat_hash_set<const Host*>& dropped,
+                                                     const HostsPerLocality& added) {
+  ASSERT(hosts.get().size() == added.get().size());
+  std::vector<HostVector> merged;
+  merged.reserve(hosts.get().size());
+  for (size_t i = 0; i < hosts.get().size(); ++i) {
+    merged.push_back(mergeHosts(hosts.get()[i], dropped, added.get()[i]));
+  }
+  return std::make_shared<HostsPerLocalityImpl>(std::move(merged), hosts.hasLocalLocality());
+}
+
+} // namespace
+
+absl::optional<PrioritySet::UpdateHostsParams>
+HostSetImpl::partitionHostsDelta(const HostSet& host_set, HostVectorConstSharedPtr hosts,
+                                 const HostVector& hosts_added, const HostVector& hosts_removed,
+                                 const HostVector& hosts_with_changed_health) {
+  const HostsPerLocality& current_hosts_per_locality = host_set.hostsPerLocality();
+  const size_t num_localities = current_hosts_per_locality.get().size();
+  const auto locality_index = [&current_hosts_per_locality](const Host& host) {
+    const std::vector<HostVector>& localities = current_hosts_per_locality.get();
+    for (size_t i = 0; i < localities.size(); ++i) {
+      if (!localities[i].empty() &&
+          LocalityEqualTo()(localities[i].front()->locality(), host.locality())) {
+        return absl::optional<size_t>(i);
+      }
+    }
+    return absl::optional<size_t>();
+  };
+
+  // The hosts to partition are the added ones, and the kept ones whose health changed, which are
+  // dropped from their current partitions.
+  HostVector delta_hosts = hosts_added;
+  std::vector<HostVector> hosts_added_per_locality(num_localities);
+  absl::flat_hash_set<const Host*> added(hosts_added.size());
+  for (const HostSharedPtr& host : hosts_added) {
+    const absl::optional<size_t> index = locality_index(*host);
+    if (!index.has_value()) {
+      return absl::nullopt;
+    }
+    hosts_added_per_locality[*index].push_back(host);
+    added.insert(host.get());
+  }
+  std::vector<HostVector> delta_hosts_per_locality = hosts_added_per_locality;
+  absl::flat_hash_set<const Host*> removed(hosts_removed.size());
+  for (const HostSharedPtr& host : hosts_removed) {
+    removed.insert(host.get());
+  }
+  absl::flat_hash_set<const Host*> dropped = removed;
+  for (const HostSharedPtr& host : hosts_with_changed_health) {
+    // A host moved from another priority is both added and changed.
+    if (added.contains(host.get())) {
+      continue;
+    }
+    const absl::optional<size_t> index = locality_index(*host);
+    if (!index.has_value()) {
+      return absl::nullopt;
+    }
+    delta_hosts.push_back(host);
+    delta_hosts_per_locality[*index].push_back(host);
+    dropped.insert(host.get());
+  }
+
+  std::vector<HostVector> per_locality;
+  per_locality.reserve(num_localities);
+  for (size_t i = 0; i < num_localities; ++i) {
+    per_locality.push_back(mergeHosts(current_hosts_per_locality.get()[i], removed,
+                                      hosts_added_per_locality[i]));
+    if (per_locality.back().empty()) {
+      return absl::nullopt;
+    }
+  }
+
+  const auto delta_partitioned_hosts = ClusterImplBase::partitionHostList(delta_hosts);
+  const auto delta_partitioned_hosts_per_locality =
+      ClusterImplBase::partitionHostsPerLocality(HostsPerLocalityImpl(
+          std::move(delta_hosts_per_locality), current_hosts_per_locality.hasLocalLocality()));
+
+  return updateHostsParams(
+      std::move(hosts),
+      std::make_shared<HostsPerLocalityImpl>(std::move(per_locality),
+                                             current_hosts_per_locality.hasLocalLocality()),
+      std::make_shared<HealthyHostVector>(
+          mergeHosts(host_set.healthyHosts(), dropped,
+                     std::get<0>(delta_partitioned_hosts)->get())),
+      mergeHostsPerLocality(host_set.healthyHostsPerLocality(), dropped,
+                            *std::get<0>(delta_partitioned_hosts_per_locality)),
+      std::make_shared<DegradedHostVector>(
+          mergeHosts(host_set.degradedHosts(), dropped,
+                     std::get<1>(delta_partitioned_hosts)->get())),
+      mergeHostsPerLocality(host_set.degradedHostsPerLocality(), dropped,
+                            *std::get<1>(delta_partitioned_hosts_per_locality)),
+      std::make_shared<ExcludedHostVector>(
+          mergeHosts(host_set.excludedHosts(), dropped,
+                     std::get<2>(delta_partitioned_hosts)->get())),
+      mergeHostsPerLocality(host_set.excludedHostsPerLocality(), dropped,
+                            *std::get<2>(delta_partitioned_hosts_per_locality)));
+}
+
 const HostSet&
 PrioritySetImpl::getOrCreateHostSet(uint32_t priority,
                                     absl::optional<bool> weighted_priority_health,
@@ -937,10 +1115,12 @@ ClusterRequestResponseSizeStats ClusterInfoImpl::generateRequestResponseSizeStat
   return {stat_names, scope};
 }
 
-ClusterLoadReportStats
-ClusterInfoImpl::generateLoadReportStats(Stats::Scope& scope,
-                                         const ClusterLoadReportStatNames& stat_names) {
-  return {stat_names, scope};
+DeferredCreationCompatibleClusterLoadReportStats
+ClusterInfoImpl::generateLoadReportStats(Stats::SymbolTable& symbol_table,
+                                         const ClusterLoadReportStatNames& stat_names,
+                                         bool defer_creation) {
+  return Stats::createDeferredCompatibleIsolatedStats<ClusterLoadReportStats>(
+      symbol_table, stat_names, defer_creation);
 }
 
 ClusterTimeoutBudgetStats
@@ -1106,7 +1286,9 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
-      socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
+      socket_matcher_(std::move(socket_matcher)),
+      transport_socket_config_hash_(transportSocketConfigHash(config)),
+      stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(
           stats_scope_, factory_context.serverFactoryContext().clusterManager().clusterStatNames(),
           server_context.statsConfig().enableDeferredCreationStats())),
@@ -1118,14 +1300,15 @@ ClusterInfoImpl::ClusterInfoImpl(
       endpoint_stats_(
           factory_context.serverFactoryContext().clusterManager().clusterEndpointStatNames(),
           *stats_scope_),
-      load_report_stats_store_(stats_scope_->symbolTable()),
       load_report_stats_(generateLoadReportStats(
-          *load_report_stats_store_.rootScope(),
-          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames())),
+          stats_scope_->symbolTable(),
+          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames(),
+          server_context.statsConfig().enableDeferredCreationStats())),
       optional_cluster_stats_(
           (config.has_track_cluster_stats() || config.track_timeout_budgets())
               ? std::make_unique<OptionalClusterStats>(
-                    config, *stats_scope_, factory_context.serverFactoryContext().clusterManager())
+                    config, stats_scope_, factory_context.serverFactoryContext().clusterManager(),
+                    server_context.statsConfig().enableDeferredCreationStats())
               : nullptr),
       features_(ClusterInfoImpl::HttpProtocolOptionsConfigImpl::parseFeatures(
           config, *http_protocol_options_)),
@@ -1574,6 +1757,12 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
             std::unique_ptr<const Event::DispatcherThreadDeletable>(self));
       });
 
+  health_update_merge_window_ = std::chrono::milliseconds(
+      PROTOBUF_GET_MS_OR_DEFAULT(cluster.common_lb_config(), health_update_merge_window, 0));
+  if (health_update_merge_window_.count() > 0) {
+    health_update_merge_timer_ = dispatcher.createTimer([this]() { onHealthUpdateMergeTimer(); });
+  }
+
   if ((info_->features() & ClusterInfoImpl::Features::USE_ALPN)) {
     if (!raw_factory_pointer->supportsAlpn()) {
       creation_status = absl::InvalidArgumentError(
@@ -1848,10 +2037,36 @@ void ClusterImplBase::reloadHealthyHosts(const HostSharedPtr& host) {
     return;
   }
 
-  reloadHealthyHostsHelper(host);
+  // When merging, the first transition applies immediately and opens a merge window. Transitions
+  // seen during the window are applied together when it ends, which opens a new one.
+  if (health_update_merge_timer_ != nullptr && health_update_merge_timer_->enabled()) {
+    if (host != nullptr) {
+      pending_health_updates_.push_back(host);
+    }
+    health_update_pending_ = true;
+    info_->configUpdateStats().health_update_merged_.inc();
+    return;
+  }
+
+  reloadHealthyHostsHelper(host != nullptr ? HostVector{host} : HostVector{});
+  if (health_update_merge_timer_ != nullptr) {
+    health_update_merge_timer_->enableTimer(health_update_merge_window_);
+  }
 }
 
-void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
+void ClusterImplBase::onHealthUpdateMergeTimer() {
+  if (!health_update_pending_) {
+    return;
+  }
+
+  health_update_pending_ = false;
+  HostVector hosts;
+  hosts.swap(pending_health_updates_);
+  reloadHealthyHostsHelper(hosts);
+  health_update_merge_timer_->enableTimer(health_update_merge_window_);
+}
+
+void ClusterImplBase::reloadHealthyHostsHelper(const HostVector&) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
@@ -1907,18 +2122,21 @@ absl::Status ClusterImplBase::validateEndpoints(
 }
 
 ClusterInfoImpl::OptionalClusterStats::OptionalClusterStats(
-    const envoy::config::cluster::v3::Cluster& config, Stats::Scope& stats_scope,
-    const ClusterManager& manager)
-    : timeout_budget_stats_(
-          (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets())
-              ? std::make_unique<ClusterTimeoutBudgetStats>(generateTimeoutBudgetStats(
-                    stats_scope, manager.clusterTimeoutBudgetStatNames()))
-              : nullptr),
-      request_response_size_stats_(
-          (config.track_cluster_stats().request_response_sizes()
-               ? std::make_unique<ClusterRequestResponseSizeStats>(generateRequestResponseSizeStats(
-                     stats_scope, manager.clusterRequestResponseSizeStatNames()))
-               : nullptr)) {}
+    const envoy::config::cluster::v3::Cluster& config, const Stats::ScopeSharedPtr& stats_scope,
+    const ClusterManager& manager, bool defer_creation) {
+  if (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets()) {
+    timeout_budget_stats_ =
+        std::make_unique<Stats::DeferredCreationCompatibleStats<ClusterTimeoutBudgetStats>>(
+            Stats::createDeferredCompatibleStats<ClusterTimeoutBudgetStats>(
+                stats_scope, manager.clusterTimeoutBudgetStatNames(), defer_creation));
+  }
+  if (config.track_cluster_stats().request_response_sizes()) {
+    request_response_size_stats_ =
+        std::make_unique<Stats::DeferredCreationCompatibleStats<ClusterRequestResponseSizeStats>>(
+            Stats::createDeferredCompatibleStats<ClusterRequestResponseSizeStats>(
+                stats_scope, manager.clusterRequestResponseSizeStatNames(), defer_creation));
+  }
+}
 
 ClusterInfoImpl::ResourceManagers::ResourceManagers(
     const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
@@ -2232,10 +2450,37 @@ void PriorityStateManager::updateClusterPrioritySet(
   }
 }
 
+bool PriorityStateManager::updateClusterPrioritySetDelta(
+    const uint32_t priority, const HostVectorSharedPtr& hosts, const HostVector& hosts_added,
+    const HostVector& hosts_removed, const HostVector& hosts_with_changed_health) {
+  const auto& host_sets = parent_.prioritySet().hostSetsPerPriority();
+  if (priority >= host_sets.size()) {
+    return false;
+  }
+  const HostSet& host_set = *host_sets[priority];
+  absl::optional<PrioritySet::UpdateHostsParams> update_hosts_params =
+      HostSetImpl::partitionHostsDelta(host_set, hosts, hosts_added, hosts_removed,
+                                       hosts_with_changed_health);
+  if (!update_hosts_params.has_value()) {
+    return false;
+  }
+
+  if (update_cb_ != nullptr) {
+    update_cb_->updateHosts(priority, std::move(*update_hosts_params), host_set.localityWeights(),
+                            hosts_added, hosts_removed, absl::nullopt, absl::nullopt);
+  } else {
+    parent_.prioritySet().updateHosts(priority, std::move(*update_hosts_params),
+                                      host_set.localityWeights(), hosts_added, hosts_removed,
+                                      absl::nullopt, absl::nullopt);
+  }
+  return true;
+}
+
 bool BaseDynamicClusterImpl::updateDynamicHostList(
     const HostVector& new_hosts, HostVector& current_priority_hosts,
     HostVector& hosts_added_to_current_priority, HostVector& hosts_removed_from_current_priority,
-    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts) {
+    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts,
+    HostVector* hosts_with_changed_health) {
   uint64_t max_host_weight = 1;
 
   // Did hosts change?
@@ -2322,11 +2567,18 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
         hosts_changed = true;
       }
 
+      if (hosts_with_changed_health != nullptr &&
+          host->edsHealthStatus() != existing_host->second->edsHealthStatus()) {
+        hosts_with_changed_health->push_back(existing_host->second);
+      }
       hosts_changed |= updateEdsHealthFlag(*host, *existing_host->second);
 
       // Did metadata change?
       bool metadata_changed = true;
-      if (host->metadata() && existing_host->second->metadata()) {
+      if (host->metadata() == existing_host->second->metadata()) {
+        // Hosts of unchanged endpoints share their metadata through the const metadata pool.
+        metadata_changed = false;
+      } else if (host->metadata() && existing_host->second->metadata()) {
         metadata_changed = !Protobuf::util::MessageDifferencer::Equivalent(
             *host->metadata(), *existing_host->second->metadata());
       } else if (!host->metadata() && !existing_host->second->metadata()) {
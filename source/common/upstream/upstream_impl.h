@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <string>
@@ -135,6 +136,21 @@ private:
   const absl::optional<MonotonicTime> time_{};
 };
 
+/**
+ * The locality of a host and the stat name of its zone. Every host of a locality shares one
+ * SharedLocality, rather than holding copies of its own, which adds up in clusters of many hosts.
+ */
+struct SharedLocality {
+  SharedLocality(const envoy::config::core::v3::Locality& locality,
+                 Stats::SymbolTable& symbol_table)
+      : locality_(locality), zone_stat_name_(locality.zone(), symbol_table) {}
+
+  const envoy::config::core::v3::Locality locality_;
+  const Stats::StatNameDynamicStorage zone_stat_name_;
+};
+
+using SharedLocalityConstSharedPtr = std::shared_ptr<const SharedLocality>;
+
 /**
  * Base implementation of most of Upstream::HostDescription, shared between
  * HostDescriptionImpl and LogicalHost, which is in
@@ -208,21 +224,39 @@ public:
     static DetectorHostMonitorNullImpl* null_outlier_detector = new DetectorHostMonitorNullImpl();
     return *null_outlier_detector;
   }
-  HostStats& stats() const override { return stats_; }
+  HostStats& stats() const override {
+    // Most hosts of large clusters never see traffic from a given Envoy, so their stats are only
+    // allocated on first use.
+    return *stats_.get([]() -> HostStats* { return new HostStats(); });
+  }
+  OptRef<HostStats> statsIfAllocated() const override {
+    if (stats_.isNull()) {
+      return {};
+    }
+    return stats();
+  }
   LoadMetricStats& loadMetricStats() const override { return load_metric_stats_; }
   const std::string& hostnameForHealthChecks() const override { return health_checks_hostname_; }
   const std::string& hostname() const override { return hostname_; }
-  const envoy::config::core::v3::Locality& locality() const override { return locality_; }
+  const envoy::config::core::v3::Locality& locality() const override {
+    return locality_->locality_;
+  }
   const MetadataConstSharedPtr localityMetadata() const override { return locality_metadata_; }
   Stats::StatName localityZoneStatName() const override {
-    return locality_zone_stat_name_.statName();
+    return locality_->zone_stat_name_.statName();
   }
   uint32_t priority() const override { return priority_; }
   void priority(uint32_t priority) override { priority_ = priority; }
   Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const override;
-  absl::optional<MonotonicTime> lastHcPassTime() const override { return last_hc_pass_time_; }
+  absl::optional<MonotonicTime> lastHcPassTime() const override {
+    const MonotonicTime::rep last_hc_pass_time = last_hc_pass_time_.load();
+    if (last_hc_pass_time == NoLastHcPassTime) {
+      return absl::nullopt;
+    }
+    return MonotonicTime(MonotonicTime::duration(last_hc_pass_time));
+  }
 
   void setHealthChecker(HealthCheckHostMonitorPtr&& health_checker) override {
     health_checker_ = std::move(health_checker);
@@ -233,7 +267,7 @@ public:
   }
 
   void setLastHcPassTime(MonotonicTime last_hc_pass_time) override {
-    last_hc_pass_time_.emplace(std::move(last_hc_pass_time));
+    last_hc_pass_time_ = last_hc_pass_time.time_since_epoch().count();
   }
 
   void setLbPolicyData(HostLbPolicyDataPtr lb_policy_data) override {
@@ -267,16 +301,18 @@ private:
   mutable absl::Mutex metadata_mutex_;
   MetadataConstSharedPtr endpoint_metadata_ ABSL_GUARDED_BY(metadata_mutex_);
   const MetadataConstSharedPtr locality_metadata_;
-  const envoy::config::core::v3::Locality locality_;
-  Stats::StatNameDynamicStorage locality_zone_stat_name_;
-  mutable HostStats stats_;
+  const SharedLocalityConstSharedPtr locality_;
+  mutable Thread::AtomicPtr<HostStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct> stats_;
   mutable LoadMetricStatsImpl load_metric_stats_;
   Outlier::DetectorHostMonitorPtr outlier_detector_;
   HealthCheckHostMonitorPtr health_checker_;
   std::atomic<uint32_t> priority_;
   std::reference_wrapper<Network::UpstreamTransportSocketFactory>
       socket_factory_ ABSL_GUARDED_BY(metadata_mutex_);
-  absl::optional<MonotonicTime> last_hc_pass_time_;
+  static constexpr MonotonicTime::rep NoLastHcPassTime =
+      std::numeric_limits<MonotonicTime::rep>::min();
+  // Set by the health checker, which may run on its own thread, and read by the load balancers.
+  std::atomic<MonotonicTime::rep> last_hc_pass_time_{NoLastHcPassTime};
   HostLbPolicyDataPtr lb_policy_data_;
 };
 
@@ -349,7 +385,7 @@ public:
   // Upstream::Host
   std::vector<std::pair<absl::string_view, Stats::PrimitiveCounterReference>>
   counters() const override {
-    return stats().counters();
+    return statsOrZeros().counters();
   }
   CreateConnectionData createConnection(
       Event::Dispatcher& dispatcher, const Network::ConnectionSocket::OptionsSharedPtr& options,
@@ -361,7 +397,7 @@ public:
 
   std::vector<std::pair<absl::string_view, Stats::PrimitiveGaugeReference>>
   gauges() const override {
-    return stats().gauges();
+    return statsOrZeros().gauges();
   }
   void healthFlagClear(HealthFlag flag) override { health_flags_ &= ~enumToInt(flag); }
   bool healthFlagGet(HealthFlag flag) const override { return health_flags_ & enumToInt(flag); }
@@ -446,6 +482,16 @@ private:
   // Helper function to check multiple health flags at once.
   bool healthFlagsGet(uint32_t flags) const { return health_flags_ & flags; }
 
+  // Lists the stats of a host that has not used them yet from a shared all zero instance, so that
+  // listing the stats of every host does not allocate them.
+  HostStats& statsOrZeros() const {
+    const OptRef<HostStats> stats = statsIfAllocated();
+    if (stats.has_value()) {
+      return *stats;
+    }
+    MUTABLE_CONSTRUCT_ON_FIRST_USE(HostStats);
+  }
+
   void setEdsHealthFlag(envoy::config::core::v3::HealthStatus health_status);
 
   std::atomic<uint32_t> health_flags_{};
@@ -614,6 +660,22 @@ public:
   static PrioritySet::UpdateHostsParams
   partitionHosts(HostVectorConstSharedPtr hosts, HostsPerLocalityConstSharedPtr hosts_per_locality);
 
+  /**
+   * Applies a delta to the hosts of a host set. Unlike partitionHosts(), only the hosts of the
+   * delta are partitioned, the partitions of the other hosts are kept as they are.
+   * @param host_set the host set to apply the delta to.
+   * @param hosts the hosts of the host set once the delta is applied.
+   * @param hosts_added the hosts added to the host set.
+   * @param hosts_removed the hosts removed from the host set.
+   * @param hosts_with_changed_health the hosts kept in the host set whose health changed.
+   * @return the parameters to update the host set with, or absl::nullopt if the delta adds or
+   *         empties a locality, which changes the locality weights of the host set.
+   */
+  static absl::optional<PrioritySet::UpdateHostsParams>
+  partitionHostsDelta(const HostSet& host_set, HostVectorConstSharedPtr hosts,
+                      const HostVector& hosts_added, const HostVector& hosts_removed,
+                      const HostVector& hosts_with_changed_health);
+
   void updateHosts(PrioritySet::UpdateHostsParams&& update_hosts_params,
                    LocalityWeightsConstSharedPtr locality_weights, const HostVector& hosts_added,
                    const HostVector& hosts_removed,
@@ -786,8 +848,9 @@ public:
   static DeferredCreationCompatibleClusterTrafficStats
   generateStats(Stats::ScopeSharedPtr scope, const ClusterTrafficStatNames& cluster_stat_names,
                 bool defer_creation);
-  static ClusterLoadReportStats
-  generateLoadReportStats(Stats::Scope& scope, const ClusterLoadReportStatNames& stat_names);
+  static DeferredCreationCompatibleClusterLoadReportStats
+  generateLoadReportStats(Stats::SymbolTable& symbol_table,
+                          const ClusterLoadReportStatNames& stat_names, bool defer_creation);
   static ClusterCircuitBreakersStats
   generateCircuitBreakersStats(Stats::Scope& scope, Stats::StatName prefix, bool track_remaining,
                                const ClusterCircuitBreakersStatNames& stat_names);
@@ -891,6 +954,7 @@ public:
   }
   ResourceManager& resourceManager(ResourcePriority priority) const override;
   TransportSocketMatcher& transportSocketMatcher() const override { return *socket_matcher_; }
+  uint64_t transportSocketConfigHash() const override { return transport_socket_config_hash_; }
   DeferredCreationCompatibleClusterTrafficStats& trafficStats() const override {
     return traffic_stats_;
   }
@@ -905,10 +969,12 @@ public:
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
+    return std::ref(**optional_cluster_stats_->request_response_size_stats_);
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  DeferredCreationCompatibleClusterLoadReportStats& loadReportStats() const override {
+    return load_report_stats_;
+  }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
@@ -916,7 +982,7 @@ public:
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->timeout_budget_stats_));
+    return std::ref(**optional_cluster_stats_->timeout_budget_stats_);
   }
 
   bool perEndpointStatsEnabled() const override { return per_endpoint_stats_; }
@@ -1040,9 +1106,12 @@ private:
 
   struct OptionalClusterStats {
     OptionalClusterStats(const envoy::config::cluster::v3::Cluster& config,
-                         Stats::Scope& stats_scope, const ClusterManager& manager);
-    const ClusterTimeoutBudgetStatsPtr timeout_budget_stats_;
-    const ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
+                         const Stats::ScopeSharedPtr& stats_scope, const ClusterManager& manager,
+                         bool defer_creation);
+    std::unique_ptr<Stats::DeferredCreationCompatibleStats<ClusterTimeoutBudgetStats>>
+        timeout_budget_stats_;
+    std::unique_ptr<Stats::DeferredCreationCompatibleStats<ClusterRequestResponseSizeStats>>
+        request_response_size_stats_;
   };
 
 #ifdef ENVOY_ENABLE_UHV
@@ -1063,13 +1132,13 @@ private:
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
   TransportSocketMatcherPtr socket_matcher_;
+  const uint64_t transport_socket_config_hash_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
   mutable ClusterConfigUpdateStats config_update_stats_;
   mutable ClusterLbStats lb_stats_;
   mutable ClusterEndpointStats endpoint_stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable DeferredCreationCompatibleClusterLoadReportStats load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -1208,7 +1277,11 @@ protected:
    */
   void onInitDone();
 
-  virtual void reloadHealthyHostsHelper(const HostSharedPtr& host);
+  /**
+   * Recalculates the healthy hosts of every priority.
+   * @param hosts the hosts whose health changed since the last recalculation, if known.
+   */
+  virtual void reloadHealthyHostsHelper(const HostVector& hosts);
 
   absl::Status parseDropOverloadConfig(
       const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment);
@@ -1245,6 +1318,7 @@ private:
 
   void finishInitialization();
   void reloadHealthyHosts(const HostSharedPtr& host);
+  void onHealthUpdateMergeTimer();
 
   bool initialization_started_{};
   std::function<absl::Status()> initialization_complete_callback_;
@@ -1252,6 +1326,11 @@ private:
   const bool local_cluster_;
   Config::ConstMetadataSharedPoolSharedPtr const_metadata_shared_pool_;
   Common::CallbackHandlePtr priority_update_cb_;
+  // Only set if health transitions are merged, see CommonLbConfig.health_update_merge_window.
+  Event::TimerPtr health_update_merge_timer_;
+  std::chrono::milliseconds health_update_merge_window_{};
+  HostVector pending_health_updates_;
+  bool health_update_pending_{};
   UnitFloat drop_overload_{0};
   std::string drop_category_;
   static constexpr int kDropOverloadSize = 1;
@@ -1296,6 +1375,14 @@ public:
                            absl::optional<bool> weighted_priority_health = absl::nullopt,
                            absl::optional<uint32_t> overprovisioning_factor = absl::nullopt);
 
+  // Applies hosts_added, hosts_removed and hosts_with_changed_health to an existing priority as a
+  // delta, see HostSetImpl::partitionHostsDelta(). The locality weights of the priority are kept.
+  // Returns false, without updating the priority, if the delta cannot be applied that way.
+  bool updateClusterPrioritySetDelta(const uint32_t priority, const HostVectorSharedPtr& hosts,
+                                     const HostVector& hosts_added,
+                                     const HostVector& hosts_removed,
+                                     const HostVector& hosts_with_changed_health);
+
   // Returns the saved priority state.
   PriorityState& priorityState() { return priority_state_; }
 
@@ -1327,13 +1414,16 @@ protected:
    * priority.
    * @param all_hosts all known hosts prior to this host update across all priorities.
    * @param all_new_hosts addresses of all hosts in the new configuration across all priorities.
+   * @param hosts_with_changed_health if not null, will be populated with the hosts kept in the
+   * priority whose EDS health status changed.
    * @return whether the hosts for the priority changed.
    */
   bool updateDynamicHostList(const HostVector& new_hosts, HostVector& current_priority_hosts,
                              HostVector& hosts_added_to_current_priority,
                              HostVector& hosts_removed_from_current_priority,
                              const HostMap& all_hosts,
-                             const absl::flat_hash_set<std::string>& all_new_hosts);
+                             const absl::flat_hash_set<std::string>& all_new_hosts,
+                             HostVector* hosts_with_changed_health = nullptr);
 };
 
 /**
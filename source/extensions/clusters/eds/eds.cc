@@ -6,10 +6,12 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/decoded_resource_impl.h"
 #include "source/common/grpc/common.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -74,11 +76,55 @@ EdsClusterImpl::~EdsClusterImpl() {
 void EdsClusterImpl::startPreInit() { subscription_->start({edsServiceName()}); }
 
 void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& host_update_cb) {
+  const bool incremental =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.eds_incremental_updates");
+
+  // Get the map of all the latest existing hosts, which is used to filter out the existing
+  // hosts in the process of updating cluster memberships.
+  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
+  ASSERT(all_hosts != nullptr);
+
   absl::flat_hash_set<std::string> all_new_hosts;
   PriorityStateManager priority_state_manager(parent_, parent_.local_info_, &host_update_cb);
   for (const auto& locality_lb_endpoint : cluster_load_assignment_.endpoints()) {
     priority_state_manager.initializePriorityFor(locality_lb_endpoint);
 
+    // Hashes what the hosts of the locality are created from, besides their endpoints.
+    uint64_t locality_hash = 0;
+    if (incremental) {
+      locality_hash = HashUtil::xxHash64Value(MessageUtil::hash(locality_lb_endpoint.locality()));
+      locality_hash = HashUtil::xxHash64Value(locality_lb_endpoint.has_metadata(), locality_hash);
+      locality_hash = HashUtil::xxHash64Value(MessageUtil::hash(locality_lb_endpoint.metadata()),
+                                              locality_hash);
+      locality_hash = HashUtil::xxHash64Value(locality_lb_endpoint.priority(), locality_hash);
+    }
+    const auto update_locality_endpoint =
+        [&](const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint) {
+          if (incremental) {
+            const uint64_t endpoint_hash = HashUtil::xxHash64Value(
+                MessageUtil::hash(lb_endpoint),
+                HashUtil::xxHash64Value(lb_endpoint.has_metadata(), locality_hash));
+            std::string endpoint = lb_endpoint.SerializeAsString();
+            if (reuseLocalityEndpoint(endpoint_hash, endpoint, locality_lb_endpoint,
+                                      priority_state_manager, *all_hosts, all_new_hosts)) {
+              return;
+            }
+            const size_t num_new_hosts = all_new_hosts.size();
+            updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
+                                    all_new_hosts);
+            // Unless the endpoint is a duplicate, its host is the last one of its priority.
+            if (all_new_hosts.size() > num_new_hosts) {
+              const HostVector& hosts =
+                  *priority_state_manager.priorityState()[locality_lb_endpoint.priority()].first;
+              new_hosts_by_endpoint_hash_.try_emplace(
+                  endpoint_hash, EndpointHost{std::move(endpoint), hosts.back()});
+            }
+          } else {
+            updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
+                                    all_new_hosts);
+          }
+        };
+
     if (locality_lb_endpoint.has_leds_cluster_locality_config()) {
       // The locality uses LEDS, fetch its dynamic data, which must be ready, or otherwise
       // the batchUpdate method should not have been called.
@@ -90,13 +136,11 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
              parent_.leds_localities_[leds_config]->isUpdated());
       for (const auto& [_, lb_endpoint] :
            parent_.leds_localities_[leds_config]->getEndpointsMap()) {
-        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+        update_locality_endpoint(lb_endpoint);
       }
     } else {
       for (const auto& lb_endpoint : locality_lb_endpoint.lb_endpoints()) {
-        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+        update_locality_endpoint(lb_endpoint);
       }
     }
   }
@@ -104,11 +148,6 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
   // Track whether we rebuilt any LB structures.
   bool cluster_rebuilt = false;
 
-  // Get the map of all the latest existing hosts, which is used to filter out the existing
-  // hosts in the process of updating cluster memberships.
-  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
-  ASSERT(all_hosts != nullptr);
-
   const uint32_t overprovisioning_factor = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
       cluster_load_assignment_.policy(), overprovisioning_factor, kDefaultOverProvisioningFactor);
   const bool weighted_priority_health =
@@ -127,14 +166,15 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
       cluster_rebuilt |= parent_.updateHostsPerLocality(
           i, weighted_priority_health, overprovisioning_factor, *priority_state[i].first,
           parent_.locality_weights_map_[i], priority_state[i].second, priority_state_manager,
-          *all_hosts, all_new_hosts);
+          *all_hosts, all_new_hosts, incremental);
     } else {
       // If the new update contains a priority with no hosts, call the update function with an empty
       // set of hosts.
       cluster_rebuilt |=
           parent_.updateHostsPerLocality(i, weighted_priority_health, overprovisioning_factor, {},
                                          parent_.locality_weights_map_[i], empty_locality_map,
-                                         priority_state_manager, *all_hosts, all_new_hosts);
+                                         priority_state_manager, *all_hosts, all_new_hosts,
+                                         incremental);
     }
   }
 
@@ -147,13 +187,15 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
     }
     cluster_rebuilt |= parent_.updateHostsPerLocality(
         i, weighted_priority_health, overprovisioning_factor, {}, parent_.locality_weights_map_[i],
-        empty_locality_map, priority_state_manager, *all_hosts, all_new_hosts);
+        empty_locality_map, priority_state_manager, *all_hosts, all_new_hosts, incremental);
   }
 
   if (!cluster_rebuilt) {
     parent_.info_->configUpdateStats().update_no_rebuild_.inc();
   }
 
+  parent_.hosts_by_endpoint_hash_ = std::move(new_hosts_by_endpoint_hash_);
+
   // If we didn't setup to initialize when our first round of health checking is complete, just
   // do it now.
   parent_.onPreInitComplete();
@@ -193,6 +235,41 @@ void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
   all_new_hosts.emplace(address_as_string);
 }
 
+bool EdsClusterImpl::BatchUpdateHelper::reuseLocalityEndpoint(
+    uint64_t endpoint_hash, const std::string& endpoint,
+    const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+    PriorityStateManager& priority_state_manager, const HostMap& all_hosts,
+    absl::flat_hash_set<std::string>& all_new_hosts) {
+  const auto it = parent_.hosts_by_endpoint_hash_.find(endpoint_hash);
+  if (it == parent_.hosts_by_endpoint_hash_.end() || it->second.endpoint_ != endpoint) {
+    return false;
+  }
+  const HostSharedPtr& host = it->second.host_;
+  // The hash may also collide for the fields of the locality the host was created from.
+  if (host->priority() != locality_lb_endpoint.priority() ||
+      !LocalityEqualTo()(host->locality(), locality_lb_endpoint.locality()) ||
+      locality_lb_endpoint.has_metadata() != (host->localityMetadata() != nullptr) ||
+      (locality_lb_endpoint.has_metadata() &&
+       !Protobuf::util::MessageDifferencer::Equals(*host->localityMetadata(),
+                                                   locality_lb_endpoint.metadata()))) {
+    return false;
+  }
+  const std::string& address_as_string = host->address()->asString();
+  // The host may have been replaced since, e.g. by a host with a different health check address.
+  const auto existing_host = all_hosts.find(address_as_string);
+  if (existing_host == all_hosts.end() || existing_host->second != host) {
+    return false;
+  }
+
+  // When the configuration contains duplicate hosts, only the first one will be retained.
+  if (!all_new_hosts.contains(address_as_string)) {
+    priority_state_manager.registerHostForPriority(host, locality_lb_endpoint);
+    all_new_hosts.emplace(address_as_string);
+    new_hosts_by_endpoint_hash_.try_emplace(endpoint_hash, EndpointHost{endpoint, host});
+  }
+  return true;
+}
+
 absl::Status
 EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& resources,
                                const std::string&) {
@@ -367,40 +444,41 @@ void EdsClusterImpl::onCachedResourceRemoved(absl::string_view resource_name) {
   update(resource);
 }
 
-void EdsClusterImpl::reloadHealthyHostsHelper(const HostSharedPtr& host) {
-  // Here we will see if we have a host that has been marked for deletion by service discovery
-  // but has been stabilized due to passing active health checking. If such a host is now
-  // failing active health checking we can remove it during this health check update.
-  HostSharedPtr host_to_exclude = host;
-  if (host_to_exclude != nullptr &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
-    // Empty for clarity.
-  } else {
-    // Do not exclude and remove the host during the update.
-    host_to_exclude = nullptr;
+void EdsClusterImpl::reloadHealthyHostsHelper(const HostVector& hosts) {
+  // Here we will see if we have hosts that have been marked for deletion by service discovery
+  // but have been stabilized due to passing active health checking. If such hosts are now
+  // failing active health checking we can remove them during this health check update.
+  absl::flat_hash_set<const Host*> hosts_to_exclude;
+  for (const HostSharedPtr& host : hosts) {
+    if (host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
+        host->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
+      hosts_to_exclude.insert(host.get());
+    }
   }
 
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
 
-    // Filter current hosts in case we need to exclude a host.
+    // Filter current hosts in case we need to exclude hosts, and setup a hosts to remove vector
+    // with them.
     HostVectorSharedPtr hosts_copy(new HostVector());
-    std::copy_if(host_set->hosts().begin(), host_set->hosts().end(),
-                 std::back_inserter(*hosts_copy),
-                 [&host_to_exclude](const HostSharedPtr& host) { return host_to_exclude != host; });
-
-    // Setup a hosts to remove vector in case we need to exclude a host.
     HostVector hosts_to_remove;
-    if (hosts_copy->size() != host_set->hosts().size()) {
-      ASSERT(hosts_copy->size() == host_set->hosts().size() - 1);
-      hosts_to_remove.emplace_back(host_to_exclude);
+    if (hosts_to_exclude.empty()) {
+      *hosts_copy = host_set->hosts();
+    } else {
+      for (const HostSharedPtr& host : host_set->hosts()) {
+        if (hosts_to_exclude.contains(host.get())) {
+          hosts_to_remove.emplace_back(host);
+        } else {
+          hosts_copy->emplace_back(host);
+        }
+      }
     }
 
-    // Filter hosts per locality in case we need to exclude a host.
+    // Filter hosts per locality in case we need to exclude hosts.
     HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().filter(
-        {[&host_to_exclude](const Host& host) { return &host != host_to_exclude.get(); }})[0];
+        {[&hosts_to_exclude](const Host& host) { return !hosts_to_exclude.contains(&host); }})[0];
 
     prioritySet().updateHosts(
         priority, HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
@@ -412,12 +490,14 @@ bool EdsClusterImpl::updateHostsPerLocality(
     const uint32_t priority, bool weighted_priority_health, const uint32_t overprovisioning_factor,
     const HostVector& new_hosts, LocalityWeightsMap& locality_weights_map,
     LocalityWeightsMap& new_locality_weights_map, PriorityStateManager& priority_state_manager,
-    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts) {
+    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts,
+    bool incremental) {
   const auto& host_set = priority_set_.getOrCreateHostSet(priority, overprovisioning_factor);
   HostVectorSharedPtr current_hosts_copy(new HostVector(host_set.hosts()));
 
   HostVector hosts_added;
   HostVector hosts_removed;
+  HostVector hosts_with_changed_health;
   // We need to trigger updateHosts with the new host vectors if they have changed. We also do this
   // when the locality weight map or the overprovisioning factor. Note calling updateDynamicHostList
   // is responsible for both determining whether there was a change and to perform the actual update
@@ -428,13 +508,25 @@ bool EdsClusterImpl::updateHostsPerLocality(
   // performance implications, since this has the knock on effect that we rebuild the load balancers
   // and locality scheduler. See the comment in BaseDynamicClusterImpl::updateDynamicHostList
   // about this. In the future we may need to do better here.
-  const bool hosts_updated = updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added,
-                                                   hosts_removed, all_hosts, all_new_hosts);
-  if (hosts_updated || host_set.weightedPriorityHealth() != weighted_priority_health ||
-      host_set.overprovisioningFactor() != overprovisioning_factor ||
-      locality_weights_map != new_locality_weights_map) {
+  const bool hosts_updated =
+      updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added, hosts_removed, all_hosts,
+                            all_new_hosts, incremental ? &hosts_with_changed_health : nullptr);
+  const bool priority_updated = host_set.weightedPriorityHealth() != weighted_priority_health ||
+                                host_set.overprovisioningFactor() != overprovisioning_factor ||
+                                locality_weights_map != new_locality_weights_map;
+  if (hosts_updated || priority_updated) {
     ASSERT(std::all_of(current_hosts_copy->begin(), current_hosts_copy->end(),
                        [&](const auto& host) { return host->priority() == priority; }));
+    // When only the hosts changed, apply them as a delta to the host set, unless the delta
+    // changes its localities.
+    if (incremental && !priority_updated &&
+        priority_state_manager.updateClusterPrioritySetDelta(
+            priority, current_hosts_copy, hosts_added, hosts_removed, hosts_with_changed_health)) {
+      ENVOY_LOG(debug, "EDS hosts changed for cluster: {} current hosts {} priority {}",
+                info_->name(), host_set.hosts().size(), host_set.priority());
+      info_->configUpdateStats().update_incremental_.inc();
+      return true;
+    }
     locality_weights_map = new_locality_weights_map;
     ENVOY_LOG(debug,
               "EDS hosts or locality weights changed for cluster: {} current hosts {} priority {}",
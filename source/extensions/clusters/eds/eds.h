@@ -62,7 +62,8 @@ private:
                               LocalityWeightsMap& new_locality_weights_map,
                               PriorityStateManager& priority_state_manager,
                               const HostMap& all_hosts,
-                              const absl::flat_hash_set<std::string>& all_new_hosts);
+                              const absl::flat_hash_set<std::string>& all_new_hosts,
+                              bool incremental);
   bool validateUpdateSize(int num_resources);
   const std::string& edsServiceName() const {
     const std::string& name = info_->edsServiceName();
@@ -76,13 +77,20 @@ private:
   void onCachedResourceRemoved(absl::string_view resource_name) override;
 
   // ClusterImplBase
-  void reloadHealthyHostsHelper(const HostSharedPtr& host) override;
+  void reloadHealthyHostsHelper(const HostVector& hosts) override;
   void startPreInit() override;
   void onAssignmentTimeout();
 
   // Returns true iff all the LEDS based localities were updated.
   bool validateAllLedsUpdated() const;
 
+  // A host reused across updates, and the serialized endpoint it was created from. The endpoint is
+  // compared when looking the host up by hash, as hashes may collide.
+  struct EndpointHost {
+    std::string endpoint_;
+    HostSharedPtr host_;
+  };
+
   class BatchUpdateHelper : public PrioritySet::BatchUpdateCb {
   public:
     BatchUpdateHelper(
@@ -99,9 +107,18 @@ private:
         const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
         PriorityStateManager& priority_state_manager,
         absl::flat_hash_set<std::string>& all_new_hosts);
+    // Registers the host of an endpoint that is unchanged since the last update, if any, and
+    // returns whether it did. The endpoint is given serialized.
+    bool reuseLocalityEndpoint(
+        uint64_t endpoint_hash, const std::string& endpoint,
+        const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+        PriorityStateManager& priority_state_manager, const HostMap& all_hosts,
+        absl::flat_hash_set<std::string>& all_new_hosts);
 
     EdsClusterImpl& parent_;
     const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment_;
+    // The hosts registered by this update, by the hash of their endpoint.
+    absl::flat_hash_map<uint64_t, EndpointHost> new_hosts_by_endpoint_hash_;
   };
 
   Config::SubscriptionPtr subscription_;
@@ -127,6 +144,12 @@ private:
 
   // Tracks whether a cached resource is used as the current EDS resource.
   bool using_cached_resource_{false};
+
+  // The hosts of the last update, by the hash of their endpoint, its locality and priority. An
+  // endpoint with the same hash in the next update reuses the host rather than creating a new one,
+  // as long as it is also equal to what the host was created from. Only populated when the
+  // envoy.reloadable_features.eds_incremental_updates runtime guard is enabled.
+  absl::flat_hash_map<uint64_t, EndpointHost> hosts_by_endpoint_hash_;
 };
 
 using EdsClusterImplSharedPtr = std::shared_ptr<EdsClusterImpl>;
@@ -1,5 +1,6 @@
 #include "source/extensions/clusters/redis/redis_cluster.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
@@ -198,15 +199,17 @@ void RedisCluster::onClusterSlotUpdate(ClusterSlotsSharedPtr&& slots) {
   onPreInitComplete();
 }
 
-void RedisCluster::reloadHealthyHostsHelper(const Upstream::HostSharedPtr& host) {
+void RedisCluster::reloadHealthyHostsHelper(const Upstream::HostVector& hosts) {
   if (lb_factory_) {
     lb_factory_->onHostHealthUpdate();
   }
-  if (host && (host->coarseHealth() == Upstream::Host::Health::Degraded ||
-               host->coarseHealth() == Upstream::Host::Health::Unhealthy)) {
+  if (std::any_of(hosts.begin(), hosts.end(), [](const Upstream::HostSharedPtr& host) {
+        return host->coarseHealth() == Upstream::Host::Health::Degraded ||
+               host->coarseHealth() == Upstream::Host::Health::Unhealthy;
+      })) {
     refresh_manager_->onHostDegraded(cluster_name_);
   }
-  ClusterImplBase::reloadHealthyHostsHelper(host);
+  ClusterImplBase::reloadHealthyHostsHelper(hosts);
 }
 
 // DnsDiscoveryResolveTarget
@@ -136,7 +136,7 @@ private:
 
   void onClusterSlotUpdate(ClusterSlotsSharedPtr&&);
 
-  void reloadHealthyHostsHelper(const Upstream::HostSharedPtr& host) override;
+  void reloadHealthyHostsHelper(const Upstream::HostVector& hosts) override;
 
   const envoy::config::endpoint::v3::LocalityLbEndpoints& localityLbEndpoint() const {
     // Always use the first endpoint.
@@ -236,6 +236,8 @@ private:
     bool enableRedirection() const override { return false; }
     uint32_t maxBufferSizeBeforeFlush() const override { return 0; }
     std::chrono::milliseconds bufferFlushTimeoutInMs() const override { return buffer_timeout_; }
+    bool flushPerEventLoopIteration() const override { return false; }
+    uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
     uint32_t maxUpstreamUnknownConnections() const override { return 0; }
     bool enableCommandStats() const override { return true; }
     bool connectionRateLimitEnabled() const override { return false; }
@@ -2,10 +2,13 @@
 
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/config/decoded_resource_impl.h"
 #include "source/common/config/utility.h"
+#include "source/common/config/xds_decoding_pool.h"
 #include "source/common/memory/utils.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/utility.h"
 #include "source/extensions/config_subscription/grpc/eds_resources_cache_impl.h"
 #include "source/extensions/config_subscription/grpc/xds_source_id.h"
 
@@ -60,7 +63,7 @@ std::string convertToWildcard(const std::string& resource_name) {
 } // namespace
 
 GrpcMuxImpl::GrpcMuxImpl(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node)
-    : dispatcher_(grpc_mux_context.dispatcher_),
+    : dispatcher_(grpc_mux_context.dispatcher_), scope_(grpc_mux_context.scope_),
       grpc_stream_(createGrpcStreamObject(std::move(grpc_mux_context.async_client_),
                                           std::move(grpc_mux_context.failover_async_client_),
                                           grpc_mux_context.service_method_, grpc_mux_context.scope_,
@@ -144,7 +147,15 @@ GrpcMuxImpl::createGrpcStreamObject(Grpc::RawAsyncClientSharedPtr&& async_client
           envoy::service::discovery::v3::DiscoveryResponse>::ConnectedStateValue::FirstEntry);
 }
 
-GrpcMuxImpl::~GrpcMuxImpl() { AllMuxes::get().erase(this); }
+GrpcMuxImpl::~GrpcMuxImpl() {
+  // The decoding threads may hold on to the pending responses after the mux is gone.
+  for (const auto& pending : pending_responses_) {
+    if (pending->same_type_resume_ != nullptr) {
+      pending->same_type_resume_->cancel();
+    }
+  }
+  AllMuxes::get().erase(this);
+}
 
 void GrpcMuxImpl::shutdownAll() { AllMuxes::get().shutdownAll(); }
 
@@ -380,53 +391,154 @@ void GrpcMuxImpl::onDiscoveryResponse(
     }
   }
 
-  if (api_state.watches_.empty()) {
-    // update the nonce as we are processing this response.
-    api_state.request_.set_response_nonce(message->nonce());
-    if (message->resources().empty()) {
-      // No watches and no resources. This can happen when envoy unregisters from a
-      // resource that's removed from the server as well. For example, a deleted cluster
-      // triggers un-watching the ClusterLoadAssignment watch, and at the same time the
-      // xDS server sends an empty list of ClusterLoadAssignment resources. we'll accept
-      // this update. no need to send a discovery request, as we don't watch for anything.
-      api_state.request_.set_version_info(message->version_info());
-    } else {
-      // No watches and we have resources - this should not happen. send a NACK (by not
-      // updating the version).
-      ENVOY_LOG(warn, "Ignoring unwatched type URL {}", type_url);
-      queueDiscoveryRequest(type_url);
+  if (XdsDecodingPoolSingleton::getExisting() != nullptr) {
+    pending_responses_.push_back(std::make_shared<PendingResponse>(std::move(message)));
+    if (pending_responses_.size() == 1) {
+      decodeNextResponse();
     }
     return;
   }
+
+  if (!checkWatchedResponse(*message, api_state)) {
+    return;
+  }
   ScopedResume same_type_resume;
   // We pause updates of the same type. This is necessary for SotW and GrpcMuxImpl, since unlike
   // delta and NewGRpcMuxImpl, independent watch additions/removals trigger updates regardless of
   // the delta state. The proper fix for this is to converge these implementations,
   // see https://github.com/envoyproxy/envoy/issues/11477.
   same_type_resume = pause(type_url);
-  TRY_ASSERT_MAIN_THREAD {
-    std::vector<DecodedResourcePtr> resources;
-    OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+  prepareDecodedResources(api_state);
+  applyDiscoveryResponse(
+      *message, api_state, [this, &message, &api_state](std::vector<DecodedResourcePtr>& resources) {
+        const DecodeStats& decode_stats = decodeStats(api_state, message->type_url());
+        const MonotonicTime decode_start = dispatcher_.timeSource().monotonicTime();
+        decodeResources(*message, 0, message->resources_size(),
+                        *api_state.watches_.front()->resource_decoder_,
+                        api_state.request_.version_info(), api_state.decoded_resources_.get(),
+                        decode_stats, resources);
+        decode_stats.decode_duration_us_->recordValue(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                dispatcher_.timeSource().monotonicTime() - decode_start)
+                .count());
+      });
+}
 
-    for (const auto& resource : message->resources()) {
-      // TODO(snowp): Check the underlying type when the resource is a Resource.
-      if (!resource.Is<envoy::service::discovery::v3::Resource>() &&
-          type_url != resource.type_url()) {
-        throw EnvoyException(
-            fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
-                        resource.type_url(), type_url, message->DebugString()));
+void GrpcMuxImpl::decodeResources(const envoy::service::discovery::v3::DiscoveryResponse& message,
+                                  int begin, int end, OpaqueResourceDecoder& resource_decoder,
+                                  const std::string& current_version,
+                                  const DecodedResourceCache* decoded_resources,
+                                  const DecodeStats& decode_stats,
+                                  std::vector<DecodedResourcePtr>& resources) {
+  const std::string& type_url = message.type_url();
+  uint64_t decoded = 0;
+  uint64_t unchanged = 0;
+  Cleanup add_stats([&decode_stats, &decoded, &unchanged]() {
+    decode_stats.resources_decoded_->add(decoded);
+    decode_stats.resources_unchanged_->add(unchanged);
+  });
+  for (int i = begin; i < end; ++i) {
+    const Protobuf::Any& resource = message.resources(i);
+    uint64_t hash = 0;
+    if (decoded_resources != nullptr) {
+      // Identical bytes decode to an identical resource, so the one decoded for an earlier
+      // response can be reused, skipping unpacking and validation.
+      hash = HashUtil::xxHash64(resource.value(), HashUtil::xxHash64(resource.type_url()));
+      const auto it = decoded_resources->find(hash);
+      if (it != decoded_resources->end() && it->second->value_ == resource.value() &&
+          it->second->type_url_ == resource.type_url()) {
+        resources.emplace_back(
+            std::make_unique<CachedDecodedResource>(hash, it->second, message.version_info()));
+        ++unchanged;
+        continue;
       }
+    }
+    // TODO(snowp): Check the underlying type when the resource is a Resource.
+    if (!resource.Is<envoy::service::discovery::v3::Resource>() &&
+        type_url != resource.type_url()) {
+      throw EnvoyException(
+          fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
+                      resource.type_url(), type_url, message.DebugString()));
+    }
 
-      auto decoded_resource = THROW_OR_RETURN_VALUE(
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info()),
-          DecodedResourceImplPtr);
+    auto decoded_resource = THROW_OR_RETURN_VALUE(
+        DecodedResourceImpl::fromResource(resource_decoder, resource, message.version_info()),
+        DecodedResourceImplPtr);
+    ++decoded;
+
+    if (decoded_resources != nullptr && decoded_resource->hasResource()) {
+      resources.emplace_back(std::make_unique<CachedDecodedResource>(
+          hash,
+          std::make_shared<const DecodedResourceCacheEntry>(DecodedResourceCacheEntry{
+              resource.type_url(), resource.value(), std::move(decoded_resource)}),
+          message.version_info()));
+    } else if (decoded_resource->hasResource() ||
+               decoded_resource->version() != current_version) {
+      // Heartbeats carry no resource, and the version that was already accepted.
+      resources.emplace_back(std::move(decoded_resource));
+    }
+  }
+}
 
-      if (!isHeartbeatResource(type_url, *decoded_resource)) {
-        resources.emplace_back(std::move(decoded_resource));
-      }
+void GrpcMuxImpl::prepareDecodedResources(ApiState& api_state) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.xds_reuse_unchanged_resources")) {
+    api_state.decoded_resources_.reset();
+  } else if (api_state.decoded_resources_ == nullptr) {
+    api_state.decoded_resources_ = std::make_shared<const DecodedResourceCache>();
+  }
+}
+
+void GrpcMuxImpl::updateDecodedResources(ApiState& api_state,
+                                         const std::vector<DecodedResourcePtr>& resources) {
+  if (api_state.decoded_resources_ == nullptr) {
+    return;
+  }
+  // Only the resources of the last response are kept, so that the resources removed by the
+  // control plane are not held on to.
+  auto decoded_resources = std::make_shared<DecodedResourceCache>();
+  decoded_resources->reserve(resources.size());
+  for (const auto& resource : resources) {
+    const auto* cached = dynamic_cast<const CachedDecodedResource*>(resource.get());
+    if (cached != nullptr) {
+      decoded_resources->emplace(cached->hash(), cached->entry());
     }
+  }
+  api_state.decoded_resources_ = std::move(decoded_resources);
+}
 
-    processDiscoveryResources(resources, api_state, type_url, message->version_info(),
+bool GrpcMuxImpl::checkWatchedResponse(
+    const envoy::service::discovery::v3::DiscoveryResponse& message, ApiState& api_state) {
+  if (!api_state.watches_.empty()) {
+    return true;
+  }
+  // update the nonce as we are processing this response.
+  api_state.request_.set_response_nonce(message.nonce());
+  if (message.resources().empty()) {
+    // No watches and no resources. This can happen when envoy unregisters from a
+    // resource that's removed from the server as well. For example, a deleted cluster
+    // triggers un-watching the ClusterLoadAssignment watch, and at the same time the
+    // xDS server sends an empty list of ClusterLoadAssignment resources. we'll accept
+    // this update. no need to send a discovery request, as we don't watch for anything.
+    api_state.request_.set_version_info(message.version_info());
+  } else {
+    // No watches and we have resources - this should not happen. send a NACK (by not
+    // updating the version).
+    ENVOY_LOG(warn, "Ignoring unwatched type URL {}", message.type_url());
+    queueDiscoveryRequest(message.type_url());
+  }
+  return false;
+}
+
+void GrpcMuxImpl::applyDiscoveryResponse(
+    const envoy::service::discovery::v3::DiscoveryResponse& message, ApiState& api_state,
+    const std::function<void(std::vector<DecodedResourcePtr>&)>& decode) {
+  const std::string& type_url = message.type_url();
+  TRY_ASSERT_MAIN_THREAD {
+    std::vector<DecodedResourcePtr> resources;
+    decode(resources);
+    updateDecodedResources(api_state, resources);
+
+    processDiscoveryResources(resources, api_state, type_url, message.version_info(),
                               /*call_delegate=*/true);
 
     // Processing point when resources are successfully ingested.
@@ -446,15 +558,118 @@ void GrpcMuxImpl::onDiscoveryResponse(
 
     // Processing point when there is any exception during the parse and ingestion process.
     if (xds_config_tracker_.has_value()) {
-      xds_config_tracker_->onConfigRejected(*message, error_detail->message());
+      xds_config_tracker_->onConfigRejected(message, error_detail->message());
     }
   }
   api_state.previously_fetched_data_ = true;
-  api_state.request_.set_response_nonce(message->nonce());
+  api_state.request_.set_response_nonce(message.nonce());
   ASSERT(api_state.paused());
   queueDiscoveryRequest(type_url);
 }
 
+void GrpcMuxImpl::decodeNextResponse() {
+  while (!pending_responses_.empty()) {
+    PendingResponseSharedPtr pending = pending_responses_.front();
+    const envoy::service::discovery::v3::DiscoveryResponse& message = *pending->message_;
+    ApiState& api_state = apiStateFor(message.type_url());
+    XdsDecodingPool* pool = XdsDecodingPoolSingleton::getExisting();
+    if (!checkWatchedResponse(message, api_state)) {
+      pending_responses_.pop_front();
+      continue;
+    }
+    // See onDiscoveryResponse() for why updates of the same type are paused.
+    pending->same_type_resume_ = pause(message.type_url());
+    if (pool == nullptr || message.resources().empty()) {
+      // Nothing to hand off, e.g. a response removing all the resources of a type.
+      applyDiscoveryResponse(message, api_state, [](std::vector<DecodedResourcePtr>&) {});
+      pending_responses_.pop_front();
+      continue;
+    }
+
+    // Split the resources evenly across the threads, in order, so that concatenating what each
+    // task decoded preserves the order of the response.
+    const int num_resources = message.resources_size();
+    const uint32_t num_tasks = std::min<uint32_t>(pool->concurrency(), num_resources);
+    pending->resource_decoder_ = api_state.watches_.front()->resource_decoder_;
+    pending->current_version_ = api_state.request_.version_info();
+    prepareDecodedResources(api_state);
+    pending->decoded_resources_ = api_state.decoded_resources_;
+    pending->decode_stats_ = decodeStats(api_state, message.type_url());
+    pending->decode_start_ = dispatcher_.timeSource().monotonicTime();
+    pending->resources_.resize(num_tasks);
+    pending->errors_.resize(num_tasks);
+    ENVOY_LOG(debug, "Decoding {} resources of {} on {} threads", num_resources,
+              message.type_url(), num_tasks);
+    pool->run(
+        num_tasks,
+        [pending, num_resources, num_tasks](uint32_t task) {
+          const int begin = static_cast<uint64_t>(num_resources) * task / num_tasks;
+          const int end = static_cast<uint64_t>(num_resources) * (task + 1) / num_tasks;
+          TRY_NEEDS_AUDIT {
+            decodeResources(*pending->message_, begin, end, *pending->resource_decoder_,
+                            pending->current_version_, pending->decoded_resources_.get(),
+                            pending->decode_stats_, pending->resources_[task]);
+          }
+          END_TRY
+          catch (const EnvoyException& e) {
+            pending->errors_[task] = e.what();
+          }
+        },
+        dispatcher_,
+        [this, still_alive = std::weak_ptr<bool>(still_alive_), pending]() {
+          if (!still_alive.expired()) {
+            onResponseDecoded(pending);
+          }
+        });
+    return;
+  }
+}
+
+void GrpcMuxImpl::onResponseDecoded(PendingResponseSharedPtr pending) {
+  if (pending_responses_.empty() || pending_responses_.front() != pending) {
+    // Superseded by a new stream.
+    return;
+  }
+  pending_responses_.pop_front();
+  const envoy::service::discovery::v3::DiscoveryResponse& message = *pending->message_;
+  ApiState& api_state = apiStateFor(message.type_url());
+  pending->decode_stats_.decode_duration_us_->recordValue(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          dispatcher_.timeSource().monotonicTime() - pending->decode_start_)
+          .count());
+  applyDiscoveryResponse(message, api_state, [&pending](std::vector<DecodedResourcePtr>& resources) {
+    for (const std::string& error : pending->errors_) {
+      if (!error.empty()) {
+        throw EnvoyException(error);
+      }
+    }
+    for (auto& task_resources : pending->resources_) {
+      std::move(task_resources.begin(), task_resources.end(), std::back_inserter(resources));
+    }
+  });
+  // Resume requests of the type before handing off the next response.
+  pending->same_type_resume_.reset();
+  decodeNextResponse();
+}
+
+const GrpcMuxImpl::DecodeStats& GrpcMuxImpl::decodeStats(ApiState& api_state,
+                                                         absl::string_view type_url) {
+  if (!api_state.decode_stats_.has_value()) {
+    // The message name of the type URL, e.g. "ClusterLoadAssignment".
+    const Stats::DynamicName type_name(type_url.substr(type_url.find_last_of("./") + 1));
+    const Stats::DynamicName prefix("control_plane");
+    api_state.decode_stats_ = DecodeStats{
+        Stats::HistogramSharedPtr(&Stats::Utility::histogramFromElements(
+            scope_, {prefix, Stats::DynamicName("decode_duration_us"), type_name},
+            Stats::Histogram::Unit::Microseconds)),
+        Stats::CounterSharedPtr(&Stats::Utility::counterFromElements(
+            scope_, {prefix, Stats::DynamicName("resources_decoded"), type_name})),
+        Stats::CounterSharedPtr(&Stats::Utility::counterFromElements(
+            scope_, {prefix, Stats::DynamicName("resources_unchanged"), type_name}))};
+  }
+  return *api_state.decode_stats_;
+}
+
 void GrpcMuxImpl::processDiscoveryResources(const std::vector<DecodedResourcePtr>& resources,
                                             ApiState& api_state, const std::string& type_url,
                                             const std::string& version_info,
@@ -566,6 +781,13 @@ void GrpcMuxImpl::onStreamEstablished() {
   grpc_stream_->maybeUpdateQueueSizeStat(0);
   clearNonce();
   request_queue_ = std::make_unique<std::queue<std::string>>();
+  // The responses of the previous stream that are yet to be applied are superseded by those the
+  // control plane sends on this one, which the requests below ask for.
+  for (const auto& pending : pending_responses_) {
+    apiStateFor(pending->message_->type_url()).pending_ = false;
+    pending->same_type_resume_.reset();
+  }
+  pending_responses_.clear();
   for (const auto& type_url : subscriptions_) {
     queueDiscoveryRequest(type_url);
   }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <queue>
 
@@ -29,6 +31,7 @@
 #include "source/extensions/config_subscription/grpc/grpc_mux_context.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_failover.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "xds/core/v3/resource_name.pb.h"
 
@@ -235,6 +238,61 @@ private:
     EdsResourcesCacheOptRef eds_resources_cache_;
   };
 
+  // A decoded resource along with the serialized resource it was decoded from, which is compared
+  // on a cache hit so that a hash collision cannot substitute another resource.
+  struct DecodedResourceCacheEntry {
+    std::string type_url_;
+    std::string value_;
+    DecodedResourcePtr resource_;
+  };
+  using DecodedResourceCacheEntrySharedPtr = std::shared_ptr<const DecodedResourceCacheEntry>;
+
+  // A decoded resource that is shared with the decoded resource cache of its type, so that it can
+  // be reused for identical resources of later responses. It has the version of the response it
+  // was received in, rather than the one it was decoded from.
+  class CachedDecodedResource : public DecodedResource {
+  public:
+    CachedDecodedResource(uint64_t hash, DecodedResourceCacheEntrySharedPtr entry,
+                          const std::string& version)
+        : hash_(hash), entry_(std::move(entry)), version_(version) {}
+
+    uint64_t hash() const { return hash_; }
+    const DecodedResourceCacheEntrySharedPtr& entry() const { return entry_; }
+
+    // Config::DecodedResource
+    const std::string& name() const override { return entry_->resource_->name(); }
+    const std::vector<std::string>& aliases() const override {
+      return entry_->resource_->aliases();
+    }
+    const std::string& version() const override { return version_; }
+    const Protobuf::Message& resource() const override { return entry_->resource_->resource(); }
+    bool hasResource() const override { return entry_->resource_->hasResource(); }
+    absl::optional<std::chrono::milliseconds> ttl() const override {
+      return entry_->resource_->ttl();
+    }
+    const OptRef<const envoy::config::core::v3::Metadata> metadata() const override {
+      return entry_->resource_->metadata();
+    }
+
+  private:
+    const uint64_t hash_;
+    const DecodedResourceCacheEntrySharedPtr entry_;
+    const std::string version_;
+  };
+
+  // The resources of the last decoded response of a type, by hash of their type URL and
+  // serialized bytes. It is immutable once built, as it may be read by the xDS decoding threads.
+  using DecodedResourceCache = absl::flat_hash_map<uint64_t, DecodedResourceCacheEntrySharedPtr>;
+  using DecodedResourceCacheSharedPtr = std::shared_ptr<const DecodedResourceCache>;
+
+  // Stats of decoding the resources of the responses of a type. The stats are referenced by the
+  // pending responses, which the xDS decoding threads may hold on to after the mux is gone.
+  struct DecodeStats {
+    Stats::HistogramSharedPtr decode_duration_us_;
+    Stats::CounterSharedPtr resources_decoded_;
+    Stats::CounterSharedPtr resources_unchanged_;
+  };
+
   // Per muxed API state.
   struct ApiState {
     ApiState(Event::Dispatcher& dispatcher,
@@ -261,12 +319,63 @@ private:
     std::string control_plane_identifier_{};
     // If true, xDS resources were previously fetched from an xDS source or an xDS delegate.
     bool previously_fetched_data_{false};
+    // Set on the first response.
+    absl::optional<DecodeStats> decode_stats_;
+    // Set if envoy.reloadable_features.xds_reuse_unchanged_resources is enabled.
+    DecodedResourceCacheSharedPtr decoded_resources_;
   };
 
-  bool isHeartbeatResource(const std::string& type_url, const DecodedResource& resource) {
-    return !resource.hasResource() &&
-           resource.version() == apiStateFor(type_url).request_.version_info();
-  }
+  // A response whose resources are decoded on the xDS decoding threads. Responses are applied in
+  // the order they are received, so only the one at the front of pending_responses_ is decoded at
+  // any time. It is shared with the decoding threads, which may outlive the mux.
+  struct PendingResponse {
+    explicit PendingResponse(
+        std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse>&& message)
+        : message_(std::move(message)) {}
+
+    std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse> message_;
+    // The decoder of the first watch, and the version accepted before this response.
+    OpaqueResourceDecoderSharedPtr resource_decoder_;
+    std::string current_version_;
+    DecodedResourceCacheSharedPtr decoded_resources_;
+    DecodeStats decode_stats_;
+    // Requests of the type are held back until the response has been applied.
+    ScopedResume same_type_resume_;
+    MonotonicTime decode_start_;
+    // The resources decoded by each task, and the first error of each, if any.
+    std::vector<std::vector<DecodedResourcePtr>> resources_;
+    std::vector<std::string> errors_;
+  };
+  using PendingResponseSharedPtr = std::shared_ptr<PendingResponse>;
+
+  // Decodes the resources of the message in [begin, end), skipping heartbeats. Resources found in
+  // decoded_resources, if set, are reused rather than decoded again. Throws an EnvoyException on
+  // the first resource that fails to decode. This may be called from the xDS decoding threads.
+  static void decodeResources(const envoy::service::discovery::v3::DiscoveryResponse& message,
+                              int begin, int end, OpaqueResourceDecoder& resource_decoder,
+                              const std::string& current_version,
+                              const DecodedResourceCache* decoded_resources,
+                              const DecodeStats& decode_stats,
+                              std::vector<DecodedResourcePtr>& resources);
+  // Prepares the decoded resource cache of the type for the next response.
+  static void prepareDecodedResources(ApiState& api_state);
+  // Replaces the decoded resource cache of the type with the resources of the last response.
+  static void updateDecodedResources(ApiState& api_state,
+                                     const std::vector<DecodedResourcePtr>& resources);
+  // Handles a response without watches. Returns false if the response needs no further
+  // processing.
+  bool checkWatchedResponse(const envoy::service::discovery::v3::DiscoveryResponse& message,
+                            ApiState& api_state);
+  // Applies the resources produced by decode, which throws an EnvoyException if they failed to
+  // decode, and ACKs or NACKs the response.
+  void applyDiscoveryResponse(const envoy::service::discovery::v3::DiscoveryResponse& message,
+                              ApiState& api_state,
+                              const std::function<void(std::vector<DecodedResourcePtr>&)>& decode);
+  // Hands the response at the front of pending_responses_ to the xDS decoding threads, applying
+  // those that need no decoding right away.
+  void decodeNextResponse();
+  void onResponseDecoded(PendingResponseSharedPtr pending);
+  const DecodeStats& decodeStats(ApiState& api_state, absl::string_view type_url);
   void expiryCallback(absl::string_view type_url, const std::vector<std::string>& expired);
   // Request queue management logic.
   void queueDiscoveryRequest(absl::string_view queue_item);
@@ -281,6 +390,7 @@ private:
                                  const std::string& version_info, bool call_delegate);
 
   Event::Dispatcher& dispatcher_;
+  Stats::Scope& scope_;
   // Multiplexes the stream to the primary and failover sources.
   // TODO(adisuissa): Once envoy.restart_features.xds_failover_support is deprecated,
   // convert from unique_ptr<GrpcStreamInterface> to GrpcMuxFailover directly.
@@ -312,6 +422,11 @@ private:
 
   Common::CallbackHandlePtr dynamic_update_callback_handle_;
 
+  // Responses waiting to be decoded on the xDS decoding threads, in the order they were received.
+  std::deque<PendingResponseSharedPtr> pending_responses_;
+  // Lets the decoding threads find out whether the mux is gone once a response is decoded.
+  std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
+
   bool started_{false};
   // True iff Envoy is shutting down; no messages should be sent on the `grpc_stream_` when this is
   // true because it may contain dangling pointers.
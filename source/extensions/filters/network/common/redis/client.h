@@ -161,6 +161,18 @@ public:
    */
   virtual std::chrono::milliseconds bufferFlushTimeoutInMs() const PURE;
 
+  /**
+   * @return when enabled and maxBufferSizeBeforeFlush() is zero, commands for a single upstream
+   * host are buffered until the end of the current event loop iteration and written together.
+   */
+  virtual bool flushPerEventLoopIteration() const PURE;
+
+  /**
+   * @return the minimum size of bulk strings which are decoded without copying, or zero if all
+   * bulk strings are copied. This applies both to downstream requests and to upstream responses.
+   */
+  virtual uint32_t zeroCopyMinBulkStringSize() const PURE;
+
   /**
    * @return the maximum number of upstream connections to unknown hosts when enableRedirection() is
    * true.
@@ -39,6 +39,8 @@ ConfigImpl::ConfigImpl(
           config, buffer_flush_timeout,
           3)), // Default timeout is 3ms. If max_buffer_size_before_flush is zero, this is not used
                // as the buffer is flushed on each request immediately.
+      flush_per_event_loop_iteration_(config.flush_per_event_loop_iteration()),
+      zero_copy_min_bulk_string_size_(config.zero_copy_min_bulk_string_size()),
       max_upstream_unknown_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_upstream_unknown_connections, 100)),
       enable_command_stats_(config.enable_command_stats()) {
@@ -139,6 +141,9 @@ ClientImpl::ClientImpl(
   traffic_stats.upstream_cx_active_.inc();
   host->stats().cx_active_.inc();
   connect_or_op_timer_->enableTimer(host->cluster().connectTimeout());
+  if (config_->flushPerEventLoopIteration() && config_->maxBufferSizeBeforeFlush() == 0) {
+    flush_cb_ = dispatcher.createSchedulableCallback([this]() { flushBufferAndResetTimer(); });
+  }
 }
 
 ClientImpl::~ClientImpl() {
@@ -154,6 +159,9 @@ void ClientImpl::flushBufferAndResetTimer() {
   if (flush_timer_->enabled()) {
     flush_timer_->disableTimer();
   }
+  if (flush_cb_ != nullptr) {
+    flush_cb_->cancel();
+  }
   connection_->write(encoder_buffer_, false);
 }
 
@@ -178,8 +186,14 @@ PoolRequest* ClientImpl::makeRequest(const RespValue& request, ClientCallbacks&
   // If we have enabled queuing (to pause AUTH while credentials are being used), don't flush our
   // buffers
   if (!queue_enabled_) {
-    // If buffer is full, flush. If the buffer was empty before the request, start the timer.
-    if (encoder_buffer_.length() >= config_->maxBufferSizeBeforeFlush()) {
+    // If batching per event loop iteration, all requests made in this iteration are written
+    // together once it completes. Otherwise, if buffer is full, flush. If the buffer was empty
+    // before the request, start the timer.
+    if (flush_cb_ != nullptr) {
+      if (!flush_cb_->enabled()) {
+        flush_cb_->scheduleCallbackCurrentIteration();
+      }
+    } else if (encoder_buffer_.length() >= config_->maxBufferSizeBeforeFlush()) {
       flushBufferAndResetTimer();
     } else if (empty_buffer) {
       flush_timer_->enableTimer(std::chrono::milliseconds(config_->bufferFlushTimeoutInMs()));
@@ -275,6 +289,9 @@ void ClientImpl::onEvent(Network::ConnectionEvent event) {
     }
 
     connect_or_op_timer_->disableTimer();
+    if (flush_cb_ != nullptr) {
+      flush_cb_->cancel();
+    }
   } else if (event == Network::ConnectionEvent::Connected) {
     connected_ = true;
     ASSERT(!pending_requests_.empty());
@@ -393,8 +410,9 @@ ClientPtr ClientFactoryImpl::create(
     absl::optional<Common::Redis::AwsIamAuthenticator::AwsIamAuthenticatorSharedPtr>
         aws_iam_authenticator) {
 
+  DecoderFactoryImpl decoder_factory(config->zeroCopyMinBulkStringSize());
   ClientPtr client =
-      ClientImpl::create(host, dispatcher, EncoderPtr{new EncoderImpl()}, decoder_factory_, config,
+      ClientImpl::create(host, dispatcher, EncoderPtr{new EncoderImpl()}, decoder_factory, config,
                          redis_command_stats, scope, is_transaction_client, auth_username,
                          aws_iam_config, aws_iam_authenticator);
 
@@ -50,6 +50,8 @@ public:
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return buffer_flush_timeout_;
   }
+  bool flushPerEventLoopIteration() const override { return flush_per_event_loop_iteration_; }
+  uint32_t zeroCopyMinBulkStringSize() const override { return zero_copy_min_bulk_string_size_; }
   uint32_t maxUpstreamUnknownConnections() const override {
     return max_upstream_unknown_connections_;
   }
@@ -64,6 +66,8 @@ private:
   const bool enable_redirection_;
   const uint32_t max_buffer_size_before_flush_;
   const std::chrono::milliseconds buffer_flush_timeout_;
+  const bool flush_per_event_loop_iteration_;
+  const uint32_t zero_copy_min_bulk_string_size_;
   const uint32_t max_upstream_unknown_connections_;
   const bool enable_command_stats_;
   ReadPolicy read_policy_;
@@ -171,6 +175,8 @@ private:
   Event::TimerPtr connect_or_op_timer_;
   bool connected_{};
   Event::TimerPtr flush_timer_;
+  // Only created if the buffer is flushed at the end of each event loop iteration.
+  Event::SchedulableCallbackPtr flush_cb_;
   Envoy::TimeSource& time_source_;
   const RedisCommandStatsSharedPtr redis_command_stats_;
   Stats::Scope& scope_;
@@ -194,9 +200,6 @@ public:
           aws_iam_authenticator) override;
 
   static ClientFactoryImpl instance_;
-
-private:
-  DecoderFactoryImpl decoder_factory_;
 };
 
 } // namespace Client
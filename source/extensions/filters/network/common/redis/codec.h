@@ -126,6 +126,16 @@ public:
   CompositeArray& asCompositeArray();
   const CompositeArray& asCompositeArray() const;
 
+  /**
+   * A BulkString may hold its data in a buffer instead of a string, so that large values can be
+   * decoded and encoded again without copying. The data is only copied into a string the first
+   * time asString() is called. Copies of the value share the buffer, which must therefore not be
+   * modified once the value is complete.
+   */
+  bool hasBuffer() const { return buffer_ != nullptr; }
+  Buffer::Instance& asBuffer();
+  const std::shared_ptr<Buffer::Instance>& sharedBuffer() const;
+
   /**
    * Get/set the type of the RespValue. A RespValue can only be a single type at a time. Each time
    * type() is called the type is changed and then the type specific as* methods can be used.
@@ -136,12 +146,15 @@ public:
 private:
   union {
     std::vector<RespValue> array_;
-    std::string string_;
+    // Mutable so that a buffer backed BulkString can be converted to a string on first access.
+    mutable std::string string_;
     int64_t integer_;
     CompositeArray composite_array_;
   };
+  mutable std::shared_ptr<Buffer::Instance> buffer_;
 
   void cleanup();
+  void bufferToString() const;
 
   RespType type_{};
 };
@@ -7,6 +7,7 @@
 
 #include "envoy/common/platform.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/utility.h"
@@ -18,6 +19,25 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace Common {
 namespace Redis {
+namespace {
+
+// A fragment referencing a slice of a buffer shared with a RespValue. Deletes itself once done.
+class SharedBufferFragment : public Buffer::BufferFragment {
+public:
+  SharedBufferFragment(std::shared_ptr<Buffer::Instance> buffer, const Buffer::RawSlice& slice)
+      : buffer_(std::move(buffer)), slice_(slice) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return slice_.mem_; }
+  size_t size() const override { return slice_.len_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<Buffer::Instance> buffer_;
+  const Buffer::RawSlice slice_;
+};
+
+} // namespace
 
 std::string RespValue::toString() const {
   switch (type_) {
@@ -45,7 +65,8 @@ std::string RespValue::toString() const {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error:
-    return fmt::format("\"{}\"", asString());
+    // Don't convert a buffer backed value to a string just for logging.
+    return fmt::format("\"{}\"", hasBuffer() ? buffer_->toString() : asString());
   case RespType::Null:
     return "null";
   case RespType::Integer:
@@ -68,15 +89,40 @@ const std::vector<RespValue>& RespValue::asArray() const {
 std::string& RespValue::asString() {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  bufferToString();
   return string_;
 }
 
 const std::string& RespValue::asString() const {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  bufferToString();
   return string_;
 }
 
+Buffer::Instance& RespValue::asBuffer() {
+  ASSERT(type_ == RespType::BulkString);
+  if (buffer_ == nullptr) {
+    buffer_ = std::make_shared<Buffer::OwnedImpl>(string_);
+    string_.clear();
+  }
+  // The buffer must not be modified once it is shared with copies or encoded buffers.
+  ASSERT(buffer_.use_count() == 1);
+  return *buffer_;
+}
+
+const std::shared_ptr<Buffer::Instance>& RespValue::sharedBuffer() const {
+  ASSERT(type_ == RespType::BulkString && buffer_ != nullptr);
+  return buffer_;
+}
+
+void RespValue::bufferToString() const {
+  if (buffer_ != nullptr) {
+    string_ = buffer_->toString();
+    buffer_.reset();
+  }
+}
+
 int64_t& RespValue::asInteger() {
   ASSERT(type_ == RespType::Integer);
   return integer_;
@@ -98,6 +144,7 @@ const RespValue::CompositeArray& RespValue::asCompositeArray() const {
 }
 
 void RespValue::cleanup() {
+  buffer_.reset();
   // Need to manually delete because of the union.
   switch (type_) {
   case RespType::Array: {
@@ -162,7 +209,11 @@ RespValue::RespValue(const RespValue& other) : type_(RespType::Null) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    if (other.hasBuffer()) {
+      buffer_ = other.buffer_;
+    } else {
+      string_ = other.string_;
+    }
     break;
   }
   case RespType::Integer: {
@@ -188,6 +239,7 @@ RespValue::RespValue(RespValue&& other) noexcept : type_(other.type_) {
   case RespType::BulkString:
   case RespType::Error: {
     new (&string_) std::string(std::move(other.string_));
+    buffer_ = std::move(other.buffer_);
     break;
   }
   case RespType::Integer: {
@@ -216,7 +268,11 @@ RespValue& RespValue::operator=(const RespValue& other) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    if (other.hasBuffer()) {
+      buffer_ = other.buffer_;
+    } else {
+      string_ = other.string_;
+    }
     break;
   }
   case RespType::Integer: {
@@ -248,6 +304,7 @@ RespValue& RespValue::operator=(RespValue&& other) noexcept {
   case RespType::BulkString:
   case RespType::Error: {
     string_ = std::move(other.string_);
+    buffer_ = std::move(other.buffer_);
     break;
   }
   case RespType::Integer: {
@@ -330,14 +387,68 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
-  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    parseSlice(slice);
+  if (zero_copy_min_bulk_string_size_ == 0) {
+    for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+      parseSlice(slice);
+    }
+
+    data.drain(data.length());
+    return;
   }
 
-  data.drain(data.length());
+  // Parse one slice at a time, as the body of a large bulk string is moved out of the data rather
+  // than parsed. parseSlice() stops at the start of such a body.
+  while (data.length() > 0) {
+    if (state_ == State::BulkStringBuffer) {
+      const uint64_t length = std::min(pending_integer_.integer_, data.length());
+      pending_value_stack_.front().value_->asBuffer().move(data, length);
+      pending_integer_.integer_ -= length;
+      if (pending_integer_.integer_ == 0) {
+        state_ = State::CR;
+      }
+      continue;
+    }
+
+    data.drain(parseSlice(data.frontSlice()));
+  }
 }
 
-void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
+bool DecoderImpl::decodeBulkString(const char*& buffer, uint64_t& remaining) {
+  ASSERT(remaining > 0 && buffer[0] == '$');
+  // Parse the length. Anything unusual, including null bulk strings, lengths which would overflow
+  // and values that are not fully contained in the slice, is left to the state machine.
+  constexpr uint64_t MaxLengthDigits = 18;
+  uint64_t length = 0;
+  uint64_t pos = 1;
+  while (pos < remaining && buffer[pos] >= '0' && buffer[pos] <= '9') {
+    if (pos > MaxLengthDigits) {
+      return false;
+    }
+    length = length * 10 + (buffer[pos] - '0');
+    pos++;
+  }
+  if (pos == 1 || pos + 1 >= remaining || buffer[pos] != '\r' || buffer[pos + 1] != '\n') {
+    return false;
+  }
+  if (zero_copy_min_bulk_string_size_ > 0 && length >= zero_copy_min_bulk_string_size_) {
+    return false;
+  }
+  const uint64_t body = pos + 2;
+  if (length > remaining - body || remaining - body - length < 2 ||
+      buffer[body + length] != '\r' || buffer[body + length + 1] != '\n') {
+    return false;
+  }
+
+  RespValuePtr value = std::make_unique<RespValue>();
+  value->type(RespType::BulkString);
+  value->asString().assign(buffer + body, length);
+  buffer += body + length + 2;
+  remaining -= body + length + 2;
+  callbacks_.onRespValue(std::move(value));
+  return true;
+}
+
+uint64_t DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
   const char* buffer = reinterpret_cast<const char*>(slice.mem_);
   uint64_t remaining = slice.len_;
 
@@ -346,6 +457,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     switch (state_) {
     case State::ValueRootStart: {
       ENVOY_LOG(trace, "parse slice: ValueRootStart");
+      // Fast path for the most common reply: a bulk string which is fully contained in the slice
+      // is decoded directly, without going through the per character state machine.
+      if (buffer[0] == '$' && decodeBulkString(buffer, remaining)) {
+        break;
+      }
       pending_value_root_ = std::make_unique<RespValue>();
       pending_value_stack_.push_front({pending_value_root_.get(), 0});
       const char c = buffer[0];
@@ -650,7 +766,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
         state_ = State::ValueComplete;
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
-        if (!pending_integer_.negative_) {
+        if (!pending_integer_.negative_ && zero_copy_min_bulk_string_size_ > 0 &&
+            pending_integer_.integer_ >= zero_copy_min_bulk_string_size_) {
+          current_value.value_->asBuffer();
+          state_ = State::BulkStringBuffer;
+        } else if (!pending_integer_.negative_) {
           // TODO(mattklein123): reserve and define max length since we don't stream currently.
           state_ = State::BulkStringBody;
         } else {
@@ -681,6 +801,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       break;
     }
 
+    case State::BulkStringBuffer: {
+      // The body is moved into the value's buffer by decode().
+      return slice.len_ - remaining;
+    }
+
     case State::CR: {
       ENVOY_LOG(trace, "parse slice: CR");
       if (buffer[0] != '\r') {
@@ -740,6 +865,8 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     }
     }
   }
+
+  return slice.len_;
 }
 
 void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
@@ -757,7 +884,11 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
     break;
   }
   case RespType::BulkString: {
-    encodeBulkString(value.asString(), out);
+    if (value.hasBuffer()) {
+      encodeBulkStringBuffer(value.sharedBuffer(), out);
+    } else {
+      encodeBulkString(value.asString(), out);
+    }
     break;
   }
   case RespType::Error: {
@@ -814,6 +945,23 @@ void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance&
   out.add("\r\n", 2);
 }
 
+void EncoderImpl::encodeBulkStringBuffer(const std::shared_ptr<Buffer::Instance>& buffer,
+                                         Buffer::Instance& out) {
+  char header[32];
+  char* current = header;
+  *current++ = '$';
+  current += StringUtil::itoa(current, 21, buffer->length());
+  *current++ = '\r';
+  *current++ = '\n';
+  out.add(header, current - header);
+  // Reference the slices of the value rather than copying them. Each fragment keeps the buffer
+  // alive until it has been drained from the output.
+  for (const Buffer::RawSlice& slice : buffer->getRawSlices()) {
+    out.addBufferFragment(*new SharedBufferFragment(buffer, slice));
+  }
+  out.add("\r\n", 2);
+}
+
 void EncoderImpl::encodeError(const std::string& string, Buffer::Instance& out) {
   out.add("-", 1);
   out.add(string);
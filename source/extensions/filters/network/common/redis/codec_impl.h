@@ -21,7 +21,14 @@ namespace Redis {
  */
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::redis> {
 public:
-  DecoderImpl(DecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+  /**
+   * @param callbacks supplies the callbacks for decoded values.
+   * @param zero_copy_min_bulk_string_size supplies the minimum size of a bulk string which is
+   *        decoded into a buffer referencing the slices of the decoded data, see
+   *        RespValue::asBuffer(). If zero, all bulk strings are copied into a string.
+   */
+  DecoderImpl(DecoderCallbacks& callbacks, uint64_t zero_copy_min_bulk_string_size = 0)
+      : callbacks_(callbacks), zero_copy_min_bulk_string_size_(zero_copy_min_bulk_string_size) {}
 
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
@@ -34,6 +41,7 @@ private:
     Integer,
     IntegerLF,
     BulkStringBody,
+    BulkStringBuffer,
     CR,
     LF,
     SimpleString,
@@ -63,9 +71,18 @@ private:
     uint64_t current_array_element_;
   };
 
-  void parseSlice(const Buffer::RawSlice& slice);
+  /**
+   * Decode a root bulk string value that is fully contained in the remaining part of a slice and
+   * dispatch it to the callbacks.
+   * @param buffer supplies the start of the value. Advanced past the value on success.
+   * @param remaining supplies the number of bytes left in the slice. Reduced on success.
+   * @return true if the value was decoded, false if it must be decoded by the state machine.
+   */
+  bool decodeBulkString(const char*& buffer, uint64_t& remaining);
+  uint64_t parseSlice(const Buffer::RawSlice& slice);
 
   DecoderCallbacks& callbacks_;
+  const uint64_t zero_copy_min_bulk_string_size_;
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
@@ -77,10 +94,16 @@ private:
  */
 class DecoderFactoryImpl : public DecoderFactory {
 public:
+  DecoderFactoryImpl(uint64_t zero_copy_min_bulk_string_size = 0)
+      : zero_copy_min_bulk_string_size_(zero_copy_min_bulk_string_size) {}
+
   // RedisProxy::DecoderFactory
   DecoderPtr create(DecoderCallbacks& callbacks) override {
-    return DecoderPtr{new DecoderImpl(callbacks)};
+    return DecoderPtr{new DecoderImpl(callbacks, zero_copy_min_bulk_string_size_)};
   }
+
+private:
+  const uint64_t zero_copy_min_bulk_string_size_;
 };
 
 /**
@@ -95,6 +118,8 @@ private:
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
+  void encodeBulkStringBuffer(const std::shared_ptr<Buffer::Instance>& buffer,
+                              Buffer::Instance& out);
   void encodeError(const std::string& string, Buffer::Instance& out);
   void encodeInteger(int64_t integer, Buffer::Instance& out);
   void encodeSimpleString(const std::string& string, Buffer::Instance& out);
@@ -131,10 +131,12 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto has_external_auth_provider_ = proto_config.has_external_auth_provider();
   auto grpc_service = proto_config.external_auth_provider().grpc_service();
   auto timeout_ms = PROTOBUF_GET_MS_OR_DEFAULT(grpc_service, timeout, 200);
+  const uint32_t zero_copy_min_bulk_string_size =
+      proto_config.settings().zero_copy_min_bulk_string_size();
 
-  return [has_external_auth_provider_, grpc_service, &context, splitter, filter_config,
-          timeout_ms](Network::FilterManager& filter_manager) -> void {
-    Common::Redis::DecoderFactoryImpl decoder_factory;
+  return [has_external_auth_provider_, grpc_service, &context, splitter, filter_config, timeout_ms,
+          zero_copy_min_bulk_string_size](Network::FilterManager& filter_manager) -> void {
+    Common::Redis::DecoderFactoryImpl decoder_factory(zero_copy_min_bulk_string_size);
 
     ExternalAuth::ExternalAuthClientPtr&& auth_client{nullptr};
     if (has_external_auth_provider_) {
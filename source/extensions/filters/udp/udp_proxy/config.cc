@@ -163,6 +163,18 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
     flush_access_log_on_tunnel_connected_ = false;
   }
 
+  if (config.has_upstream_udp_packet_writer_config()) {
+    auto& factory_factory =
+        Config::Utility::getAndCheckFactory<Network::UdpPacketWriterFactoryFactory>(
+            config.upstream_udp_packet_writer_config());
+    upstream_writer_factory_ =
+        factory_factory.createUdpPacketWriterFactory(config.upstream_udp_packet_writer_config());
+    if (upstream_writer_factory_ == nullptr) {
+      throw EnvoyException(fmt::format("UDP packet writer '{}' is not supported on this platform.",
+                                       config.upstream_udp_packet_writer_config().name()));
+    }
+  }
+
   for (const auto& filter : config.session_filters()) {
     ENVOY_LOG(debug, "    UDP session filter #{}", filter_factories_.size());
 
@@ -157,6 +157,9 @@ public:
     return access_log_flush_interval_;
   }
   Random::RandomGenerator& randomGenerator() const override { return random_generator_; }
+  Network::UdpPacketWriterFactory* upstreamPacketWriterFactory() const override {
+    return upstream_writer_factory_.get();
+  }
 
   // UdpSessionFilterChainFactory
   bool createFilterChain(Network::UdpSessionFilterChainFactoryCallbacks& callbacks) const override {
@@ -203,6 +206,7 @@ private:
       udp_session_filter_config_provider_manager_;
   UdpSessionFilterFactoriesList filter_factories_;
   Random::RandomGenerator& random_generator_;
+  Network::UdpPacketWriterFactoryPtr upstream_writer_factory_;
 };
 
 /**
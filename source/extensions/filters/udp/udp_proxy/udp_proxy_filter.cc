@@ -337,6 +337,17 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     : ActiveSession(filter, std::move(addresses), std::move(host)),
       use_original_src_ip_(filter_.config_->usingOriginalSrcIp()) {}
 
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() {
+  // Make a best effort attempt to send any datagrams still buffered by a batching writer.
+  if (upstream_flush_cb_ != nullptr && upstream_flush_cb_->enabled()) {
+    upstream_flush_cb_->cancel();
+    if (upstream_writer_->flush().ok()) {
+      cluster_->cluster_stats_.sess_tx_datagrams_.add(pending_tx_datagrams_);
+      cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(pending_tx_bytes_);
+    }
+  }
+}
+
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
 }
@@ -554,15 +565,67 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
             host_->address()->asStringView());
 
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
-  Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
-      udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
+  Api::IoCallUint64Result rc =
+      upstream_writer_ != nullptr
+          ? upstream_writer_->writePacket(*data.buffer_, local_ip, *host_->address())
+          : Network::Utility::writeToSocket(udp_socket_->ioHandle(), *data.buffer_, local_ip,
+                                            *host_->address());
 
   if (!rc.ok()) {
     cluster_->cluster_stats_.sess_tx_errors_.inc();
+  } else if (upstream_flush_cb_ != nullptr) {
+    // A batching writer only accepted the datagram. It is counted once the batch is sent.
+    ++pending_tx_datagrams_;
+    pending_tx_bytes_ += tx_buffer_length;
   } else {
     cluster_->cluster_stats_.sess_tx_datagrams_.inc();
     cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(tx_buffer_length);
   }
+
+  // A batching writer may hold on to the datagram. Flush once all datagrams received in the
+  // current event loop iteration have been written, so that they share a single syscall.
+  if (upstream_flush_cb_ != nullptr && !upstream_flush_cb_->enabled()) {
+    upstream_flush_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void UdpProxyFilter::UdpActiveSession::flushUpstream() {
+  ASSERT(upstream_writer_ != nullptr);
+  const Api::IoCallUint64Result rc = upstream_writer_->flush();
+  if (rc.ok()) {
+    cluster_->cluster_stats_.sess_tx_datagrams_.add(pending_tx_datagrams_);
+    cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(pending_tx_bytes_);
+    pending_tx_datagrams_ = 0;
+    pending_tx_bytes_ = 0;
+    return;
+  }
+
+  if (upstream_writer_->isWriteBlocked()) {
+    // The buffered datagrams are retained by the writer. Retry once the socket becomes writable.
+    ENVOY_LOG(trace, "upstream writer is blocked: downstream={} local={} upstream={}",
+              addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
+              host_->address()->asStringView());
+    udp_socket_->ioHandle().enableFileEvents(Event::FileReadyType::Read |
+                                             Event::FileReadyType::Write);
+    return;
+  }
+
+  // The writer drops the buffered datagrams on any other error.
+  ENVOY_LOG(debug, "cannot flush {} upstream datagrams: {}", pending_tx_datagrams_,
+            rc.err_->getErrorDetails());
+  cluster_->cluster_stats_.sess_tx_errors_.inc();
+  pending_tx_datagrams_ = 0;
+  pending_tx_bytes_ = 0;
+}
+
+void UdpProxyFilter::UdpActiveSession::onWriteReady() {
+  udp_socket_->ioHandle().enableFileEvents(Event::FileReadyType::Read);
+  if (upstream_writer_ == nullptr) {
+    return;
+  }
+
+  upstream_writer_->setWritable();
+  flushUpstream();
 }
 
 bool UdpProxyFilter::ActiveSession::onContinueFilterChain(ActiveReadFilter* filter) {
@@ -633,12 +696,28 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
   udp_socket_ = filter_.createUdpSocket(host);
   udp_socket_->ioHandle().initializeFileEvent(
       filter_.read_callbacks_->udpListener().dispatcher(),
-      [this](uint32_t) {
-        onReadReady();
+      [this](uint32_t events) {
+        if (events & Event::FileReadyType::Write) {
+          onWriteReady();
+        }
+        if (events & Event::FileReadyType::Read) {
+          onReadReady();
+        }
         return absl::OkStatus();
       },
       Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
 
+  Network::UdpPacketWriterFactory* writer_factory = filter_.config_->upstreamPacketWriterFactory();
+  if (writer_factory != nullptr) {
+    upstream_writer_ = writer_factory->createUdpPacketWriter(
+        udp_socket_->ioHandle(), cluster_->cluster_info_->statsScope());
+    if (upstream_writer_->isBatchMode()) {
+      upstream_flush_cb_ =
+          filter_.read_callbacks_->udpListener().dispatcher().createSchedulableCallback(
+              [this]() { flushUpstream(); });
+    }
+  }
+
   ENVOY_LOG(debug, "creating new session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host->address()->asStringView());
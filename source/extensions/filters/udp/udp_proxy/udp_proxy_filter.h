@@ -9,6 +9,7 @@
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/http/header_evaluator.h"
 #include "envoy/network/filter.h"
+#include "envoy/network/udp_packet_writer_handler.h"
 #include "envoy/stream_info/stream_info.h"
 #include "envoy/stream_info/uint32_accessor.h"
 #include "envoy/upstream/cluster_manager.h"
@@ -140,6 +141,9 @@ public:
   virtual bool flushAccessLogOnTunnelConnected() const PURE;
   virtual const absl::optional<std::chrono::milliseconds>& accessLogFlushInterval() const PURE;
   virtual Random::RandomGenerator& randomGenerator() const PURE;
+  // Returns the factory used to create upstream packet writers, or nullptr if datagrams should be
+  // written to upstream sockets directly.
+  virtual Network::UdpPacketWriterFactory* upstreamPacketWriterFactory() const PURE;
 };
 
 using UdpProxyFilterConfigSharedPtr = std::shared_ptr<const UdpProxyFilterConfig>;
@@ -689,7 +693,7 @@ protected:
   public:
     UdpActiveSession(UdpProxyFilter& filter, Network::UdpRecvData::LocalPeerAddresses&& addresses,
                      const Upstream::HostConstSharedPtr& host);
-    ~UdpActiveSession() override = default;
+    ~UdpActiveSession() override;
 
     // ActiveSession
     bool shouldCreateUpstream() override;
@@ -725,12 +729,23 @@ protected:
 
   private:
     void onReadReady();
+    void onWriteReady();
     void createUdpSocket(const Upstream::HostConstSharedPtr& host);
+    void flushUpstream();
 
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
     // write to the upstream host.
     Network::SocketPtr udp_socket_;
+    // Optional writer for upstream datagrams. It references the socket's IO handle and so must be
+    // destroyed before udp_socket_. When the writer is in batch mode, datagrams written during an
+    // event loop iteration are buffered and flushed by upstream_flush_cb_ at the end of the
+    // iteration.
+    Network::UdpPacketWriterPtr upstream_writer_;
+    Event::SchedulableCallbackPtr upstream_flush_cb_;
+    // Datagrams and bytes accepted by a batching writer that have not been flushed yet.
+    uint64_t pending_tx_datagrams_{};
+    uint64_t pending_tx_bytes_{};
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
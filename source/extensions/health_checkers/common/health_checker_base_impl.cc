@@ -5,12 +5,100 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/empty_string.h"
+#include "source/common/common/hash.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/thread.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/router.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * Sessions sharing the probes of a host, in the order they subscribed. The first session probes the
+ * host and the results of its probes are applied to the other ones, which do not probe. All the
+ * sessions of a probe run on the same dispatcher, while the registry of the probes is shared by the
+ * dispatchers of the process.
+ */
+class HealthCheckerImplBase::SharedProbe {
+public:
+  explicit SharedProbe(const std::string& key) : key_(key) {}
+
+  ~SharedProbe() {
+    Registry& registry = getRegistry();
+    Thread::LockGuard lock(registry.lock_);
+    auto it = registry.probes_.find(key_);
+    // The key may already be used by another probe, subscribed to after this one expired.
+    if (it != registry.probes_.end() && it->second.expired()) {
+      registry.probes_.erase(it);
+    }
+  }
+
+  /**
+   * Subscribes a session to the probe of its key, which is created if there is none.
+   */
+  static std::shared_ptr<SharedProbe> subscribe(const std::string& key,
+                                                ActiveHealthCheckSession& session) {
+    std::shared_ptr<SharedProbe> probe;
+    {
+      Registry& registry = getRegistry();
+      Thread::LockGuard lock(registry.lock_);
+      std::weak_ptr<SharedProbe>& entry = registry.probes_[key];
+      probe = entry.lock();
+      if (probe == nullptr) {
+        probe = std::make_shared<SharedProbe>(key);
+        entry = probe;
+      }
+    }
+    probe->sessions_.push_back(&session);
+    return probe;
+  }
+
+  /**
+   * Unsubscribes a session. If it was probing the host, the next session takes over.
+   */
+  void unsubscribe(ActiveHealthCheckSession& session) {
+    const bool was_prober = isProber(session);
+    sessions_.remove(&session);
+    if (was_prober && !sessions_.empty()) {
+      ActiveHealthCheckSession& prober = *sessions_.front();
+      const HealthState state = prober.host_->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)
+                                    ? HealthState::Unhealthy
+                                    : HealthState::Healthy;
+      prober.interval_timer_->enableTimer(
+          prober.parent_.interval(state, HealthTransition::Unchanged));
+    }
+  }
+
+  bool isProber(const ActiveHealthCheckSession& session) const {
+    return !sessions_.empty() && sessions_.front() == &session;
+  }
+
+  /**
+   * @return the sessions not probing the host.
+   */
+  std::vector<ActiveHealthCheckSession*> subscribers() const {
+    return {std::next(sessions_.begin()), sessions_.end()};
+  }
+
+private:
+  struct Registry {
+    Thread::MutexBasicLockable lock_;
+    absl::flat_hash_map<std::string, std::weak_ptr<SharedProbe>> probes_ ABSL_GUARDED_BY(lock_);
+  };
+
+  static Registry& getRegistry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+  const std::string key_;
+  std::list<ActiveHealthCheckSession*> sessions_;
+};
+
 HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
                                              const envoy::config::core::v3::HealthCheck& config,
                                              Event::Dispatcher& dispatcher,
@@ -19,10 +107,11 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
                                              HealthCheckEventLoggerPtr&& event_logger)
     : always_log_health_check_failures_(config.always_log_health_check_failures()),
       always_log_health_check_success_(config.always_log_health_check_success()), cluster_(cluster),
-      dispatcher_(dispatcher), timeout_(PROTOBUF_GET_MS_REQUIRED(config, timeout)),
+      cluster_info_(cluster.info()), dispatcher_(dispatcher), main_thread_dispatcher_(&dispatcher),
+      timeout_(PROTOBUF_GET_MS_REQUIRED(config, timeout)),
       unhealthy_threshold_(PROTOBUF_GET_WRAPPED_REQUIRED(config, unhealthy_threshold)),
       healthy_threshold_(PROTOBUF_GET_WRAPPED_REQUIRED(config, healthy_threshold)),
-      stats_(generateStats(cluster.info()->statsScope())), runtime_(runtime), random_(random),
+      stats_(generateStats(cluster_info_->statsScope())), runtime_(runtime), random_(random),
       reuse_connection_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, reuse_connection, true)),
       event_logger_(std::move(event_logger)), interval_(PROTOBUF_GET_MS_REQUIRED(config, interval)),
       no_traffic_interval_(PROTOBUF_GET_MS_OR_DEFAULT(config, no_traffic_interval, 60000)),
@@ -39,11 +128,43 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
+      shared_probe_hash_(initSharedProbeHash(config)),
+      shared_probe_default_host_header_(initSharedProbeDefaultHostHeader(cluster, config)),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) {
-            onClusterMemberUpdate(hosts_added, hosts_removed);
+            setHostMonitors(hosts_added);
+            if (!onDedicatedThread()) {
+              onClusterMemberUpdate(hosts_added, hosts_removed);
+              return;
+            }
+            // Capturing this is safe as the health checker is deleted on its own thread, after
+            // any update posted to it before, see destroy().
+            dispatcher_.post([this, hosts_added, hosts_removed]() {
+              onClusterMemberUpdate(hosts_added, hosts_removed);
+            });
           })} {}
 
+void HealthCheckerImplBase::destroy(HealthCheckerImplBase* health_checker) {
+  if (!health_checker->onDedicatedThread() || health_checker->dispatcher_.isThreadSafe()) {
+    delete health_checker;
+    return;
+  }
+
+  // The cluster state is released here on the main thread, so that the sessions and their
+  // connections can be destroyed on the thread they were created on, once it has run what was
+  // already posted to it.
+  health_checker->member_update_cb_.reset();
+  health_checker->callbacks_.clear();
+  health_checker->dispatcher_.post([health_checker]() {
+    // The info of the cluster may outlive the cluster through the health checker only, in which
+    // case it is released back on the main thread, where it was created.
+    ClusterInfoConstSharedPtr cluster_info = health_checker->cluster_info_;
+    Event::Dispatcher& main_thread_dispatcher = *health_checker->main_thread_dispatcher_;
+    delete health_checker;
+    main_thread_dispatcher.post([cluster_info = std::move(cluster_info)]() {});
+  });
+}
+
 std::shared_ptr<const Network::TransportSocketOptionsImpl>
 HealthCheckerImplBase::initTransportSocketOptions(
     const envoy::config::core::v3::HealthCheck& config) {
@@ -71,6 +192,66 @@ MetadataConstSharedPtr HealthCheckerImplBase::initTransportSocketMatchMetadata(
   return nullptr;
 }
 
+absl::optional<uint64_t>
+HealthCheckerImplBase::initSharedProbeHash(const envoy::config::core::v3::HealthCheck& config) {
+  if (!config.share_probes()) {
+    return absl::nullopt;
+  }
+
+  // The thresholds and event logging only change how the results of the probes are applied to the
+  // hosts of each cluster.
+  envoy::config::core::v3::HealthCheck probe_config(config);
+  probe_config.clear_unhealthy_threshold();
+  probe_config.clear_healthy_threshold();
+  probe_config.clear_event_log_path();
+  probe_config.clear_event_logger();
+  probe_config.clear_event_service();
+  probe_config.clear_always_log_health_check_failures();
+  probe_config.clear_always_log_health_check_success();
+  return MessageUtil::hash(probe_config);
+}
+
+absl::optional<uint64_t>
+HealthCheckerImplBase::threadAffinity(const Cluster& cluster,
+                                      const envoy::config::core::v3::HealthCheck& config) {
+  const absl::optional<uint64_t> shared_probe_hash = initSharedProbeHash(config);
+  if (!shared_probe_hash.has_value()) {
+    return absl::nullopt;
+  }
+  // The host header is left out, as hosts with their own health check hostname may share their
+  // probes across clusters with different default host headers.
+  return HashUtil::xxHash64Value(cluster.info()->transportSocketConfigHash(), *shared_probe_hash);
+}
+
+absl::optional<std::string> HealthCheckerImplBase::initSharedProbeDefaultHostHeader(
+    const Cluster& cluster, const envoy::config::core::v3::HealthCheck& config) {
+  if (!config.share_probes() ||
+      (!config.has_http_health_check() && !config.has_grpc_health_check())) {
+    return absl::nullopt;
+  }
+  // The configured host header is part of the hash of the config. Without it, the host header of
+  // the probes defaults to the name of the cluster.
+  if ((config.has_http_health_check() && config.http_health_check().host().empty()) ||
+      (config.has_grpc_health_check() && config.grpc_health_check().authority().empty())) {
+    return cluster.info()->name();
+  }
+  return EMPTY_STRING;
+}
+
+std::string HealthCheckerImplBase::sharedProbeKey(const Host& host) const {
+  // The probes of hosts with their own health check hostname are sent with it as host header.
+  absl::string_view host_header;
+  if (shared_probe_default_host_header_.has_value()) {
+    host_header = host.hostnameForHealthChecks().empty() ? *shared_probe_default_host_header_
+                                                         : host.hostnameForHealthChecks();
+  }
+  // Probes are only shared on the dispatcher they run on, and when they are sent with the same
+  // transport socket, e.g. with the same SNI, and the same host header.
+  return absl::StrCat(reinterpret_cast<uintptr_t>(&dispatcher_), "_", *shared_probe_hash_, "_",
+                      cluster_info_->transportSocketConfigHash(), "_", host_header, "_",
+                      host.healthCheckAddress()->asString());
+}
+
 HealthCheckerImplBase::~HealthCheckerImplBase() {
   // First clear callbacks that otherwise will be run from
   // ActiveHealthCheckSession::onDeferredDeleteBase(). This prevents invoking a callback on a
@@ -105,7 +286,7 @@ std::chrono::milliseconds HealthCheckerImplBase::interval(HealthState state,
   // If a connection has been established, we choose an interval based on the host's health. Please
   // refer to the HealthCheck API documentation for more details.
   uint64_t base_time_ms;
-  if (cluster_.info()->trafficStats()->upstream_cx_total_.used()) {
+  if (cluster_info_->trafficStats()->upstream_cx_total_.used()) {
     // When healthy/unhealthy threshold is configured the health transition of a host will be
     // delayed. In this situation Envoy should use the edge interval settings between health checks.
     //
@@ -158,14 +339,24 @@ HealthCheckerImplBase::intervalWithJitter(uint64_t base_time_ms,
   return std::chrono::milliseconds(final_ms);
 }
 
+void HealthCheckerImplBase::setHostMonitors(const HostVector& hosts) {
+  // The monitors are set on the main thread, before the hosts are handed to the workers, even when
+  // the health checks run on another thread.
+  for (const HostSharedPtr& host : hosts) {
+    if (host->disableActiveHealthCheck()) {
+      continue;
+    }
+    host->setHealthChecker(
+        HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(weak_from_this(), host)});
+  }
+}
+
 void HealthCheckerImplBase::addHosts(const HostVector& hosts) {
   for (const HostSharedPtr& host : hosts) {
     if (host->disableActiveHealthCheck()) {
       continue;
     }
     active_sessions_[host] = makeSession(host);
-    host->setHealthChecker(
-        HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(shared_from_this(), host)});
     active_sessions_[host]->start();
   }
 }
@@ -188,11 +379,48 @@ void HealthCheckerImplBase::onClusterMemberUpdate(const HostVector& hosts_added,
 
 void HealthCheckerImplBase::runCallbacks(HostSharedPtr host, HealthTransition changed_state,
                                          HealthState current_check_result) {
+  if (onDedicatedThread()) {
+    // Transitions are batched until the main thread gets to run them. The health checker may be
+    // gone by then, in which case the cluster does not care about them anymore.
+    std::weak_ptr<HealthCheckerImplBase> weak_this = weak_from_this();
+    if (weak_this.expired()) {
+      return;
+    }
+    bool post;
+    {
+      Thread::LockGuard lock(pending_callbacks_lock_);
+      post = pending_callbacks_.empty();
+      pending_callbacks_.push_back({std::move(host), changed_state, current_check_result});
+    }
+    if (post) {
+      main_thread_dispatcher_->post([weak_this]() {
+        std::shared_ptr<HealthCheckerImplBase> shared_this = weak_this.lock();
+        if (shared_this != nullptr) {
+          shared_this->runPendingCallbacks();
+        }
+      });
+    }
+    return;
+  }
+
   for (const HostStatusCb& cb : callbacks_) {
     cb(host, changed_state, current_check_result);
   }
 }
 
+void HealthCheckerImplBase::runPendingCallbacks() {
+  std::vector<PendingCallback> pending_callbacks;
+  {
+    Thread::LockGuard lock(pending_callbacks_lock_);
+    pending_callbacks.swap(pending_callbacks_);
+  }
+  for (const PendingCallback& pending : pending_callbacks) {
+    for (const HostStatusCb& cb : callbacks_) {
+      cb(pending.host_, pending.changed_state_, pending.current_check_result_);
+    }
+  }
+}
+
 void HealthCheckerImplBase::HealthCheckHostMonitorImpl::setUnhealthy(UnhealthyType type) {
   // This is called cross thread. The cluster/health checker might already be gone.
   std::shared_ptr<HealthCheckerImplBase> health_checker = health_checker_.lock();
@@ -214,26 +442,50 @@ void HealthCheckerImplBase::setUnhealthyCrossThread(const HostSharedPtr& host,
   //    thread.
   // 2) On the main thread, we make sure it is still valid (as the cluster may have been destroyed).
   // 3) Additionally, the host/session may also be gone by then so we check that also.
+  // 4) When the health checks run on their own thread, we hop to it from the main thread. The
+  //    health checker is only deleted on that thread after this, see destroy().
   std::weak_ptr<HealthCheckerImplBase> weak_this = shared_from_this();
-  dispatcher_.post([weak_this, host]() -> void {
+  main_thread_dispatcher_->post([weak_this, host]() -> void {
     std::shared_ptr<HealthCheckerImplBase> shared_this = weak_this.lock();
     if (shared_this == nullptr) {
       return;
     }
 
-    const auto session = shared_this->active_sessions_.find(host);
-    if (session == shared_this->active_sessions_.end()) {
+    if (!shared_this->onDedicatedThread()) {
+      shared_this->onPassiveFailure(host);
       return;
     }
-
-    session->second->setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+    HealthCheckerImplBase* health_checker = shared_this.get();
+    health_checker->dispatcher_.post(
+        [health_checker, host]() { health_checker->onPassiveFailure(host); });
   });
 }
 
+void HealthCheckerImplBase::onPassiveFailure(const HostSharedPtr& host) {
+  const auto session = active_sessions_.find(host);
+  if (session == active_sessions_.end()) {
+    return;
+  }
+
+  session->second->setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+}
+
 void HealthCheckerImplBase::start() {
+  if (!onDedicatedThread()) {
+    for (auto& host_set : cluster_.prioritySet().hostSetsPerPriority()) {
+      setHostMonitors(host_set->hosts());
+      addHosts(host_set->hosts());
+    }
+    return;
+  }
+
+  // The hosts are read here, as the priority set is only accessed on the main thread.
+  HostVector hosts;
   for (auto& host_set : cluster_.prioritySet().hostSetsPerPriority()) {
-    addHosts(host_set->hosts());
+    hosts.insert(hosts.end(), host_set->hosts().begin(), host_set->hosts().end());
   }
+  setHostMonitors(hosts);
+  dispatcher_.post([this, hosts = std::move(hosts)]() { addHosts(hosts); });
 }
 
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
@@ -252,6 +504,16 @@ HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
   }
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::start() {
+  if (parent_.shared_probe_hash_.has_value()) {
+    shared_probe_ = SharedProbe::subscribe(parent_.sharedProbeKey(*host_), *this);
+    if (!shared_probe_->isProber(*this)) {
+      return;
+    }
+  }
+  onInitialInterval();
+}
+
 HealthCheckerImplBase::ActiveHealthCheckSession::~ActiveHealthCheckSession() {
   // Make sure onDeferredDeleteBase() has been called. We should not reference our parent at this
   // point since we may have been deferred deleted.
@@ -264,6 +526,10 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   // implementation specific state is destroyed.
   interval_timer_.reset();
   timeout_timer_.reset();
+  if (shared_probe_ != nullptr) {
+    shared_probe_->unsubscribe(*this);
+    shared_probe_.reset();
+  }
   if (!host_->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent_.decHealthy();
     state = HealthState::Healthy;
@@ -280,6 +546,14 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degraded) {
+  const HealthTransition changed_state = setHealthy(degraded);
+  timeout_timer_->disableTimer();
+  interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+
+  shareResult([degraded](ActiveHealthCheckSession& session) { session.setHealthy(degraded); });
+}
+
+HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setHealthy(bool degraded) {
   // If we are healthy, reset the # of unhealthy to zero.
   num_unhealthy_ = 0;
 
@@ -340,9 +614,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
   parent_.stats_.success_.inc();
   first_check_ = false;
   parent_.runCallbacks(host_, changed_state, HealthState::Healthy);
-
-  timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+  return changed_state;
 }
 
 namespace {
@@ -412,6 +684,28 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
   if (interval_timer_ != nullptr) {
     interval_timer_->enableTimer(parent_.interval(HealthState::Unhealthy, changed_state));
   }
+
+  shareResult([type, retriable](ActiveHealthCheckSession& session) {
+    session.setUnhealthy(type, retriable);
+  });
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::shareResult(
+    const std::function<void(ActiveHealthCheckSession&)>& apply_result) {
+  if (shared_probe_ == nullptr) {
+    return;
+  }
+  ASSERT(shared_probe_->isProber(*this));
+  // The probe is kept alive and the subscribers are copied, as applying a result can remove hosts,
+  // and unsubscribe their sessions, which are deferred deleted.
+  const std::shared_ptr<SharedProbe> probe = shared_probe_;
+  for (ActiveHealthCheckSession* session : probe->subscribers()) {
+    if (session->shared_probe_ != probe) {
+      continue;
+    }
+    apply_result(*session);
+    session->parent_.stats_.probes_saved_.inc();
+  }
 }
 
 HealthTransition
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/common/callback.h"
 #include "envoy/common/random_generator.h"
@@ -13,8 +16,11 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
+#include "source/common/common/thread.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -26,6 +32,7 @@ namespace Upstream {
   COUNTER(failure)                                                                                 \
   COUNTER(network_failure)                                                                         \
   COUNTER(passive_failure)                                                                         \
+  COUNTER(probes_saved)                                                                            \
   COUNTER(success)                                                                                 \
   COUNTER(verify_cluster)                                                                          \
   GAUGE(degraded, Accumulate)                                                                      \
@@ -55,14 +62,38 @@ public:
     return transport_socket_match_metadata_;
   }
 
+  /**
+   * @return the affinity to pass to HealthCheckerFactoryContext::healthCheckDispatcher(), so that
+   *         the health checkers that may share their probes run on the same thread.
+   */
+  static absl::optional<uint64_t>
+  threadAffinity(const Cluster& cluster, const envoy::config::core::v3::HealthCheck& config);
+
+  /**
+   * Creates a health checker, which runs its health checks on the dispatcher it is constructed
+   * with. If this is not the main thread's dispatcher, the updates of the cluster members are
+   * posted to it, and the health transitions of the hosts are posted back to the main thread in
+   * batches. The health checker is then destroyed on the thread it runs on.
+   */
+  template <class T, class... Args>
+  static std::shared_ptr<T> makeHealthChecker(Event::Dispatcher& main_thread_dispatcher,
+                                              Args&&... args) {
+    T* health_checker = new T(std::forward<Args>(args)...);
+    static_cast<HealthCheckerImplBase*>(health_checker)->main_thread_dispatcher_ =
+        &main_thread_dispatcher;
+    return std::shared_ptr<T>(health_checker, [](T* health_checker) { destroy(health_checker); });
+  }
+
 protected:
+  class SharedProbe;
+
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
   public:
     ~ActiveHealthCheckSession() override;
     HealthTransition setUnhealthy(envoy::data::core::v3::HealthCheckFailureType type,
                                   bool retriable);
     void onDeferredDeleteBase();
-    void start() { onInitialInterval(); }
+    void start();
 
   protected:
     ActiveHealthCheckSession(HealthCheckerImplBase& parent, HostSharedPtr host);
@@ -73,6 +104,11 @@ protected:
     HostSharedPtr host_;
 
   private:
+    friend class SharedProbe;
+
+    HealthTransition setHealthy(bool degraded);
+    // Applies the result of a probe to the sessions sharing it with this one, if any.
+    void shareResult(const std::function<void(ActiveHealthCheckSession&)>& apply_result);
     // Clears the pending flag if it is set. By clearing this flag we're marking the host as having
     // been health checked.
     // Returns the changed state to use following the flag update.
@@ -91,6 +127,8 @@ protected:
     uint32_t num_healthy_{};
     bool first_check_{true};
     TimeSource& time_source_;
+    // Set when the probes of this session are shared with the sessions of other health checkers.
+    std::shared_ptr<SharedProbe> shared_probe_;
   };
 
   using ActiveHealthCheckSessionPtr = std::unique_ptr<ActiveHealthCheckSession>;
@@ -105,7 +143,10 @@ protected:
 
   const bool always_log_health_check_failures_;
   const bool always_log_health_check_success_;
+  // The cluster is only accessed on the main thread, as it may be destroyed before a health
+  // checker running on a dedicated thread. Its info is kept alive for the health checks instead.
   const Cluster& cluster_;
+  const ClusterInfoConstSharedPtr cluster_info_;
   Event::Dispatcher& dispatcher_;
   const std::chrono::milliseconds timeout_;
   const uint32_t unhealthy_threshold_;
@@ -118,7 +159,7 @@ protected:
 
 private:
   struct HealthCheckHostMonitorImpl : public HealthCheckHostMonitor {
-    HealthCheckHostMonitorImpl(const std::shared_ptr<HealthCheckerImplBase>& health_checker,
+    HealthCheckHostMonitorImpl(const std::weak_ptr<HealthCheckerImplBase>& health_checker,
                                const HostSharedPtr& host)
         : health_checker_(health_checker), host_(host) {}
 
@@ -129,6 +170,15 @@ private:
     std::weak_ptr<Host> host_;
   };
 
+  struct PendingCallback {
+    HostSharedPtr host_;
+    HealthTransition changed_state_;
+    HealthState current_check_result_;
+  };
+
+  static void destroy(HealthCheckerImplBase* health_checker);
+  bool onDedicatedThread() const { return main_thread_dispatcher_ != &dispatcher_; }
+  void setHostMonitors(const HostVector& hosts);
   void addHosts(const HostVector& hosts);
   void decHealthy();
   void decDegraded();
@@ -141,14 +191,29 @@ private:
   void onClusterMemberUpdate(const HostVector& hosts_added, const HostVector& hosts_removed);
   void runCallbacks(HostSharedPtr host, HealthTransition changed_state,
                     HealthState current_check_result);
+  void runPendingCallbacks();
   void setUnhealthyCrossThread(const HostSharedPtr& host,
                                HealthCheckHostMonitor::UnhealthyType type);
+  void onPassiveFailure(const HostSharedPtr& host);
   static std::shared_ptr<const Network::TransportSocketOptionsImpl>
   initTransportSocketOptions(const envoy::config::core::v3::HealthCheck& config);
   static MetadataConstSharedPtr
   initTransportSocketMatchMetadata(const envoy::config::core::v3::HealthCheck& config);
-
+  static absl::optional<uint64_t>
+  initSharedProbeHash(const envoy::config::core::v3::HealthCheck& config);
+  static absl::optional<std::string>
+  initSharedProbeDefaultHostHeader(const Cluster& cluster,
+                                   const envoy::config::core::v3::HealthCheck& config);
+  std::string sharedProbeKey(const Host& host) const;
+
+  // Dispatcher of the main thread, which is the one the health checks run on unless the health
+  // checker was created with makeHealthChecker().
+  Event::Dispatcher* main_thread_dispatcher_;
+  // Only accessed on the main thread.
   std::list<HostStatusCb> callbacks_;
+  // Health transitions to run the callbacks for on the main thread, when running on another one.
+  Thread::MutexBasicLockable pending_callbacks_lock_;
+  std::vector<PendingCallback> pending_callbacks_ ABSL_GUARDED_BY(pending_callbacks_lock_);
   const std::chrono::milliseconds interval_;
   const std::chrono::milliseconds no_traffic_interval_;
   const std::chrono::milliseconds no_traffic_healthy_interval_;
@@ -161,7 +226,12 @@ private:
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
-  const Common::CallbackHandlePtr member_update_cb_;
+  // Hash of the configuration of the probes when they are shared with other health checkers.
+  const absl::optional<uint64_t> shared_probe_hash_;
+  // Host header of the shared probes of hosts without a health check hostname, if the probes have
+  // one. It is empty when the configured host header is used, which is part of the hash above.
+  const absl::optional<std::string> shared_probe_default_host_header_;
+  Common::CallbackHandlePtr member_update_cb_;
 };
 
 } // namespace Upstream
@@ -45,9 +45,10 @@ const std::string& getHostname(const HostSharedPtr& host,
 Upstream::HealthCheckerSharedPtr GrpcHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ProdGrpcHealthCheckerImpl>(
-      context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
-      context.api().randomGenerator(), context.eventLogger());
+  return HealthCheckerImplBase::makeHealthChecker<ProdGrpcHealthCheckerImpl>(
+      context.mainThreadDispatcher(), context.cluster(), config,
+      context.healthCheckDispatcher(HealthCheckerImplBase::threadAffinity(context.cluster(), config)),
+      context.runtime(), context.api().randomGenerator(), context.eventLogger());
 }
 
 REGISTER_FACTORY(GrpcHealthCheckerFactory, Server::Configuration::CustomHealthCheckerFactory);
@@ -197,7 +198,7 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onInterval() {
   request_encoder_->getStream().addCallbacks(*this);
 
   absl::string_view authority =
-      getHostname(host_, parent_.authority_value_, parent_.cluster_.info());
+      getHostname(host_, parent_.authority_value_, parent_.cluster_info_);
   auto headers_message =
       Grpc::Common::prepareHeaders(authority, parent_.service_method_.service()->full_name(),
                                    parent_.service_method_.name(), absl::nullopt);
@@ -48,8 +48,8 @@ getMethod(const envoy::config::core::v3::RequestMethod config_method) {
 Upstream::HealthCheckerSharedPtr HttpHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ProdHttpHealthCheckerImpl>(context.cluster(), config, context,
-                                                     context.eventLogger());
+  return HealthCheckerImplBase::makeHealthChecker<ProdHttpHealthCheckerImpl>(
+      context.mainThreadDispatcher(), context.cluster(), config, context, context.eventLogger());
 }
 
 REGISTER_FACTORY(HttpHealthCheckerFactory, Server::Configuration::CustomHealthCheckerFactory);
@@ -58,8 +58,10 @@ HttpHealthCheckerImpl::HttpHealthCheckerImpl(
     const Cluster& cluster, const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context,
     HealthCheckEventLoggerPtr&& event_logger)
-    : HealthCheckerImplBase(cluster, config, context.mainThreadDispatcher(), context.runtime(),
-                            context.api().randomGenerator(), std::move(event_logger)),
+    : HealthCheckerImplBase(cluster, config,
+                            context.healthCheckDispatcher(threadAffinity(cluster, config)),
+                            context.runtime(), context.api().randomGenerator(),
+                            std::move(event_logger)),
       path_(config.http_health_check().path()), host_value_(config.http_health_check().host()),
       method_(getMethod(config.http_health_check().method())),
       response_buffer_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
@@ -209,7 +211,7 @@ HttpHealthCheckerImpl::HttpActiveHealthCheckSession::HttpActiveHealthCheckSessio
     : ActiveHealthCheckSession(parent, host), parent_(parent),
       response_body_(std::make_unique<Buffer::OwnedImpl>()),
       hostname_(
-          HealthCheckerFactory::getHostname(host, parent_.host_value_, parent_.cluster_.info())),
+          HealthCheckerFactory::getHostname(host, parent_.host_value_, parent_.cluster_info_)),
       local_connection_info_provider_(std::make_shared<Network::ConnectionInfoSetterImpl>(
           Network::Utility::getCanonicalIpv4LoopbackAddress(),
           Network::Utility::getCanonicalIpv4LoopbackAddress())),
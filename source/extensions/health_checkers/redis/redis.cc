@@ -46,7 +46,7 @@ RedisHealthChecker::RedisActiveHealthCheckSession::RedisActiveHealthCheckSession
     : ActiveHealthCheckSession(parent, host), parent_(parent) {
   redis_command_stats_ =
       Extensions::NetworkFilters::Common::Redis::RedisCommandStats::createRedisCommandStats(
-          parent_.cluster_.info()->statsScope().symbolTable());
+          parent_.cluster_info_->statsScope().symbolTable());
 }
 
 RedisHealthChecker::RedisActiveHealthCheckSession::~RedisActiveHealthCheckSession() {
@@ -83,7 +83,7 @@ void RedisHealthChecker::RedisActiveHealthCheckSession::onInterval() {
   if (!client_) {
     client_ = parent_.client_factory_.create(
         host_, parent_.dispatcher_, redis_config_, redis_command_stats_,
-        parent_.cluster_.info()->statsScope(), parent_.auth_username_, parent_.auth_password_,
+        parent_.cluster_info_->statsScope(), parent_.auth_username_, parent_.auth_password_,
         false, parent_.aws_iam_config_, parent_.aws_iam_authenticator_);
     client_->addConnectionCallbacks(*this);
   }
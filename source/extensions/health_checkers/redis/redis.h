@@ -92,6 +92,8 @@ private:
     std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
       return std::chrono::milliseconds(1);
     }
+    bool flushPerEventLoopIteration() const override { return false; }
+    uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
 
     uint32_t maxUpstreamUnknownConnections() const override { return 0; }
     bool enableCommandStats() const override { return false; }
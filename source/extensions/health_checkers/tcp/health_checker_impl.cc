@@ -36,9 +36,10 @@ namespace Upstream {
 Upstream::HealthCheckerSharedPtr TcpHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<TcpHealthCheckerImpl>(
-      context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
-      context.api().randomGenerator(), context.eventLogger());
+  return HealthCheckerImplBase::makeHealthChecker<TcpHealthCheckerImpl>(
+      context.mainThreadDispatcher(), context.cluster(), config,
+      context.healthCheckDispatcher(HealthCheckerImplBase::threadAffinity(context.cluster(), config)),
+      context.runtime(), context.api().randomGenerator(), context.eventLogger());
 }
 
 REGISTER_FACTORY(TcpHealthCheckerFactory, Server::Configuration::CustomHealthCheckerFactory);
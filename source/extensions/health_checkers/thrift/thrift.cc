@@ -41,7 +41,7 @@ ThriftHealthChecker::ThriftHealthChecker(
 ThriftHealthChecker::ThriftActiveHealthCheckSession::ThriftActiveHealthCheckSession(
     ThriftHealthChecker& parent, const Upstream::HostSharedPtr& host)
     : ActiveHealthCheckSession(parent, host), parent_(parent),
-      hostname_(getHostname(host, parent_.cluster_.info())) {
+      hostname_(getHostname(host, parent_.cluster_info_)) {
   ENVOY_LOG(trace, "ThriftActiveHealthCheckSession construct hostname={}", hostname_);
 }
 
@@ -28,9 +28,8 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // it and cause a divide by zero. This won't happen in normal cases but stops
   // failing fuzz tests
   const uint64_t active_request_value =
-      host.stats().rq_active_.value() != std::numeric_limits<uint64_t>::max()
-          ? host.stats().rq_active_.value() + 1
-          : host.stats().rq_active_.value();
+      host.activeRequests() != std::numeric_limits<uint64_t>::max() ? host.activeRequests() + 1
+                                                                    : host.activeRequests();
 
   if (active_request_bias_ == 1.0) {
     host_weight = static_cast<double>(host.weight()) / active_request_value;
@@ -89,8 +88,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const auto candidate_active_rq = candidate_host->activeRequests();
+    const auto sampled_active_rq = sampled_host->activeRequests();
 
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
@@ -129,8 +128,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const auto candidate_active_rq = candidate_host->activeRequests();
+    const auto sampled_active_rq = sampled_host->activeRequests();
 
     if (sampled_active_rq < candidate_active_rq) {
       candidate_host = sampled_host;
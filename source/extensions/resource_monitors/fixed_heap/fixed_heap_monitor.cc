@@ -1,9 +1,12 @@
 #include "source/extensions/resource_monitors/fixed_heap/fixed_heap_monitor.h"
 
+#include <algorithm>
+
 #include "envoy/extensions/resource_monitors/fixed_heap/v3/fixed_heap.pb.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/memory/stats.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -18,8 +21,10 @@ uint64_t MemoryStatsReader::freeMappedHeapBytes() { return Memory::Stats::totalP
 
 FixedHeapMonitor::FixedHeapMonitor(
     const envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig& config,
-    std::unique_ptr<MemoryStatsReader> stats)
-    : max_heap_(config.max_heap_size_bytes()), stats_(std::move(stats)) {
+    TimeSource& time_source, std::unique_ptr<MemoryStatsReader> stats)
+    : max_heap_(config.max_heap_size_bytes()),
+      projection_window_(PROTOBUF_GET_MS_OR_DEFAULT(config, projection_window, 0)),
+      time_source_(time_source), stats_(std::move(stats)) {
   ASSERT(max_heap_ > 0);
 }
 
@@ -37,6 +42,9 @@ void FixedHeapMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& call
 
   Server::ResourceUsage usage;
   usage.resource_pressure_ = used / static_cast<double>(max_heap_);
+  if (projection_window_.count() > 0) {
+    usage.resource_pressure_ = projectedPressure(used, usage.resource_pressure_);
+  }
 
   ENVOY_LOG_MISC(trace, "FixedHeapMonitor: used={}, max_heap={}, pressure={}", used, max_heap_,
                  usage.resource_pressure_);
@@ -44,6 +52,25 @@ void FixedHeapMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& call
   callbacks.onSuccess(usage);
 }
 
+double FixedHeapMonitor::projectedPressure(uint64_t used, double pressure) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (last_sample_.has_value() && used > last_sample_->first && now > last_sample_->second) {
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(now - last_sample_->second).count();
+    const double bytes_per_ms = (used - last_sample_->first) / elapsed_ms;
+    const double projected = used + bytes_per_ms * projection_window_.count();
+    ENVOY_LOG_MISC(trace, "FixedHeapMonitor: growing at {} bytes/ms, projected={}", bytes_per_ms,
+                   projected);
+    // The projection only says whether the maximum would be reached within the window, so the
+    // pressure is either full or left as is.
+    if (projected >= max_heap_) {
+      pressure = std::max(pressure, 1.0);
+    }
+  }
+  last_sample_.emplace(used, now);
+  return pressure;
+}
+
 } // namespace FixedHeapMonitor
 } // namespace ResourceMonitors
 } // namespace Extensions
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <chrono>
+
+#include "envoy/common/time.h"
 #include "envoy/extensions/resource_monitors/fixed_heap/v3/fixed_heap.pb.h"
 #include "envoy/server/resource_monitor.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace ResourceMonitors {
@@ -25,19 +30,30 @@ public:
 };
 
 /**
- * Heap memory monitor with a statically configured maximum.
+ * Heap memory monitor with a statically configured maximum. If a projection window is configured,
+ * the monitor also reports full pressure when the heap, growing at the rate it grew since the
+ * previous sample, would reach the maximum within the window.
  */
 class FixedHeapMonitor : public Server::ResourceMonitor {
 public:
   FixedHeapMonitor(
       const envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig& config,
+      TimeSource& time_source,
       std::unique_ptr<MemoryStatsReader> stats = std::make_unique<MemoryStatsReader>());
 
   void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
 
 private:
+  // Returns full pressure if the heap usage projected projection_window_ ahead reaches the maximum,
+  // and the current pressure otherwise.
+  double projectedPressure(uint64_t used, double pressure);
+
   const uint64_t max_heap_;
+  const std::chrono::milliseconds projection_window_;
+  TimeSource& time_source_;
   std::unique_ptr<MemoryStatsReader> stats_;
+  // The heap usage at the previous sample, and when it was sampled.
+  absl::optional<std::pair<uint64_t, MonotonicTime>> last_sample_;
 };
 
 } // namespace FixedHeapMonitor
@@ -0,0 +1,45 @@
+#include "source/extensions/stat_sinks/shared_memory/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/stat_sinks/shared_memory/v3/shared_memory.pb.h"
+#include "envoy/extensions/stat_sinks/shared_memory/v3/shared_memory.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_sink.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+absl::StatusOr<Stats::SinkPtr>
+SharedMemorySinkFactory::createStatsSink(const Protobuf::Message& config,
+                                         Server::Configuration::ServerFactoryContext& server) {
+  const auto& sink_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink&>(
+      config, server.messageValidationContext().staticValidationVisitor());
+  auto sink_or_error = SharedMemoryStatsSink::create(
+      sink_config.path(), PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, max_size_bytes, 64 << 20),
+      server.scope().symbolTable(), Api::OsSysCallsSingleton::get());
+  RETURN_IF_NOT_OK_REF(sink_or_error.status());
+  return std::move(sink_or_error.value());
+}
+
+ProtobufTypes::MessagePtr SharedMemorySinkFactory::createEmptyConfigProto() {
+  return std::make_unique<envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink>();
+}
+
+std::string SharedMemorySinkFactory::name() const { return "envoy.stat_sinks.shared_memory"; }
+
+/**
+ * Static registration for the shared memory sink factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(SharedMemorySinkFactory, Server::Configuration::StatsSinkFactory);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "envoy/server/instance.h"
+
+#include "source/server/configuration_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+/**
+ * Config registration for the shared memory stats sink. @see StatsSinkFactory.
+ */
+class SharedMemorySinkFactory : Logger::Loggable<Logger::Id::config>,
+                                public Server::Configuration::StatsSinkFactory {
+public:
+  // StatsSinkFactory
+  absl::StatusOr<Stats::SinkPtr>
+  createStatsSink(const Protobuf::Message& config,
+                  Server::Configuration::ServerFactoryContext& server) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override;
+
+  std::string name() const override;
+};
+
+DECLARE_FACTORY(SharedMemorySinkFactory);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
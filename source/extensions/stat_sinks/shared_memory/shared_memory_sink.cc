@@ -0,0 +1,266 @@
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_sink.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "source/common/common/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+namespace {
+
+uint64_t toBits(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+} // namespace
+
+absl::StatusOr<std::unique_ptr<SharedMemoryStatsSink>>
+SharedMemoryStatsSink::create(const std::string& path, uint64_t max_size_bytes,
+                              Stats::SymbolTable& symbol_table, Api::OsSysCalls& os_sys_calls) {
+  // A file left by a previous process is replaced rather than truncated, as truncating it would
+  // make readers that still map it fault.
+  os_sys_calls.unlink(path.c_str());
+  const Api::SysCallIntResult fd = os_sys_calls.open(
+      path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd.return_value_ == -1) {
+    return absl::InvalidArgumentError(fmt::format("cannot create shared memory stats file {}: {}",
+                                                  path, errorDetails(fd.errno_)));
+  }
+  const Api::SysCallIntResult truncate_result = os_sys_calls.ftruncate(fd.return_value_, 0);
+  const Api::SysCallPtrResult mmap_result =
+      truncate_result.return_value_ == -1
+          ? Api::SysCallPtrResult{MAP_FAILED, truncate_result.errno_}
+          : os_sys_calls.mmap(nullptr, max_size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                              fd.return_value_, 0);
+  if (mmap_result.return_value_ == MAP_FAILED) {
+    os_sys_calls.close(fd.return_value_);
+    return absl::InvalidArgumentError(fmt::format("cannot map shared memory stats file {}: {}",
+                                                  path, errorDetails(mmap_result.errno_)));
+  }
+
+  std::unique_ptr<SharedMemoryStatsSink> sink(
+      new SharedMemoryStatsSink(max_size_bytes, symbol_table, os_sys_calls, fd.return_value_,
+                                static_cast<uint8_t*>(mmap_result.return_value_)));
+  if (!sink->ensureFileSize(sizeof(Header))) {
+    return absl::InvalidArgumentError(
+        fmt::format("cannot allocate shared memory stats file {}", path));
+  }
+  Header& header = sink->header();
+  header.magic_ = SharedMemoryStatsMagic;
+  header.version_ = SharedMemoryStatsVersion;
+  header.header_size_ = sizeof(Header);
+  header.names_offset_ = sizeof(Header);
+  header.used_size_ = sizeof(Header);
+  return sink;
+}
+
+SharedMemoryStatsSink::SharedMemoryStatsSink(uint64_t max_size_bytes,
+                                             Stats::SymbolTable& symbol_table,
+                                             Api::OsSysCalls& os_sys_calls, int fd, uint8_t* region)
+    : max_size_(max_size_bytes), symbol_table_(symbol_table), os_sys_calls_(os_sys_calls),
+      fd_(fd), region_(region) {}
+
+SharedMemoryStatsSink::~SharedMemoryStatsSink() {
+  ::munmap(region_, max_size_);
+  os_sys_calls_.close(fd_);
+}
+
+void SharedMemoryStatsSink::flush(Stats::MetricSnapshot& snapshot) {
+  std::vector<Entry> layout;
+  std::string names;
+  uint32_t dropped = 0;
+  const bool layout_changed = !layoutMatches(snapshot);
+  if (layout_changed) {
+    dropped = buildLayout(snapshot, layout, names);
+  }
+
+  // Seqlock write: readers discard anything they read while the sequence is odd or changed.
+  Header& header = this->header();
+  const uint64_t sequence = header.sequence_.load(std::memory_order_relaxed);
+  header.sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (layout_changed) {
+    const uint64_t names_offset = sizeof(Header) + layout.size() * sizeof(Entry);
+    std::memcpy(entries(), layout.data(), layout.size() * sizeof(Entry));
+    std::memcpy(region_ + names_offset, names.data(), names.size());
+    header.generation_++;
+    header.num_entries_ = layout.size();
+    header.dropped_entries_ = dropped;
+    header.names_offset_ = names_offset;
+    header.used_size_ = names_offset + names.size();
+  }
+  writeValues(snapshot);
+  header.snapshot_time_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 snapshot.snapshotTime().time_since_epoch())
+                                 .count();
+
+  header.sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+bool SharedMemoryStatsSink::layoutMatches(Stats::MetricSnapshot& snapshot) const {
+  if (pool_ == nullptr || snapshot.counters().size() != num_counters_ ||
+      snapshot.gauges().size() != num_gauges_ ||
+      snapshot.histograms().size() != names_.size() - num_counters_ - num_gauges_) {
+    return false;
+  }
+  auto name = names_.begin();
+  for (const auto& counter : snapshot.counters()) {
+    if (counter.counter_.get().statName() != *name++) {
+      return false;
+    }
+  }
+  for (const Stats::Gauge& gauge : snapshot.gauges()) {
+    if (gauge.statName() != *name++) {
+      return false;
+    }
+  }
+  for (const Stats::ParentHistogram& histogram : snapshot.histograms()) {
+    if (histogram.statName() != *name++) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t SharedMemoryStatsSink::buildLayout(Stats::MetricSnapshot& snapshot,
+                                            std::vector<Entry>& layout, std::string& names) {
+  auto pool = std::make_unique<Stats::StatNamePool>(symbol_table_);
+  std::vector<Stats::StatName> stat_names;
+  stat_names.reserve(snapshot.counters().size() + snapshot.gauges().size() +
+                     snapshot.histograms().size());
+
+  // Entries are only ever dropped from the end, so that writeValues() can match the published
+  // entries with the snapshot by position.
+  uint32_t dropped = 0;
+  uint32_t name_offset = 0;
+  auto add_name = [&](const Stats::Metric& metric) {
+    stat_names.push_back(pool->add(metric.statName()));
+    name_offset = names.size();
+    names.append(metric.name());
+  };
+  auto add_entry = [&](EntryType type, uint32_t quantile) {
+    const uint64_t name_length = names.size() - name_offset;
+    if (dropped > 0 ||
+        sizeof(Header) + (layout.size() + 1) * sizeof(Entry) + names.size() > max_size_) {
+      dropped++;
+      return;
+    }
+    layout.push_back({name_offset, static_cast<uint32_t>(name_length), type, quantile, 0});
+  };
+
+  for (const auto& counter : snapshot.counters()) {
+    add_name(counter.counter_.get());
+    add_entry(EntryType::Counter, 0);
+  }
+  for (const Stats::Gauge& gauge : snapshot.gauges()) {
+    add_name(gauge);
+    add_entry(EntryType::Gauge, 0);
+  }
+  for (const Stats::ParentHistogram& histogram : snapshot.histograms()) {
+    // All the entries of a histogram share its name.
+    add_name(histogram);
+    for (const double quantile : histogram.cumulativeStatistics().supportedQuantiles()) {
+      add_entry(EntryType::HistogramQuantile, std::lround(quantile * 1e6));
+    }
+    add_entry(EntryType::HistogramSampleCount, 0);
+    add_entry(EntryType::HistogramSampleSum, 0);
+  }
+
+  // Names of dropped entries are not published.
+  if (dropped > 0) {
+    uint64_t names_size = 0;
+    for (const Entry& entry : layout) {
+      names_size = std::max<uint64_t>(names_size, entry.name_offset_ + entry.name_length_);
+    }
+    names.resize(names_size);
+    ENVOY_LOG_EVERY_POW_2(warn,
+                          "{} stats do not fit into the shared memory stats file and are dropped",
+                          dropped);
+  }
+  if (!ensureFileSize(sizeof(Header) + layout.size() * sizeof(Entry) + names.size())) {
+    // Publish no entries, and forget the previous layout so that the next flush builds the layout
+    // again and retries growing the file.
+    dropped += layout.size();
+    layout.clear();
+    names.clear();
+    pool_.reset();
+    names_.clear();
+    num_counters_ = 0;
+    num_gauges_ = 0;
+    num_entries_ = 0;
+    return dropped;
+  }
+
+  pool_ = std::move(pool);
+  names_ = std::move(stat_names);
+  num_counters_ = snapshot.counters().size();
+  num_gauges_ = snapshot.gauges().size();
+  num_entries_ = layout.size();
+  return dropped;
+}
+
+void SharedMemoryStatsSink::writeValues(Stats::MetricSnapshot& snapshot) {
+  Entry* entry = entries();
+  Entry* const end = entry + num_entries_;
+  for (const auto& counter : snapshot.counters()) {
+    if (entry == end) {
+      return;
+    }
+    (entry++)->value_ = counter.counter_.get().value();
+  }
+  for (const Stats::Gauge& gauge : snapshot.gauges()) {
+    if (entry == end) {
+      return;
+    }
+    (entry++)->value_ = gauge.value();
+  }
+  for (const Stats::ParentHistogram& histogram : snapshot.histograms()) {
+    const Stats::HistogramStatistics& statistics = histogram.cumulativeStatistics();
+    for (const double value : statistics.computedQuantiles()) {
+      if (entry == end) {
+        return;
+      }
+      (entry++)->value_ = toBits(value);
+    }
+    if (entry == end) {
+      return;
+    }
+    (entry++)->value_ = statistics.sampleCount();
+    if (entry == end) {
+      return;
+    }
+    (entry++)->value_ = toBits(statistics.sampleSum());
+  }
+}
+
+bool SharedMemoryStatsSink::ensureFileSize(uint64_t size) {
+  if (size <= file_size_) {
+    return true;
+  }
+  // Grow geometrically so that adding metrics one at a time does not resize the file each time.
+  const uint64_t new_size = std::min(max_size_, std::max(size, 2 * file_size_));
+  const Api::SysCallIntResult result = os_sys_calls_.ftruncate(fd_, new_size);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG(warn, "cannot grow shared memory stats file to {} bytes: {}", new_size,
+              errorDetails(result.errno_));
+    return false;
+  }
+  file_size_ = new_size;
+  return true;
+}
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
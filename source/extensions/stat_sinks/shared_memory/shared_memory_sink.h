@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/api/os_sys_calls.h"
+#include "envoy/stats/sink.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/stats/symbol_table.h"
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_stats_format.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+/**
+ * Stats sink publishing counters, gauges and histogram summaries into a memory mapped file, so
+ * that co-located processes can read them at any frequency without any work on Envoy's side. See
+ * shared_memory_stats_format.h for the layout of the file.
+ *
+ * The names are only written when the set of metrics changes. On other flushes, only the values
+ * are copied, which is detected by comparing the stat names of the snapshot with the ones of the
+ * previous flush.
+ */
+class SharedMemoryStatsSink : public Stats::Sink, Logger::Loggable<Logger::Id::stats> {
+public:
+  static absl::StatusOr<std::unique_ptr<SharedMemoryStatsSink>>
+  create(const std::string& path, uint64_t max_size_bytes, Stats::SymbolTable& symbol_table,
+         Api::OsSysCalls& os_sys_calls);
+  ~SharedMemoryStatsSink() override;
+
+  // Stats::Sink
+  void flush(Stats::MetricSnapshot& snapshot) override;
+  void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+
+private:
+  SharedMemoryStatsSink(uint64_t max_size_bytes, Stats::SymbolTable& symbol_table,
+                        Api::OsSysCalls& os_sys_calls, int fd, uint8_t* region);
+
+  bool layoutMatches(Stats::MetricSnapshot& snapshot) const;
+  // Computes the entries and the name table for the metrics of the snapshot, and returns the
+  // number of entries that were dropped.
+  uint32_t buildLayout(Stats::MetricSnapshot& snapshot, std::vector<Entry>& layout,
+                       std::string& names);
+  void writeValues(Stats::MetricSnapshot& snapshot);
+  bool ensureFileSize(uint64_t size);
+  Header& header() { return *reinterpret_cast<Header*>(region_); }
+  Entry* entries() { return reinterpret_cast<Entry*>(region_ + sizeof(Header)); }
+
+  const uint64_t max_size_;
+  Stats::SymbolTable& symbol_table_;
+  Api::OsSysCalls& os_sys_calls_;
+  const int fd_;
+  uint8_t* const region_;
+  uint64_t file_size_{};
+
+  // The stat name of each metric published by the last flush, in the order of the snapshot. The
+  // names are held in pool_ so that their symbols cannot be reused by other names.
+  std::unique_ptr<Stats::StatNamePool> pool_;
+  std::vector<Stats::StatName> names_;
+  uint32_t num_counters_{};
+  uint32_t num_gauges_{};
+  uint32_t num_entries_{};
+};
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
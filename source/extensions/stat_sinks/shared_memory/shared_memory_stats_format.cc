@@ -0,0 +1,101 @@
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_stats_format.h"
+
+#include <cstring>
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+namespace {
+
+double toDouble(uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+absl::StatusOr<SharedMemoryStatsSnapshot>
+readSharedMemoryStats(const uint8_t* region, uint64_t size, uint32_t max_attempts) {
+  if (size < sizeof(Header)) {
+    return absl::InvalidArgumentError("shared memory stats region is too small");
+  }
+  const Header& header = *reinterpret_cast<const Header*>(region);
+  if (header.magic_ != SharedMemoryStatsMagic || header.version_ != SharedMemoryStatsVersion ||
+      header.header_size_ != sizeof(Header)) {
+    return absl::InvalidArgumentError("unsupported shared memory stats format");
+  }
+
+  std::vector<Entry> entries;
+  for (uint32_t attempt = 0; attempt < max_attempts; ++attempt) {
+    const uint64_t sequence = header.sequence_.load(std::memory_order_acquire);
+    if (sequence % 2 != 0) {
+      continue;
+    }
+
+    SharedMemoryStatsSnapshot snapshot;
+    snapshot.generation_ = header.generation_;
+    snapshot.snapshot_time_ms_ = header.snapshot_time_ms_;
+    snapshot.dropped_entries_ = header.dropped_entries_;
+    const uint64_t used_size = header.used_size_;
+    const uint64_t num_entries = header.num_entries_;
+    const uint64_t names_offset = header.names_offset_;
+
+    // The fields may be torn if the sink is updating the file concurrently, so they are only
+    // trusted once the sequence has been checked again.
+    const bool valid_layout = used_size <= size && names_offset <= used_size &&
+                              sizeof(Header) + num_entries * sizeof(Entry) <= names_offset;
+    if (valid_layout) {
+      entries.resize(num_entries);
+      std::memcpy(entries.data(), region + sizeof(Header), num_entries * sizeof(Entry));
+      snapshot.stats_.reserve(num_entries);
+      for (const Entry& entry : entries) {
+        if (static_cast<uint64_t>(entry.name_offset_) + entry.name_length_ >
+            used_size - names_offset) {
+          break;
+        }
+        SharedMemoryStat& stat = snapshot.stats_.emplace_back();
+        stat.name_.assign(
+            reinterpret_cast<const char*>(region + names_offset + entry.name_offset_),
+            entry.name_length_);
+        stat.type_ = entry.type_;
+        switch (entry.type_) {
+        case EntryType::HistogramQuantile:
+          stat.quantile_ = entry.quantile_ / 1e6;
+          stat.double_value_ = toDouble(entry.value_);
+          break;
+        case EntryType::HistogramSampleSum:
+          stat.double_value_ = toDouble(entry.value_);
+          break;
+        default:
+          stat.value_ = entry.value_;
+          break;
+        }
+      }
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header.sequence_.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    if (used_size > size) {
+      return absl::OutOfRangeError(
+          absl::StrCat("shared memory stats region must be mapped with at least ", used_size,
+                       " bytes"));
+    }
+    if (!valid_layout || snapshot.stats_.size() != num_entries) {
+      return absl::InvalidArgumentError("corrupted shared memory stats region");
+    }
+    return snapshot;
+  }
+  return absl::UnavailableError("shared memory stats region is being updated");
+}
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+/**
+ * Layout of the file published by the shared memory stats sink. The file starts with a Header,
+ * followed by an array of Header::num_entries_ Entry records and by the name table, which holds
+ * the concatenated names of all entries. All integers are stored in the byte order of the host.
+ *
+ * The header and the entries are only consistent while Header::sequence_ is even and unchanged:
+ * the sink increments it before updating the file and again once done. Readers copy what they
+ * need between two reads of the sequence, and retry if it was odd or changed in between (a
+ * seqlock). The layout of the entries and the name table only changes when metrics are added or
+ * removed, in which case Header::generation_ is incremented.
+ */
+constexpr uint64_t SharedMemoryStatsMagic = 0x53545359564e45; // "ENVYSTS" in little endian.
+constexpr uint32_t SharedMemoryStatsVersion = 1;
+
+enum class EntryType : uint32_t {
+  Counter = 0,
+  Gauge = 1,
+  // The value of a histogram quantile, stored as the bits of a double. The quantile itself is
+  // stored in millionths in Entry::quantile_.
+  HistogramQuantile = 2,
+  // The number of samples recorded into a histogram.
+  HistogramSampleCount = 3,
+  // The sum of the samples recorded into a histogram, stored as the bits of a double.
+  HistogramSampleSum = 4,
+};
+
+struct Header {
+  uint64_t magic_;
+  uint32_t version_;
+  uint32_t header_size_;
+  std::atomic<uint64_t> sequence_;
+  uint64_t generation_;
+  // Number of bytes in use from the start of the file. The file may be larger.
+  uint64_t used_size_;
+  // Time of the published snapshot, in milliseconds since the epoch.
+  uint64_t snapshot_time_ms_;
+  uint32_t num_entries_;
+  // Number of entries that did not fit into the maximum size of the file.
+  uint32_t dropped_entries_;
+  // Offset of the name table from the start of the file.
+  uint64_t names_offset_;
+};
+
+struct Entry {
+  // Offset of the name from the start of the name table.
+  uint32_t name_offset_;
+  uint32_t name_length_;
+  EntryType type_;
+  uint32_t quantile_;
+  uint64_t value_;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the sequence must be usable from other processes");
+static_assert(sizeof(Header) == 64 && sizeof(Entry) == 24, "the layout must not change");
+
+/**
+ * A metric read from a shared memory stats file.
+ */
+struct SharedMemoryStat {
+  std::string name_;
+  EntryType type_;
+  // Only set for EntryType::HistogramQuantile.
+  double quantile_{};
+  // Set for counters, gauges and sample counts.
+  uint64_t value_{};
+  // Set for histogram quantiles and sample sums.
+  double double_value_{};
+};
+
+struct SharedMemoryStatsSnapshot {
+  uint64_t generation_{};
+  uint64_t snapshot_time_ms_{};
+  uint32_t dropped_entries_{};
+  std::vector<SharedMemoryStat> stats_;
+};
+
+/**
+ * Reads a consistent snapshot from a mapping of a shared memory stats file. Never blocks the
+ * process publishing the stats.
+ * @param region the start of the mapping.
+ * @param size the size of the mapping.
+ * @param max_attempts the number of times reading is retried while the file is being updated.
+ * @return the snapshot, OutOfRange if the mapping is smaller than the used part of the file and
+ *         must be extended, Unavailable if no consistent snapshot could be read, or
+ *         InvalidArgument if the region does not hold a compatible stats file.
+ */
+absl::StatusOr<SharedMemoryStatsSnapshot>
+readSharedMemoryStats(const uint8_t* region, uint64_t size, uint32_t max_attempts = 100);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
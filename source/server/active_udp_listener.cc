@@ -5,6 +5,7 @@
 #include "envoy/stats/scope.h"
 
 #include "source/common/network/udp_listener_impl.h"
+#include "source/common/network/udp_peer_address_steering.h"
 #include "source/common/network/utility.h"
 
 #include "spdlog/spdlog.h"
@@ -86,7 +87,8 @@ ActiveRawUdpListener::ActiveRawUdpListener(uint32_t worker_index, uint32_t concu
                                            Network::UdpListenerPtr&& listener,
                                            Network::ListenerConfig& config)
     : ActiveUdpListenerBase(worker_index, concurrency, parent, listen_socket, std::move(listener),
-                            &config) {
+                            &config),
+      steer_by_peer_address_(config.udpListenerConfig()->config().steer_by_peer_address()) {
   // Create the filter chain on creating a new udp listener.
   config_->filterChainFactory().createUdpListenerFilterChain(*this, *this);
 
@@ -101,6 +103,16 @@ ActiveRawUdpListener::ActiveRawUdpListener(uint32_t worker_index, uint32_t concu
       listen_socket_.ioHandle(), config.listenerScope());
 }
 
+uint32_t ActiveRawUdpListener::destination(const Network::UdpRecvData& data) const {
+  if (!steer_by_peer_address_) {
+    return worker_index_;
+  }
+
+  // This matches the worker selected by the kernel when the steering BPF program is attached, in
+  // which case datagrams are only forwarded while the SO_REUSEPORT group is being changed.
+  return Network::UdpPeerAddressSteering::hash(*data.addresses_.peer_) % concurrency_;
+}
+
 void ActiveRawUdpListener::onDataWorker(Network::UdpRecvData&& data) {
   for (auto& read_filter : read_filters_) {
     Network::FilterStatus status = read_filter->onData(data);
@@ -121,9 +121,13 @@ public:
   // Network::UdpReadFilterCallbacks
   Network::UdpListener& udpListener() override;
 
+protected:
+  uint32_t destination(const Network::UdpRecvData& data) const override;
+
 private:
   std::list<Network::UdpListenerReadFilterPtr> read_filters_;
   Network::UdpPacketWriterPtr udp_packet_writer_;
+  const bool steer_by_peer_address_;
 };
 
 } // namespace Server
@@ -157,6 +157,9 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         "enable",
                         "enables the CPU profiler",
                         {"y", "n"}}}),
+          makeHandler("/dispatchers",
+                      "print the slowest callbacks of the event dispatchers (if enabled)",
+                      MAKE_ADMIN_HANDLER(server_info_handler_.handlerDispatchers), false, false),
           makeHandler("/heapprofiler", "enable/disable the heap profiler",
                       MAKE_ADMIN_HANDLER(profiling_handler_.handlerHeapProfiler), false, true,
                       {{Admin::ParamDescriptor::Type::Enum,
@@ -200,6 +203,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         prepend("", LogsHandler::levelStrings())}}),
           makeHandler("/memory", "print current allocation/heap usage",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false),
+          makeHandler("/memory/streams", "print the streams using the most memory (if tracked)",
+                      MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemoryStreams), false, false,
+                      {{Admin::ParamDescriptor::Type::String, "limit",
+                        "The maximum number of streams to print, 10 by default"}}),
           makeHandler("/quitquitquit", "exit the server",
                       MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true),
           makeHandler("/reset_counters", "reset all counters to zero",
@@ -223,19 +230,7 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/ready", "print server state, return 200 if LIVE, otherwise return 503",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerReady), false, false),
           stats_handler_.statsHandler(false /* not active mode */),
-          makeHandler("/stats/prometheus", "print server stats in prometheus format",
-                      MAKE_ADMIN_HANDLER(stats_handler_.handlerPrometheusStats), false, false,
-                      {{ParamDescriptor::Type::Boolean, "usedonly",
-                        "Only include stats that have been written by system since restart"},
-                       {ParamDescriptor::Type::Boolean, "text_readouts",
-                        "Render text_readouts as new gaugues with value 0 (increases Prometheus "
-                        "data size)"},
-                       {ParamDescriptor::Type::String, "filter",
-                        "Regular expression (Google re2) for filtering stats"},
-                       {ParamDescriptor::Type::Enum,
-                        "histogram_buckets",
-                        "Histogram bucket display mode",
-                        {"cumulative", "summary"}}}),
+          stats_handler_.prometheusStatsHandler(),
           makeHandler("/stats/recentlookups", "Show recent stat-name lookups",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerStatsRecentLookups), false, false),
           makeHandler("/stats/recentlookups/clear", "clear list of stat-name lookups and counter",
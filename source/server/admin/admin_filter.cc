@@ -40,6 +40,9 @@ void AdminFilter::onDestroy() {
   for (const auto& callback : on_destroy_callbacks_) {
     callback();
   }
+  // Drop any chunks that have not been sent yet.
+  next_chunk_cb_.reset();
+  handler_.reset();
 }
 
 void AdminFilter::addOnDestroyCallback(std::function<void()> cb) {
@@ -86,24 +89,44 @@ void AdminFilter::onComplete() {
 
   auto header_map = Http::ResponseHeaderMapImpl::create();
   RELEASE_ASSERT(request_headers_, "");
-  Admin::RequestPtr handler = admin_.makeRequest(*this);
-  Http::Code code = handler->start(*header_map);
+  handler_ = admin_.makeRequest(*this);
+  Http::Code code = handler_->start(*header_map);
   Utility::populateFallbackResponseHeaders(code, *header_map);
   decoder_callbacks_->encodeHeaders(std::move(header_map), false,
                                     StreamInfo::ResponseCodeDetails::get().AdminFilterResponse);
+  // The stream may have been destroyed while encoding the headers.
+  if (handler_ != nullptr) {
+    nextChunk();
+  }
+}
 
+void AdminFilter::nextChunk() {
   // TODO(#31087): use high/lower watermarks to apply flow-control to the admin http port.
-  bool more_data;
-  do {
-    Buffer::OwnedImpl response;
-    more_data = handler->nextChunk(response);
-    bool end_stream = end_stream_on_complete_ && !more_data;
-    ENVOY_LOG_MISC(debug, "nextChunk: response.length={} more_data={} end_stream={}",
-                   response.length(), more_data, end_stream);
-    if (response.length() > 0 || end_stream) {
-      decoder_callbacks_->encodeData(response, end_stream);
-    }
-  } while (more_data);
+  Buffer::OwnedImpl response;
+  const bool more_data = handler_->nextChunk(response);
+  const bool end_stream = end_stream_on_complete_ && !more_data;
+  ENVOY_LOG_MISC(debug, "nextChunk: response.length={} more_data={} end_stream={}",
+                 response.length(), more_data, end_stream);
+  if (response.length() > 0 || end_stream) {
+    decoder_callbacks_->encodeData(response, end_stream);
+  }
+
+  // The stream may have been destroyed while encoding the chunk.
+  if (handler_ == nullptr) {
+    return;
+  }
+  if (!more_data) {
+    handler_.reset();
+    return;
+  }
+
+  // Yield to the dispatcher between chunks, so that large responses such as
+  // stats scrapes don't block the main thread until they are fully rendered.
+  if (next_chunk_cb_ == nullptr) {
+    next_chunk_cb_ =
+        decoder_callbacks_->dispatcher().createSchedulableCallback([this]() { nextChunk(); });
+  }
+  next_chunk_cb_->scheduleCallbackNextIteration();
 }
 
 } // namespace Server
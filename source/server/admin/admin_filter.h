@@ -3,6 +3,7 @@
 #include <functional>
 #include <list>
 
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/http/filter.h"
 #include "envoy/server/admin.h"
 
@@ -64,10 +65,19 @@ private:
    * Called when an admin request has been completely received.
    */
   void onComplete();
+
+  /**
+   * Sends the next chunk of the response, and schedules the following one on
+   * the next dispatcher iteration if there is more data.
+   */
+  void nextChunk();
+
   const Admin& admin_;
   Http::RequestHeaderMap* request_headers_{};
   std::list<std::function<void()>> on_destroy_callbacks_;
   bool end_stream_on_complete_ = true;
+  Admin::RequestPtr handler_;
+  Event::SchedulableCallbackPtr next_chunk_cb_;
 };
 
 } // namespace Server
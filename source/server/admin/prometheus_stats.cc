@@ -64,12 +64,17 @@ struct PrimitiveMetricSnapshotLessThan {
   }
 };
 
-std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
+std::string generateNumericOutput(uint64_t value, absl::string_view formatted_tags,
                                   const std::string& prefixed_tag_extracted_name) {
-  const std::string formatted_tags = PrometheusStatsFormatter::formattedTags(tags);
   return fmt::format("{0}{{{1}}} {2}\n", prefixed_tag_extracted_name, formatted_tags, value);
 }
 
+std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
+                                  const std::string& prefixed_tag_extracted_name) {
+  return generateNumericOutput(value, PrometheusStatsFormatter::formattedTags(tags),
+                               prefixed_tag_extracted_name);
+}
+
 /*
  * Return the prometheus output for a numeric Stat (Counter or Gauge).
  */
@@ -86,12 +91,23 @@ std::string generateStatNumericOutput(const StatType& metric,
  * always equal to 0. Returned gauge contains all tags of a given text-readout and one additional
  * tag {"text_value":"textReadout.value"}.
  */
+std::string generateTextReadoutOutputWithTags(const Stats::TextReadout& text_readout,
+                                              absl::string_view formatted_tags,
+                                              const std::string& prefixed_tag_extracted_name) {
+  const std::string text_value =
+      PrometheusStatsFormatter::formattedTags({Stats::Tag{"text_value", text_readout.value()}});
+  if (formatted_tags.empty()) {
+    return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, text_value);
+  }
+  return fmt::format("{0}{{{1},{2}}} 0\n", prefixed_tag_extracted_name, formatted_tags,
+                     text_value);
+}
+
 std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
                                       const std::string& prefixed_tag_extracted_name) {
-  auto tags = text_readout.tags();
-  tags.push_back(Stats::Tag{"text_value", text_readout.value()});
-  const std::string formattedTags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, formattedTags);
+  return generateTextReadoutOutputWithTags(
+      text_readout, PrometheusStatsFormatter::formattedTags(text_readout.tags()),
+      prefixed_tag_extracted_name);
 }
 
 /*
@@ -99,10 +115,10 @@ std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
  * newlines) that contains all the individual bucket counts and sum/count for a single histogram
  * (metric_name plus all tags).
  */
-std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
-                                    const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+std::string generateHistogramOutputWithTags(const Stats::ParentHistogram& histogram,
+                                            absl::string_view tags,
+                                            const std::string& prefixed_tag_extracted_name) {
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : absl::StrCat(tags, ",");
 
   const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
   Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
@@ -130,6 +146,13 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
+                                    const std::string& prefixed_tag_extracted_name) {
+  return generateHistogramOutputWithTags(
+      histogram, PrometheusStatsFormatter::formattedTags(histogram.tags()),
+      prefixed_tag_extracted_name);
+}
+
 /**
  * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
  * them by tag-extracted metric name, and then outputting them in the correct sorted order into
@@ -281,10 +304,10 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
  * newlines) that contains all the individual quantile values and sum/count for a single histogram
  * (metric_name plus all tags).
  */
-std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
-                                  const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+std::string generateSummaryOutputWithTags(const Stats::ParentHistogram& histogram,
+                                          absl::string_view tags,
+                                          const std::string& prefixed_tag_extracted_name) {
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : absl::StrCat(tags, ",");
 
   const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
   Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
@@ -305,6 +328,13 @@ std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
+                                  const std::string& prefixed_tag_extracted_name) {
+  return generateSummaryOutputWithTags(
+      histogram, PrometheusStatsFormatter::formattedTags(histogram.tags()),
+      prefixed_tag_extracted_name);
+}
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -418,5 +448,221 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusNameCache::PrometheusNameCache(Stats::SymbolTable& symbol_table)
+    : symbol_table_(symbol_table) {}
+
+PrometheusNameCache::~PrometheusNameCache() {
+  for (auto& map : {&names_, &tags_}) {
+    for (auto& entry : *map) {
+      entry.second.storage_.free(symbol_table_);
+    }
+  }
+}
+
+template <class RenderFn>
+const std::string& PrometheusNameCache::lookup(EntryMap& map, Stats::StatName name,
+                                               uint64_t generation, RenderFn render) {
+  auto iter = map.find(name);
+  if (iter == map.end()) {
+    // The key references the bytes held by the entry's storage, which do not
+    // move when the map is rehashed.
+    Stats::StatNameStorage storage(name, symbol_table_);
+    const Stats::StatName key = storage.statName();
+    iter = map.emplace(key, Entry{std::move(storage), render(), generation}).first;
+  } else {
+    iter->second.generation_ = std::max(iter->second.generation_, generation);
+  }
+  return iter->second.rendered_;
+}
+
+const std::string&
+PrometheusNameCache::metricName(Stats::StatName tag_extracted_name,
+                                const Stats::CustomStatNamespaces& custom_namespaces,
+                                uint64_t generation) {
+  return lookup(names_, tag_extracted_name, generation, [&]() -> std::string {
+    return PrometheusStatsFormatter::metricName(symbol_table_.toString(tag_extracted_name),
+                                                custom_namespaces)
+        .value_or(EMPTY_STRING);
+  });
+}
+
+const std::string& PrometheusNameCache::formattedTags(const Stats::Metric& metric,
+                                                      uint64_t generation) {
+  return lookup(tags_, metric.statName(), generation, [&metric]() -> std::string {
+    return PrometheusStatsFormatter::formattedTags(metric.tags());
+  });
+}
+
+void PrometheusNameCache::endScrape() {
+  sweep(names_);
+  sweep(tags_);
+}
+
+void PrometheusNameCache::sweep(EntryMap& map) {
+  for (auto iter = map.begin(); iter != map.end();) {
+    if (iter->second.generation_ + MaxIdleScrapes <= generation_) {
+      iter->second.storage_.free(symbol_table_);
+      map.erase(iter++);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Upstream::ClusterManager& cluster_manager,
+                                               const Stats::CustomStatNamespaces& custom_namespaces,
+                                               PrometheusNameCache& cache)
+    : params_(params), stats_(stats), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), cache_(cache), groups_(stats.symbolTable()),
+      group_(groups_.end()) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  generation_ = cache_.startScrape();
+  startPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  const uint64_t starting_response_length = response.length();
+  while (response.length() - starting_response_length < chunk_size_) {
+    if (group_ == groups_.end()) {
+      if (phase_ == Phase::Histograms) {
+        // Note: This assumes that there is no overlap in stat name between per-endpoint stats and
+        // all other stats, as in PrometheusStatsFormatter::statsAsPrometheus.
+        renderPerHostMetrics(response);
+        cache_.endScrape();
+        return false;
+      }
+      phase_ = static_cast<Phase>(static_cast<int>(phase_) + 1);
+      startPhase();
+      continue;
+    }
+
+    std::vector<const Stats::Metric*>& metrics = group_->second;
+    if (metric_index_ == 0) {
+      // The name is copied as the cache may be rehashed by concurrent scrapes
+      // between chunks.
+      metric_name_ = cache_.metricName(group_->first, custom_namespaces_, generation_);
+      if (metric_name_.empty()) {
+        ++group_;
+        continue;
+      }
+      response.addFragments({"# TYPE ", metric_name_, " ", phaseType(), "\n"});
+      std::sort(metrics.begin(), metrics.end(), MetricLessThan());
+    }
+
+    renderMetric(*metrics[metric_index_], response);
+    if (++metric_index_ == metrics.size()) {
+      ++group_;
+      metric_index_ = 0;
+    }
+  }
+  return true;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  groups_.clear();
+  metric_index_ = 0;
+
+  // Only the metrics of the current phase are held, to bound the memory used
+  // by the request.
+  counters_.clear();
+  gauges_.clear();
+  text_readouts_.clear();
+  histograms_.clear();
+  switch (phase_) {
+  case Phase::Counters:
+    counters_ = stats_.counters();
+    populateGroups(counters_);
+    break;
+  case Phase::Gauges:
+    gauges_ = stats_.gauges();
+    populateGroups(gauges_);
+    break;
+  case Phase::TextReadouts:
+    if (params_.prometheus_text_readouts_) {
+      text_readouts_ = stats_.textReadouts();
+      populateGroups(text_readouts_);
+    }
+    break;
+  case Phase::Histograms:
+    histograms_ = stats_.histograms();
+    populateGroups(histograms_);
+    break;
+  }
+  group_ = groups_.begin();
+}
+
+template <class StatType>
+void PrometheusStatsRequest::populateGroups(
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics) {
+  for (const auto& metric : metrics) {
+    if (params_.shouldShowMetric(*metric)) {
+      groups_[metric->tagExtractedStatName()].push_back(metric.get());
+    }
+  }
+}
+
+absl::string_view PrometheusStatsRequest::phaseType() const {
+  switch (phase_) {
+  case Phase::Counters:
+    return "counter";
+  case Phase::Gauges:
+  case Phase::TextReadouts:
+    // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+    return "gauge";
+  case Phase::Histograms:
+    break;
+  }
+  return params_.histogram_buckets_mode_ == Utility::HistogramBucketsMode::Summary ? "summary"
+                                                                                   : "histogram";
+}
+
+void PrometheusStatsRequest::renderMetric(const Stats::Metric& metric,
+                                          Buffer::Instance& response) {
+  const std::string& tags = cache_.formattedTags(metric, generation_);
+  switch (phase_) {
+  case Phase::Counters:
+    response.add(generateNumericOutput(static_cast<const Stats::Counter&>(metric).value(), tags,
+                                       metric_name_));
+    break;
+  case Phase::Gauges:
+    response.add(generateNumericOutput(static_cast<const Stats::Gauge&>(metric).value(), tags,
+                                       metric_name_));
+    break;
+  // Text readouts and histograms derive virtually from Stats::Metric.
+  case Phase::TextReadouts:
+    response.add(generateTextReadoutOutputWithTags(dynamic_cast<const Stats::TextReadout&>(metric),
+                                                   tags, metric_name_));
+    break;
+  case Phase::Histograms: {
+    const auto& histogram = dynamic_cast<const Stats::ParentHistogram&>(metric);
+    if (params_.histogram_buckets_mode_ == Utility::HistogramBucketsMode::Summary) {
+      response.add(generateSummaryOutputWithTags(histogram, tags, metric_name_));
+    } else {
+      response.add(generateHistogramOutputWithTags(histogram, tags, metric_name_));
+    }
+    break;
+  }
+  }
+}
+
+void PrometheusStatsRequest::renderPerHostMetrics(Buffer::Instance& response) {
+  // As in StatsRequest, per-host stats are rendered in one batch, as there is no
+  // shared pointer to hold on to them across chunks.
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+  Upstream::HostUtility::forEachHostMetric(
+      cluster_manager_,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        host_counters.emplace_back(std::move(metric));
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+
+  outputPrimitiveStatType(response, params_, host_counters, "counter", custom_namespaces_);
+  outputPrimitiveStatType(response, params_, host_gauges, "gauge", custom_namespaces_);
+}
+
 } // namespace Server
 } // namespace Envoy
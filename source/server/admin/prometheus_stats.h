@@ -4,10 +4,13 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
@@ -53,5 +56,131 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Caches the sanitized prometheus metric names and formatted labels of stats
+ * across scrapes, so that a scrape of stats that were already rendered only
+ * has to format their values. Entries hold references to the symbols of the
+ * stat names; entries for stats that are not rendered by any of the last
+ * MaxIdleScrapes scrapes are released when a scrape completes.
+ *
+ * This is only accessed from the main thread.
+ */
+class PrometheusNameCache {
+public:
+  static constexpr uint64_t MaxIdleScrapes = 4;
+
+  explicit PrometheusNameCache(Stats::SymbolTable& symbol_table);
+  ~PrometheusNameCache();
+
+  /**
+   * @return the generation to pass to lookups made on behalf of a new scrape.
+   */
+  uint64_t startScrape() { return ++generation_; }
+
+  /**
+   * Releases the entries that were not used by the recent scrapes.
+   */
+  void endScrape();
+
+  /**
+   * @return the prometheus metric name for a tag-extracted stat name, or an
+   *         empty string if the name cannot be exported to prometheus. See
+   *         PrometheusStatsFormatter::metricName.
+   */
+  const std::string& metricName(Stats::StatName tag_extracted_name,
+                                const Stats::CustomStatNamespaces& custom_namespaces,
+                                uint64_t generation);
+
+  /**
+   * @return the formatted tags of the metric. See PrometheusStatsFormatter::formattedTags.
+   */
+  const std::string& formattedTags(const Stats::Metric& metric, uint64_t generation);
+
+  /**
+   * @return the number of cached metric names and tags, for testing.
+   */
+  uint64_t size() const { return names_.size() + tags_.size(); }
+
+private:
+  struct Entry {
+    Stats::StatNameStorage storage_;
+    std::string rendered_;
+    uint64_t generation_;
+  };
+  using EntryMap = Stats::StatNameHashMap<Entry>;
+
+  template <class RenderFn>
+  const std::string& lookup(EntryMap& map, Stats::StatName name, uint64_t generation,
+                            RenderFn render);
+  void sweep(EntryMap& map);
+
+  Stats::SymbolTable& symbol_table_;
+  EntryMap names_;
+  EntryMap tags_;
+  uint64_t generation_{0};
+};
+
+/**
+ * Streams a prometheus scrape out in chunks, so that the main thread can serve
+ * other events between chunks of a large scrape. The output is identical to
+ * PrometheusStatsFormatter::statsAsPrometheus: each stat type is grouped by
+ * tag-extracted name, and the groups are emitted in order. Names and labels are
+ * rendered through a PrometheusNameCache shared across scrapes.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+  // Ordered to match the output of PrometheusStatsFormatter::statsAsPrometheus.
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms };
+
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusNameCache& cache);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+
+  // Emits the groups of the current phase until the chunk size is reached,
+  // resuming in the middle of a group if needed. Only the metrics of the
+  // current phase are held, and they are grouped when the phase starts, as
+  // the whole phase has to be visited to collect the members of each group.
+  // Per-host stats are rendered in a single batch at the end, as there is no
+  // way to hold on to them across chunks.
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  using MetricGroups =
+      std::map<Stats::StatName, std::vector<const Stats::Metric*>, Stats::StatNameLessThan>;
+
+  void startPhase();
+  template <class StatType>
+  void populateGroups(const std::vector<Stats::RefcountPtr<StatType>>& metrics);
+  absl::string_view phaseType() const;
+  void renderMetric(const Stats::Metric& metric, Buffer::Instance& response);
+  void renderPerHostMetrics(Buffer::Instance& response);
+
+  StatsParams params_;
+  Stats::Store& stats_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusNameCache& cache_;
+  uint64_t generation_{0};
+  Phase phase_{Phase::Counters};
+  std::vector<Stats::CounterSharedPtr> counters_;
+  std::vector<Stats::GaugeSharedPtr> gauges_;
+  std::vector<Stats::TextReadoutSharedPtr> text_readouts_;
+  std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+  MetricGroups groups_;
+  MetricGroups::iterator group_;
+  size_t metric_index_{0};
+  std::string metric_name_;
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -1,12 +1,19 @@
 #include "source/server/admin/server_info_handler.h"
 
+#include <algorithm>
+
+#include "envoy/admin/v3/dispatchers.pb.h"
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "source/common/buffer/watermark_buffer.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/http/headers.h"
 #include "source/common/memory/stats.h"
 #include "source/common/version/version.h"
 #include "source/server/utils.h"
 
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -54,6 +61,91 @@ Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_he
   return Http::Code::OK;
 }
 
+Http::Code ServerInfoHandler::handlerMemoryStreams(Http::ResponseHeaderMap& response_headers,
+                                                   Buffer::Instance& response,
+                                                   AdminStream& admin_stream) {
+  uint64_t max_streams = DefaultMaxMemoryStreams;
+  const Http::Utility::QueryParamsMulti params = admin_stream.queryParams();
+  const absl::optional<std::string> limit = params.getFirstValue("limit");
+  if (limit.has_value() && (!absl::SimpleAtoi(limit.value(), &max_streams) || max_streams == 0)) {
+    response.add("limit must be a positive integer\n");
+    return Http::Code::BadRequest;
+  }
+
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  envoy::admin::v3::StreamsMemory streams_memory;
+  const Buffer::WatermarkBufferFactory::AccountsSummary summary =
+      Buffer::WatermarkBufferFactory::largestAccounts(max_streams);
+  for (const auto& account : summary.accounts_) {
+    envoy::admin::v3::StreamsMemory::StreamMemory& stream = *streams_memory.add_streams();
+    stream.set_connection_id(account.connection_id_);
+    stream.set_stream_id(account.stream_id_);
+    stream.set_buffer_bytes(account.buffer_bytes_);
+    stream.set_non_buffer_bytes(account.non_buffer_bytes_);
+  }
+  for (const auto& connection : summary.connections_) {
+    envoy::admin::v3::StreamsMemory::ConnectionMemory& connection_memory =
+        *streams_memory.add_connections();
+    connection_memory.set_connection_id(connection.connection_id_);
+    connection_memory.set_bytes(connection.bytes_);
+    connection_memory.set_streams(connection.streams_);
+  }
+  response.add(MessageUtil::getJsonStringFromMessageOrError(streams_memory, true, true));
+  return Http::Code::OK;
+}
+
+Http::Code ServerInfoHandler::handlerDispatchers(Http::ResponseHeaderMap& response_headers,
+                                                 Buffer::Instance& response, AdminStream&) {
+  if (!server_.bootstrap().enable_dispatcher_stats() ||
+      !server_.bootstrap().enable_dispatcher_callback_stats()) {
+    response.add("Dispatcher callback stats are not enabled. To enable, set both "
+                 "enable_dispatcher_stats and enable_dispatcher_callback_stats in the bootstrap.");
+    return Http::Code::OK;
+  }
+
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  envoy::admin::v3::Dispatchers dispatchers;
+  Event::CallbackProfiler::forEach([&dispatchers](const Event::CallbackProfiler& profiler) {
+    envoy::admin::v3::DispatcherCallbacks& dispatcher = *dispatchers.add_dispatchers();
+    dispatcher.set_name(profiler.dispatcherName());
+    for (const auto& slow_callback : profiler.slowestCallbacks()) {
+      envoy::admin::v3::SlowCallback& callback = *dispatcher.add_slowest_callbacks();
+      switch (slow_callback.category_) {
+      case Event::CallbackCategory::FileEvent:
+        callback.set_category(envoy::admin::v3::SlowCallback::FILE_EVENT);
+        break;
+      case Event::CallbackCategory::Timer:
+        callback.set_category(envoy::admin::v3::SlowCallback::TIMER);
+        break;
+      case Event::CallbackCategory::PostCallback:
+        callback.set_category(envoy::admin::v3::SlowCallback::POST_CALLBACK);
+        break;
+      case Event::CallbackCategory::DeferredDelete:
+        callback.set_category(envoy::admin::v3::SlowCallback::DEFERRED_DELETE);
+        break;
+      case Event::CallbackCategory::SchedulableCallback:
+        callback.set_category(envoy::admin::v3::SlowCallback::SCHEDULABLE_CALLBACK);
+        break;
+      }
+      *callback.mutable_duration() =
+          Protobuf::util::TimeUtil::MicrosecondsToDuration(slow_callback.duration_.count());
+      if (slow_callback.tracked_object_type_ != nullptr) {
+        callback.set_tracked_object_type(
+            Event::CallbackProfiler::typeName(slow_callback.tracked_object_type_));
+      }
+      TimestampUtil::systemClockToTimestamp(slow_callback.time_, *callback.mutable_time());
+    }
+  });
+  // The profilers are registered in no particular order.
+  std::sort(dispatchers.mutable_dispatchers()->begin(), dispatchers.mutable_dispatchers()->end(),
+            [](const envoy::admin::v3::DispatcherCallbacks& lhs,
+               const envoy::admin::v3::DispatcherCallbacks& rhs) {
+              return lhs.name() < rhs.name();
+            });
+  response.add(MessageUtil::getJsonStringFromMessageOrError(dispatchers, true, true));
+  return Http::Code::OK;
+}
+
 Http::Code ServerInfoHandler::handlerReady(Http::ResponseHeaderMap&, Buffer::Instance& response,
                                            AdminStream&) {
   const envoy::admin::v3::ServerInfo::State state =
@@ -16,6 +16,9 @@ namespace Server {
 class ServerInfoHandler : public HandlerContextBase {
 
 public:
+  // The number of streams /memory/streams prints unless a limit is given.
+  static constexpr uint64_t DefaultMaxMemoryStreams = 10;
+
   ServerInfoHandler(Server::Instance& server);
 
   Http::Code handlerCerts(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
@@ -32,6 +35,12 @@ public:
 
   Http::Code handlerMemory(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
                            AdminStream&);
+
+  Http::Code handlerMemoryStreams(Http::ResponseHeaderMap& response_headers,
+                                  Buffer::Instance& response, AdminStream&);
+
+  Http::Code handlerDispatchers(Http::ResponseHeaderMap& response_headers,
+                                Buffer::Instance& response, AdminStream&);
 };
 
 } // namespace Server
@@ -10,6 +10,7 @@
 #include "envoy/server/instance.h"
 
 #include "source/server/admin/handler_ctx.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 #include "source/server/admin/utils.h"
 
@@ -33,26 +34,6 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
-
-  /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
-   */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  Http::Code prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
 
   /**
    * Renders the stats as prometheus. This is broken out as a separately
@@ -92,10 +73,21 @@ public:
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
 
+  /**
+   * @return a URL handler streaming the stats in prometheus format, shared by
+   *         /stats/prometheus and /stats?format=prometheus.
+   */
+  Admin::UrlHandler prometheusStatsHandler();
+
+  /**
+   * Creates a request streaming the stats in prometheus format. The rendered
+   * names and labels of the stats are cached across requests.
+   */
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params);
+
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  std::unique_ptr<PrometheusNameCache> prometheus_name_cache_;
 };
 
 } // namespace Server
@@ -89,6 +89,9 @@ public:
   }
   Ssl::ContextManager& sslContextManager() override { return *ssl_context_manager_; }
   Event::Dispatcher& dispatcher() override { return *dispatcher_; }
+  Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t>) override {
+    return *dispatcher_;
+  }
   Network::DnsResolverSharedPtr dnsResolver() override;
   void drainListeners(OptRef<const Network::ExtraShutdownListenerOptions>) override {}
   DrainManager& drainManager() override { return *drain_manager_; }
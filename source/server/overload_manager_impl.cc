@@ -509,13 +509,16 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
       SET_AND_RETURN_IF_NOT_OK(timer_or_error.status(), creation_status);
       timer_minimums_ =
           std::make_shared<const Event::ScaledTimerTypeMap>(std::move(*timer_or_error));
-    } else if (name == OverloadActionNames::get().ResetStreams) {
+    } else if (name == OverloadActionNames::get().ResetStreams ||
+               name == OverloadActionNames::get().ResetLargestStreams) {
       if (!config.has_buffer_factory_config()) {
         creation_status = absl::InvalidArgumentError(
             fmt::format("Overload action \"{}\" requires buffer_factory_config.", name));
         return;
       }
-      makeCounter(api.rootScope(), OverloadActionStatsNames::get().ResetStreamsCount);
+      makeCounter(api.rootScope(), name == OverloadActionNames::get().ResetStreams
+                                       ? OverloadActionStatsNames::get().ResetStreamsCount
+                                       : OverloadActionStatsNames::get().ResetLargestStreamsCount);
     } else if (action.has_typed_config()) {
       creation_status = absl::InvalidArgumentError(fmt::format(
           "Overload action \"{}\" has an unexpected value for the typed_config field", name));
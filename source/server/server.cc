@@ -145,6 +145,14 @@ InstanceBase::~InstanceBase() {
 #endif
 }
 
+Event::Dispatcher& InstanceBase::healthCheckDispatcher(absl::optional<uint64_t> affinity) {
+  if (health_check_threads_ == nullptr) {
+    return *dispatcher_;
+  }
+  return affinity.has_value() ? health_check_threads_->dispatcherFor(*affinity)
+                              : health_check_threads_->nextDispatcher();
+}
+
 Upstream::ClusterManager& InstanceBase::clusterManager() {
   ASSERT(config_.clusterManager() != nullptr);
   return *config_.clusterManager();
@@ -550,6 +558,8 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       bootstrap_.stats_config(), stats_store_.symbolTable(), server_contexts_));
   stats_store_.setHistogramSettings(
       std::make_unique<Stats::HistogramSettingsImpl>(bootstrap_.stats_config(), server_contexts_));
+  stats_store_.symbolTable().setEncodeCacheCapacity(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(bootstrap_.stats_config(), symbol_table_encode_cache_size, 0));
 
   const std::string server_stats_prefix = "server.";
   const std::string server_compilation_settings_stats_prefix = "server.compilation_settings";
@@ -718,6 +728,15 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // Workers get created first so they register for thread local updates.
   listener_manager_ = listener_manager_factory->createListenerManager(
       *this, nullptr, worker_factory_, bootstrap_.enable_dispatcher_stats(), quic_stat_names_);
+  if (bootstrap_.health_check_threads() > 0) {
+    health_check_threads_ = std::make_unique<Event::DispatcherThreads>(
+        "health_check", "hc", bootstrap_.health_check_threads(), thread_local_, *api_);
+  }
+  if (bootstrap_.xds_decoding_threads() > 0) {
+    xds_decoding_pool_ =
+        std::make_unique<Config::XdsDecodingPoolLoader>(std::make_unique<Config::XdsDecodingPool>(
+            bootstrap_.xds_decoding_threads(), thread_local_, *api_));
+  }
 
   // We can now initialize stats for threading.
   stats_store_.initializeThreading(*dispatcher_, thread_local_);
@@ -725,6 +744,17 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // It's now safe to start writing stats from the main thread's dispatcher.
   if (bootstrap_.enable_dispatcher_stats()) {
     dispatcher_->initializeStats(*stats_store_.rootScope(), "server.");
+    if (bootstrap_.enable_dispatcher_callback_stats()) {
+      dispatcher_->initializeCallbackStats(*stats_store_.rootScope());
+    }
+    if (health_check_threads_ != nullptr) {
+      health_check_threads_->initializeStats(*stats_store_.rootScope(),
+                                             bootstrap_.enable_dispatcher_callback_stats());
+    }
+    if (xds_decoding_pool_ != nullptr) {
+      xds_decoding_pool_->instance().initializeStats(*stats_store_.rootScope(),
+                                                     bootstrap_.enable_dispatcher_callback_stats());
+    }
   }
 
   // The broad order of initialization from this point on is the following:
@@ -1108,6 +1138,15 @@ void InstanceBase::terminate() {
   if (config_.clusterManager() != nullptr) {
     config_.clusterManager()->shutdown();
   }
+  // The health checkers running on the health check threads, including those of the HDS clusters,
+  // are destroyed on these threads, so they must be gone before the threads are stopped.
+  if (health_check_threads_ != nullptr) {
+    hds_delegate_.reset();
+    health_check_threads_->stop();
+  }
+  if (xds_decoding_pool_ != nullptr) {
+    xds_decoding_pool_->instance().stop();
+  }
   handler_.reset();
   thread_local_.shutdownThread();
   restarter_.shutdown();
@@ -29,6 +29,8 @@
 #include "source/common/common/cleanup.h"
 #include "source/common/common/logger_delegates.h"
 #include "source/common/common/perf_tracing.h"
+#include "source/common/config/xds_decoding_pool.h"
+#include "source/common/event/dispatcher_threads.h"
 #include "source/common/grpc/async_client_manager_impl.h"
 #include "source/common/grpc/context_impl.h"
 #include "source/common/http/context_impl.h"
@@ -190,6 +192,9 @@ public:
     return server_.httpServerPropertiesCacheManager();
   }
   Event::Dispatcher& mainThreadDispatcher() override { return server_.dispatcher(); }
+  Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) override {
+    return server_.healthCheckDispatcher(affinity);
+  }
   const Server::Options& options() override { return server_.options(); }
   const LocalInfo::LocalInfo& localInfo() const override { return server_.localInfo(); }
   ProtobufMessage::ValidationContext& messageValidationContext() override {
@@ -277,6 +282,7 @@ public:
   }
   Ssl::ContextManager& sslContextManager() override { return *ssl_context_manager_; }
   Event::Dispatcher& dispatcher() override { return *dispatcher_; }
+  Event::Dispatcher& healthCheckDispatcher(absl::optional<uint64_t> affinity) override;
   Network::DnsResolverSharedPtr dnsResolver() override { return dns_resolver_; }
   void drainListeners(OptRef<const Network::ExtraShutdownListenerOptions> options) override;
   DrainManager& drainManager() override { return *drain_manager_; }
@@ -410,6 +416,8 @@ private:
   std::unique_ptr<Runtime::Loader> runtime_;
   ProdWorkerFactory worker_factory_;
   std::unique_ptr<ListenerManager> listener_manager_;
+  Event::DispatcherThreadsPtr health_check_threads_;
+  std::unique_ptr<Config::XdsDecodingPoolLoader> xds_decoding_pool_;
   absl::node_hash_map<Stage, LifecycleNotifierCallbacks> stage_callbacks_;
   absl::node_hash_map<Stage, LifecycleNotifierCompletionCallbacks> stage_completable_callbacks_;
   Configuration::MainImpl config_;
@@ -48,7 +48,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        WorkerStatNames& stat_names)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      reset_largest_streams_counter_(
+          api_.rootScope().counterFromStatName(stat_names.reset_largest_memory_streams_)) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -59,6 +61,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().ResetLargestStreams, *dispatcher_,
+      [this](OverloadActionState state) { resetLargestMemoryStreams(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -119,7 +124,12 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
       [this, guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
 
-void WorkerImpl::initializeStats(Stats::Scope& scope) { dispatcher_->initializeStats(scope); }
+void WorkerImpl::initializeStats(Stats::Scope& scope) {
+  dispatcher_->initializeStats(scope);
+  if (api_.bootstrap().enable_dispatcher_callback_stats()) {
+    dispatcher_->initializeCallbackStats(scope);
+  }
+}
 
 void WorkerImpl::stop() {
   // It's possible for the server to cleanly shut down while cluster initialization during startup
@@ -186,5 +196,11 @@ void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   reset_streams_counter_.add(streams_reset_count);
 }
 
+void WorkerImpl::resetLargestMemoryStreams(OverloadActionState state) {
+  uint64_t streams_reset_count =
+      dispatcher_->getWatermarkFactory().resetLargestAccounts(state.value().value());
+  reset_largest_streams_counter_.add(streams_reset_count);
+}
+
 } // namespace Server
 } // namespace Envoy
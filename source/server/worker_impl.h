@@ -20,10 +20,13 @@ namespace Server {
 struct WorkerStatNames {
   explicit WorkerStatNames(Stats::SymbolTable& symbol_table)
       : pool_(symbol_table),
-        reset_high_memory_stream_(pool_.add(OverloadActionStatsNames::get().ResetStreamsCount)) {}
+        reset_high_memory_stream_(pool_.add(OverloadActionStatsNames::get().ResetStreamsCount)),
+        reset_largest_memory_streams_(
+            pool_.add(OverloadActionStatsNames::get().ResetLargestStreamsCount)) {}
 
   Stats::StatNamePool pool_;
   Stats::StatName reset_high_memory_stream_;
+  Stats::StatName reset_largest_memory_streams_;
 };
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
@@ -74,6 +77,7 @@ private:
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
+  void resetLargestMemoryStreams(OverloadActionState state);
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -81,6 +85,7 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  Stats::Counter& reset_largest_streams_counter_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
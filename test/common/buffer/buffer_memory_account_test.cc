@@ -365,6 +365,32 @@ TEST_F(BufferMemoryAccountTest, AccountShouldNotBeTrackedByFactoryUnlessAboveMin
   account->clearDownstream();
 }
 
+TEST_F(BufferMemoryAccountTest, NonBufferChargesDoNotCountTowardsTracking) {
+  auto account = factory_.createAccount(mock_reset_handler_);
+  auto* account_impl = static_cast<BufferMemoryAccountImpl*>(account.get());
+
+  account->charge(kMinimumBalanceToTrack / 2);
+  account->chargeNonBuffer(kMinimumBalanceToTrack);
+  EXPECT_EQ(account_impl->bufferBalance(), kMinimumBalanceToTrack / 2);
+  EXPECT_EQ(account_impl->nonBufferBalance(), kMinimumBalanceToTrack);
+  EXPECT_EQ(getBalance(account), kMinimumBalanceToTrack * 3 / 2);
+  factory_.inspectMemoryClasses(noAccountsTracked);
+
+  // Check now tracked, by the buffer balance only.
+  account->charge(kMinimumBalanceToTrack / 2);
+  factory_.inspectMemoryClasses([](MemoryClassesToAccountsSet& memory_classes_to_account) {
+    EXPECT_EQ(memory_classes_to_account[0].size(), 1);
+  });
+
+  account->creditNonBuffer(kMinimumBalanceToTrack);
+  factory_.inspectMemoryClasses([](MemoryClassesToAccountsSet& memory_classes_to_account) {
+    EXPECT_EQ(memory_classes_to_account[0].size(), 1);
+  });
+
+  account->credit(kMinimumBalanceToTrack);
+  account->clearDownstream();
+}
+
 TEST_F(BufferMemoryAccountTest, ClearingDownstreamShouldUnregisterTrackedAccounts) {
   auto account = factory_.createAccount(mock_reset_handler_);
   account->charge(kMinimumBalanceToTrack);
@@ -587,7 +613,9 @@ struct AccountWithResetHandler {
 
   void expectResetStream() {
     EXPECT_CALL(*reset_handler_, resetStream(_)).WillOnce([this](Http::StreamResetReason) {
-      account_->credit(getBalance(account_));
+      const auto& account_impl = static_cast<const BufferMemoryAccountImpl&>(*account_);
+      account_->credit(account_impl.bufferBalance());
+      account_->creditNonBuffer(account_impl.nonBufferBalance());
       account_->clearDownstream();
       reset_handler_invoked_ = true;
     });
@@ -680,6 +708,162 @@ TEST(WatermarkBufferFactoryTest,
   }
 }
 
+TEST(WatermarkBufferFactoryTest, ResetsLargestAccountsByExactBalance) {
+  TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
+
+  // The accounts in the final bucket differ by less than the size of a bucket.
+  std::vector<AccountWithResetHandlerPtr> accounts;
+  for (int i = 0; i < 5; ++i) {
+    accounts.push_back(std::make_unique<AccountWithResetHandler>(factory));
+    accounts.back()->account_->charge(kThresholdForFinalBucket + i * kMinimumBalanceToTrack);
+  }
+  for (int i = 0; i < 3; ++i) {
+    accounts.push_back(std::make_unique<AccountWithResetHandler>(factory));
+    accounts.back()->account_->charge(kMinimumBalanceToTrack);
+  }
+
+  // No streams are reset without pressure.
+  EXPECT_EQ(factory.resetLargestAccounts(0), 0);
+
+  // With the default of 10 streams to reset, a pressure of 0.25 resets the 3 largest.
+  for (int i = 2; i < 5; ++i) {
+    accounts[i]->expectResetStream();
+  }
+  EXPECT_LOG_CONTAINS("warn", "resetting the 3 streams using the most memory",
+                      EXPECT_EQ(factory.resetLargestAccounts(0.25), 3));
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(accounts[i]->reset_handler_invoked_, i >= 2 && i < 5);
+  }
+
+  // The remaining accounts span buckets, and are all reset when saturated.
+  for (int i = 0; i < 8; ++i) {
+    if (!accounts[i]->reset_handler_invoked_) {
+      accounts[i]->expectResetStream();
+    }
+  }
+  EXPECT_EQ(factory.resetLargestAccounts(1.0), 5);
+  EXPECT_EQ(factory.resetLargestAccounts(1.0), 0);
+}
+
+TEST(WatermarkBufferFactoryTest, CanConfigureLargestStreamsToReset) {
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  config.mutable_largest_streams_to_reset()->set_value(1);
+  WatermarkBufferFactory factory(config);
+
+  AccountWithResetHandler smaller(factory);
+  AccountWithResetHandler larger(factory);
+  smaller.account_->charge(kMinimumBalanceToTrack);
+  larger.account_->charge(2 * kMinimumBalanceToTrack);
+
+  larger.expectResetStream();
+  EXPECT_EQ(factory.resetLargestAccounts(1.0), 1);
+  EXPECT_TRUE(larger.reset_handler_invoked_);
+  EXPECT_FALSE(smaller.reset_handler_invoked_);
+
+  smaller.account_->credit(kMinimumBalanceToTrack);
+  smaller.account_->clearDownstream();
+}
+
+TEST(WatermarkBufferFactoryTest, ResetsLargestAccountsIncludingNonBufferCharges) {
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  config.mutable_largest_streams_to_reset()->set_value(1);
+  WatermarkBufferFactory factory(config);
+
+  // The account with the smaller buffer balance, in a lower bucket, has the larger balance.
+  AccountWithResetHandler larger_buffers(factory);
+  AccountWithResetHandler larger(factory);
+  larger_buffers.account_->charge(2 * kMinimumBalanceToTrack);
+  larger.account_->charge(kMinimumBalanceToTrack);
+  larger.account_->chargeNonBuffer(2 * kMinimumBalanceToTrack);
+
+  larger.expectResetStream();
+  EXPECT_EQ(factory.resetLargestAccounts(1.0), 1);
+  EXPECT_TRUE(larger.reset_handler_invoked_);
+  EXPECT_FALSE(larger_buffers.reset_handler_invoked_);
+
+  larger_buffers.account_->credit(2 * kMinimumBalanceToTrack);
+  larger_buffers.account_->clearDownstream();
+}
+
+TEST(WatermarkBufferFactoryTest, ResetsLargestAccountsAboveMinimumOnlyWithNonBufferCharges) {
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+  WatermarkBufferFactory factory(config);
+
+  // The account is only above the minimum with the memory of its headers, so it is in no bucket.
+  AccountWithResetHandler headers(factory);
+  headers.account_->setOwner(1, 1);
+  headers.account_->charge(kMinimumBalanceToTrack / 2);
+  headers.account_->chargeNonBuffer(kMinimumBalanceToTrack);
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), 0);
+  EXPECT_FALSE(headers.reset_handler_invoked_);
+
+  auto summary = WatermarkBufferFactory::largestAccounts(10);
+  ASSERT_EQ(summary.accounts_.size(), 1);
+  EXPECT_EQ(summary.accounts_[0].stream_id_, 1);
+  EXPECT_EQ(summary.accounts_[0].non_buffer_bytes_, kMinimumBalanceToTrack);
+
+  headers.expectResetStream();
+  EXPECT_EQ(factory.resetLargestAccounts(1.0), 1);
+  EXPECT_TRUE(headers.reset_handler_invoked_);
+  EXPECT_TRUE(WatermarkBufferFactory::largestAccounts(10).accounts_.empty());
+}
+
+TEST(WatermarkBufferFactoryTest, ReportsLargestAccountsOfEveryFactory) {
+  TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
+  TrackedWatermarkBufferFactory other_factory(absl::bit_width(kMinimumBalanceToTrack));
+  Http::MockStreamResetHandler reset_handler;
+
+  auto untracked = factory.createAccount(reset_handler);
+  untracked->setOwner(1, 1);
+  untracked->charge(kMinimumBalanceToTrack / 2);
+  auto smaller = factory.createAccount(reset_handler);
+  smaller->setOwner(1, 2);
+  smaller->charge(kMinimumBalanceToTrack);
+  auto other_smaller = other_factory.createAccount(reset_handler);
+  other_smaller->setOwner(1, 4);
+  other_smaller->charge(kMinimumBalanceToTrack);
+  auto larger = other_factory.createAccount(reset_handler);
+  larger->setOwner(2, 3);
+  larger->charge(kMinimumBalanceToTrack);
+  larger->chargeNonBuffer(100);
+
+  auto summary = WatermarkBufferFactory::largestAccounts(10);
+  ASSERT_EQ(summary.accounts_.size(), 3);
+  EXPECT_EQ(summary.accounts_[0].connection_id_, 2);
+  EXPECT_EQ(summary.accounts_[0].stream_id_, 3);
+  EXPECT_EQ(summary.accounts_[0].buffer_bytes_, kMinimumBalanceToTrack);
+  EXPECT_EQ(summary.accounts_[0].non_buffer_bytes_, 100);
+  EXPECT_EQ(summary.accounts_[1].connection_id_, 1);
+  EXPECT_EQ(summary.accounts_[1].buffer_bytes_, kMinimumBalanceToTrack);
+  EXPECT_EQ(summary.accounts_[1].non_buffer_bytes_, 0);
+  // The untracked account is not counted in the total of its connection.
+  ASSERT_EQ(summary.connections_.size(), 2);
+  EXPECT_EQ(summary.connections_[0].connection_id_, 1);
+  EXPECT_EQ(summary.connections_[0].bytes_, 2 * kMinimumBalanceToTrack);
+  EXPECT_EQ(summary.connections_[0].streams_, 2);
+  EXPECT_EQ(summary.connections_[1].connection_id_, 2);
+  EXPECT_EQ(summary.connections_[1].bytes_, kMinimumBalanceToTrack + 100);
+  EXPECT_EQ(summary.connections_[1].streams_, 1);
+
+  // The connection totals include the accounts that are not returned.
+  summary = WatermarkBufferFactory::largestAccounts(1);
+  ASSERT_EQ(summary.accounts_.size(), 1);
+  EXPECT_EQ(summary.accounts_[0].stream_id_, 3);
+  ASSERT_EQ(summary.connections_.size(), 1);
+  EXPECT_EQ(summary.connections_[0].connection_id_, 1);
+  EXPECT_EQ(summary.connections_[0].bytes_, 2 * kMinimumBalanceToTrack);
+
+  for (auto* account : {&untracked, &smaller, &other_smaller, &larger}) {
+    auto* account_impl = static_cast<BufferMemoryAccountImpl*>(account->get());
+    (*account)->credit(account_impl->bufferBalance());
+    (*account)->creditNonBuffer(account_impl->nonBufferBalance());
+    (*account)->clearDownstream();
+  }
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
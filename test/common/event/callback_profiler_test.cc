@@ -0,0 +1,127 @@
+#include <chrono>
+#include <vector>
+
+#include "source/common/event/callback_profiler.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class OtherTrackedObject : public ScopeTrackedObject {
+public:
+  void dumpState(std::ostream&, int) const override {}
+};
+
+class CallbackProfilerTest : public testing::Test {
+protected:
+  void runCallback(CallbackCategory category, std::chrono::milliseconds duration,
+                   const ScopeTrackedObject* tracked_object = nullptr) {
+    CallbackProfiler::ScopedCallback profiled(&profiler_, category, tracked_object);
+    time_system_.advanceTimeWait(duration);
+  }
+
+  std::vector<int64_t> slowestDurations() {
+    std::vector<int64_t> durations;
+    for (const auto& slow_callback : profiler_.slowestCallbacks()) {
+      durations.push_back(
+          std::chrono::duration_cast<std::chrono::milliseconds>(slow_callback.duration_).count());
+    }
+    return durations;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  CallbackProfiler profiler_{"test_thread", *store_.rootScope(), "test.dispatcher.", time_system_};
+};
+
+TEST_F(CallbackProfilerTest, KeepsSlowestCallbacks) {
+  for (int64_t duration = 1; duration <= 20; ++duration) {
+    // Neither in ascending nor in descending order.
+    runCallback(CallbackCategory::Timer, std::chrono::milliseconds((duration * 7) % 20 + 1));
+  }
+  EXPECT_THAT(slowestDurations(), testing::ElementsAre(20, 19, 18, 17, 16, 15, 14, 13, 12, 11));
+
+  // Not slower than the slowest callbacks.
+  runCallback(CallbackCategory::PostCallback, std::chrono::milliseconds(11));
+  EXPECT_EQ(11, slowestDurations().back());
+  runCallback(CallbackCategory::PostCallback, std::chrono::milliseconds(30));
+  EXPECT_EQ(30, slowestDurations().front());
+  EXPECT_EQ(CallbackCategory::PostCallback, profiler_.slowestCallbacks().front().category_);
+  EXPECT_EQ(CallbackProfiler::MaxSlowCallbacks, profiler_.slowestCallbacks().size());
+}
+
+TEST_F(CallbackProfilerTest, AttributesCallbacksToTrackedObjects) {
+  MockScopeTrackedObject tracked_object;
+  OtherTrackedObject other_tracked_object;
+  runCallback(CallbackCategory::FileEvent, std::chrono::milliseconds(3), &tracked_object);
+  {
+    // Only the first object tracked during the callback is kept.
+    CallbackProfiler::ScopedCallback profiled(&profiler_, CallbackCategory::Timer, nullptr);
+    profiler_.onTrackedObject(tracked_object);
+    profiler_.onTrackedObject(other_tracked_object);
+    time_system_.advanceTimeWait(std::chrono::milliseconds(2));
+  }
+  runCallback(CallbackCategory::DeferredDelete, std::chrono::milliseconds(1));
+  // Objects tracked between callbacks are not attributed to the next one.
+  profiler_.onTrackedObject(tracked_object);
+  runCallback(CallbackCategory::SchedulableCallback, std::chrono::milliseconds(1));
+
+  const auto slowest = profiler_.slowestCallbacks();
+  ASSERT_EQ(4, slowest.size());
+  EXPECT_EQ(CallbackCategory::FileEvent, slowest[0].category_);
+  EXPECT_EQ("Envoy::MockScopeTrackedObject",
+            CallbackProfiler::typeName(slowest[0].tracked_object_type_));
+  EXPECT_EQ(CallbackCategory::Timer, slowest[1].category_);
+  EXPECT_EQ("Envoy::MockScopeTrackedObject",
+            CallbackProfiler::typeName(slowest[1].tracked_object_type_));
+  EXPECT_EQ(nullptr, slowest[2].tracked_object_type_);
+  EXPECT_EQ(nullptr, slowest[3].tracked_object_type_);
+}
+
+TEST_F(CallbackProfilerTest, NestedCallbacksAreNotProfiledSeparately) {
+  {
+    CallbackProfiler::ScopedCallback profiled(&profiler_, CallbackCategory::PostCallback, nullptr);
+    time_system_.advanceTimeWait(std::chrono::milliseconds(2));
+    runCallback(CallbackCategory::DeferredDelete, std::chrono::milliseconds(3));
+  }
+  const auto slowest = profiler_.slowestCallbacks();
+  ASSERT_EQ(1, slowest.size());
+  EXPECT_EQ(CallbackCategory::PostCallback, slowest[0].category_);
+  EXPECT_EQ(std::chrono::milliseconds(5), slowest[0].duration_);
+}
+
+TEST_F(CallbackProfilerTest, Registry) {
+  std::vector<std::string> names;
+  auto collect_names = [&names]() {
+    names.clear();
+    CallbackProfiler::forEach(
+        [&names](const CallbackProfiler& profiler) { names.push_back(profiler.dispatcherName()); });
+  };
+  collect_names();
+  EXPECT_THAT(names, testing::ElementsAre("test_thread"));
+  {
+    CallbackProfiler other("other_thread", *store_.rootScope(), "other.dispatcher.", time_system_);
+    collect_names();
+    EXPECT_THAT(names, testing::UnorderedElementsAre("test_thread", "other_thread"));
+  }
+  collect_names();
+  EXPECT_THAT(names, testing::ElementsAre("test_thread"));
+}
+
+TEST(CallbackProfilerTypeNameTest, Demangles) {
+  EXPECT_EQ("Envoy::MockScopeTrackedObject",
+            CallbackProfiler::typeName(typeid(MockScopeTrackedObject).name()));
+  // Names that cannot be demangled are returned as is.
+  EXPECT_EQ("not a mangled name", CallbackProfiler::typeName("not a mangled name"));
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -372,6 +372,20 @@ TEST_F(DispatcherImplTest, InitializeStats) {
   dispatcher_->initializeStats(scope_, "test.");
 }
 
+TEST_F(DispatcherImplTest, LoopBusyTime) {
+  EXPECT_EQ(std::chrono::microseconds(0), dispatcher_->loopBusyTime());
+  dispatcher_->initializeStats(scope_, "test.");
+  dispatcher_->post([this]() {
+    // The stats are initialized by now, and this runs in a later loop iteration.
+    dispatcher_->post([]() { absl::SleepFor(absl::Milliseconds(10)); });
+  });
+
+  // The busy time is recorded once the loop iteration running the callback completes.
+  while (dispatcher_->loopBusyTime() < std::chrono::milliseconds(10)) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+}
+
 TEST_F(DispatcherImplTest, Post) {
   dispatcher_->post([this]() {
     {
@@ -445,7 +459,7 @@ TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
     // Block dispatcher first to ensure that both posted events below are handled
     // by a single call to runPostCallbacks().
     //
-    // This also ensures that the post_lock_ is not held while callbacks are called,
+    // This also ensures that callbacks can post while the callbacks of the same batch are called,
     // or else this would deadlock.
     Thread::LockGuard lock(mu_);
     dispatcher_->post([this]() { Thread::LockGuard lock(mu_); });
@@ -823,6 +837,92 @@ TEST_F(DispatcherMonotonicTimeTest, ApproximateMonotonicTime) {
   dispatcher_->run(Dispatcher::RunType::Block);
 }
 
+class DispatcherCallbackStatsTest : public testing::Test {
+protected:
+  DispatcherCallbackStatsTest() : api_(Api::createApiForTest()) {
+    dispatcher_ = api_->allocateDispatcher("callback_stats_thread");
+  }
+
+  void initializeStats() {
+    dispatcher_->initializeStats(scope_, "test.");
+    dispatcher_->initializeCallbackStats(scope_);
+    // Runs the posted initialization.
+    dispatcher_->run(Dispatcher::RunType::NonBlock);
+  }
+
+  std::vector<CallbackProfiler::SlowCallback> slowestCallbacks() {
+    std::vector<CallbackProfiler::SlowCallback> slowest;
+    CallbackProfiler::forEach([&slowest](const CallbackProfiler& profiler) {
+      if (profiler.dispatcherName() == "callback_stats_thread") {
+        slowest = profiler.slowestCallbacks();
+      }
+    });
+    return slowest;
+  }
+
+  NiceMock<Stats::MockStore> store_;
+  Stats::Scope& scope_{*store_.rootScope()};
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+TEST_F(DispatcherCallbackStatsTest, InitializeCallbackStats) {
+  for (const std::string name :
+       {"deferred_delete_duration_us", "file_event_duration_us", "post_callback_duration_us",
+        "schedulable_callback_duration_us", "timer_duration_us"}) {
+    EXPECT_CALL(store_, histogram("test.dispatcher." + name, Stats::Histogram::Unit::Microseconds));
+  }
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_queue_depth", Stats::Histogram::Unit::Unspecified));
+  initializeStats();
+}
+
+TEST_F(DispatcherCallbackStatsTest, RecordsSlowestCallbacks) {
+  initializeStats();
+  EXPECT_CALL(store_, deliverHistogramToSinks(_, _)).Times(testing::AnyNumber());
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          testing::Property(&Stats::Metric::name, "test.dispatcher.post_queue_depth"),
+                          2));
+
+  MockScopeTrackedObject tracked_object;
+  dispatcher_->post([this, &tracked_object]() {
+    ScopeTrackerScopeState scope(&tracked_object, *dispatcher_);
+    absl::SleepFor(absl::Milliseconds(10));
+  });
+  dispatcher_->post([this]() {
+    // Deleted within the post callback, which includes its duration.
+    dispatcher_->deferredDelete(std::make_unique<TestDeferredDeletable>([]() {}));
+    dispatcher_->clearDeferredDeleteList();
+  });
+  TimerPtr timer = dispatcher_->createTimer([]() { absl::SleepFor(absl::Milliseconds(5)); });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+
+  const auto slowest = slowestCallbacks();
+  ASSERT_GE(slowest.size(), 2);
+  EXPECT_EQ(CallbackCategory::PostCallback, slowest[0].category_);
+  EXPECT_GE(slowest[0].duration_, std::chrono::milliseconds(10));
+  EXPECT_EQ("Envoy::MockScopeTrackedObject",
+            CallbackProfiler::typeName(slowest[0].tracked_object_type_));
+  EXPECT_EQ(CallbackCategory::Timer, slowest[1].category_);
+  EXPECT_GE(slowest[1].duration_, std::chrono::milliseconds(5));
+  EXPECT_EQ(nullptr, slowest[1].tracked_object_type_);
+  for (const auto& slow_callback : slowest) {
+    EXPECT_NE(CallbackCategory::DeferredDelete, slow_callback.category_);
+  }
+}
+
+TEST_F(DispatcherCallbackStatsTest, NotEnabled) {
+  dispatcher_->initializeStats(scope_, "test.");
+  dispatcher_->post([]() { absl::SleepFor(absl::Milliseconds(1)); });
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  bool found = false;
+  CallbackProfiler::forEach([&found](const CallbackProfiler& profiler) {
+    found |= profiler.dispatcherName() == "callback_stats_thread";
+  });
+  EXPECT_FALSE(found);
+}
+
 class TimerImplTest : public testing::Test {
 protected:
   TimerImplTest() {
@@ -0,0 +1,75 @@
+// Measures the throughput of post() and the latency of the posted callbacks when many threads post
+// to the same dispatcher at once, as the main thread and the workers do on every thread local
+// update.
+
+#include <chrono>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmPostUnderContention(benchmark::State& state) {
+  const int64_t num_producers = state.range(0);
+  const int64_t posts_per_producer = state.range(1);
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Thread::ThreadPtr dispatcher_thread = api->threadFactory().createThread(
+      [&dispatcher]() { dispatcher->run(Dispatcher::RunType::RunUntilExit); });
+
+  // Only accessed from the dispatcher thread.
+  int64_t remaining = 0;
+  std::chrono::nanoseconds total_latency{};
+  int64_t total_posts = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    remaining = num_producers * posts_per_producer;
+    absl::Notification all_ran;
+    absl::Notification start;
+    std::vector<Thread::ThreadPtr> producers;
+    for (int64_t i = 0; i < num_producers; ++i) {
+      producers.push_back(api->threadFactory().createThread([&]() {
+        start.WaitForNotification();
+        for (int64_t j = 0; j < posts_per_producer; ++j) {
+          const auto posted = std::chrono::steady_clock::now();
+          dispatcher->post([&, posted]() {
+            total_latency += std::chrono::steady_clock::now() - posted;
+            if (--remaining == 0) {
+              all_ran.Notify();
+            }
+          });
+        }
+      }));
+    }
+    start.Notify();
+    all_ran.WaitForNotification();
+    for (auto& producer : producers) {
+      producer->join();
+    }
+    total_posts += num_producers * posts_per_producer;
+  }
+
+  dispatcher->exit();
+  dispatcher_thread->join();
+  state.counters["posts"] = benchmark::Counter(total_posts, benchmark::Counter::kIsRate);
+  state.counters["mean_latency_us"] =
+      std::chrono::duration<double, std::micro>(total_latency).count() / total_posts;
+}
+BENCHMARK(bmPostUnderContention)
+    ->ArgNames({"producers", "posts"})
+    ->ArgsProduct({{1, 8, 64}, {1000}})
+    ->UseRealTime()
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#include "source/common/event/dispatcher_threads.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class DispatcherThreadsTest : public testing::Test {
+public:
+  Api::ApiPtr api_{Api::createApiForTest()};
+  NiceMock<ThreadLocal::MockInstance> tls_;
+};
+
+// Verify that the threads are registered for thread local updates and handed out in turn.
+TEST_F(DispatcherThreadsTest, NextDispatcher) {
+  EXPECT_CALL(tls_, registerThread(_, false)).Times(2);
+  DispatcherThreads threads("test", "t", 2, tls_, *api_);
+  EXPECT_EQ(2U, threads.size());
+
+  Dispatcher& first = threads.nextDispatcher();
+  Dispatcher& second = threads.nextDispatcher();
+  EXPECT_NE(&first, &second);
+  EXPECT_EQ(&first, &threads.nextDispatcher());
+  EXPECT_EQ(&second, &threads.nextDispatcher());
+  EXPECT_EQ("test_0", first.name());
+  EXPECT_EQ("test_1", second.name());
+}
+
+// Verify that work with the same affinity is always handed to the same thread.
+TEST_F(DispatcherThreadsTest, DispatcherFor) {
+  DispatcherThreads threads("test", "t", 2, tls_, *api_);
+
+  EXPECT_EQ(&threads.dispatcherFor(1), &threads.dispatcherFor(1));
+  EXPECT_EQ(&threads.dispatcherFor(1), &threads.dispatcherFor(3));
+  EXPECT_NE(&threads.dispatcherFor(1), &threads.dispatcherFor(2));
+  // Handing out dispatchers in turn does not change the thread of an affinity.
+  threads.nextDispatcher();
+  EXPECT_EQ("test_1", threads.dispatcherFor(1).name());
+}
+
+// Verify that stopping the threads runs what was posted to them before.
+TEST_F(DispatcherThreadsTest, StopRunsPostedCallbacks) {
+  DispatcherThreads threads("test", "t", 1, tls_, *api_);
+
+  bool ran = false;
+  Dispatcher& dispatcher = threads.nextDispatcher();
+  dispatcher.post([&ran, &dispatcher]() { ran = dispatcher.isThreadSafe(); });
+  EXPECT_CALL(tls_, shutdownThread());
+  threads.stop();
+  EXPECT_TRUE(ran);
+
+  // Stopping again is a no-op.
+  threads.stop();
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
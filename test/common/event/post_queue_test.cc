@@ -0,0 +1,122 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "source/common/event/post_queue.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::ElementsAre;
+
+// Runs and destroys all the callbacks of a batch.
+void runAll(PostQueue::Batch& batch) {
+  while (!batch.empty()) {
+    batch.front()();
+    batch.popFront();
+  }
+}
+
+TEST(PostQueueTest, PushAndTakeAll) {
+  PostQueue queue;
+  std::vector<int> ran;
+  EXPECT_TRUE(queue.push([&ran]() { ran.push_back(1); }));
+  EXPECT_FALSE(queue.push([&ran]() { ran.push_back(2); }));
+  EXPECT_FALSE(queue.push([&ran]() { ran.push_back(3); }));
+  EXPECT_EQ(3, queue.size());
+
+  PostQueue::Batch batch = queue.takeAll();
+  EXPECT_EQ(0, queue.size());
+  EXPECT_EQ(3, batch.size());
+  // The queue is empty again once the callbacks are taken.
+  EXPECT_TRUE(queue.push([&ran]() { ran.push_back(4); }));
+  runAll(batch);
+  EXPECT_THAT(ran, ElementsAre(1, 2, 3));
+
+  PostQueue::Batch next_batch = queue.takeAll();
+  runAll(next_batch);
+  EXPECT_THAT(ran, ElementsAre(1, 2, 3, 4));
+
+  PostQueue::Batch empty_batch = queue.takeAll();
+  EXPECT_TRUE(empty_batch.empty());
+  EXPECT_EQ(0, empty_batch.size());
+}
+
+TEST(PostQueueTest, CallbacksAreDestroyedInOrder) {
+  std::vector<int> destroyed;
+  auto push = [&destroyed](PostQueue& queue, int id) {
+    auto on_destroy = std::shared_ptr<void>(nullptr, [&destroyed, id](void*) {
+      destroyed.push_back(id);
+    });
+    queue.push([on_destroy]() {});
+  };
+
+  {
+    PostQueue queue;
+    push(queue, 1);
+    push(queue, 2);
+    {
+      PostQueue::Batch batch = queue.takeAll();
+      push(queue, 3);
+      batch.popFront();
+      EXPECT_THAT(destroyed, ElementsAre(1));
+      // The remaining callbacks of a batch are destroyed with it.
+    }
+    EXPECT_THAT(destroyed, ElementsAre(1, 2));
+    // As are the callbacks left in the queue.
+  }
+  EXPECT_THAT(destroyed, ElementsAre(1, 2, 3));
+}
+
+// Callbacks pushed concurrently are all taken, in the order each thread pushed them.
+TEST(PostQueueTest, ConcurrentProducers) {
+  constexpr int NumThreads = 8;
+  constexpr int CallbacksPerThread = 10000;
+  PostQueue queue;
+  std::vector<std::vector<int>> ran(NumThreads);
+  std::atomic<int> wake_ups{0};
+  int batches = 0;
+
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < NumThreads; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&, i]() {
+      for (int j = 0; j < CallbacksPerThread; ++j) {
+        if (queue.push([&ran, i, j]() { ran[i].push_back(j); })) {
+          wake_ups++;
+        }
+      }
+    }));
+  }
+  Thread::ThreadPtr consumer = Thread::threadFactoryForTest().createThread([&]() {
+    uint64_t taken = 0;
+    while (taken < NumThreads * CallbacksPerThread) {
+      PostQueue::Batch batch = queue.takeAll();
+      taken += batch.size();
+      batches += batch.empty() ? 0 : 1;
+      runAll(batch);
+    }
+  });
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  consumer->join();
+
+  // Exactly one push per batch found the queue empty, so only one wake up was needed per batch.
+  EXPECT_EQ(batches, wake_ups.load());
+  for (int i = 0; i < NumThreads; ++i) {
+    ASSERT_EQ(CallbacksPerThread, ran[i].size());
+    for (int j = 0; j < CallbacksPerThread; ++j) {
+      EXPECT_EQ(j, ran[i][j]);
+    }
+  }
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
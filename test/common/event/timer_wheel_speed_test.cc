@@ -0,0 +1,87 @@
+// Compares the cost of enabling and disabling timers with libevent and with the timer wheel, with
+// as many timers as the idle and stream timeouts of a very large number of connections.
+
+#include <chrono>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/common/random_generator.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/runtime/runtime_features.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// Re-enables enabled timers, as the idle timeout of a connection is on each read and write.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmTimerChurn(benchmark::State& state) {
+  Runtime::maybeSetRuntimeGuard("envoy.restart_features.dispatcher_timer_wheel",
+                                state.range(0) == 1);
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Random::RandomGeneratorImpl random;
+
+  std::vector<TimerPtr> timers;
+  timers.reserve(state.range(1));
+  for (int64_t i = 0; i < state.range(1); ++i) {
+    timers.push_back(dispatcher->createTimer([]() {}));
+    timers.back()->enableTimer(std::chrono::milliseconds(10000 + random.random() % 300000));
+  }
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    timers[i++ % timers.size()]->enableTimer(
+        std::chrono::milliseconds(10000 + random.random() % 300000));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  timers.clear();
+  Runtime::maybeSetRuntimeGuard("envoy.restart_features.dispatcher_timer_wheel", false);
+}
+BENCHMARK(bmTimerChurn)
+    ->ArgNames({"wheel", "timers"})
+    ->ArgsProduct({{0, 1}, {1000, 1000000}})
+    ->Unit(::benchmark::kNanosecond);
+
+// Disables and re-enables timers, as stream timeouts are when streams complete and start.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmTimerEnableDisable(benchmark::State& state) {
+  Runtime::maybeSetRuntimeGuard("envoy.restart_features.dispatcher_timer_wheel",
+                                state.range(0) == 1);
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Random::RandomGeneratorImpl random;
+
+  std::vector<TimerPtr> timers;
+  timers.reserve(state.range(1));
+  for (int64_t i = 0; i < state.range(1); ++i) {
+    timers.push_back(dispatcher->createTimer([]() {}));
+    timers.back()->enableTimer(std::chrono::milliseconds(10000 + random.random() % 300000));
+  }
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Timer& timer = *timers[i++ % timers.size()];
+    timer.disableTimer();
+    timer.enableTimer(std::chrono::milliseconds(10000 + random.random() % 300000));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  timers.clear();
+  Runtime::maybeSetRuntimeGuard("envoy.restart_features.dispatcher_timer_wheel", false);
+}
+BENCHMARK(bmTimerEnableDisable)
+    ->ArgNames({"wheel", "timers"})
+    ->ArgsProduct({{0, 1}, {1000, 1000000}})
+    ->Unit(::benchmark::kNanosecond);
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
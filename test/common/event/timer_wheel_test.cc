@@ -0,0 +1,182 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/timer.h"
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::ElementsAre;
+
+class TimerWheelTest : public testing::Test {
+protected:
+  TimerWheelTest() {
+    scoped_runtime_.mergeValues({{"envoy.restart_features.dispatcher_timer_wheel", "true"}});
+    api_ = Api::createApiForTest(time_system_);
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+  }
+
+  void advance(std::chrono::milliseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  // Checks that the timer fires after exactly the given duration.
+  void expectFiresAfter(Timer& timer, bool& fired, std::chrono::milliseconds duration) {
+    advance(duration - std::chrono::milliseconds(1));
+    EXPECT_FALSE(fired);
+    EXPECT_TRUE(timer.enabled());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_TRUE(fired);
+    EXPECT_FALSE(timer.enabled());
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+TEST_F(TimerWheelTest, EnableDisable) {
+  bool fired = false;
+  TimerPtr timer = dispatcher_->createTimer([&fired]() { fired = true; });
+  EXPECT_FALSE(timer->enabled());
+
+  timer->enableTimer(std::chrono::milliseconds(5));
+  EXPECT_TRUE(timer->enabled());
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  advance(std::chrono::milliseconds(10));
+  EXPECT_FALSE(fired);
+
+  timer->enableTimer(std::chrono::milliseconds(20));
+  expectFiresAfter(*timer, fired, std::chrono::milliseconds(20));
+}
+
+TEST_F(TimerWheelTest, ZeroDurationFiresOnNextIteration) {
+  int fired = 0;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    fired++;
+    // Timers enabled for a zero duration from a callback do not run in the same iteration.
+    timer->enableTimer(std::chrono::milliseconds(0));
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  EXPECT_TRUE(timer->enabled());
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(1, fired);
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(2, fired);
+  timer->disableTimer();
+}
+
+TEST_F(TimerWheelTest, FiresInExpiryOrder) {
+  std::vector<int> fired;
+  std::vector<TimerPtr> timers;
+  for (const int duration : {30, 1, 700, 2, 255, 256}) {
+    timers.push_back(dispatcher_->createTimer([&fired, duration]() { fired.push_back(duration); }));
+    timers.back()->enableTimer(std::chrono::milliseconds(duration));
+  }
+  advance(std::chrono::seconds(1));
+  EXPECT_THAT(fired, ElementsAre(1, 2, 30, 255, 256, 700));
+}
+
+TEST_F(TimerWheelTest, LongDurationsAreCascaded) {
+  // Durations in the range of each level of the wheel, and beyond.
+  for (const std::chrono::milliseconds duration :
+       {std::chrono::milliseconds(300), std::chrono::milliseconds(70000),
+        std::chrono::milliseconds(std::chrono::hours(5)),
+        std::chrono::milliseconds(std::chrono::hours(24 * 60))}) {
+    bool fired = false;
+    TimerPtr timer = dispatcher_->createTimer([&fired]() { fired = true; });
+    // Start from a tick that is not aligned on any level.
+    advance(std::chrono::milliseconds(123));
+    timer->enableTimer(duration);
+    expectFiresAfter(*timer, fired, duration);
+  }
+}
+
+TEST_F(TimerWheelTest, RoundsUpToTheNextTick) {
+  bool fired = false;
+  TimerPtr timer = dispatcher_->createTimer([&fired]() { fired = true; });
+  time_system_.advanceTimeWait(std::chrono::microseconds(500));
+  timer->enableTimer(std::chrono::milliseconds(2));
+  advance(std::chrono::milliseconds(2));
+  EXPECT_FALSE(fired);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_TRUE(fired);
+}
+
+TEST_F(TimerWheelTest, PeriodicTimer) {
+  int fired = 0;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    fired++;
+    timer->enableTimer(std::chrono::milliseconds(10));
+  });
+  timer->enableTimer(std::chrono::milliseconds(10));
+  for (int i = 0; i < 100; ++i) {
+    advance(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(100, fired);
+  timer->disableTimer();
+}
+
+TEST_F(TimerWheelTest, CallbacksDisableAndDeleteOtherTimers) {
+  std::vector<int> fired;
+  TimerPtr second = dispatcher_->createTimer([&fired]() { fired.push_back(2); });
+  TimerPtr third = dispatcher_->createTimer([&fired]() { fired.push_back(3); });
+  TimerPtr first = dispatcher_->createTimer([&]() {
+    fired.push_back(1);
+    second.reset();
+    third->disableTimer();
+  });
+  first->enableTimer(std::chrono::milliseconds(5));
+  second->enableTimer(std::chrono::milliseconds(5));
+  third->enableTimer(std::chrono::milliseconds(5));
+  advance(std::chrono::milliseconds(10));
+  EXPECT_THAT(fired, ElementsAre(1));
+  EXPECT_FALSE(third->enabled());
+}
+
+TEST_F(TimerWheelTest, HighResolutionTimer) {
+  bool fired = false;
+  TimerPtr timer = dispatcher_->createTimer([&fired]() { fired = true; });
+  timer->enableHRTimer(std::chrono::microseconds(1500));
+  EXPECT_TRUE(timer->enabled());
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(1499), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(fired);
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(1), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(fired);
+
+  // Switching back to a millisecond timer disables the high resolution one.
+  fired = false;
+  timer->enableHRTimer(std::chrono::microseconds(500));
+  timer->enableTimer(std::chrono::milliseconds(3));
+  expectFiresAfter(*timer, fired, std::chrono::milliseconds(3));
+}
+
+TEST_F(TimerWheelTest, ScaledTimers) {
+  bool fired = false;
+  TimerPtr timer = dispatcher_->createScaledTimer(ScaledTimerMinimum(ScaledMinimum(UnitFloat(0.5))),
+                                                  [&fired]() { fired = true; });
+  timer->enableTimer(std::chrono::milliseconds(100));
+  expectFiresAfter(*timer, fired, std::chrono::milliseconds(100));
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
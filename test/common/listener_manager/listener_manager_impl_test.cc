@@ -8241,6 +8241,52 @@ address:
   EXPECT_FALSE(udp_packet_writer->isBatchMode());
 }
 
+// Steering by peer address installs the reuse port BPF program on UDP listeners when there is more
+// than one worker.
+TEST_P(ListenerManagerImplTest, UdpSteerByPeerAddressConfig) {
+  server_.options_.concurrency_ = 2;
+  const envoy::config::listener::v3::Listener listener = parseListenerFromV3Yaml(R"EOF(
+name: steered
+address:
+  socket_address:
+    address: 127.0.0.1
+    protocol: UDP
+    port_value: 1234
+udp_listener_config:
+  steer_by_peer_address: true
+    )EOF");
+  addOrUpdateListener(listener);
+  ASSERT_EQ(1U, manager_->listeners().size());
+  const Network::Socket::OptionsSharedPtr& options =
+      manager_->listeners().front().get().udpListenerConfig()->listenerFactory().socketOptions();
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  EXPECT_EQ(1U, options->size());
+#else
+  EXPECT_TRUE(options->empty());
+#endif
+
+  // A single worker has nothing to steer between.
+  server_.options_.concurrency_ = 1;
+  const envoy::config::listener::v3::Listener unsteered = parseListenerFromV3Yaml(R"EOF(
+name: single_worker
+address:
+  socket_address:
+    address: 127.0.0.1
+    protocol: UDP
+    port_value: 1235
+udp_listener_config:
+  steer_by_peer_address: true
+    )EOF");
+  addOrUpdateListener(unsteered);
+  ASSERT_EQ(2U, manager_->listeners().size());
+  EXPECT_TRUE(manager_->listeners()[1]
+                  .get()
+                  .udpListenerConfig()
+                  ->listenerFactory()
+                  .socketOptions()
+                  ->empty());
+}
+
 TEST_P(ListenerManagerImplTest, TcpBacklogCustomConfig) {
   const std::string yaml = TestEnvironment::substitute(R"EOF(
     name: TcpBacklogConfigListener
@@ -8352,6 +8398,42 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, EmptyConnectionBalanceConfig) {
 #endif
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, LoadAwareConnectionBalanceConfig) {
+// Envoy always use ExactBalance at WIN32, so ignore it.
+#ifndef WIN32
+  auto listener = createIPv4Listener("TCPListener");
+  listener.mutable_connection_balance_config()->mutable_load_aware_balance();
+  Network::Address::InstanceConstSharedPtr address(
+      new Network::Address::Ipv4Instance("192.168.0.1", 80, nullptr));
+
+  {
+    auto listener_impl = *ListenerImpl::create(listener, "version", *manager_, "foo", true, false,
+                                               /*hash=*/static_cast<uint64_t>(0));
+    auto socket_factory = std::make_unique<Network::MockListenSocketFactory>();
+    EXPECT_CALL(*socket_factory, localAddress()).WillOnce(ReturnRef(address));
+    EXPECT_EQ(listener_impl->addSocketFactory(std::move(socket_factory)).message(),
+              "error adding listener 'foo': load aware connection balancing requires "
+              "enable_dispatcher_stats to be set in the bootstrap");
+  }
+
+  server_.server_factory_context_->bootstrap_.set_enable_dispatcher_stats(true);
+  auto listener_impl = *ListenerImpl::create(listener, "version", *manager_, "foo", true, false,
+                                             /*hash=*/static_cast<uint64_t>(0));
+  auto socket_factory = std::make_unique<Network::MockListenSocketFactory>();
+  EXPECT_CALL(*socket_factory, localAddress()).WillOnce(ReturnRef(address));
+  EXPECT_TRUE(listener_impl->addSocketFactory(std::move(socket_factory)).ok());
+
+  listener.mutable_connection_balance_config()
+      ->mutable_load_aware_balance()
+      ->mutable_connection_migration();
+  auto migrating_listener_impl = *ListenerImpl::create(listener, "version", *manager_, "foo", true,
+                                                       false, /*hash=*/static_cast<uint64_t>(0));
+  socket_factory = std::make_unique<Network::MockListenSocketFactory>();
+  EXPECT_CALL(*socket_factory, localAddress()).WillOnce(ReturnRef(address));
+  EXPECT_TRUE(migrating_listener_impl->addSocketFactory(std::move(socket_factory)).ok());
+#endif
+}
+
 // Test mock socket interface for custom address testing.
 class TestCustomSocketInterface : public Network::SocketInterfaceBase {
 public:
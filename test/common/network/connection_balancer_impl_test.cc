@@ -0,0 +1,231 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "source/common/network/connection_balancer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnPointee;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class LoadAwareConnectionBalancerTest : public testing::Test {
+protected:
+  struct Worker {
+    Worker() {
+      ON_CALL(handler_, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+      ON_CALL(dispatcher_, loopBusyTime()).WillByDefault(ReturnPointee(&busy_time_));
+      ON_CALL(dispatcher_, approximateMonotonicTime()).WillByDefault(ReturnPointee(&now_));
+      ON_CALL(dispatcher_, isThreadSafe()).WillByDefault(ReturnPointee(&current_));
+    }
+
+    NiceMock<Event::MockDispatcher> dispatcher_;
+    NiceMock<MockBalancedConnectionHandler> handler_;
+    Event::MockTimer* timer_{};
+    std::chrono::microseconds busy_time_{};
+    MonotonicTime now_;
+    // Whether the test runs on the worker.
+    bool current_{};
+  };
+
+  LoadAwareConnectionBalancerTest() { ON_CALL(random_, random()).WillByDefault(Return(0)); }
+
+  ~LoadAwareConnectionBalancerTest() override {
+    for (auto& worker : workers_) {
+      balancer_->unregisterHandler(worker->handler_);
+    }
+  }
+
+  void initialize(const std::string& yaml = "{}") {
+    envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance config;
+    TestUtility::loadFromYaml(yaml, config);
+    balancer_ =
+        std::make_unique<LoadAwareConnectionBalancerImpl>(config, random_, *store_.rootScope());
+  }
+
+  void addWorkers(uint32_t num_workers) {
+    if (balancer_ == nullptr) {
+      initialize();
+    }
+    for (uint32_t i = 0; i < num_workers; ++i) {
+      auto& worker = workers_.emplace_back(std::make_unique<Worker>());
+      registerWorker(*worker);
+    }
+  }
+
+  void registerWorker(Worker& worker) {
+    worker.timer_ = new NiceMock<Event::MockTimer>(&worker.dispatcher_);
+    EXPECT_CALL(*worker.timer_, enableTimer(std::chrono::milliseconds(100), _))
+        .Times(testing::AtLeast(1));
+    worker.current_ = true;
+    balancer_->registerHandler(worker.handler_);
+    worker.current_ = false;
+  }
+
+  // Runs one load sampling interval, during which each worker is busy for the given percentage of
+  // the time.
+  void runInterval(const std::vector<uint32_t>& busy_percents) {
+    ASSERT_EQ(workers_.size(), busy_percents.size());
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      Worker& worker = *workers_[i];
+      worker.now_ += std::chrono::milliseconds(100);
+      worker.busy_time_ += std::chrono::milliseconds(busy_percents[i]);
+      worker.timer_->invokeCallback();
+    }
+  }
+
+  BalancedConnectionHandler& pick(uint32_t worker) {
+    return balancer_->pickTargetHandler(workers_[worker]->handler_);
+  }
+
+  bool shouldMigrate(uint32_t worker) {
+    workers_[worker]->current_ = true;
+    const bool result = balancer_->shouldMigrateConnection();
+    workers_[worker]->current_ = false;
+    return result;
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "load_aware_connection_balancer." + name)->value();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  std::unique_ptr<LoadAwareConnectionBalancerImpl> balancer_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+TEST_F(LoadAwareConnectionBalancerTest, KeepsConnectionsWhenBalanced) {
+  addWorkers(3);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_CALL(workers_[i]->handler_, incNumConnections());
+    EXPECT_EQ(&workers_[i]->handler_, &pick(i));
+  }
+
+  runInterval({50, 50, 50});
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_CALL(workers_[i]->handler_, incNumConnections());
+    EXPECT_EQ(&workers_[i]->handler_, &pick(i));
+  }
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, HandsOffConnectionsFromBusyWorkers) {
+  addWorkers(3);
+  runInterval({90, 10, 80});
+
+  // Only the second worker is less loaded than the first one by more than the threshold.
+  EXPECT_CALL(workers_[1]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[1]->handler_, &pick(0));
+  EXPECT_CALL(workers_[1]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[1]->handler_, &pick(2));
+  // The least loaded worker keeps its connections.
+  EXPECT_CALL(workers_[1]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[1]->handler_, &pick(1));
+  EXPECT_EQ(2, counter("connections_handed_off"));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, SpreadsConnectionsAmongLessLoadedWorkers) {
+  addWorkers(3);
+  runInterval({100, 10, 30});
+
+  // Both other workers are eligible, and the target is picked at random among them.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
+  BalancedConnectionHandler* first_target = &pick(0);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  BalancedConnectionHandler* second_target = &pick(0);
+  EXPECT_NE(&workers_[0]->handler_, first_target);
+  EXPECT_NE(&workers_[0]->handler_, second_target);
+  EXPECT_NE(first_target, second_target);
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, LoadIsSmoothed) {
+  addWorkers(2);
+  // A single busy interval only counts for half.
+  runInterval({18, 0});
+  EXPECT_CALL(workers_[0]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[0]->handler_, &pick(0));
+
+  runInterval({18, 0});
+  EXPECT_CALL(workers_[1]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[1]->handler_, &pick(0));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, UnregisteredHandlersAreNotPicked) {
+  addWorkers(3);
+  runInterval({90, 0, 80});
+  balancer_->unregisterHandler(workers_[1]->handler_);
+
+  EXPECT_CALL(workers_[0]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[0]->handler_, &pick(0));
+
+  // The slot of the unregistered handler is reused, and its load starts from zero.
+  registerWorker(*workers_[1]);
+  EXPECT_CALL(workers_[1]->handler_, incNumConnections());
+  EXPECT_EQ(&workers_[1]->handler_, &pick(0));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, NoMigrationByDefault) {
+  addWorkers(2);
+  runInterval({100, 0});
+  runInterval({100, 0});
+  EXPECT_FALSE(shouldMigrate(0));
+  EXPECT_EQ(0, counter("connections_migrated"));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, MigratesConnectionsOffBusyWorkers) {
+  initialize(R"EOF(
+connection_migration:
+  imbalance_threshold_percent: 20
+  max_connections_per_interval: 2
+)EOF");
+  addWorkers(3);
+  // Smoothed loads are 45%, 5% and 20%: only the first worker is over the threshold.
+  runInterval({90, 10, 40});
+  EXPECT_FALSE(shouldMigrate(1));
+  EXPECT_FALSE(shouldMigrate(2));
+  EXPECT_TRUE(shouldMigrate(0));
+  EXPECT_TRUE(shouldMigrate(0));
+  // The budget of the interval is used up.
+  EXPECT_FALSE(shouldMigrate(0));
+  EXPECT_EQ(2, counter("connections_migrated"));
+
+  // The budget is renewed on the next load update.
+  runInterval({90, 10, 40});
+  EXPECT_TRUE(shouldMigrate(0));
+  EXPECT_TRUE(shouldMigrate(2));
+
+  // Once balanced, the budget left is dropped.
+  runInterval({10, 10, 10});
+  runInterval({10, 10, 10});
+  EXPECT_FALSE(shouldMigrate(0));
+  EXPECT_EQ(4, counter("connections_migrated"));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, UnregisteredHandlersDoNotMigrate) {
+  initialize(R"EOF(
+connection_migration: {}
+)EOF");
+  addWorkers(2);
+  runInterval({100, 0});
+  balancer_->unregisterHandler(workers_[0]->handler_);
+  EXPECT_FALSE(shouldMigrate(0));
+  EXPECT_EQ(0, counter("connections_migrated"));
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,273 @@
+// Simulates workers serving connections of very different costs, to compare how evenly the
+// connection balancers spread the load between them.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "source/common/common/random_generator.h"
+#include "source/common/network/connection_balancer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+#include "gmock/gmock.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnPointee;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr std::chrono::milliseconds LoadUpdateInterval(100);
+
+class SimulatedWorker : public BalancedConnectionHandler {
+public:
+  SimulatedWorker() {
+    ON_CALL(dispatcher_, createTimer_(_)).WillByDefault(Invoke([this](Event::TimerCb cb) {
+      timer_ = new NiceMock<Event::MockTimer>();
+      timer_->callback_ = cb;
+      return timer_;
+    }));
+    ON_CALL(dispatcher_, loopBusyTime()).WillByDefault(ReturnPointee(&busy_time_));
+    ON_CALL(dispatcher_, approximateMonotonicTime()).WillByDefault(ReturnPointee(&now_));
+    ON_CALL(dispatcher_, isThreadSafe()).WillByDefault(ReturnPointee(&current_));
+  }
+
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return connection_costs_.size() + pending_; }
+  void incNumConnections() override { ++pending_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+  Event::Dispatcher& dispatcher() override { return dispatcher_; }
+
+  void accept(double cost) {
+    connection_costs_.push_back(cost);
+    --pending_;
+  }
+
+  // Closes the connections the balancer asks to migrate, as a drained HTTP connection would be
+  // closed on its next response, and returns their costs.
+  std::vector<double> drainMigratedConnections(Random::RandomGenerator& random,
+                                               LoadAwareConnectionBalancerImpl& balancer) {
+    std::vector<double> drained;
+    current_ = true;
+    while (!connection_costs_.empty() && balancer.shouldMigrateConnection()) {
+      // Busier connections respond more often, so they are more likely to see the drain first.
+      double total_cost = 0;
+      for (const double cost : connection_costs_) {
+        total_cost += cost;
+      }
+      double point = total_cost * (random.random() % 1000000) / 1000000;
+      auto it = connection_costs_.begin();
+      while (point >= *it && std::next(it) != connection_costs_.end()) {
+        point -= *it++;
+      }
+      drained.push_back(*it);
+      connection_costs_.erase(it);
+    }
+    current_ = false;
+    return drained;
+  }
+
+  // Closes some connections, and returns the fraction of the interval spent serving the others.
+  double runInterval(Random::RandomGenerator& random, uint32_t close_one_in) {
+    std::erase_if(connection_costs_, [&](double) { return random.random() % close_one_in == 0; });
+    double load = 0;
+    for (const double cost : connection_costs_) {
+      load += cost;
+    }
+    load = std::min(load, 1.0);
+    now_ += LoadUpdateInterval;
+    busy_time_ += std::chrono::duration_cast<std::chrono::microseconds>(load * LoadUpdateInterval);
+    if (timer_ != nullptr && timer_->enabled_) {
+      timer_->invokeCallback();
+    }
+    return load;
+  }
+
+private:
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  // Only created by the load aware balancer.
+  Event::MockTimer* timer_{};
+  std::chrono::microseconds busy_time_{};
+  MonotonicTime now_;
+  bool current_{};
+  std::vector<double> connection_costs_;
+  uint64_t pending_{};
+};
+
+ConnectionBalancerSharedPtr createBalancer(int64_t type, Random::RandomGenerator& random,
+                                           Stats::Scope& scope) {
+  envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance config;
+  config.mutable_load_update_interval()->set_nanos(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(LoadUpdateInterval).count());
+  switch (type) {
+  case 0:
+    return std::make_shared<NopConnectionBalancerImpl>();
+  case 1:
+    return std::make_shared<ExactConnectionBalancerImpl>();
+  case 2:
+    return std::make_shared<LoadAwareConnectionBalancerImpl>(config, random, scope);
+  default:
+    config.mutable_connection_migration();
+    return std::make_shared<LoadAwareConnectionBalancerImpl>(config, random, scope);
+  }
+}
+
+// Connections arrive on random workers, as the kernel would distribute them, and last 10s on
+// average. Most of them are cheap, but one in fifty costs as much as a hundred others, like long
+// lived streaming connections would. Reports the average load of the most loaded worker, and the
+// average load of all the workers, over 60s of simulated time.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmBalancerSimulation(benchmark::State& state) {
+  constexpr uint32_t NumWorkers = 8;
+  constexpr uint32_t NumIntervals = 600;
+  constexpr uint32_t ArrivalsPerInterval = 20;
+  constexpr uint32_t CloseOneIn = 100;
+
+  Random::RandomGeneratorImpl random;
+  Stats::IsolatedStoreImpl store;
+  double max_load = 0;
+  double mean_load = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<std::unique_ptr<SimulatedWorker>> workers;
+    ConnectionBalancerSharedPtr balancer =
+        createBalancer(state.range(0), random, *store.rootScope());
+    for (uint32_t i = 0; i < NumWorkers; ++i) {
+      balancer->registerHandler(*workers.emplace_back(std::make_unique<SimulatedWorker>()));
+    }
+
+    max_load = 0;
+    mean_load = 0;
+    for (uint32_t interval = 0; interval < NumIntervals; ++interval) {
+      for (uint32_t i = 0; i < ArrivalsPerInterval; ++i) {
+        SimulatedWorker& accepting = *workers[random.random() % NumWorkers];
+        const double cost = random.random() % 50 == 0 ? 0.05 : 0.0005;
+        static_cast<SimulatedWorker&>(balancer->pickTargetHandler(accepting)).accept(cost);
+      }
+      double interval_max_load = 0;
+      for (auto& worker : workers) {
+        const double load = worker->runInterval(random, CloseOneIn);
+        interval_max_load = std::max(interval_max_load, load);
+        mean_load += load / (NumWorkers * NumIntervals);
+      }
+      max_load += interval_max_load / NumIntervals;
+    }
+
+    for (auto& worker : workers) {
+      balancer->unregisterHandler(*worker);
+    }
+  }
+  state.counters["max_load"] = max_load;
+  state.counters["mean_load"] = mean_load;
+}
+BENCHMARK(bmBalancerSimulation)
+    ->ArgName("nop_exact_load_aware")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(::benchmark::kMillisecond);
+
+// Connections never close, like the long lived connections of gRPC clients, so that the balancers
+// can only act when they are established. With connection migration, the drained connections
+// reconnect to a random worker. Reports the average load of the most loaded worker over 60s of
+// simulated time, and the number of migrated connections.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmLongLivedConnectionsSimulation(benchmark::State& state) {
+  constexpr uint32_t NumWorkers = 8;
+  constexpr uint32_t NumIntervals = 600;
+  constexpr uint32_t NumConnections = 200;
+
+  Random::RandomGeneratorImpl random;
+  double max_load = 0;
+  uint64_t migrated = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Stats::IsolatedStoreImpl store;
+    std::vector<std::unique_ptr<SimulatedWorker>> workers;
+    ConnectionBalancerSharedPtr balancer =
+        createBalancer(state.range(0), random, *store.rootScope());
+    auto* load_aware = dynamic_cast<LoadAwareConnectionBalancerImpl*>(balancer.get());
+    for (uint32_t i = 0; i < NumWorkers; ++i) {
+      balancer->registerHandler(*workers.emplace_back(std::make_unique<SimulatedWorker>()));
+    }
+    auto connect = [&](double cost) {
+      SimulatedWorker& accepting = *workers[random.random() % NumWorkers];
+      static_cast<SimulatedWorker&>(balancer->pickTargetHandler(accepting)).accept(cost);
+    };
+    // All the connections are established before their costs are known.
+    for (uint32_t i = 0; i < NumConnections; ++i) {
+      connect(random.random() % 10 == 0 ? 0.04 : 0.002);
+    }
+
+    max_load = 0;
+    for (uint32_t interval = 0; interval < NumIntervals; ++interval) {
+      if (load_aware != nullptr) {
+        for (auto& worker : workers) {
+          for (const double cost : worker->drainMigratedConnections(random, *load_aware)) {
+            connect(cost);
+          }
+        }
+      }
+      double interval_max_load = 0;
+      for (auto& worker : workers) {
+        interval_max_load = std::max(interval_max_load, worker->runInterval(random, UINT32_MAX));
+      }
+      max_load += interval_max_load / NumIntervals;
+    }
+
+    for (auto& worker : workers) {
+      balancer->unregisterHandler(*worker);
+    }
+    if (load_aware != nullptr) {
+      migrated =
+          TestUtility::findCounter(store, "load_aware_connection_balancer.connections_migrated")
+              ->value();
+    }
+  }
+  state.counters["max_load"] = max_load;
+  state.counters["migrated"] = migrated;
+}
+BENCHMARK(bmLongLivedConnectionsSimulation)
+    ->ArgName("exact_load_aware_migration")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(3)
+    ->Unit(::benchmark::kMillisecond);
+
+// Measures the cost of picking the target of a connection.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void bmPickTargetHandler(benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  Stats::IsolatedStoreImpl store;
+  std::vector<std::unique_ptr<SimulatedWorker>> workers;
+  ConnectionBalancerSharedPtr balancer = createBalancer(state.range(0), random, *store.rootScope());
+  for (int64_t i = 0; i < state.range(1); ++i) {
+    balancer->registerHandler(*workers.emplace_back(std::make_unique<SimulatedWorker>()));
+  }
+
+  uint64_t i = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(&balancer->pickTargetHandler(*workers[i++ % workers.size()]));
+  }
+
+  for (auto& worker : workers) {
+    balancer->unregisterHandler(*worker);
+  }
+}
+BENCHMARK(bmPickTargetHandler)
+    ->ArgNames({"exact_load_aware", "workers"})
+    ->ArgsProduct({{1, 2}, {8, 64}});
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
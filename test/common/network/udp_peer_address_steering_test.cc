@@ -0,0 +1,103 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/listen_socket_impl.h"
+#include "source/common/network/socket_option_factory.h"
+#include "source/common/network/udp_peer_address_steering.h"
+#include "source/common/network/utility.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+TEST(UdpPeerAddressSteeringTest, HashIpv4) {
+  Address::Ipv4Instance peer("10.1.2.3", 5000);
+  EXPECT_EQ(5000u ^ 0x0a010203u, UdpPeerAddressSteering::hash(peer));
+
+  UdpPeerAddressSteering steering(4);
+  EXPECT_EQ((5000u ^ 0x0a010203u) % 4, steering.workerIndex(peer));
+}
+
+TEST(UdpPeerAddressSteeringTest, HashIpv6) {
+  Address::Ipv6Instance peer("2001:db8:1:2:3:4:5:6", 443);
+  EXPECT_EQ(443u ^ 0x20010db8u ^ 0x00010002u ^ 0x00030004u ^ 0x00050006u,
+            UdpPeerAddressSteering::hash(peer));
+
+  UdpPeerAddressSteering steering(3);
+  EXPECT_EQ((443u ^ 0x20010db8u ^ 0x00010002u ^ 0x00030004u ^ 0x00050006u) % 3,
+            steering.workerIndex(peer));
+}
+
+TEST(UdpPeerAddressSteeringTest, DifferentPortsSpreadAcrossWorkers) {
+  UdpPeerAddressSteering steering(4);
+  std::vector<bool> seen(4, false);
+  for (uint32_t port = 10000; port < 10004; ++port) {
+    seen[steering.workerIndex(Address::Ipv4Instance("127.0.0.1", port))] = true;
+  }
+  EXPECT_EQ(std::vector<bool>(4, true), seen);
+}
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+class UdpPeerAddressSteeringSocketTest : public testing::TestWithParam<Address::IpVersion> {};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, UdpPeerAddressSteeringSocketTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// Verify that the kernel delivers each datagram to the SO_REUSEPORT socket at the index computed
+// by workerIndex() for the sender's address.
+TEST_P(UdpPeerAddressSteeringSocketTest, KernelSteeringMatchesWorkerIndex) {
+  constexpr uint32_t Concurrency = 4;
+  UdpPeerAddressSteering steering(Concurrency);
+  Socket::OptionConstSharedPtr bpf_option = steering.createReusePortBpfSocketOption();
+  ASSERT_NE(nullptr, bpf_option);
+
+  std::vector<std::unique_ptr<UdpListenSocket>> listen_sockets;
+  Address::InstanceConstSharedPtr listen_address =
+      Test::getCanonicalLoopbackAddress(GetParam());
+  for (uint32_t i = 0; i < Concurrency; ++i) {
+    listen_sockets.push_back(std::make_unique<UdpListenSocket>(
+        listen_address, SocketOptionFactory::buildReusePortOptions(), true));
+    listen_address = listen_sockets.back()->connectionInfoProvider().localAddress();
+  }
+  ASSERT_TRUE(bpf_option->setOption(*listen_sockets[0],
+                                    envoy::config::core::v3::SocketOption::STATE_BOUND));
+
+  for (uint32_t i = 0; i < 16; ++i) {
+    auto client = Test::bindFreeLoopbackPort(GetParam(), Socket::Type::Datagram);
+    const uint32_t expected = steering.workerIndex(*client.first);
+    Buffer::OwnedImpl buffer("hello");
+    ASSERT_TRUE(Utility::writeToSocket(client.second->ioHandle(), buffer, nullptr, *listen_address)
+                    .ok());
+
+    absl::optional<uint32_t> received;
+    for (int attempt = 0; attempt < 1000 && !received.has_value(); ++attempt) {
+      for (uint32_t j = 0; j < Concurrency; ++j) {
+        char data[16];
+        if (listen_sockets[j]->ioHandle().recv(data, sizeof(data), MSG_DONTWAIT).ok()) {
+          received = j;
+          break;
+        }
+      }
+      if (!received.has_value()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(expected, received.value()) << client.first->asString();
+  }
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -5435,6 +5435,47 @@ virtual_hosts:
   EXPECT_EQ(0, percent.numerator());
 }
 
+TEST_F(RouteMatcherTest, ProactiveHedge) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- domains: [www.lyft.com]
+  name: www
+  hedge_policy: {proactive_hedging: {latency_percentile: 99}}
+  routes:
+  - match: {prefix: /foo}
+    route: {cluster: www}
+  - match: {prefix: /bar}
+    route: {cluster: www}
+  - match: {prefix: /}
+    route:
+      cluster: www
+      hedge_policy: {hedge_on_per_try_timeout: true}
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"www"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  ProactiveHedging* foo = config.route(genHeaders("www.lyft.com", "/foo", "GET"), 0)
+                              ->routeEntry()
+                              ->hedgePolicy()
+                              .proactiveHedging();
+  ProactiveHedging* bar = config.route(genHeaders("www.lyft.com", "/bar", "GET"), 0)
+                              ->routeEntry()
+                              ->hedgePolicy()
+                              .proactiveHedging();
+  ASSERT_NE(nullptr, foo);
+  ASSERT_NE(nullptr, bar);
+  // Latencies are tracked per route, even if the policy is inherited from the virtual host.
+  EXPECT_NE(foo, bar);
+  EXPECT_EQ(absl::nullopt, foo->hedgeDelay());
+
+  EXPECT_EQ(nullptr, config.route(genHeaders("www.lyft.com", "/", "GET"), 0)
+                         ->routeEntry()
+                         ->hedgePolicy()
+                         .proactiveHedging());
+}
+
 TEST_F(RouteMatcherTest, TestBadDefaultConfig) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -0,0 +1,119 @@
+#include <chrono>
+#include <limits>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/router/proactive_hedging_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+envoy::config::route::v3::HedgePolicy::ProactiveHedging parseConfig(const std::string& yaml) {
+  envoy::config::route::v3::HedgePolicy::ProactiveHedging config;
+  TestUtility::loadFromYaml(yaml, config);
+  return config;
+}
+
+TEST(ProactiveHedgingImplTest, Buckets) {
+  for (uint64_t latency = 0; latency < 4; ++latency) {
+    EXPECT_EQ(latency, ProactiveHedgingImpl::bucketIndex(latency));
+    EXPECT_EQ(latency, ProactiveHedgingImpl::bucketUpperBound(latency));
+  }
+  EXPECT_EQ(8U, ProactiveHedgingImpl::bucketIndex(8));
+  EXPECT_EQ(8U, ProactiveHedgingImpl::bucketIndex(9));
+  EXPECT_EQ(9U, ProactiveHedgingImpl::bucketUpperBound(8));
+  EXPECT_EQ(111U, ProactiveHedgingImpl::bucketUpperBound(ProactiveHedgingImpl::bucketIndex(100)));
+
+  // Every latency falls into the bucket whose bound is the first one not below it.
+  for (uint64_t latency = 1; latency < 100000; ++latency) {
+    const uint32_t index = ProactiveHedgingImpl::bucketIndex(latency);
+    EXPECT_LE(latency, ProactiveHedgingImpl::bucketUpperBound(index));
+    EXPECT_GT(latency, ProactiveHedgingImpl::bucketUpperBound(index - 1));
+  }
+
+  // Latencies beyond the last bucket are clamped to it.
+  EXPECT_EQ(ProactiveHedgingImpl::NumBuckets - 1,
+            ProactiveHedgingImpl::bucketIndex(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(ProactiveHedgingImplTest, DelayFollowsPercentile) {
+  ProactiveHedgingImpl hedging(parseConfig("min_samples: 100"));
+
+  // 90 fast and 10 slow requests: the 95th percentile is slow.
+  for (int i = 0; i < 90; ++i) {
+    hedging.recordLatency(std::chrono::milliseconds(2));
+  }
+  for (int i = 0; i < 9; ++i) {
+    hedging.recordLatency(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(absl::nullopt, hedging.hedgeDelay());
+  hedging.recordLatency(std::chrono::milliseconds(100));
+  EXPECT_EQ(std::chrono::milliseconds(111), hedging.hedgeDelay());
+}
+
+TEST(ProactiveHedgingImplTest, LowerPercentileAndMinDelay) {
+  ProactiveHedgingImpl hedging(parseConfig(R"EOF(
+latency_percentile: 50
+min_delay: 0.005s
+min_samples: 16
+)EOF"));
+
+  for (int i = 0; i < 16; ++i) {
+    hedging.recordLatency(std::chrono::milliseconds(i < 12 ? 2 : 1000));
+  }
+  // The median is 2ms, which is raised to the minimum delay.
+  EXPECT_EQ(std::chrono::milliseconds(5), hedging.hedgeDelay());
+}
+
+TEST(ProactiveHedgingImplTest, DecayFollowsRecentLatencies) {
+  ProactiveHedgingImpl hedging(parseConfig("min_samples: 16"));
+
+  for (int i = 0; i < 160; ++i) {
+    hedging.recordLatency(std::chrono::milliseconds(200));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(223), hedging.hedgeDelay());
+
+  // Once the upstream gets faster, older latencies are decayed away.
+  for (int i = 0; i < 2000; ++i) {
+    hedging.recordLatency(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(11), hedging.hedgeDelay());
+}
+
+TEST(ProactiveHedgingImplTest, Budget) {
+  ProactiveHedgingImpl hedging(parseConfig("max_hedged_requests: {value: 10}"));
+
+  EXPECT_FALSE(hedging.tryHedge());
+  for (int i = 0; i < 10; ++i) {
+    hedging.onRequest();
+  }
+  EXPECT_TRUE(hedging.tryHedge());
+  EXPECT_FALSE(hedging.tryHedge());
+
+  for (int i = 0; i < 10; ++i) {
+    hedging.onRequest();
+  }
+  EXPECT_TRUE(hedging.tryHedge());
+  EXPECT_FALSE(hedging.tryHedge());
+}
+
+TEST(ProactiveHedgingImplTest, DefaultBudget) {
+  ProactiveHedgingImpl hedging(parseConfig("{}"));
+
+  for (int i = 0; i < 100; ++i) {
+    hedging.onRequest();
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(hedging.tryHedge());
+  }
+  EXPECT_FALSE(hedging.tryHedge());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
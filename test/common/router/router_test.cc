@@ -55,6 +55,7 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::AnyNumber;
 using testing::InSequence;
 using testing::Invoke;
 using testing::InvokeWithoutArgs;
@@ -2476,7 +2477,178 @@ TEST_F(RouterTest, HedgedPerTryTimeoutFirstRequestSucceeds) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
   EXPECT_EQ(0U, router_->upstreamRequests().size());
 
-  // TODO: Verify hedge stats here once they are implemented.
+  Stats::Store& cluster_stats = cm_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_sent").value());
+  EXPECT_EQ(0U, cluster_stats.counter("upstream_rq_hedge_won").value());
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_cancelled").value());
+}
+
+// Sequence:
+// 1) the proactive hedge delay expires before the first upstream request got response headers
+// 2) a hedged request is sent, which avoids the host of the first request
+// 3) the hedged request gets a 2xx, assert the first request is reset
+TEST_F(RouterTest, ProactiveHedgeSecondRequestWins) {
+  NiceMock<MockProactiveHedging> proactive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.proactive_hedging_ = &proactive_hedging;
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder1 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder1, Http::Protocol::Http10);
+  Event::MockTimer* hedge_timer = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*hedge_timer, enableTimer(std::chrono::milliseconds(10), _));
+  expectResponseTimerCreate();
+  EXPECT_CALL(proactive_hedging, onRequest());
+  EXPECT_CALL(proactive_hedging, hedgeDelay())
+      .WillOnce(Return(absl::make_optional(std::chrono::milliseconds(10))));
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  EXPECT_EQ(1U, router_->upstreamRequests().size());
+
+  EXPECT_CALL(proactive_hedging, tryHedge()).WillOnce(Return(true));
+  router_->retry_state_->expectProactiveHedge();
+  hedge_timer->invokeCallback();
+  Stats::Store& cluster_stats = cm_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_sent").value());
+
+  NiceMock<Http::MockRequestEncoder> encoder2;
+  Http::ResponseDecoder* response_decoder2 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder2, &response_decoder2, Http::Protocol::Http10);
+  router_->retry_state_->callback_();
+  EXPECT_EQ(2U, router_->upstreamRequests().size());
+  EXPECT_TRUE(router_->shouldSelectAnotherHost(*cm_.thread_local_cluster_.conn_pool_.host_));
+
+  EXPECT_CALL(*router_->retry_state_, shouldRetryHeaders(_, _, _))
+      .WillOnce(Return(RetryStatus::No));
+  EXPECT_CALL(encoder1.stream_, resetStream(_));
+  EXPECT_CALL(encoder2.stream_, resetStream(_)).Times(0);
+  EXPECT_CALL(proactive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder2->decodeHeaders(std::move(response_headers), true);
+  EXPECT_EQ(0U, router_->upstreamRequests().size());
+
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_won").value());
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_cancelled").value());
+}
+
+// Sequence:
+// 1) the proactive hedge delay expires before the first upstream request got response headers
+// 2) the first upstream request then hits its per try timeout, with hedge_on_per_try_timeout
+//    enabled, assert it is not hedged again
+// 3) the hedged request gets a 2xx, assert the first request is reset
+TEST_F(RouterTest, ProactiveHedgeThenPerTryTimeout) {
+  NiceMock<MockProactiveHedging> proactive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.proactive_hedging_ = &proactive_hedging;
+  enableHedgeOnPerTryTimeout();
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder1 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder1, Http::Protocol::Http10);
+  Event::MockTimer* hedge_timer = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*hedge_timer, enableTimer(std::chrono::milliseconds(10), _));
+  expectPerTryTimerCreate();
+  expectResponseTimerCreate();
+  EXPECT_CALL(proactive_hedging, onRequest());
+  EXPECT_CALL(proactive_hedging, hedgeDelay())
+      .WillOnce(Return(absl::make_optional(std::chrono::milliseconds(10))));
+
+  Http::TestRequestHeaderMapImpl headers{{"x-envoy-upstream-rq-per-try-timeout-ms", "20"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  EXPECT_EQ(1U, router_->upstreamRequests().size());
+
+  EXPECT_CALL(proactive_hedging, tryHedge()).WillOnce(Return(true));
+  router_->retry_state_->expectProactiveHedge();
+  hedge_timer->invokeCallback();
+
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_, putResult(_, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(
+      cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+      putResult(Upstream::Outlier::Result::LocalOriginTimeout, absl::optional<uint64_t>(504)));
+  EXPECT_CALL(*router_->retry_state_, shouldHedgeRetryPerTryTimeout(_)).Times(0);
+  EXPECT_CALL(encoder1.stream_, resetStream(_)).Times(0);
+  per_try_timeout_->invokeCallback();
+  Stats::Store& cluster_stats = cm_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_sent").value());
+
+  NiceMock<Http::MockRequestEncoder> encoder2;
+  Http::ResponseDecoder* response_decoder2 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder2, &response_decoder2, Http::Protocol::Http10);
+  expectPerTryTimerCreate();
+  router_->retry_state_->callback_();
+  EXPECT_EQ(2U, router_->upstreamRequests().size());
+
+  EXPECT_CALL(*router_->retry_state_, shouldRetryHeaders(_, _, _))
+      .WillOnce(Return(RetryStatus::No));
+  EXPECT_CALL(encoder1.stream_, resetStream(_));
+  EXPECT_CALL(encoder2.stream_, resetStream(_)).Times(0);
+  EXPECT_CALL(proactive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder2->decodeHeaders(std::move(response_headers), true);
+  EXPECT_EQ(0U, router_->upstreamRequests().size());
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_won").value());
+}
+
+// A proactive hedge that would exceed the hedging budget is not sent.
+TEST_F(RouterTest, ProactiveHedgeBudgetExceeded) {
+  NiceMock<MockProactiveHedging> proactive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.proactive_hedging_ = &proactive_hedging;
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  Event::MockTimer* hedge_timer = new Event::MockTimer(&callbacks_.dispatcher_);
+  expectResponseTimerCreate();
+  EXPECT_CALL(proactive_hedging, hedgeDelay())
+      .WillOnce(Return(absl::make_optional(std::chrono::milliseconds(10))));
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  EXPECT_CALL(proactive_hedging, tryHedge()).WillOnce(Return(false));
+  EXPECT_CALL(*router_->retry_state_, shouldHedgeProactively(_)).Times(0);
+  hedge_timer->invokeCallback();
+  EXPECT_EQ(1U, router_->upstreamRequests().size());
+
+  Stats::Store& cluster_stats = cm_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(0U, cluster_stats.counter("upstream_rq_hedge_sent").value());
+  EXPECT_EQ(1U, cluster_stats.counter("upstream_rq_hedge_budget_exceeded").value());
+
+  EXPECT_CALL(proactive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+}
+
+// No hedge timer is armed until the route has observed enough latencies.
+TEST_F(RouterTest, ProactiveHedgeWithoutDelay) {
+  NiceMock<MockProactiveHedging> proactive_hedging;
+  callbacks_.route_->route_entry_.hedge_policy_.proactive_hedging_ = &proactive_hedging;
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+  EXPECT_CALL(proactive_hedging, onRequest());
+  EXPECT_CALL(proactive_hedging, hedgeDelay()).WillOnce(Return(absl::nullopt));
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  EXPECT_CALL(proactive_hedging, recordLatency(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
 }
 
 // Tests that an upstream request is reset even if it can't be retried as long as there is
@@ -8,6 +8,7 @@
 #include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/config/runtime_utility.h"
+#include "source/common/runtime/key_handle_registry.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/runtime/runtime_impl.h"
 
@@ -563,6 +564,65 @@ TEST_F(StaticLoaderImplTest, All) {
   testNewOverrides(*loader_, store_);
 }
 
+TEST_F(StaticLoaderImplTest, KeyHandles) {
+  const KeyHandleConstSharedPtr bool_key = KeyHandleRegistry::get().handle("key_handles.bool");
+  EXPECT_EQ("key_handles.bool", bool_key->key());
+  EXPECT_EQ(bool_key, KeyHandleRegistry::get().handle("key_handles.bool"));
+  const KeyHandleConstSharedPtr empty_key = KeyHandleRegistry::get().handle("");
+  setup();
+
+  EXPECT_TRUE(loader_->snapshot().getBoolean(*bool_key, true));
+  EXPECT_FALSE(loader_->snapshot().getBoolean(*empty_key, false));
+  ASSERT_TRUE(loader_->mergeValues({{"key_handles.bool", "false"},
+                                    {"key_handles.int", "5"},
+                                    {"key_handles.double", "2.5"},
+                                    {"key_handles.percent", "100"}})
+                  .ok());
+  EXPECT_FALSE(loader_->snapshot().getBoolean(*bool_key, true));
+
+  // Handles created after the snapshot fall back to looking up their keys.
+  const KeyHandleConstSharedPtr int_key = KeyHandleRegistry::get().handle("key_handles.int");
+  const KeyHandleConstSharedPtr double_key = KeyHandleRegistry::get().handle("key_handles.double");
+  const KeyHandleConstSharedPtr percent_key =
+      KeyHandleRegistry::get().handle("key_handles.percent");
+  envoy::type::v3::FractionalPercent zero_percent;
+  EXPECT_EQ(5UL, loader_->snapshot().getInteger(*int_key, 1));
+  EXPECT_EQ(2.5, loader_->snapshot().getDouble(*double_key, 1.5));
+  EXPECT_TRUE(loader_->snapshot().featureEnabled(*percent_key, zero_percent));
+
+  // And are resolved by the snapshots created after them.
+  ASSERT_TRUE(loader_->mergeValues({{"key_handles.int", "6"}, {"key_handles.percent", ""}}).ok());
+  EXPECT_EQ(6UL, loader_->snapshot().getInteger(*int_key, 1));
+  EXPECT_EQ(2.5, loader_->snapshot().getDouble(*double_key, 1.5));
+  EXPECT_EQ(1.5, loader_->snapshot().getDouble(*int_key, 1.5));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(*percent_key, zero_percent));
+}
+
+// Keys are unregistered with the last reference to their handle, and their index is reused by the
+// next key registered, which must not get the entry of the released key from older snapshots.
+TEST_F(StaticLoaderImplTest, KeyHandlesReleased) {
+  KeyHandleConstSharedPtr old_key = KeyHandleRegistry::get().handle("key_handles.old");
+  const size_t size = KeyHandleRegistry::get().size();
+  setup();
+  ASSERT_TRUE(loader_->mergeValues({{"key_handles.old", "1"}, {"key_handles.new", "2"}}).ok());
+  SnapshotConstSharedPtr snapshot = loader_->threadsafeSnapshot();
+  EXPECT_EQ(1UL, snapshot->getInteger(*old_key, 0));
+
+  const uint32_t index = old_key->index();
+  old_key.reset();
+  EXPECT_EQ(size - 1, KeyHandleRegistry::get().size());
+  const KeyHandleConstSharedPtr new_key = KeyHandleRegistry::get().handle("key_handles.new");
+  EXPECT_EQ(index, new_key->index());
+  EXPECT_EQ(size, KeyHandleRegistry::get().size());
+  EXPECT_EQ(2UL, snapshot->getInteger(*new_key, 0));
+  EXPECT_EQ(2UL, loader_->snapshot().getInteger(*new_key, 0));
+
+  // A new handle of a released key gets a new index.
+  old_key = KeyHandleRegistry::get().handle("key_handles.old");
+  EXPECT_NE(index, old_key->index());
+  EXPECT_EQ(1UL, snapshot->getInteger(*old_key, 0));
+}
+
 #ifdef ENVOY_ENABLE_QUIC
 TEST_F(StaticLoaderImplTest, QuicheReloadableFlags) {
   EXPECT_TRUE(GetQuicheReloadableFlag(quic_testonly_default_true));
@@ -0,0 +1,90 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Compares looking up runtime values by key with looking them up through key handles, in a
+// snapshot holding as many keys as the first argument of each benchmark.
+
+#include "envoy/type/v3/percent.pb.h"
+
+#include "source/common/common/random_generator.h"
+#include "source/common/runtime/key_handle_registry.h"
+#include "source/common/runtime/runtime_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Runtime {
+
+class RuntimeSpeedTest {
+public:
+  explicit RuntimeSpeedTest(uint64_t num_keys)
+      : stats_{ALL_RUNTIME_STATS(POOL_COUNTER(*store_.rootScope()),
+                                 POOL_GAUGE(*store_.rootScope()))} {
+    Protobuf::Struct proto;
+    for (uint64_t i = 0; i < num_keys; ++i) {
+      (*proto.mutable_fields())[absl::StrCat("speed_test.bool_", i)].set_bool_value(true);
+      (*proto.mutable_fields())[absl::StrCat("speed_test.percent_", i)].set_number_value(50);
+    }
+    absl::Status creation_status;
+    std::vector<Snapshot::OverrideLayerConstPtr> layers;
+    layers.push_back(std::make_unique<ProtoLayer>("base", proto, creation_status));
+    RELEASE_ASSERT(creation_status.ok(), "");
+
+    // Look up the keys in the middle of the snapshot, and register their handles before creating
+    // the snapshot so that it resolves them.
+    bool_key_ = absl::StrCat("speed_test.bool_", num_keys / 2);
+    percent_key_ = absl::StrCat("speed_test.percent_", num_keys / 2);
+    bool_handle_ = KeyHandleRegistry::get().handle(bool_key_);
+    percent_handle_ = KeyHandleRegistry::get().handle(percent_key_);
+    snapshot_ = std::make_unique<SnapshotImpl>(random_, stats_, std::move(layers));
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  RuntimeStats stats_;
+  Random::RandomGeneratorImpl random_;
+  std::string bool_key_;
+  std::string percent_key_;
+  KeyHandleConstSharedPtr bool_handle_;
+  KeyHandleConstSharedPtr percent_handle_;
+  std::unique_ptr<SnapshotImpl> snapshot_;
+  const envoy::type::v3::FractionalPercent default_percent_;
+};
+
+static void bmGetBooleanByKey(benchmark::State& state) {
+  RuntimeSpeedTest speed_test(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(speed_test.snapshot_->getBoolean(speed_test.bool_key_, false));
+  }
+}
+BENCHMARK(bmGetBooleanByKey)->Range(8, 8 << 10);
+
+static void bmGetBooleanByHandle(benchmark::State& state) {
+  RuntimeSpeedTest speed_test(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(speed_test.snapshot_->getBoolean(*speed_test.bool_handle_, false));
+  }
+}
+BENCHMARK(bmGetBooleanByHandle)->Range(8, 8 << 10);
+
+static void bmFractionalPercentByKey(benchmark::State& state) {
+  RuntimeSpeedTest speed_test(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(
+        speed_test.snapshot_->featureEnabled(speed_test.percent_key_, speed_test.default_percent_));
+  }
+}
+BENCHMARK(bmFractionalPercentByKey)->Range(8, 8 << 10);
+
+static void bmFractionalPercentByHandle(benchmark::State& state) {
+  RuntimeSpeedTest speed_test(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(speed_test.snapshot_->featureEnabled(*speed_test.percent_handle_,
+                                                                  speed_test.default_percent_));
+  }
+}
+BENCHMARK(bmFractionalPercentByHandle)->Range(8, 8 << 10);
+
+} // namespace Runtime
+} // namespace Envoy
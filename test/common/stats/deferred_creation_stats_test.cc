@@ -201,6 +201,27 @@ TEST_F(DeferredCreationStatsTest, WhenScopesOverlapStatsAreAliveAsLongAsThereAre
   EXPECT_EQ(TestUtility::findGauge(store_, "bluh.AwesomeStats.initialized"), nullptr);
 }
 
+// Tests that isolated stats are kept out of the store, and only allocated on first reference when
+// deferred.
+TEST_F(DeferredCreationStatsTest, IsolatedStats) {
+  MyStats lazy =
+      createDeferredCompatibleIsolatedStats<AwesomeStats>(symbol_table_, stats_names_, true);
+  MyStats non_lazy =
+      createDeferredCompatibleIsolatedStats<AwesomeStats>(symbol_table_, stats_names_, false);
+  EXPECT_FALSE(lazy.isPresent());
+  EXPECT_TRUE(non_lazy.isPresent());
+
+  lazy->foo_.inc();
+  non_lazy->foo_.add(2);
+  EXPECT_TRUE(lazy.isPresent());
+  EXPECT_EQ(lazy->foo_.value(), 1);
+  EXPECT_EQ(non_lazy->foo_.value(), 2);
+
+  // Neither the stats nor an "initialized" gauge are added to the store.
+  EXPECT_EQ(TestUtility::findCounter(store_, "foo"), nullptr);
+  EXPECT_EQ(TestUtility::findGauge(store_, "AwesomeStats.initialized"), nullptr);
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -714,6 +714,110 @@ TEST_F(StatNameTest, RecentLookups) {
   EXPECT_EQ(0, num_calls);
 }
 
+TEST_F(StatNameTest, EncodeCache) {
+  table_.setEncodeCacheCapacity(2);
+  const StatName a = makeStat("a.b");
+  const StatName b = makeStat("a.b");
+  EXPECT_EQ(a, b);
+  EXPECT_EQ("a.b", table_.toString(b));
+  makeStat("c.d");
+
+  // Evicts one of the cached names.
+  makeStat("e.f");
+  pool_.clear();
+
+  // Only the symbols of the cached names are kept.
+  const uint64_t num_symbols = table_.numSymbols();
+  EXPECT_EQ(4, num_symbols);
+  for (int i = 0; i < 1000; ++i) {
+    StatNameManagedStorage storage("e.f", table_);
+  }
+  EXPECT_EQ(num_symbols, table_.numSymbols());
+
+  table_.setEncodeCacheCapacity(0);
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
+TEST_F(StatNameTest, EncodeCacheEvictsLeastRecentlyEncoded) {
+  table_.setEncodeCacheCapacity(2);
+  makeStat("a.b");
+  makeStat("c.d");
+  makeStat("a.b");
+  // Evicts c.d, which was encoded less recently than a.b.
+  makeStat("e.f");
+  pool_.clear();
+  EXPECT_EQ(4, table_.numSymbols());
+
+  // Tracking recent lookups bypasses the cache, so that the remaining symbols
+  // can be probed without changing the cache.
+  table_.setRecentLookupCapacity(10);
+  {
+    StatNameManagedStorage a("a", table_);
+    EXPECT_EQ(4, table_.numSymbols());
+    StatNameManagedStorage c("c", table_);
+    EXPECT_EQ(5, table_.numSymbols());
+  }
+  table_.setRecentLookupCapacity(0);
+
+  table_.setEncodeCacheCapacity(0);
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
+TEST_F(StatNameTest, EncodeCacheBypassedForRecentLookups) {
+  table_.setEncodeCacheCapacity(10);
+  table_.setRecentLookupCapacity(10);
+  encodeDecode("direct.stat");
+  encodeDecode("direct.stat");
+  uint64_t total = table_.getRecentLookups([](absl::string_view, uint64_t) {});
+  EXPECT_EQ(2, total);
+  pool_.clear();
+  EXPECT_EQ(0, table_.numSymbols());
+  table_.setEncodeCacheCapacity(0);
+}
+
+TEST_F(StatNameTest, EncodeCacheAcrossThreads) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  table_.setEncodeCacheCapacity(10);
+
+  constexpr int num_threads = 10;
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([this, i]() {
+      for (int count = 0; count < 1000; ++count) {
+        StatNameManagedStorage storage(absl::StrCat("thread.symbol", (i + count) % 20), table_);
+        EXPECT_EQ(absl::StrCat("thread.symbol", (i + count) % 20),
+                  table_.toString(storage.statName()));
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  // The caches are drained when their threads exit.
+  EXPECT_EQ(0, table_.numSymbols());
+  table_.setEncodeCacheCapacity(0);
+}
+
+TEST(EncodeCacheTest, TableDestroyedBeforeThread) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  auto table = std::make_unique<SymbolTableImpl>();
+  table->setEncodeCacheCapacity(10);
+  ConditionalInitializer encoded, destroyed;
+  Thread::ThreadPtr thread = thread_factory.createThread([&table, &encoded, &destroyed]() {
+    StatNameStorage storage("cached.name", *table);
+    storage.free(*table);
+    encoded.setReady();
+    destroyed.wait();
+  });
+
+  // The table releases the references held by the cache of the thread.
+  encoded.wait();
+  table.reset();
+  destroyed.setReady();
+  thread->join();
+}
+
 TEST_F(StatNameTest, StatNameEmptyEquivalent) {
   StatName empty1;
   StatName empty2 = makeStat("");
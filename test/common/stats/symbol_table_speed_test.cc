@@ -16,6 +16,7 @@
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
+// The argument is the capacity of the per-thread encode caches, where 0 disables them.
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmCreateRace(benchmark::State& state) {
   for (auto _ : state) {
@@ -30,6 +31,7 @@ static void bmCreateRace(benchmark::State& state) {
     Envoy::ConditionalInitializer access, wait;
     absl::BlockingCounter accesses(num_threads);
     Envoy::Stats::SymbolTableImpl table;
+    table.setEncodeCacheCapacity(state.range(0));
     const absl::string_view stat_name_string = "here.is.a.stat.name";
     Envoy::Stats::StatNameStorage initial(stat_name_string, table);
 
@@ -59,9 +61,10 @@ static void bmCreateRace(benchmark::State& state) {
     }
 
     initial.free(table);
+    table.setEncodeCacheCapacity(0);
   }
 }
-BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
+BENCHMARK(bmCreateRace)->Arg(0)->Arg(64)->Unit(::benchmark::kMillisecond);
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
@@ -108,6 +108,42 @@ void BM_ExtractTags(benchmark::State& state) {
 }
 BENCHMARK(BM_ExtractTags)->DenseRange(0, 26, 1);
 
+// Produces tags for the stats created when state.range(0) clusters are added by CDS.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ExtractClusterTags(benchmark::State& state) {
+  const Stats::TagVector tags;
+  auto tag_extractors =
+      TagProducerImpl::createTagProducer(envoy::config::metrics::v3::StatsConfig(), tags).value();
+  const std::vector<std::string> suffixes = {
+      "upstream_cx_total",
+      "upstream_rq_total",
+      "upstream_rq_2xx",
+      "upstream_rq_503",
+      "upstream_rq_time",
+      "membership_healthy",
+      "circuit_breakers.default.rq_pending_open",
+      "ssl.ciphers.ECDHE-RSA-AES128-GCM-SHA256",
+      "grpc.grpc_service.grpc_method.success",
+      "ext_authz.authz_prefix.ok",
+  };
+  std::vector<std::string> stat_names;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    for (const std::string& suffix : suffixes) {
+      stat_names.push_back(absl::StrCat("cluster.cluster_", i, ".", suffix));
+    }
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const std::string& stat_name : stat_names) {
+      TagVector tags;
+      benchmark::DoNotOptimize(tag_extractors->produceTags(stat_name, tags));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * stat_names.size());
+}
+BENCHMARK(BM_ExtractClusterTags)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
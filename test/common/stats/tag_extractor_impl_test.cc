@@ -588,6 +588,20 @@ class TagExtractorTokensTest : public testing::Test {
 protected:
   bool extract(absl::string_view tag_name, absl::string_view pattern, absl::string_view stat_name) {
     TagExtractorTokensImpl tokens(tag_name, pattern);
+    const bool extracted = extract(tokens, stat_name);
+
+    // Extracting through a token set must yield the same result.
+    const std::vector<Tag> tags = tags_;
+    const std::string tag_extracted_name = tag_extracted_name_;
+    TagExtractorTokenSet token_set;
+    TagExtractorTokensImpl set_tokens(tag_name, pattern, token_set);
+    EXPECT_EQ(extracted, extract(set_tokens, stat_name));
+    EXPECT_EQ(tags, tags_);
+    EXPECT_EQ(tag_extracted_name, tag_extracted_name_);
+    return extracted;
+  }
+
+  bool extract(const TagExtractorTokensImpl& tokens, absl::string_view stat_name) {
     IntervalSetImpl<size_t> remove_characters;
     tags_.clear();
     TagExtractionContext tag_extraction_context(stat_name);
@@ -694,5 +708,41 @@ TEST_F(TagExtractorTokensTest, TokensMismatchPatternTooLong) {
   EXPECT_FALSE(extract("article", "now.$.the.time.to", "now.is.the.time"));
 }
 
+TEST(TagExtractorTokenSetTest, MatchesAllPatternsInOnePass) {
+  TagExtractorTokenSet token_set;
+  EXPECT_EQ(0, token_set.addPattern("http.*.user_agent.$.**"));
+  EXPECT_EQ(1, token_set.addPattern("http.*.fault.$.**"));
+  EXPECT_EQ(2, token_set.addPattern("http.$.**"));
+  EXPECT_EQ(3, token_set.addPattern("$.rbac.**"));
+  EXPECT_EQ(4, token_set.addPattern("cluster.$.**.query.*"));
+  EXPECT_EQ(absl::nullopt, token_set.addPattern("cluster.**.$"));
+  EXPECT_EQ(5, token_set.size());
+
+  const auto match = [&token_set](absl::string_view stat_name) {
+    TagExtractionContext context(stat_name);
+    return context.tokenSetMatches(token_set);
+  };
+  EXPECT_EQ(std::vector<bool>({true, false, true, false, false}),
+            match("http.hcm.user_agent.ios.downstream_cx_total"));
+  EXPECT_EQ(std::vector<bool>({false, true, true, false, false}),
+            match("http.hcm.fault.upstream.aborts_injected"));
+  EXPECT_EQ(std::vector<bool>({false, false, true, true, false}), match("http.rbac.allowed"));
+  // A trailing "**" must match at least one token.
+  EXPECT_EQ(std::vector<bool>({false, false, false, false, false}), match("http.hcm"));
+  // A "**" followed by more tokens may match none.
+  EXPECT_EQ(std::vector<bool>({false, false, false, false, true}), match("cluster.c.query.get"));
+  EXPECT_EQ(std::vector<bool>({false, false, false, false, true}),
+            match("cluster.c.a.query.b.query.get"));
+  EXPECT_EQ(std::vector<bool>({false, false, false, false, false}), match("cluster.c.query"));
+}
+
+TEST(TagExtractorTokenSetTest, DefaultTokenizedDescriptors) {
+  // All default token extractors are matched through the set.
+  TagExtractorTokenSet token_set;
+  for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
+    EXPECT_NE(absl::nullopt, token_set.addPattern(desc.pattern_)) << desc.pattern_;
+  }
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -4795,6 +4795,171 @@ TEST_F(TcpHealthCheckerImplTest, PassiveFailureCrossThreadRemoveClusterRace) {
   EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.passive_failure").value());
 }
 
+// Tests that a host shared by clusters sharing their probes is only probed once, and that the
+// results are applied according to the thresholds of each cluster.
+TEST_F(TcpHealthCheckerImplTest, SharedProbes) {
+  InSequence s;
+
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    share_probes: true
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF";
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80")};
+
+  auto other_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  envoy::config::core::v3::HealthCheck other_config = parseHealthCheckFromV3Yaml(yaml);
+  other_config.mutable_unhealthy_threshold()->set_value(1);
+  auto other_health_checker = std::make_shared<TcpHealthCheckerImpl>(
+      *other_cluster, other_config, dispatcher_, runtime_, random_, nullptr);
+  other_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(other_cluster->info_, "tcp://127.0.0.1:80")};
+  const HostSharedPtr other_host = other_cluster->prioritySet().getMockHostSet(0)->hosts_[0];
+
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  // The host of the other cluster is not probed.
+  Event::MockTimer* other_interval_timer = new Event::MockTimer(&dispatcher_);
+  new Event::MockTimer(&dispatcher_);
+  other_health_checker->start();
+  EXPECT_FALSE(other_interval_timer->enabled());
+
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  // A single timeout fails the host of the other cluster only.
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  timeout_timer_->invokeCallback();
+  EXPECT_FALSE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
+      Host::HealthFlag::FAILED_ACTIVE_HC));
+  EXPECT_TRUE(other_host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC));
+  EXPECT_FALSE(other_interval_timer->enabled());
+
+  EXPECT_EQ(1UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.probes_saved").value());
+  EXPECT_EQ(0UL, other_cluster->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, other_cluster->info_->stats_store_.counter("health_check.success").value());
+  EXPECT_EQ(1UL, other_cluster->info_->stats_store_.counter("health_check.failure").value());
+  EXPECT_EQ(2UL, other_cluster->info_->stats_store_.counter("health_check.probes_saved").value());
+
+  // The host of the other cluster is probed once the one of this cluster is removed.
+  EXPECT_CALL(*other_interval_timer, enableTimer(_, _));
+  HostVector old_hosts = std::move(cluster_->prioritySet().getMockHostSet(0)->hosts_);
+  cluster_->prioritySet().getMockHostSet(0)->runCallbacks({}, old_hosts);
+}
+
+// Verify that a health checker running on its own thread posts the health transitions of its hosts
+// back to the main thread in batches.
+TEST_F(TcpHealthCheckerImplTest, DedicatedThread) {
+  InSequence s;
+
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 1
+    healthy_threshold: 1
+    tcp_health_check: {}
+    )EOF";
+  NiceMock<Event::MockDispatcher> main_thread_dispatcher;
+  health_checker_ = HealthCheckerImplBase::makeHealthChecker<TcpHealthCheckerImpl>(
+      main_thread_dispatcher, *cluster_, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_,
+      random_, nullptr);
+  testing::MockFunction<void(HostSharedPtr, HealthTransition, HealthState)> host_status;
+  health_checker_->addHostCheckCompleteCb(host_status.AsStdFunction());
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80"),
+      makeTestHost(cluster_->info_, "tcp://127.0.0.2:80")};
+
+  // The hosts are added on the health check thread.
+  EXPECT_CALL(dispatcher_, post(_));
+  std::vector<Event::MockTimer*> timeout_timers;
+  for (size_t i = 0; i < 2; i++) {
+    expectSessionCreate();
+    expectClientCreate();
+    EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+    timeout_timers.push_back(timeout_timer_);
+  }
+  health_checker_->start();
+
+  // Both hosts fail before the main thread gets to run the callbacks.
+  Event::PostCb flush;
+  EXPECT_CALL(main_thread_dispatcher, post(_)).WillOnce([&flush](Event::PostCb cb) {
+    flush = std::move(cb);
+  });
+  for (Event::MockTimer* timeout_timer : timeout_timers) {
+    timeout_timer->invokeCallback();
+  }
+
+  EXPECT_CALL(host_status, Call(_, HealthTransition::Changed, HealthState::Unhealthy)).Times(2);
+  flush();
+
+  health_checker_.reset();
+}
+
+// Verify that a health checker running on its own thread does not access its cluster once the
+// cluster is destroyed, while its deletion is still pending on the health check thread.
+TEST_F(TcpHealthCheckerImplTest, DedicatedThreadClusterDestroyed) {
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 1
+    healthy_threshold: 1
+    tcp_health_check: {}
+    )EOF";
+  NiceMock<Event::MockDispatcher> main_thread_dispatcher;
+  health_checker_ = HealthCheckerImplBase::makeHealthChecker<TcpHealthCheckerImpl>(
+      main_thread_dispatcher, *cluster_, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_,
+      random_, nullptr);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80")};
+
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  // The cluster is destroyed on the main thread right after its health checker, whose deletion is
+  // posted to the health check thread.
+  Event::PostCb deletion;
+  EXPECT_CALL(dispatcher_, isThreadSafe()).WillOnce(Return(false));
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce([&deletion](Event::PostCb cb) {
+    deletion = std::move(cb);
+  });
+  health_checker_.reset();
+  cluster_.reset();
+
+  // The pending timeout still schedules the next check, with the interval of the cluster info.
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  timeout_timer_->invokeCallback();
+
+  // The info of the cluster is released back on the main thread.
+  Event::PostCb release;
+  EXPECT_CALL(main_thread_dispatcher, post(_)).WillOnce([&release](Event::PostCb cb) {
+    release = std::move(cb);
+  });
+  deletion();
+  ASSERT_NE(nullptr, release);
+  release();
+}
+
 TEST_F(TcpHealthCheckerImplTest, ConnectionLocalFailure) {
   InSequence s;
 
@@ -7249,6 +7414,74 @@ TEST_F(HttpHealthCheckerImplTest, MinimalPayloadPostMethod) {
             cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
 }
 
+// Verify that the hosts of clusters that differ only in their name, which is the default host header
+// of their probes, or in their transport socket, e.g. in their SNI, do not share their probes.
+TEST_F(HttpHealthCheckerImplTest, SharedProbesRequireIdenticalProbes) {
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    share_probes: true
+    http_health_check:
+      path: /healthcheck
+    )EOF";
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80")};
+  expectSessionCreate();
+  expectStreamCreate(0);
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+  const std::shared_ptr<TestHttpHealthCheckerImpl> health_checker = health_checker_;
+
+  // The probes of a cluster with another name are sent with another host header.
+  auto renamed_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  renamed_cluster->info_->name_ = "renamed_cluster";
+  renamed_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(renamed_cluster->info_, "tcp://127.0.0.1:80")};
+  health_checker_ = std::make_shared<TestHttpHealthCheckerImpl>(
+      *renamed_cluster, parseHealthCheckFromV3Yaml(yaml), context_, nullptr);
+  expectSessionCreate();
+  expectStreamCreate(1);
+  EXPECT_CALL(*test_sessions_[1]->timeout_timer_, enableTimer(_, _));
+  EXPECT_CALL(test_sessions_[1]->request_encoder_, encodeHeaders(_, true))
+      .WillOnce(Invoke([](const Http::RequestHeaderMap& headers, bool) -> Http::Status {
+        EXPECT_EQ("renamed_cluster", headers.getHostValue());
+        return Http::okStatus();
+      }));
+  health_checker_->start();
+  const std::shared_ptr<TestHttpHealthCheckerImpl> renamed_health_checker = health_checker_;
+
+  // The probes of a cluster with another SNI are sent over another transport socket.
+  auto sni_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  ON_CALL(*sni_cluster->info_, transportSocketConfigHash()).WillByDefault(Return(1));
+  sni_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(sni_cluster->info_, "tcp://127.0.0.1:80")};
+  health_checker_ = std::make_shared<TestHttpHealthCheckerImpl>(
+      *sni_cluster, parseHealthCheckFromV3Yaml(yaml), context_, nullptr);
+  expectSessionCreate();
+  expectStreamCreate(2);
+  EXPECT_CALL(*test_sessions_[2]->timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  // The host of an identical cluster is not probed.
+  auto identical_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  identical_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(identical_cluster->info_, "tcp://127.0.0.1:80")};
+  auto identical_health_checker = std::make_shared<TestHttpHealthCheckerImpl>(
+      *identical_cluster, parseHealthCheckFromV3Yaml(yaml), context_, nullptr);
+  Event::MockTimer* identical_timeout_timer = new Event::MockTimer(&dispatcher_);
+  new Event::MockTimer(&dispatcher_);
+  identical_health_checker->start();
+  EXPECT_FALSE(identical_timeout_timer->enabled());
+
+  EXPECT_EQ(1UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, renamed_cluster->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, sni_cluster->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, identical_cluster->info_->stats_store_.counter("health_check.attempt").value());
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -143,7 +143,7 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
   time_system_.setMonotonicTime(std::chrono::microseconds(3));
   // Start reporting on foo.
   NiceMock<MockClusterMockPrioritySet> foo_cluster;
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(2);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(2);
   foo_cluster.info_->eds_service_name_ = "bar";
   NiceMock<MockClusterMockPrioritySet> bar_cluster;
   ON_CALL(cm_, getActiveCluster("foo"))
@@ -152,8 +152,8 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
       .WillByDefault(Return(OptRef<const Upstream::Cluster>(bar_cluster)));
   deliverLoadStatsResponse({"foo"});
   // Initial stats report for foo on timer tick.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(5);
-  foo_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(7);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(5);
+  foo_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(7);
   time_system_.setMonotonicTime(std::chrono::microseconds(4));
   {
     envoy::config::endpoint::v3::ClusterStats foo_cluster_stats;
@@ -169,17 +169,17 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
   response_timer_cb_();
 
   // Some traffic on foo/bar in between previous request and next response.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(5);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(5);
 
   // Start reporting on bar.
   time_system_.setMonotonicTime(std::chrono::microseconds(6));
   deliverLoadStatsResponse({"foo", "bar"});
   // Stats report foo/bar on timer tick.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(3);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(3);
   time_system_.setMonotonicTime(std::chrono::microseconds(28));
   {
     envoy::config::endpoint::v3::ClusterStats foo_cluster_stats;
@@ -200,16 +200,16 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
   response_timer_cb_();
 
   // Some traffic on foo/bar in between previous request and next response.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(1);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(1);
 
   // Stop reporting on foo.
   deliverLoadStatsResponse({"bar"});
   // Stats report for bar on timer tick.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(5);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(5);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(7);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(5);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(5);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(7);
   time_system_.setMonotonicTime(std::chrono::microseconds(33));
   {
     envoy::config::endpoint::v3::ClusterStats bar_cluster_stats;
@@ -224,19 +224,19 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
   response_timer_cb_();
 
   // Some traffic on foo/bar in between previous request and next response.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  foo_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(8);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(3);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  foo_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(8);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(3);
 
   // Start tracking foo again, we should forget earlier history for foo.
   time_system_.setMonotonicTime(std::chrono::microseconds(43));
   deliverLoadStatsResponse({"foo", "bar"});
   // Stats report foo/bar on timer tick.
-  foo_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  foo_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(9);
-  bar_cluster.info_->load_report_stats_.upstream_rq_dropped_.add(1);
-  bar_cluster.info_->load_report_stats_.upstream_rq_drop_overload_.add(4);
+  foo_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  foo_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(9);
+  bar_cluster.info_->load_report_stats_->upstream_rq_dropped_.add(1);
+  bar_cluster.info_->load_report_stats_->upstream_rq_drop_overload_.add(4);
   time_system_.setMonotonicTime(std::chrono::microseconds(47));
   {
     envoy::config::endpoint::v3::ClusterStats foo_cluster_stats;
@@ -1909,6 +1909,79 @@ TEST_F(HostImplTest, HostnameCanaryAndLocality) {
   EXPECT_EQ(1, host->priority());
 }
 
+// Hosts of the same locality share one copy of it.
+TEST_F(HostImplTest, SharedLocality) {
+  MockClusterMockPrioritySet cluster;
+  envoy::config::core::v3::Locality locality;
+  locality.set_region("oceania");
+  locality.set_zone("hello");
+  auto create_host = [&](const std::string& url) {
+    return *HostImpl::create(
+        cluster.info_, "", *Network::Utility::resolveUrl(url), nullptr, nullptr, 1, locality,
+        envoy::config::endpoint::v3::Endpoint::HealthCheckConfig::default_instance(), 0,
+        envoy::config::core::v3::UNKNOWN);
+  };
+  std::unique_ptr<HostImpl> host1 = create_host("tcp://10.0.0.1:1234");
+  std::unique_ptr<HostImpl> host2 = create_host("tcp://10.0.0.2:1234");
+  EXPECT_EQ(&host1->locality(), &host2->locality());
+  EXPECT_EQ(host1->localityZoneStatName().data(), host2->localityZoneStatName().data());
+
+  locality.set_sub_zone("world");
+  std::unique_ptr<HostImpl> host3 = create_host("tcp://10.0.0.3:1234");
+  EXPECT_NE(&host1->locality(), &host3->locality());
+  EXPECT_EQ("world", host3->locality().sub_zone());
+
+  // Once all hosts of a locality are gone, a new host gets a new copy of the locality.
+  host1.reset();
+  host2.reset();
+  locality.clear_sub_zone();
+  std::unique_ptr<HostImpl> host4 = create_host("tcp://10.0.0.4:1234");
+  EXPECT_EQ("oceania", host4->locality().region());
+  EXPECT_EQ("", host4->locality().sub_zone());
+
+  // Hosts of clusters with another symbol table do not share the locality, as its zone stat name
+  // is encoded with the symbol table.
+  Stats::SymbolTableImpl symbol_table;
+  Stats::TestUtil::TestStore store(symbol_table);
+  ON_CALL(*cluster.info_, statsScope()).WillByDefault(ReturnRef(*store.rootScope()));
+  std::unique_ptr<HostImpl> host5 = create_host("tcp://10.0.0.5:1234");
+  EXPECT_NE(&host4->locality(), &host5->locality());
+  EXPECT_EQ("hello", symbol_table.toString(host5->localityZoneStatName()));
+  host5.reset();
+}
+
+// Host stats are allocated on first use, and are not allocated by listing or reading them.
+TEST_F(HostImplTest, LazyStats) {
+  MockClusterMockPrioritySet cluster;
+  std::unique_ptr<HostImpl> host = *HostImpl::create(
+      cluster.info_, "", *Network::Utility::resolveUrl("tcp://10.0.0.1:1234"), nullptr, nullptr, 1,
+      envoy::config::core::v3::Locality(),
+      envoy::config::endpoint::v3::Endpoint::HealthCheckConfig::default_instance(), 0,
+      envoy::config::core::v3::UNKNOWN);
+  EXPECT_FALSE(host->statsIfAllocated().has_value());
+
+  for (const auto& [name, counter] : host->counters()) {
+    EXPECT_EQ(0, counter.get().value());
+  }
+  for (const auto& [name, gauge] : host->gauges()) {
+    EXPECT_EQ(0, gauge.get().value());
+  }
+  EXPECT_EQ(0, host->activeRequests());
+  EXPECT_FALSE(host->statsIfAllocated().has_value());
+
+  host->stats().rq_total_.inc();
+  host->stats().rq_active_.inc();
+  ASSERT_TRUE(host->statsIfAllocated().has_value());
+  EXPECT_EQ(&host->stats(), &host->statsIfAllocated().ref());
+  EXPECT_EQ(1, host->activeRequests());
+  for (const auto& [name, counter] : host->counters()) {
+    EXPECT_EQ(name == "rq_total" ? 1 : 0, counter.get().value());
+  }
+  for (const auto& [name, gauge] : host->gauges()) {
+    EXPECT_EQ(name == "rq_active" ? 1 : 0, gauge.get().value());
+  }
+}
+
 TEST_F(HostImplTest, CreateConnection) {
   MockClusterMockPrioritySet cluster;
   envoy::config::core::v3::Metadata metadata;
@@ -2953,6 +3026,73 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
   EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
 }
 
+// Verify that the health transitions seen during a health update merge window are applied together
+// when it ends.
+TEST_F(StaticClusterImplTest, HealthUpdateMergeWindow) {
+  const std::string yaml = R"EOF(
+    name: addressportconfig
+    connect_timeout: 0.25s
+    type: static
+    lb_policy: random
+    common_lb_config:
+      health_update_merge_window: 1s
+    load_assignment:
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11001
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11002
+  )EOF";
+
+  envoy::config::cluster::v3::Cluster cluster_config = parseClusterFromV3Yaml(yaml);
+
+  Envoy::Upstream::ClusterFactoryContextImpl factory_context(server_context_, nullptr, nullptr,
+                                                             false);
+  Event::MockTimer* merge_timer = new Event::MockTimer(&server_context_.dispatcher_);
+  std::shared_ptr<StaticClusterImpl> cluster = createCluster(cluster_config, factory_context);
+
+  std::shared_ptr<MockHealthChecker> health_checker(new NiceMock<MockHealthChecker>());
+  cluster->setHealthChecker(health_checker);
+  cluster->initialize([] { return absl::OkStatus(); });
+
+  const HostVector hosts = cluster->prioritySet().hostSetsPerPriority()[0]->hosts();
+  for (const HostSharedPtr& host : hosts) {
+    host->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+    health_checker->runCallbacks(host, HealthTransition::Changed, HealthState::Healthy);
+  }
+  // The initial recalculation opens a merge window.
+  EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_TRUE(merge_timer->enabled());
+
+  for (const HostSharedPtr& host : hosts) {
+    host->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    health_checker->runCallbacks(host, HealthTransition::Changed, HealthState::Unhealthy);
+  }
+  EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_EQ(2UL, cluster->info()->configUpdateStats().health_update_merged_.value());
+
+  // Both transitions are applied when the window ends, which opens a new one.
+  merge_timer->invokeCallback();
+  EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_TRUE(merge_timer->enabled());
+
+  // Without transitions during the window, the next one applies immediately.
+  merge_timer->invokeCallback();
+  EXPECT_FALSE(merge_timer->enabled());
+  hosts[0]->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+  health_checker->runCallbacks(hosts[0], HealthTransition::Changed, HealthState::Healthy);
+  EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_TRUE(merge_timer->enabled());
+  EXPECT_EQ(2UL, cluster->info()->configUpdateStats().health_update_merged_.value());
+}
+
 TEST_F(StaticClusterImplTest, InitialHostsDisableHC) {
   const std::string yaml = R"EOF(
     name: staticcluster
@@ -4917,6 +5057,43 @@ TEST_P(ParametrizedClusterInfoImplTest, DEPRECATED_FEATURE_TEST(TestTrackTimeout
             tb_stats.upstream_rq_timeout_budget_per_try_percent_used_.unit());
 }
 
+TEST_P(ParametrizedClusterInfoImplTest, DeferredCreationOfOptionalAndLoadReportStats) {
+  ON_CALL(server_context_.stats_config_, enableDeferredCreationStats())
+      .WillByDefault(Return(true));
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    track_cluster_stats: { timeout_budgets : true, request_response_sizes : true }
+  )EOF";
+
+  auto cluster = makeCluster(yaml);
+  // Nothing is instantiated until the stats are first referenced.
+  EXPECT_FALSE(cluster->info()->loadReportStats().isPresent());
+  EXPECT_EQ(0, stats_.findGaugeByString("cluster.name.ClusterTimeoutBudgetStats.initialized")
+                   ->get()
+                   .value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+
+  ASSERT_TRUE(cluster->info()->timeoutBudgetStats().has_value());
+  Upstream::ClusterTimeoutBudgetStats& tb_stats = cluster->info()->timeoutBudgetStats()->get();
+  EXPECT_EQ(Stats::Histogram::Unit::Unspecified,
+            tb_stats.upstream_rq_timeout_budget_percent_used_.unit());
+  EXPECT_EQ(1, stats_.findGaugeByString("cluster.name.ClusterTimeoutBudgetStats.initialized")
+                   ->get()
+                   .value());
+
+  ASSERT_TRUE(cluster->info()->requestResponseSizeStats().has_value());
+  cluster->info()->requestResponseSizeStats()->get().upstream_rq_headers_size_.recordValue(10);
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+
+  cluster->info()->loadReportStats()->upstream_rq_dropped_.inc();
+  EXPECT_TRUE(cluster->info()->loadReportStats().isPresent());
+  // Load report stats are kept out of the cluster scope.
+  EXPECT_FALSE(stats_.findCounterByString("cluster.name.upstream_rq_dropped").has_value());
+}
+
 // Validates HTTP2 SETTINGS config.
 TEST_P(ParametrizedClusterInfoImplTest, Http2ProtocolOptions) {
   const std::string yaml = R"EOF(
@@ -6081,6 +6258,35 @@ TEST_F(ClusterInfoImplTest, DeprecatedMaxRequestsPerConnection) {
   EXPECT_EQ(3U, cluster->info()->maxRequestsPerConnection());
 }
 
+// Verify that the hash of the transport socket configuration only depends on the transport socket
+// settings of the cluster, e.g. its SNI.
+TEST_F(ClusterInfoImplTest, TransportSocketConfigHash) {
+  const std::string yaml = R"EOF(
+  name: {}
+  type: STRICT_DNS
+  lb_policy: ROUND_ROBIN
+)EOF";
+  const std::string tls = R"EOF(
+  transport_socket:
+    name: envoy.transport_sockets.tls
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.transport_sockets.tls.v3.UpstreamTlsContext
+      sni: {}
+)EOF";
+
+  auto cluster = makeCluster(fmt::format(yaml, "cluster1"));
+  auto renamed_cluster = makeCluster(fmt::format(yaml, "cluster2"));
+  EXPECT_EQ(cluster->info()->transportSocketConfigHash(),
+            renamed_cluster->info()->transportSocketConfigHash());
+
+  auto foo_cluster = makeCluster(fmt::format(yaml, "cluster1") + fmt::format(tls, "foo.com"));
+  auto bar_cluster = makeCluster(fmt::format(yaml, "cluster1") + fmt::format(tls, "bar.com"));
+  EXPECT_NE(cluster->info()->transportSocketConfigHash(),
+            foo_cluster->info()->transportSocketConfigHash());
+  EXPECT_NE(foo_cluster->info()->transportSocketConfigHash(),
+            bar_cluster->info()->transportSocketConfigHash());
+}
+
 TEST_F(ClusterInfoImplTest, FilterChain) {
   {
     const std::string yaml = TestEnvironment::substitute(R"EOF(
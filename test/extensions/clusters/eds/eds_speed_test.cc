@@ -12,6 +12,7 @@
 
 #include "source/common/config/protobuf_link_hacks.h"
 #include "source/common/config/utility.h"
+#include "source/common/memory/stats.h"
 #include "source/common/singleton/manager_impl.h"
 #include "source/extensions/clusters/eds/eds.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_impl.h"
@@ -166,6 +167,15 @@ public:
            num_hosts);
   }
 
+  // Allocates the stats of every host, as they would be once each host has been used.
+  void allocateHostStats() {
+    for (const auto& host_set : cluster_->prioritySet().hostSetsPerPriority()) {
+      for (const HostSharedPtr& host : host_set->hosts()) {
+        host->stats();
+      }
+    }
+  }
+
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
   Stats::TestUtil::TestStore& stats_ = server_context_.store_;
 
@@ -243,3 +253,48 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Applies an update adding a single endpoint to the cluster, with and without incremental updates.
+static void addSingleEndpoint(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.eds_incremental_updates",
+                               state.range(1) ? "true" : "false"}});
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints + 1, true);
+  }
+}
+
+BENCHMARK(addSingleEndpoint)
+    ->Ranges({{1, 100000}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
+
+// Reports the memory held per host once a cluster load assignment has been applied. This relies
+// on tcmalloc to report allocated memory, and reports 0 without it.
+static void hostMemory(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    const size_t start_mem = Envoy::Memory::Stats::totalCurrentlyAllocated();
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+    const size_t end_mem = Envoy::Memory::Stats::totalCurrentlyAllocated();
+    state.counters["bytes_per_host"] = (end_mem - start_mem) / endpoints;
+    // The memory of hosts once they have all been used, i.e. with the stats of every host
+    // allocated, as they were before host stats were allocated on first use.
+    speed_test.allocateHostStats();
+    const size_t used_mem = Envoy::Memory::Stats::totalCurrentlyAllocated();
+    state.counters["bytes_per_used_host"] = (used_mem - start_mem) / endpoints;
+  }
+}
+
+BENCHMARK(hostMemory)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -387,6 +387,97 @@ TEST_F(EdsTest, EndpointWeightChangeCausesRebuild) {
   EXPECT_EQ(new_hosts[0]->weight(), 31);
 }
 
+// Verify that with incremental updates, hosts added to, removed from and changed in existing
+// localities are applied as a delta to the host set.
+TEST_F(EdsTest, IncrementalUpdates) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.eds_incremental_updates", "true"}});
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  endpoints->mutable_locality()->set_zone("us-east-1a");
+  auto add_endpoint = [](envoy::config::endpoint::v3::LocalityLbEndpoints& endpoints,
+                         uint32_t port) {
+    auto* socket_address = endpoints.add_lb_endpoints()
+                               ->mutable_endpoint()
+                               ->mutable_address()
+                               ->mutable_socket_address();
+    socket_address->set_address("1.2.3.4");
+    socket_address->set_port_value(port);
+  };
+  add_endpoint(*endpoints, 80);
+  add_endpoint(*endpoints, 81);
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+  // The first update adds a locality.
+  EXPECT_EQ(0UL,
+            stats_.findCounterByString("cluster.name.update_incremental").value().get().value());
+  const HostSharedPtr host = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[0];
+
+  // Add a host.
+  add_endpoint(*endpoints, 82);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL,
+            stats_.findCounterByString("cluster.name.update_incremental").value().get().value());
+  {
+    const HostSet& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+    EXPECT_EQ(3, host_set.hosts().size());
+    EXPECT_EQ(host, host_set.hosts()[0]);
+    EXPECT_EQ(3, host_set.healthyHosts().size());
+    ASSERT_EQ(1, host_set.hostsPerLocality().get().size());
+    EXPECT_EQ(3, host_set.hostsPerLocality().get()[0].size());
+    EXPECT_EQ(3, host_set.healthyHostsPerLocality().get()[0].size());
+  }
+
+  // Change the health of a host.
+  endpoints->mutable_lb_endpoints(0)->set_health_status(envoy::config::core::v3::DRAINING);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(2UL,
+            stats_.findCounterByString("cluster.name.update_incremental").value().get().value());
+  {
+    const HostSet& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+    EXPECT_EQ(3, host_set.hosts().size());
+    EXPECT_EQ(host, host_set.hosts()[0]);
+    EXPECT_EQ(Host::Health::Unhealthy, host->coarseHealth());
+    EXPECT_EQ(2, host_set.healthyHosts().size());
+    EXPECT_EQ(2, host_set.healthyHostsPerLocality().get()[0].size());
+    ASSERT_EQ(1, host_set.excludedHosts().size());
+    EXPECT_EQ(host, host_set.excludedHosts()[0]);
+    EXPECT_EQ(1, host_set.excludedHostsPerLocality().get()[0].size());
+  }
+
+  // Remove a host.
+  endpoints->mutable_lb_endpoints()->DeleteSubrange(1, 1);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(3UL,
+            stats_.findCounterByString("cluster.name.update_incremental").value().get().value());
+  {
+    const HostSet& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+    EXPECT_EQ(2, host_set.hosts().size());
+    EXPECT_EQ(1, host_set.healthyHosts().size());
+    EXPECT_EQ(2, host_set.hostsPerLocality().get()[0].size());
+    EXPECT_EQ(1, host_set.healthyHostsPerLocality().get()[0].size());
+    EXPECT_EQ(1, host_set.excludedHosts().size());
+  }
+
+  // Add a host in a new locality, which needs a full update.
+  auto* other_endpoints = cluster_load_assignment.add_endpoints();
+  other_endpoints->mutable_locality()->set_zone("us-east-1b");
+  add_endpoint(*other_endpoints, 83);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(3UL,
+            stats_.findCounterByString("cluster.name.update_incremental").value().get().value());
+  {
+    const HostSet& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+    EXPECT_EQ(3, host_set.hosts().size());
+    EXPECT_EQ(2, host_set.healthyHosts().size());
+    EXPECT_EQ(2, host_set.hostsPerLocality().get().size());
+  }
+}
+
 // Verify that host weight changes cause a full rebuild.
 TEST_F(EdsTest, DualStackEndpoint) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
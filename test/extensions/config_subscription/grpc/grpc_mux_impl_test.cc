@@ -11,6 +11,7 @@
 #include "source/common/config/null_grpc_mux_impl.h"
 #include "source/common/config/protobuf_link_hacks.h"
 #include "source/common/config/utility.h"
+#include "source/common/config/xds_decoding_pool.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_impl.h"
@@ -24,6 +25,7 @@
 #include "test/mocks/grpc/mocks.h"
 #include "test/mocks/local_info/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/logging.h"
 #include "test/test_common/resources.h"
 #include "test/test_common/simulated_time_system.h"
@@ -32,6 +34,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -761,6 +764,212 @@ TEST_P(GrpcMuxImplTest, WatchDemux) {
   expectSendMessage(type_url, {}, "2");
 }
 
+// Validate that with xDS decoding threads, the resources of responses are decoded on them, and
+// that the responses are applied, ACKed and NACKed in order on the main thread.
+TEST_P(GrpcMuxImplTest, XdsDecodingThreads) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<ThreadLocal::MockInstance> tls;
+  StackedScopedInjectableLoaderForTest<XdsDecodingPool> pool(
+      std::make_unique<XdsDecodingPool>(2, tls, *api));
+  // Hold what the decoding threads post back to the main thread, to run it on this one.
+  absl::Mutex mutex;
+  std::vector<Event::PostCb> posted;
+  ON_CALL(dispatcher_, post(_)).WillByDefault([&mutex, &posted](Event::PostCb callback) {
+    absl::MutexLock lock(&mutex);
+    posted.push_back(std::move(callback));
+  });
+  const auto run_posted = [&mutex, &posted]() {
+    std::vector<Event::PostCb> callbacks;
+    {
+      absl::MutexLock lock(&mutex);
+      mutex.Await(absl::Condition(
+          +[](std::vector<Event::PostCb>* posted) { return !posted->empty(); }, &posted));
+      callbacks.swap(posted);
+    }
+    for (Event::PostCb& callback : callbacks) {
+      callback();
+    }
+  };
+
+  setup();
+  InSequence s;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  const std::string& type_url = Config::TestTypeUrl::get().ClusterLoadAssignment;
+  NiceMock<MockSubscriptionCallbacks> foo_callbacks;
+  auto foo_sub =
+      grpc_mux_->addWatch(type_url, {"x", "y", "z"}, foo_callbacks, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {"x", "y", "z"}, "", true);
+  grpc_mux_->start();
+
+  auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_version_info("1");
+  response->set_nonce("n1");
+  for (const char* name : {"x", "y", "z"}) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+    load_assignment.set_cluster_name(name);
+    response->add_resources()->PackFrom(load_assignment);
+  }
+  // The second response is only handed off once the first has been applied.
+  auto invalid_response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  invalid_response->set_type_url(type_url);
+  invalid_response->set_version_info("2");
+  invalid_response->set_nonce("n2");
+  invalid_response->mutable_resources()->Add()->set_type_url("bar");
+  const std::string error_message =
+      fmt::format("bar does not match the message-wide type URL {} in DiscoveryResponse {}",
+                  type_url, invalid_response->DebugString());
+  EXPECT_CALL(foo_callbacks, onConfigUpdate(_, _)).Times(0);
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(invalid_response));
+
+  EXPECT_CALL(foo_callbacks, onConfigUpdate(_, "1"))
+      .WillOnce(Invoke([](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+        EXPECT_EQ(3, resources.size());
+        EXPECT_EQ("x", resources[0].get().name());
+        EXPECT_EQ("y", resources[1].get().name());
+        EXPECT_EQ("z", resources[2].get().name());
+        return absl::OkStatus();
+      }));
+  expectSendMessage(type_url, {"x", "y", "z"}, "1", false, "n1");
+  run_posted();
+
+  EXPECT_CALL(foo_callbacks, onConfigUpdateFailed(_, _));
+  expectSendMessage(type_url, {"x", "y", "z"}, "1", false, "n2",
+                    Grpc::Status::WellKnownGrpcStatus::Internal, error_message);
+  run_posted();
+  EXPECT_EQ(2U, stats_.histogramValues("control_plane.decode_duration_us.ClusterLoadAssignment",
+                                       false)
+                    .size());
+
+  expectSendMessage(type_url, {}, "1", false, "n2");
+}
+
+// Validate that the xDS decoding threads may still decode the resources of a response after the
+// mux is gone.
+TEST_P(GrpcMuxImplTest, XdsDecodingThreadsOutliveMux) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<ThreadLocal::MockInstance> tls;
+  StackedScopedInjectableLoaderForTest<XdsDecodingPool> pool(
+      std::make_unique<XdsDecodingPool>(1, tls, *api));
+
+  // A decoder that blocks the decoding thread until the mux has been destroyed.
+  class BlockingResourceDecoder : public TestUtility::TestOpaqueResourceDecoderImpl<
+                                      envoy::config::endpoint::v3::ClusterLoadAssignment> {
+  public:
+    BlockingResourceDecoder() : TestOpaqueResourceDecoderImpl("cluster_name") {}
+
+    ProtobufTypes::MessagePtr decodeResource(const Protobuf::Any& resource) override {
+      decoding_.Notify();
+      resume_.WaitForNotification();
+      return TestOpaqueResourceDecoderImpl::decodeResource(resource);
+    }
+
+    absl::Notification decoding_;
+    absl::Notification resume_;
+  };
+  auto resource_decoder = std::make_shared<BlockingResourceDecoder>();
+
+  setup();
+  const std::string& type_url = Config::TestTypeUrl::get().ClusterLoadAssignment;
+  NiceMock<MockSubscriptionCallbacks> foo_callbacks;
+  auto foo_sub = grpc_mux_->addWatch(type_url, {"x"}, foo_callbacks, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {"x"}, "", true);
+  grpc_mux_->start();
+
+  auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_version_info("1");
+  response->set_nonce("n1");
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+  load_assignment.set_cluster_name("x");
+  response->add_resources()->PackFrom(load_assignment);
+  EXPECT_CALL(foo_callbacks, onConfigUpdate(_, _)).Times(0);
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+
+  resource_decoder->decoding_.WaitForNotification();
+  foo_sub.reset();
+  grpc_mux_.reset();
+  // What the decoding thread posts back once done is dropped, as the mux is gone.
+  absl::Notification decoded;
+  ON_CALL(dispatcher_, post(_)).WillByDefault([&decoded](Event::PostCb) { decoded.Notify(); });
+  resource_decoder->resume_.Notify();
+  decoded.WaitForNotification();
+  EXPECT_EQ(1U, stats_.counter("control_plane.resources_decoded.ClusterLoadAssignment").value());
+}
+
+// Validate that resources identical to those of the previous response are not decoded again.
+TEST_P(GrpcMuxImplTest, ReuseUnchangedResources) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.xds_reuse_unchanged_resources", "true"}});
+  setup();
+  InSequence s;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  const std::string& type_url = Config::TestTypeUrl::get().ClusterLoadAssignment;
+  NiceMock<MockSubscriptionCallbacks> foo_callbacks;
+  auto foo_sub = grpc_mux_->addWatch(type_url, {"x", "y"}, foo_callbacks, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {"x", "y"}, "", true);
+  grpc_mux_->start();
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_x;
+  load_assignment_x.set_cluster_name("x");
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_y;
+  load_assignment_y.set_cluster_name("y");
+  const Protobuf::Message* decoded_x = nullptr;
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("1");
+    response->add_resources()->PackFrom(load_assignment_x);
+    response->add_resources()->PackFrom(load_assignment_y);
+    EXPECT_CALL(foo_callbacks, onConfigUpdate(_, "1"))
+        .WillOnce(Invoke([&decoded_x](const std::vector<DecodedResourceRef>& resources,
+                                      const std::string&) {
+          EXPECT_EQ(2, resources.size());
+          decoded_x = &resources[0].get().resource();
+          return absl::OkStatus();
+        }));
+    expectSendMessage(type_url, {"x", "y"}, "1");
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+  EXPECT_EQ(2, stats_.counter("control_plane.resources_decoded.ClusterLoadAssignment").value());
+  EXPECT_EQ(0, stats_.counter("control_plane.resources_unchanged.ClusterLoadAssignment").value());
+
+  {
+    // Only y changes, so x is reused as it was decoded for the first response.
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("2");
+    response->add_resources()->PackFrom(load_assignment_x);
+    load_assignment_y.mutable_policy()->mutable_overprovisioning_factor()->set_value(140);
+    response->add_resources()->PackFrom(load_assignment_y);
+    EXPECT_CALL(foo_callbacks, onConfigUpdate(_, "2"))
+        .WillOnce(Invoke([&decoded_x, &load_assignment_y](
+                             const std::vector<DecodedResourceRef>& resources, const std::string&) {
+          EXPECT_EQ(2, resources.size());
+          EXPECT_EQ(decoded_x, &resources[0].get().resource());
+          EXPECT_EQ("x", resources[0].get().name());
+          // The reused resource has the version of the response it was received in.
+          EXPECT_EQ("2", resources[0].get().version());
+          EXPECT_EQ("2", resources[1].get().version());
+          EXPECT_TRUE(TestUtility::protoEqual(resources[1].get().resource(), load_assignment_y));
+          return absl::OkStatus();
+        }));
+    expectSendMessage(type_url, {"x", "y"}, "2");
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+  EXPECT_EQ(3, stats_.counter("control_plane.resources_decoded.ClusterLoadAssignment").value());
+  EXPECT_EQ(1, stats_.counter("control_plane.resources_unchanged.ClusterLoadAssignment").value());
+
+  expectSendMessage(type_url, {}, "2");
+}
+
 // Validate behavior when we have multiple watchers that send empty updates.
 TEST_P(GrpcMuxImplTest, MultipleWatcherWithEmptyUpdates) {
   setup();
@@ -10,6 +10,7 @@
 
 #include "test/extensions/filters/network/common/redis/mocks.h"
 #include "test/extensions/filters/network/common/redis/test_utils.h"
+#include "test/mocks/buffer/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/upstream/host.h"
 #include "test/test_common/simulated_time_system.h"
@@ -68,6 +69,9 @@ public:
     // Create timers in order they are created in client_impl.cc
     connect_or_op_timer_ = new Event::MockTimer(&dispatcher_);
     flush_timer_ = new Event::MockTimer(&dispatcher_);
+    if (config_->flushPerEventLoopIteration() && config_->maxBufferSizeBeforeFlush() == 0) {
+      flush_cb_ = new Event::MockSchedulableCallback(&dispatcher_);
+    }
 
     EXPECT_CALL(*connect_or_op_timer_, enableTimer(_, _));
     EXPECT_CALL(*host_, createConnection_(_, _)).WillOnce(Return(conn_info));
@@ -132,6 +136,7 @@ public:
   std::shared_ptr<Upstream::MockHost> host_{new NiceMock<Upstream::MockHost>()};
   Event::MockDispatcher dispatcher_;
   Event::MockTimer* flush_timer_{};
+  Event::MockSchedulableCallback* flush_cb_{};
   Event::MockTimer* connect_or_op_timer_{};
   MockEncoder* encoder_{new MockEncoder()};
   MockDecoder* decoder_{new MockDecoder()};
@@ -188,6 +193,8 @@ class ConfigBufferSizeGTSingleRequest : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(1);
   }
+  bool flushPerEventLoopIteration() const override { return false; }
+  uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return false; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
@@ -288,6 +295,63 @@ TEST_F(RedisClientImplTest, BatchWithTimerCancelledByBufferFlush) {
   client_->close();
 }
 
+class ConfigFlushPerEventLoopIteration : public Config {
+  bool disableOutlierEvents() const override { return false; }
+  std::chrono::milliseconds opTimeout() const override { return std::chrono::milliseconds(25); }
+  bool enableHashtagging() const override { return false; }
+  bool enableRedirection() const override { return false; }
+  unsigned int maxBufferSizeBeforeFlush() const override { return 0; }
+  std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
+    return std::chrono::milliseconds(0);
+  }
+  bool flushPerEventLoopIteration() const override { return true; }
+  uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
+  uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+  bool enableCommandStats() const override { return false; }
+  ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
+  bool connectionRateLimitEnabled() const override { return false; }
+  uint32_t connectionRateLimitPerSec() const override { return 0; }
+};
+
+TEST_F(RedisClientImplTest, BatchPerEventLoopIteration) {
+  // All requests made within one event loop iteration are written upstream together when the
+  // iteration completes, without arming the flush timer.
+  InSequence s;
+
+  setup(std::make_shared<ConfigFlushPerEventLoopIteration>());
+  ASSERT_NE(nullptr, flush_cb_);
+
+  Common::Redis::RespValue request1;
+  MockClientCallbacks callbacks1;
+  EXPECT_CALL(*encoder_, encode(Ref(request1), _))
+      .WillOnce(Invoke([](const Common::Redis::RespValue&, Buffer::Instance& out) {
+        out.add("request1");
+      }));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
+  EXPECT_NE(nullptr, client_->makeRequest(request1, callbacks1));
+
+  Common::Redis::RespValue request2;
+  MockClientCallbacks callbacks2;
+  EXPECT_CALL(*encoder_, encode(Ref(request2), _))
+      .WillOnce(Invoke([](const Common::Redis::RespValue&, Buffer::Instance& out) {
+        out.add("request2");
+      }));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration()).Times(0);
+  EXPECT_NE(nullptr, client_->makeRequest(request2, callbacks2));
+
+  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*upstream_connection_, write(BufferStringEqual("request1request2"), false));
+  flush_cb_->invokeCallback();
+
+  EXPECT_CALL(host_->outlier_detector_,
+              putResult(Upstream::Outlier::Result::LocalOriginConnectFailed, _));
+  EXPECT_CALL(callbacks1, onFailure());
+  EXPECT_CALL(callbacks2, onFailure());
+  EXPECT_CALL(*connect_or_op_timer_, disableTimer());
+  EXPECT_CALL(*flush_cb_, cancel());
+  upstream_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+}
+
 TEST_F(RedisClientImplTest, Basic) {
   InSequence s;
 
@@ -349,6 +413,8 @@ class ConfigEnableCommandStats : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(0);
   }
+  bool flushPerEventLoopIteration() const override { return false; }
+  uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return true; }
@@ -737,6 +803,8 @@ class ConfigOutlierDisabled : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(0);
   }
+  bool flushPerEventLoopIteration() const override { return false; }
+  uint32_t zeroCopyMinBulkStringSize() const override { return 0; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Primary; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return false; }
@@ -275,6 +275,96 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, PipelinedBulkStrings) {
+  buffer_.add("$3\r\nfoo\r\n$0\r\n\r\n$-1\r\n$6\r\nfoo\r\nb\r\n+OK\r\n$3\r\nbar\r\n");
+  decoder_.decode(buffer_);
+  ASSERT_EQ(6UL, decoded_values_.size());
+  EXPECT_EQ(RespType::BulkString, decoded_values_[0]->type());
+  EXPECT_EQ("foo", decoded_values_[0]->asString());
+  EXPECT_EQ(RespType::BulkString, decoded_values_[1]->type());
+  EXPECT_EQ("", decoded_values_[1]->asString());
+  EXPECT_EQ(RespType::Null, decoded_values_[2]->type());
+  EXPECT_EQ("foo\r\nb", decoded_values_[3]->asString());
+  EXPECT_EQ(RespType::SimpleString, decoded_values_[4]->type());
+  EXPECT_EQ("bar", decoded_values_[5]->asString());
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, BulkStringSplitAcrossSlices) {
+  buffer_.appendSliceForTest("$5\r\nhello\r\n$11\r\nhello");
+  buffer_.appendSliceForTest(" world\r");
+  buffer_.appendSliceForTest("\n$5\r\nworld\r\n");
+  decoder_.decode(buffer_);
+  ASSERT_EQ(3UL, decoded_values_.size());
+  EXPECT_EQ("hello", decoded_values_[0]->asString());
+  EXPECT_EQ("hello world", decoded_values_[1]->asString());
+  EXPECT_EQ("world", decoded_values_[2]->asString());
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, ZeroCopyBulkStrings) {
+  DecoderImpl decoder(*this, 8);
+  buffer_.appendSliceForTest("*3\r\n$3\r\nset\r\n$3\r\nkey\r\n$16\r\n0123");
+  buffer_.appendSliceForTest("456789");
+  buffer_.appendSliceForTest("abcdef\r\n$9\r\nlarge get\r\n");
+  decoder.decode(buffer_);
+  EXPECT_EQ(0UL, buffer_.length());
+  ASSERT_EQ(2UL, decoded_values_.size());
+
+  // Only bulk strings at or above the threshold are held in a buffer.
+  const RespValue& request = *decoded_values_[0];
+  ASSERT_EQ(RespType::Array, request.type());
+  EXPECT_FALSE(request.asArray()[0].hasBuffer());
+  EXPECT_FALSE(request.asArray()[1].hasBuffer());
+  ASSERT_TRUE(request.asArray()[2].hasBuffer());
+  EXPECT_EQ("0123456789abcdef", request.asArray()[2].sharedBuffer()->toString());
+  EXPECT_EQ("[\"set\", \"key\", \"0123456789abcdef\"]", request.toString());
+  EXPECT_TRUE(request.asArray()[2].hasBuffer());
+  ASSERT_TRUE(decoded_values_[1]->hasBuffer());
+
+  // Encoding references the slices of the value instead of copying them.
+  encoder_.encode(request, buffer_);
+  EXPECT_EQ("*3\r\n$3\r\nset\r\n$3\r\nkey\r\n$16\r\n0123456789abcdef\r\n", buffer_.toString());
+  const void* value_data = request.asArray()[2].sharedBuffer()->frontSlice().mem_;
+  bool referenced = false;
+  for (const Buffer::RawSlice& slice : buffer_.getRawSlices()) {
+    referenced |= slice.mem_ == value_data;
+  }
+  EXPECT_TRUE(referenced);
+
+  // The encoded data remains valid after the value is destroyed.
+  decoded_values_.clear();
+  EXPECT_EQ("*3\r\n$3\r\nset\r\n$3\r\nkey\r\n$16\r\n0123456789abcdef\r\n", buffer_.toString());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, ZeroCopyBulkStringAsString) {
+  DecoderImpl decoder(*this, 4);
+  buffer_.add("$5\r\nhello\r\n");
+  decoder.decode(buffer_);
+  ASSERT_EQ(1UL, decoded_values_.size());
+  RespValue& value = *decoded_values_[0];
+  ASSERT_TRUE(value.hasBuffer());
+
+  // Copies share the buffer.
+  RespValue copy = value;
+  ASSERT_TRUE(copy.hasBuffer());
+  EXPECT_EQ(value.sharedBuffer(), copy.sharedBuffer());
+  EXPECT_EQ(value, copy);
+
+  // Accessing the value as a string converts it.
+  RespValue moved = std::move(copy);
+  EXPECT_EQ("hello", moved.asString());
+  EXPECT_FALSE(moved.hasBuffer());
+  encoder_.encode(moved, buffer_);
+  EXPECT_EQ("$5\r\nhello\r\n", buffer_.toString());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, ZeroCopyInvalidBulkStringExpectCR) {
+  DecoderImpl decoder(*this, 1);
+  buffer_.add("$1\r\nab");
+  EXPECT_THROW(decoder.decode(buffer_), ProtocolError);
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
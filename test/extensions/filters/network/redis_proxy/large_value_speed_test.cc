@@ -0,0 +1,106 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+// Proxies large values through the codec: the value is decoded from a read buffer and encoded
+// again into a write buffer, as done for SET requests and GET responses.
+class LargeValueSpeedTest : public Common::Redis::DecoderCallbacks {
+public:
+  LargeValueSpeedTest(uint64_t zero_copy_min_bulk_string_size)
+      : decoder_(*this, zero_copy_min_bulk_string_size) {}
+
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&& value) override {
+    encoder_.encode(*value, write_buffer_);
+  }
+
+  static std::string makeSet(uint64_t value_size) {
+    Common::Redis::RespValue request;
+    std::vector<Common::Redis::RespValue> values(3);
+    values[0].type(Common::Redis::RespType::BulkString);
+    values[0].asString() = "set";
+    values[1].type(Common::Redis::RespType::BulkString);
+    values[1].asString() = std::string(36, 'k');
+    values[2].type(Common::Redis::RespType::BulkString);
+    values[2].asString() = std::string(value_size, 'v');
+    request.type(Common::Redis::RespType::Array);
+    request.asArray().swap(values);
+    return encode(request);
+  }
+
+  static std::string makeGetResponse(uint64_t value_size) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = std::string(value_size, 'v');
+    return encode(response);
+  }
+
+  void proxy(const std::string& data) {
+    // Mimic a socket read into 16KiB slices.
+    Buffer::OwnedImpl read_buffer;
+    for (uint64_t offset = 0; offset < data.size(); offset += ReadSize) {
+      read_buffer.appendSliceForTest(data.data() + offset,
+                                     std::min<uint64_t>(ReadSize, data.size() - offset));
+    }
+    decoder_.decode(read_buffer);
+    benchmark::DoNotOptimize(write_buffer_.length());
+    write_buffer_.drain(write_buffer_.length());
+  }
+
+private:
+  static constexpr uint64_t ReadSize = 16384;
+
+  static std::string encode(const Common::Redis::RespValue& value) {
+    Common::Redis::EncoderImpl encoder;
+    Buffer::OwnedImpl buffer;
+    encoder.encode(value, buffer);
+    return buffer.toString();
+  }
+
+  Common::Redis::EncoderImpl encoder_;
+  Common::Redis::DecoderImpl decoder_;
+  Buffer::OwnedImpl write_buffer_;
+};
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
+
+// The second argument is zero_copy_min_bulk_string_size, where 0 disables zero copy decoding.
+static void bmProxySetRequest(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::LargeValueSpeedTest context(state.range(1));
+  const std::string request =
+      Envoy::Extensions::NetworkFilters::RedisProxy::LargeValueSpeedTest::makeSet(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    context.proxy(request);
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(bmProxySetRequest)->ArgsProduct({{1024, 16384, 102400, 1048576}, {0, 16384}});
+
+static void bmProxyGetResponse(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::LargeValueSpeedTest context(state.range(1));
+  const std::string response =
+      Envoy::Extensions::NetworkFilters::RedisProxy::LargeValueSpeedTest::makeGetResponse(
+          state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    context.proxy(response);
+  }
+  state.SetBytesProcessed(state.iterations() * response.size());
+}
+BENCHMARK(bmProxyGetResponse)->ArgsProduct({{1024, 16384, 102400, 1048576}, {0, 16384}});
@@ -0,0 +1,130 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+class PipelineDepthSpeedTest : public Common::Redis::DecoderCallbacks {
+public:
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&& value) override {
+    benchmark::DoNotOptimize(value.get());
+    decoded_++;
+  }
+
+  // Encodes `depth` replies into a single buffer, as read from an upstream connection that
+  // answered a pipeline of `depth` commands.
+  std::string makeReplies(uint64_t depth, uint64_t value_size, bool wrap_in_array) {
+    Common::Redis::RespValue value;
+    value.type(Common::Redis::RespType::BulkString);
+    value.asString() = std::string(value_size, 'v');
+    if (wrap_in_array) {
+      Common::Redis::RespValue array;
+      array.type(Common::Redis::RespType::Array);
+      array.asArray().push_back(value);
+      value = array;
+    }
+
+    Buffer::OwnedImpl buffer;
+    for (uint64_t i = 0; i < depth; i++) {
+      encoder_.encode(value, buffer);
+    }
+    return buffer.toString();
+  }
+
+  // Encodes `depth` GET commands for a single upstream connection, either writing each one to the
+  // connection buffer as it is made or writing all of them once.
+  void encodeRequests(uint64_t depth, bool batch) {
+    Buffer::OwnedImpl pending;
+    for (uint64_t i = 0; i < depth; i++) {
+      encoder_.encode(request_, pending);
+      if (!batch) {
+        connection_buffer_.move(pending);
+      }
+    }
+    connection_buffer_.move(pending);
+    connection_buffer_.drain(connection_buffer_.length());
+  }
+
+  Common::Redis::EncoderImpl encoder_;
+  Common::Redis::DecoderImpl decoder_{*this};
+  Common::Redis::RespValue request_{makeGet()};
+  Buffer::OwnedImpl connection_buffer_;
+  uint64_t decoded_{};
+
+private:
+  static Common::Redis::RespValue makeGet() {
+    std::vector<Common::Redis::RespValue> values(2);
+    values[0].type(Common::Redis::RespType::BulkString);
+    values[0].asString() = "get";
+    values[1].type(Common::Redis::RespType::BulkString);
+    values[1].asString() = std::string(36, 'k');
+    Common::Redis::RespValue request;
+    request.type(Common::Redis::RespType::Array);
+    request.asArray().swap(values);
+    return request;
+  }
+};
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
+
+// Decode a pipeline of bulk string replies, as returned by GET.
+static void bmDecodeBulkStringReplies(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::PipelineDepthSpeedTest context;
+  const std::string replies = context.makeReplies(state.range(0), state.range(1), false);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Buffer::OwnedImpl buffer(replies);
+    context.decoder_.decode(buffer);
+  }
+  state.counters["replies"] = benchmark::Counter(context.decoded_, benchmark::Counter::kIsRate);
+}
+BENCHMARK(bmDecodeBulkStringReplies)->Ranges({{1, 256}, {16, 4096}});
+
+// Decode a pipeline of single element array replies, which are not eligible for the bulk string
+// fast path. Used as a reference for bmDecodeBulkStringReplies.
+static void bmDecodeArrayReplies(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::PipelineDepthSpeedTest context;
+  const std::string replies = context.makeReplies(state.range(0), state.range(1), true);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Buffer::OwnedImpl buffer(replies);
+    context.decoder_.decode(buffer);
+  }
+  state.counters["replies"] = benchmark::Counter(context.decoded_, benchmark::Counter::kIsRate);
+}
+BENCHMARK(bmDecodeArrayReplies)->Ranges({{1, 256}, {16, 4096}});
+
+// Write each request of a pipeline to the upstream connection individually.
+static void bmEncodePipelineUnbatched(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::PipelineDepthSpeedTest context;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    context.encodeRequests(state.range(0), false);
+  }
+}
+BENCHMARK(bmEncodePipelineUnbatched)->Range(1, 256);
+
+// Write all requests of a pipeline to the upstream connection at once, as done when
+// flush_per_event_loop_iteration is enabled.
+static void bmEncodePipelineBatched(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::PipelineDepthSpeedTest context;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    context.encodeRequests(state.range(0), true);
+  }
+}
+BENCHMARK(bmEncodePipelineBatched)->Range(1, 256);
@@ -2,6 +2,7 @@
 #include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.validate.h"
+#include "envoy/extensions/udp_packet_writer/v3/udp_default_writer_factory.pb.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/hash.h"
@@ -28,6 +29,7 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/thread_local_cluster.h"
+#include "test/test_common/registry.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -103,6 +105,35 @@ Api::IoCallUint64Result makeError(int sys_errno) {
   return {0, Network::IoSocketError::create(sys_errno)};
 }
 
+// Packet writer factory which hands out batching mock writers. It takes the place of the default
+// writer factory so that it can be selected by the default writer's config type.
+class BatchingUdpPacketWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
+public:
+  std::string name() const override { return "envoy.udp_packet_writer.default"; }
+  Network::UdpPacketWriterFactoryPtr
+  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+    auto factory = std::make_unique<NiceMock<Network::MockUdpPacketWriterFactory>>();
+    ON_CALL(*factory, createUdpPacketWriter(_, _))
+        .WillByDefault(Invoke([this](Network::IoHandle&, Stats::Scope&) {
+          auto writer = std::make_unique<NiceMock<Network::MockUdpPacketWriter>>();
+          ON_CALL(*writer, isBatchMode()).WillByDefault(Return(true));
+          ON_CALL(*writer, writePacket(_, _, _))
+              .WillByDefault(Invoke([](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                                       const Network::Address::Instance&) {
+                return makeNoError(buffer.length());
+              }));
+          writer_ = writer.get();
+          return writer;
+        }));
+    return factory;
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::udp_packet_writer::v3::UdpDefaultWriterFactory>();
+  }
+
+  NiceMock<Network::MockUdpPacketWriter>* writer_{};
+};
+
 class UdpProxyFilterBase : public testing::Test {
 public:
   UdpProxyFilterBase() {
@@ -1104,6 +1135,112 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 }
 
+// Datagrams written to a batching upstream writer within one event loop iteration are flushed
+// together at the end of the iteration.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWrites) {
+  BatchingUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registered_writer_factory(
+      writer_factory);
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+upstream_udp_packet_writer_config:
+  name: envoy.udp_packet_writer.default
+  typed_config:
+    '@type': type.googleapis.com/envoy.extensions.udp_packet_writer.v3.UdpDefaultWriterFactory
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, nullptr)).Times(AtLeast(1));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, sendmsg(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration());
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  ASSERT_NE(nullptr, writer_factory.writer_);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
+  auto& cluster_stats = factory_context_.server_factory_context_.cluster_manager_
+                            .thread_local_cluster_.cluster_.info_->stats_store_;
+  // Buffered datagrams are not counted until they are sent.
+  EXPECT_EQ(0, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+
+  EXPECT_CALL(*writer_factory.writer_, flush()).WillOnce(Return(ByMove(makeNoError(10))));
+  flush_cb->invokeCallback();
+  EXPECT_EQ(2, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+
+  // A blocked writer retains the datagram and retries when the socket becomes writable.
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "again");
+  EXPECT_CALL(*writer_factory.writer_, flush())
+      .WillOnce(Return(ByMove(
+          Api::IoCallUint64Result(0, Network::IoSocketError::getIoSocketEagainError()))))
+      .WillOnce(Return(ByMove(makeNoError(5))));
+  EXPECT_CALL(*writer_factory.writer_, isWriteBlocked()).WillOnce(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_,
+              enableFileEvents(Event::FileReadyType::Read | Event::FileReadyType::Write));
+  flush_cb->invokeCallback();
+  EXPECT_EQ(2, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+
+  EXPECT_CALL(*writer_factory.writer_, setWritable());
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_,
+              enableFileEvents(Event::FileReadyType::Read));
+  EXPECT_TRUE(test_sessions_[0].file_event_cb_(Event::FileReadyType::Write).ok());
+  EXPECT_EQ(3, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(0, TestUtility::findCounter(cluster_stats, "udp.sess_tx_errors")->value());
+
+  // Datagrams dropped by a failed flush are counted as a send error, not as sent.
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "lost");
+  EXPECT_CALL(*writer_factory.writer_, flush())
+      .WillOnce(Return(ByMove(makeError(ECONNREFUSED))));
+  EXPECT_CALL(*writer_factory.writer_, isWriteBlocked()).WillOnce(Return(false));
+  flush_cb->invokeCallback();
+  EXPECT_EQ(3, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(1, TestUtility::findCounter(cluster_stats, "udp.sess_tx_errors")->value());
+}
+
+// The upstream packet writer config selects the writer factory from the registry.
+TEST_F(UdpProxyFilterTest, UpstreamPacketWriterFactoryWiring) {
+  const std::string base_config = R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF";
+  EXPECT_EQ(nullptr, UdpProxyFilterConfigImpl(factory_context_, readConfig(base_config))
+                         .upstreamPacketWriterFactory());
+
+  BatchingUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registered_writer_factory(
+      writer_factory);
+  UdpProxyFilterConfigImpl config(factory_context_, readConfig(base_config + R"EOF(
+upstream_udp_packet_writer_config:
+  name: envoy.udp_packet_writer.default
+  typed_config:
+    '@type': type.googleapis.com/envoy.extensions.udp_packet_writer.v3.UdpDefaultWriterFactory
+  )EOF"));
+  ASSERT_NE(nullptr, config.upstreamPacketWriterFactory());
+  NiceMock<Network::MockIoHandle> io_handle;
+  EXPECT_NE(nullptr, config.upstreamPacketWriterFactory()->createUdpPacketWriter(
+                         io_handle, factory_context_.scope()));
+  EXPECT_NE(nullptr, writer_factory.writer_);
+}
+
 // Make sure socket option is set correctly if use_original_src_ip is set.
 TEST_F(UdpProxyFilterTest, SocketOptionForUseOriginalSrcIp) {
   if (!isTransparentSocketOptionsSupported()) {
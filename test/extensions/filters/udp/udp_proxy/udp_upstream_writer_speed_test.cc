@@ -0,0 +1,78 @@
+// Measures the packet rate at which the UDP proxy can write datagrams to an upstream socket, with
+// and without a batching upstream packet writer.
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/udp_packet_writer_handler_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#ifdef ENVOY_ENABLE_QUIC
+#include "source/common/quic/udp_gso_batch_writer.h"
+#endif
+
+#include "test/test_common/network_utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace UdpProxy {
+namespace {
+
+// Number of datagrams received from downstream in a single event loop iteration. The proxy
+// flushes batched upstream datagrams once per iteration.
+constexpr uint32_t DatagramsPerIteration = 16;
+
+void writeDatagrams(benchmark::State& state, Network::UdpPacketWriter& writer,
+                    const Network::Address::Instance& upstream_address) {
+  const std::string payload(state.range(0), 'a');
+  uint64_t datagrams = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (uint32_t i = 0; i < DatagramsPerIteration; ++i) {
+      Buffer::OwnedImpl buffer(payload);
+      benchmark::DoNotOptimize(writer.writePacket(buffer, nullptr, upstream_address));
+    }
+    benchmark::DoNotOptimize(writer.flush());
+    writer.setWritable();
+    datagrams += DatagramsPerIteration;
+  }
+  state.counters["pps"] = benchmark::Counter(datagrams, benchmark::Counter::kIsRate);
+}
+
+// Upstream receiver and proxy side upstream socket, both bound to loopback.
+struct UpstreamSockets {
+  UpstreamSockets()
+      : upstream_(Network::Test::bindFreeLoopbackPort(Network::Address::IpVersion::v4,
+                                                      Network::Socket::Type::Datagram)),
+        proxy_(Network::Test::bindFreeLoopbackPort(Network::Address::IpVersion::v4,
+                                                   Network::Socket::Type::Datagram)) {}
+
+  std::pair<Network::Address::InstanceConstSharedPtr, Network::SocketPtr> upstream_;
+  std::pair<Network::Address::InstanceConstSharedPtr, Network::SocketPtr> proxy_;
+};
+
+// Baseline: one sendmsg per datagram.
+void bmUpstreamWriteDefault(benchmark::State& state) {
+  UpstreamSockets sockets;
+  Network::UdpDefaultWriter writer(sockets.proxy_.second->ioHandle());
+  writeDatagrams(state, writer, *sockets.upstream_.first);
+}
+BENCHMARK(bmUpstreamWriteDefault)->Arg(64)->Arg(512)->Arg(1200);
+
+#if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
+// Datagrams of a single iteration are coalesced into one GSO sendmsg.
+void bmUpstreamWriteGsoBatch(benchmark::State& state) {
+  UpstreamSockets sockets;
+  Stats::IsolatedStoreImpl store;
+  Quic::UdpGsoBatchWriter writer(sockets.proxy_.second->ioHandle(), *store.rootScope());
+  writeDatagrams(state, writer, *sockets.upstream_.first);
+}
+BENCHMARK(bmUpstreamWriteGsoBatch)->Arg(64)->Arg(512)->Arg(1200);
+#endif
+
+} // namespace
+} // namespace UdpProxy
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -2,6 +2,8 @@
 
 #include "source/extensions/resource_monitors/fixed_heap/fixed_heap_monitor.h"
 
+#include "test/test_common/simulated_time_system.h"
+
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -45,11 +47,12 @@ TEST(FixedHeapMonitorTest, ComputesCorrectUsage) {
 
   envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig config;
   config.set_max_heap_size_bytes(1000);
+  Event::SimulatedTimeSystem time_system;
   auto stats_reader = std::make_unique<MockMemoryStatsReader>();
   EXPECT_CALL(*stats_reader, reservedHeapBytes()).WillOnce(Return(800));
   EXPECT_CALL(*stats_reader, unmappedHeapBytes()).WillOnce(Return(100));
   EXPECT_CALL(*stats_reader, freeMappedHeapBytes()).WillOnce(Return(200));
-  auto monitor = std::make_unique<FixedHeapMonitor>(config, std::move(stats_reader));
+  auto monitor = std::make_unique<FixedHeapMonitor>(config, time_system, std::move(stats_reader));
 
   ResourcePressure resource;
   monitor->updateResourceUsage(resource);
@@ -63,17 +66,98 @@ TEST(FixedHeapMonitorTest, ComputeUsageWithRealMemoryStats) {
   envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig config;
   const uint64_t max_heap = 1024 * 1024 * 1024;
   config.set_max_heap_size_bytes(max_heap);
+  Event::SimulatedTimeSystem time_system;
   auto stats_reader = std::make_unique<MemoryStatsReader>();
   const double expected_usage =
       (stats_reader->reservedHeapBytes() - stats_reader->unmappedHeapBytes() -
        stats_reader->freeMappedHeapBytes()) /
       static_cast<double>(max_heap);
-  auto monitor = std::make_unique<FixedHeapMonitor>(config, std::move(stats_reader));
+  auto monitor = std::make_unique<FixedHeapMonitor>(config, time_system, std::move(stats_reader));
 
   ResourcePressure resource;
   monitor->updateResourceUsage(resource);
   EXPECT_NEAR(resource.pressure(), expected_usage, 0.0005);
 }
+
+class FixedHeapMonitorProjectionTest : public testing::Test {
+protected:
+  FixedHeapMonitorProjectionTest() {
+    config_.set_max_heap_size_bytes(1000);
+    config_.mutable_projection_window()->set_seconds(10);
+    auto stats_reader = std::make_unique<MockMemoryStatsReader>();
+    stats_reader_ = stats_reader.get();
+    ON_CALL(*stats_reader_, unmappedHeapBytes()).WillByDefault(Return(0));
+    ON_CALL(*stats_reader_, freeMappedHeapBytes()).WillByDefault(Return(0));
+    monitor_ = std::make_unique<FixedHeapMonitor>(config_, time_system_, std::move(stats_reader));
+  }
+
+  double sample(uint64_t used) {
+    EXPECT_CALL(*stats_reader_, reservedHeapBytes()).WillOnce(Return(used));
+    ResourcePressure resource;
+    monitor_->updateResourceUsage(resource);
+    EXPECT_TRUE(resource.hasPressure());
+    return resource.pressure();
+  }
+
+  envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig config_;
+  Event::SimulatedTimeSystem time_system_;
+  MockMemoryStatsReader* stats_reader_;
+  std::unique_ptr<FixedHeapMonitor> monitor_;
+};
+
+// The first sample has no growth rate to project.
+TEST_F(FixedHeapMonitorProjectionTest, FirstSampleReportsCurrentUsage) {
+  EXPECT_EQ(sample(300), 0.3);
+}
+
+// Growing by 100 bytes per second projects 400 + 10 * 100 = 1400 bytes, which is reported as full
+// pressure.
+TEST_F(FixedHeapMonitorProjectionTest, FastGrowthReportsFullPressure) {
+  EXPECT_EQ(sample(300), 0.3);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(400), 1.0);
+}
+
+// Growing by 10 bytes per second projects 410 + 10 * 10 = 510 bytes, which is below the maximum,
+// so the current usage is reported.
+TEST_F(FixedHeapMonitorProjectionTest, SlowGrowthReportsCurrentUsage) {
+  EXPECT_EQ(sample(400), 0.4);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(sample(410), 0.41);
+}
+
+// Growing by 60 bytes per second projects 460 + 10 * 60 = 1060 bytes, which reaches the maximum.
+TEST_F(FixedHeapMonitorProjectionTest, GrowthReachingMaximumReportsFullPressure) {
+  EXPECT_EQ(sample(400), 0.4);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(460), 1.0);
+}
+
+// A shrinking or stable heap reports the current usage.
+TEST_F(FixedHeapMonitorProjectionTest, NoGrowthReportsCurrentUsage) {
+  EXPECT_EQ(sample(800), 0.8);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(600), 0.6);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(600), 0.6);
+}
+
+// Two samples at the same time have no growth rate.
+TEST_F(FixedHeapMonitorProjectionTest, NoElapsedTimeReportsCurrentUsage) {
+  EXPECT_EQ(sample(300), 0.3);
+  EXPECT_EQ(sample(400), 0.4);
+}
+
+// The rate is computed against the previous sample only.
+TEST_F(FixedHeapMonitorProjectionTest, RateFollowsPreviousSample) {
+  EXPECT_EQ(sample(100), 0.1);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(200), 1.0);
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(sample(200), 0.2);
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_DOUBLE_EQ(sample(220), 0.22);
+}
 } // namespace
 } // namespace FixedHeapMonitor
 } // namespace ResourceMonitors
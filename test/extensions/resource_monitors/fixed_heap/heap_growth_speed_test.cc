@@ -0,0 +1,108 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "envoy/extensions/resource_monitors/fixed_heap/v3/fixed_heap.pb.h"
+
+#include "source/extensions/resource_monitors/fixed_heap/fixed_heap_monitor.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/types/optional.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace FixedHeapMonitor {
+
+// Grows the heap at a controlled rate per overload manager refresh interval, and samples a
+// monitor with and without a projection window after each interval, until the monitor without
+// projection reports full pressure.
+class HeapGrowthSpeedTest : public Server::ResourceUpdateCallbacks {
+public:
+  static constexpr std::chrono::seconds RefreshInterval{1};
+  static constexpr uint64_t ProjectionIntervals = 4;
+
+  HeapGrowthSpeedTest(uint64_t bytes_per_interval, uint64_t headroom_bytes)
+      : bytes_per_interval_(bytes_per_interval), headroom_bytes_(headroom_bytes) {}
+
+  // Server::ResourceUpdateCallbacks
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+  }
+  void onFailure(const EnvoyException&) override { pressure_ = 0; }
+
+  // Runs one ramp, returning how many intervals before the monitor without projection the
+  // projecting monitor reported full pressure.
+  uint64_t rampUp() {
+    MemoryStatsReader stats;
+    envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig config;
+    config.set_max_heap_size_bytes(stats.reservedHeapBytes() - stats.unmappedHeapBytes() -
+                                   stats.freeMappedHeapBytes() + headroom_bytes_);
+    FixedHeapMonitor reactive(config, time_system_);
+    config.mutable_projection_window()->set_seconds(RefreshInterval.count() *
+                                                    ProjectionIntervals);
+    FixedHeapMonitor predictive(config, time_system_);
+
+    std::vector<std::unique_ptr<char[]>> allocations;
+    absl::optional<uint64_t> predictive_interval;
+    // Bounds the ramp if the allocator does not report heap stats.
+    const uint64_t max_intervals = 2 * headroom_bytes_ / bytes_per_interval_ + 1;
+    for (uint64_t interval = 0; interval < max_intervals; ++interval) {
+      allocations.emplace_back(new char[bytes_per_interval_]);
+      // Touch the allocation so that it is backed by memory.
+      memset(allocations.back().get(), 1, bytes_per_interval_);
+      time_system_.advanceTimeWait(RefreshInterval);
+
+      predictive.updateResourceUsage(*this);
+      if (!predictive_interval.has_value() && pressure_ >= 1) {
+        predictive_interval = interval;
+      }
+      reactive.updateResourceUsage(*this);
+      if (pressure_ >= 1) {
+        return interval - predictive_interval.value_or(interval);
+      }
+    }
+    return 0;
+  }
+
+private:
+  const uint64_t bytes_per_interval_;
+  const uint64_t headroom_bytes_;
+  Event::SimulatedTimeSystem time_system_;
+  double pressure_{};
+};
+
+} // namespace FixedHeapMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
+
+// The first argument is the number of bytes allocated per refresh interval, the second is the
+// headroom between the heap usage at the start of the ramp and the maximum heap size.
+static void bmHeapGrowth(benchmark::State& state) {
+  const uint64_t bytes_per_interval = state.range(0);
+  const uint64_t headroom_bytes = state.range(1);
+  if (Envoy::benchmark::skipExpensiveBenchmarks() && headroom_bytes > 64 * 1024 * 1024) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  Envoy::Extensions::ResourceMonitors::FixedHeapMonitor::HeapGrowthSpeedTest context(
+      bytes_per_interval, headroom_bytes);
+  uint64_t early_intervals = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    early_intervals += context.rampUp();
+  }
+  state.counters["early_intervals"] =
+      benchmark::Counter(early_intervals, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(bmHeapGrowth)
+    ->ArgsProduct({{1 << 20, 4 << 20, 16 << 20}, {64 << 20, 256 << 20}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,232 @@
+#include <cmath>
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_sink.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/stats/mocks.h"
+#include "test/test_common/environment.h"
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+namespace {
+
+// Fails growing the file on demand.
+class FailingTruncateOsSysCalls : public Api::OsSysCallsImpl {
+public:
+  Api::SysCallIntResult ftruncate(int fd, off_t length) override {
+    if (fail_truncate_ && length > 0) {
+      return {-1, ENOSPC};
+    }
+    return Api::OsSysCallsImpl::ftruncate(fd, length);
+  }
+
+  bool fail_truncate_{};
+};
+
+class SharedMemoryStatsSinkTest : public testing::Test {
+protected:
+  SharedMemoryStatsSinkTest()
+      : path_(TestEnvironment::temporaryPath("shared_memory_sink_test")), store_(*symbol_table_) {}
+
+  void createSink(uint64_t max_size_bytes = 1 << 20) {
+    sink_ = SharedMemoryStatsSink::create(path_, max_size_bytes, *symbol_table_, os_sys_calls_)
+                .value();
+  }
+
+  Stats::Counter& addCounter(const std::string& name) {
+    Stats::Counter& counter = store_.rootScope()->counterFromString(name);
+    snapshot_.counters_.push_back({0, counter});
+    return counter;
+  }
+
+  Stats::Gauge& addGauge(const std::string& name) {
+    Stats::Gauge& gauge =
+        store_.rootScope()->gaugeFromString(name, Stats::Gauge::ImportMode::Accumulate);
+    snapshot_.gauges_.push_back(gauge);
+    return gauge;
+  }
+
+  SharedMemoryStatsSnapshot read() {
+    const std::string contents = TestEnvironment::readFileToStringForTest(path_);
+    return readSharedMemoryStats(reinterpret_cast<const uint8_t*>(contents.data()),
+                                 contents.size())
+        .value();
+  }
+
+  Stats::TestUtil::TestSymbolTable symbol_table_;
+  FailingTruncateOsSysCalls os_sys_calls_;
+  const std::string path_;
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot_;
+  std::unique_ptr<SharedMemoryStatsSink> sink_;
+};
+
+TEST_F(SharedMemoryStatsSinkTest, Empty) {
+  createSink();
+  const SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_EQ(0, snapshot.generation_);
+  EXPECT_TRUE(snapshot.stats_.empty());
+}
+
+TEST_F(SharedMemoryStatsSinkTest, PublishesCountersGaugesAndHistograms) {
+  createSink();
+  addCounter("cluster.foo.upstream_rq").add(5);
+  addGauge("cluster.foo.upstream_cx_active").set(7);
+  NiceMock<Stats::MockParentHistogram> histogram;
+  histogram.name_ = "cluster.foo.upstream_rq_time";
+  snapshot_.histograms_.push_back(histogram);
+  sink_->flush(snapshot_);
+
+  const SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_EQ(1, snapshot.generation_);
+  EXPECT_EQ(0, snapshot.dropped_entries_);
+  const std::vector<double>& quantiles = histogram.cumulativeStatistics().supportedQuantiles();
+  ASSERT_EQ(4 + quantiles.size(), snapshot.stats_.size());
+
+  EXPECT_EQ("cluster.foo.upstream_rq", snapshot.stats_[0].name_);
+  EXPECT_EQ(EntryType::Counter, snapshot.stats_[0].type_);
+  EXPECT_EQ(5, snapshot.stats_[0].value_);
+  EXPECT_EQ("cluster.foo.upstream_cx_active", snapshot.stats_[1].name_);
+  EXPECT_EQ(EntryType::Gauge, snapshot.stats_[1].type_);
+  EXPECT_EQ(7, snapshot.stats_[1].value_);
+  for (size_t i = 0; i < quantiles.size(); ++i) {
+    const SharedMemoryStat& stat = snapshot.stats_[2 + i];
+    EXPECT_EQ("cluster.foo.upstream_rq_time", stat.name_);
+    EXPECT_EQ(EntryType::HistogramQuantile, stat.type_);
+    EXPECT_DOUBLE_EQ(quantiles[i], stat.quantile_);
+    EXPECT_TRUE(std::isnan(stat.double_value_));
+  }
+  EXPECT_EQ(EntryType::HistogramSampleCount, snapshot.stats_[2 + quantiles.size()].type_);
+  EXPECT_EQ(0, snapshot.stats_[2 + quantiles.size()].value_);
+  EXPECT_EQ(EntryType::HistogramSampleSum, snapshot.stats_[3 + quantiles.size()].type_);
+  EXPECT_EQ(0, snapshot.stats_[3 + quantiles.size()].double_value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, NamesAreOnlyRewrittenWhenMetricsChange) {
+  createSink();
+  Stats::Counter& counter = addCounter("foo");
+  sink_->flush(snapshot_);
+  EXPECT_EQ(1, read().generation_);
+
+  // Only the values change.
+  counter.add(3);
+  snapshot_.snapshot_time_ = SystemTime(std::chrono::milliseconds(1000));
+  ON_CALL(snapshot_, snapshotTime()).WillByDefault(testing::Return(snapshot_.snapshot_time_));
+  sink_->flush(snapshot_);
+  SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_EQ(1, snapshot.generation_);
+  EXPECT_EQ(1000, snapshot.snapshot_time_ms_);
+  ASSERT_EQ(1, snapshot.stats_.size());
+  EXPECT_EQ(3, snapshot.stats_[0].value_);
+
+  // A metric is added.
+  addGauge("bar").set(2);
+  sink_->flush(snapshot_);
+  snapshot = read();
+  EXPECT_EQ(2, snapshot.generation_);
+  ASSERT_EQ(2, snapshot.stats_.size());
+  EXPECT_EQ("bar", snapshot.stats_[1].name_);
+  EXPECT_EQ(2, snapshot.stats_[1].value_);
+
+  // A metric is replaced by another one.
+  snapshot_.counters_.clear();
+  addCounter("baz").add(4);
+  sink_->flush(snapshot_);
+  snapshot = read();
+  EXPECT_EQ(3, snapshot.generation_);
+  ASSERT_EQ(2, snapshot.stats_.size());
+  EXPECT_EQ("baz", snapshot.stats_[0].name_);
+  EXPECT_EQ(4, snapshot.stats_[0].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, DropsEntriesBeyondMaxSize) {
+  createSink(4096);
+  for (int i = 0; i < 200; ++i) {
+    addCounter(absl::StrCat("counter_with_a_long_name_", i)).add(i);
+  }
+  sink_->flush(snapshot_);
+
+  const SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_GT(snapshot.dropped_entries_, 0);
+  EXPECT_EQ(200, snapshot.stats_.size() + snapshot.dropped_entries_);
+  for (size_t i = 0; i < snapshot.stats_.size(); ++i) {
+    EXPECT_EQ(absl::StrCat("counter_with_a_long_name_", i), snapshot.stats_[i].name_);
+    EXPECT_EQ(i, snapshot.stats_[i].value_);
+  }
+}
+
+// When the file cannot be grown for a new layout, no entries are published, and the layout is
+// built again on the next flush.
+TEST_F(SharedMemoryStatsSinkTest, RetriesLayoutWhenFileCannotGrow) {
+  createSink();
+  addCounter("foo").add(1);
+  os_sys_calls_.fail_truncate_ = true;
+  sink_->flush(snapshot_);
+  SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_EQ(1, snapshot.generation_);
+  EXPECT_EQ(1, snapshot.dropped_entries_);
+  EXPECT_TRUE(snapshot.stats_.empty());
+
+  os_sys_calls_.fail_truncate_ = false;
+  sink_->flush(snapshot_);
+  snapshot = read();
+  EXPECT_EQ(2, snapshot.generation_);
+  EXPECT_EQ(0, snapshot.dropped_entries_);
+  ASSERT_EQ(1, snapshot.stats_.size());
+  EXPECT_EQ("foo", snapshot.stats_[0].name_);
+  EXPECT_EQ(1, snapshot.stats_[0].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, ReaderErrors) {
+  createSink();
+  addCounter("foo");
+  sink_->flush(snapshot_);
+  std::string contents = TestEnvironment::readFileToStringForTest(path_);
+  const uint8_t* region = reinterpret_cast<const uint8_t*>(contents.data());
+
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument,
+            readSharedMemoryStats(region, sizeof(Header) - 1).status().code());
+  EXPECT_EQ(absl::StatusCode::kOutOfRange,
+            readSharedMemoryStats(region, sizeof(Header)).status().code());
+
+  // The sink is updating the file.
+  Header& header = *reinterpret_cast<Header*>(contents.data());
+  header.sequence_++;
+  EXPECT_EQ(absl::StatusCode::kUnavailable,
+            readSharedMemoryStats(region, contents.size()).status().code());
+  header.sequence_++;
+  EXPECT_TRUE(readSharedMemoryStats(region, contents.size()).ok());
+
+  header.version_++;
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument,
+            readSharedMemoryStats(region, contents.size()).status().code());
+}
+
+TEST_F(SharedMemoryStatsSinkTest, ReplacesExistingFile) {
+  createSink();
+  addCounter("foo");
+  sink_->flush(snapshot_);
+  sink_.reset();
+
+  createSink();
+  const SharedMemoryStatsSnapshot snapshot = read();
+  EXPECT_EQ(0, snapshot.generation_);
+  EXPECT_TRUE(snapshot.stats_.empty());
+}
+
+} // namespace
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
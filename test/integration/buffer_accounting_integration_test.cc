@@ -778,6 +778,66 @@ TEST_P(Http2OverloadManagerIntegrationTest,
   EXPECT_EQ(smallest_request_response->headers().getStatusValue(), "200");
 }
 
+TEST_P(Http2OverloadManagerIntegrationTest, ResetsLargestStreamsWhenOverloaded) {
+  autonomous_upstream_ = true;
+  autonomous_allow_incomplete_streams_ = true;
+  initializeOverloadManagerInBootstrap(
+      TestUtility::parseYaml<envoy::config::overload::v3::OverloadAction>(R"EOF(
+      name: "envoy.overload_actions.reset_largest_memory_streams"
+      triggers:
+        - name: "envoy.resource_monitors.testonly.fake_resource_monitor"
+          threshold:
+            value: 0.90
+    )EOF"));
+  overload_manager_config_.mutable_buffer_factory_config()
+      ->mutable_largest_streams_to_reset()
+      ->set_value(1);
+  initialize();
+
+  // Makes us have Envoy's writes to upstream return EAGAIN
+  write_matcher_->setDestinationPort(fake_upstreams_[0]->localAddress()->ip()->port());
+  write_matcher_->setWriteReturnsEgain();
+
+  codec_client_ = makeHttpConnection(lookupPort("http"));
+  auto smallest_request_response = std::move(sendRequests(1, 4096, 4096)[0]);
+  auto largest_request_response = std::move(sendRequests(1, 4096 * 4, 4096)[0]);
+  auto medium_request_response = std::move(sendRequests(1, 4096 * 2, 4096)[0]);
+
+  // Wait for requests to come into Envoy.
+  EXPECT_TRUE(buffer_factory_->waitUntilTotalBufferedExceeds(7 * 4096));
+
+  // Set the pressure so the overload action resets the largest stream only.
+  updateResource(0.95);
+  test_server_->waitForGaugeEq(
+      "overload.envoy.overload_actions.reset_largest_memory_streams.scale_percent", 100);
+  if (streamBufferAccounting()) {
+    test_server_->waitForCounterGe("http.config_test.downstream_rq_rx_reset", 1);
+    test_server_->waitForCounterEq("envoy.overload_actions.reset_largest_memory_streams.count",
+                                   1);
+    EXPECT_TRUE(largest_request_response->waitForReset());
+    EXPECT_TRUE(largest_request_response->reset());
+  }
+
+  // Reduce resource pressure
+  updateResource(0.80);
+  test_server_->waitForGaugeEq(
+      "overload.envoy.overload_actions.reset_largest_memory_streams.scale_percent", 0);
+
+  // Resume writes to upstream, the remaining streams can go through.
+  write_matcher_->setResumeWrites();
+
+  if (!streamBufferAccounting()) {
+    ASSERT_TRUE(largest_request_response->waitForEndStream());
+    ASSERT_TRUE(largest_request_response->complete());
+  }
+  ASSERT_TRUE(medium_request_response->waitForEndStream());
+  ASSERT_TRUE(medium_request_response->complete());
+  EXPECT_EQ(medium_request_response->headers().getStatusValue(), "200");
+  ASSERT_TRUE(smallest_request_response->waitForEndStream());
+  ASSERT_TRUE(smallest_request_response->complete());
+  EXPECT_EQ(smallest_request_response->headers().getStatusValue(), "200");
+}
+
 TEST_P(Http2OverloadManagerIntegrationTest,
        ResetsExpensiveStreamsWhenDownstreamBuffersTakeTooMuchSpaceAndOverloaded) {
   initializeOverloadManagerInBootstrap(
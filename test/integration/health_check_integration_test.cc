@@ -1,5 +1,6 @@
 #include <memory>
 
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/type/v3/range.pb.h"
 
@@ -264,6 +265,38 @@ TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointUnhealthyHttp) {
 
 // Tests that a retriable status response does not mark endpoint unhealthy until threshold is
 // reached
+// Tests that the health transitions of an endpoint checked on a dedicated health check thread are
+// applied to the cluster on the main thread.
+TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointHealthCheckThreads) {
+  config_helper_.addConfigModifier([](envoy::config::bootstrap::v3::Bootstrap& bootstrap) {
+    bootstrap.set_health_check_threads(2);
+  });
+  const uint32_t cluster_idx = 0;
+  initialize();
+  initHttpHealthCheck(cluster_idx);
+
+  // Endpoint responds with healthy status to the health check.
+  clusters_[cluster_idx].host_stream_->encodeHeaders(
+      Http::TestResponseHeaderMapImpl{{":status", "200"}}, false);
+  clusters_[cluster_idx].host_stream_->encodeData(0, true);
+
+  test_server_->waitForCounterEq("cluster.cluster_1.health_check.success", 1);
+  test_server_->waitForGaugeEq("cluster.cluster_1.membership_healthy", 1);
+
+  // Endpoint responds to the next health check with unhealthy status.
+  test_server_->waitForCounterEq("cluster.cluster_1.health_check.attempt", 2);
+  ASSERT_TRUE(clusters_[cluster_idx].host_fake_connection_->waitForNewStream(
+      *dispatcher_, clusters_[cluster_idx].host_stream_));
+  ASSERT_TRUE(clusters_[cluster_idx].host_stream_->waitForEndStream(*dispatcher_));
+  clusters_[cluster_idx].host_stream_->encodeHeaders(
+      Http::TestResponseHeaderMapImpl{{":status", "503"}}, false);
+  clusters_[cluster_idx].host_stream_->encodeData(0, true);
+
+  test_server_->waitForCounterEq("cluster.cluster_1.health_check.failure", 1);
+  test_server_->waitForGaugeEq("cluster.cluster_1.membership_healthy", 0);
+  EXPECT_EQ(1, test_server_->gauge("cluster.cluster_1.membership_total")->value());
+}
+
 TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointUnhealthyThresholdHttp) {
   const uint32_t cluster_idx = 0;
   initialize();
@@ -270,7 +270,8 @@ public:
   }
 
   static size_t computeMemoryDelta(int initial_num_clusters, int initial_num_hosts,
-                                   int final_num_clusters, int final_num_hosts, bool allow_stats) {
+                                   int final_num_clusters, int final_num_hosts, bool allow_stats,
+                                   bool defer_stats_creation = false) {
     // Use the same number of fake upstreams for both helpers in order to exclude memory overhead
     // added by the fake upstreams.
     int fake_upstreams_count = 1 + final_num_clusters * final_num_hosts;
@@ -280,13 +281,14 @@ public:
       ClusterMemoryTestHelper helper;
       helper.setUpstreamCount(fake_upstreams_count);
       helper.skipPortUsageValidation();
-      initial_memory =
-          helper.clusterMemoryHelper(initial_num_clusters, initial_num_hosts, allow_stats);
+      initial_memory = helper.clusterMemoryHelper(initial_num_clusters, initial_num_hosts,
+                                                  allow_stats, defer_stats_creation);
     }
 
     ClusterMemoryTestHelper helper;
     helper.setUpstreamCount(fake_upstreams_count);
-    return helper.clusterMemoryHelper(final_num_clusters, final_num_hosts, allow_stats) -
+    return helper.clusterMemoryHelper(final_num_clusters, final_num_hosts, allow_stats,
+                                      defer_stats_creation) -
            initial_memory;
   }
 
@@ -294,14 +296,18 @@ private:
   /**
    * @param num_clusters number of clusters appended to bootstrap_config
    * @param allow_stats if false, enable set_reject_all in stats_config
+   * @param defer_stats_creation if true, enable deferred creation of stats
    * @return size_t the total memory allocated
    */
-  size_t clusterMemoryHelper(int num_clusters, int num_hosts, bool allow_stats) {
+  size_t clusterMemoryHelper(int num_clusters, int num_hosts, bool allow_stats,
+                             bool defer_stats_creation) {
     Memory::TestUtil::MemoryTest memory_test;
     config_helper_.addConfigModifier([&](envoy::config::bootstrap::v3::Bootstrap& bootstrap) {
       if (!allow_stats) {
         bootstrap.mutable_stats_config()->mutable_stats_matcher()->set_reject_all(true);
       }
+      bootstrap.mutable_deferred_stat_options()->set_enable_deferred_creation_stats(
+          defer_stats_creation);
       for (int i = 1; i < num_clusters; ++i) {
         auto* cluster = bootstrap.mutable_static_resources()->add_clusters();
         cluster->set_name(absl::StrCat("cluster_", i));
@@ -424,6 +430,24 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSize) {
   EXPECT_MEMORY_LE(m_per_cluster, 44500); // Round up to allow platform variations.
 }
 
+TEST_P(ClusterMemoryTestRunner, MemoryLargeIdleClusterSizeWithDeferredStats) {
+  // Measures the bytes per cluster that never receives traffic, when the creation of its traffic,
+  // load report and optional stats is deferred until they are first referenced.
+  const size_t m_per_cluster =
+      ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true) / 100;
+  const size_t m_per_idle_cluster =
+      ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true, true) / 100;
+  ENVOY_LOG_MISC(info, "Bytes per cluster: {}, per idle cluster with deferred stats: {}",
+                 m_per_cluster, m_per_idle_cluster);
+
+  // Deferring creation saves at least the 71 cluster traffic stats and the isolated store of the
+  // load report stats of each cluster. This is a conservative lower bound on their size, so that
+  // the test fails if these stats are instantiated for idle clusters again.
+  const size_t min_deferred_bytes_per_cluster = 3000;
+  EXPECT_MEMORY_LE(m_per_idle_cluster + min_deferred_bytes_per_cluster, m_per_cluster);
+  EXPECT_MEMORY_LE(m_per_idle_cluster, 41500); // Round up to allow platform variations.
+}
+
 TEST_P(ClusterMemoryTestRunner, MemoryLargeHostSizeWithStats) {
   // A unique instance of ClusterMemoryTest allows for multiple runs of Envoy with
   // differing configuration. This is necessary for measuring the memory consumption
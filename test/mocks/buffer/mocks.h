@@ -92,6 +92,7 @@ public:
 
   MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, createAccount, (Http::StreamResetHandler&));
   MOCK_METHOD(uint64_t, resetAccountsGivenPressure, (float));
+  MOCK_METHOD(uint64_t, resetLargestAccounts, (float));
 };
 
 MATCHER_P(BufferEqual, rhs, testing::PrintToString(*rhs)) {
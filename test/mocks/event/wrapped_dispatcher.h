@@ -31,6 +31,12 @@ public:
     impl_.initializeStats(scope, prefix);
   }
 
+  void initializeCallbackStats(Stats::Scope& scope) override {
+    impl_.initializeCallbackStats(scope);
+  }
+
+  std::chrono::microseconds loopBusyTime() const override { return impl_.loopBusyTime(); }
+
   void clearDeferredDeleteList() override { impl_.clearDeferredDeleteList(); }
 
   Network::ServerConnectionPtr
@@ -242,6 +242,9 @@ MockUdpListenerFilterManager::~MockUdpListenerFilterManager() = default;
 MockConnectionBalancer::MockConnectionBalancer() = default;
 MockConnectionBalancer::~MockConnectionBalancer() = default;
 
+MockBalancedConnectionHandler::MockBalancedConnectionHandler() = default;
+MockBalancedConnectionHandler::~MockBalancedConnectionHandler() = default;
+
 MockListenerFilterMatcher::MockListenerFilterMatcher() = default;
 MockListenerFilterMatcher::~MockListenerFilterMatcher() = default;
 
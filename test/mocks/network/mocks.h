@@ -731,6 +731,20 @@ public:
               (BalancedConnectionHandler & current_handler));
 };
 
+class MockBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  MockBalancedConnectionHandler();
+  ~MockBalancedConnectionHandler() override;
+
+  MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(void, incNumConnections, ());
+  MOCK_METHOD(void, post, (Network::ConnectionSocketPtr && socket));
+  MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
+  MOCK_METHOD(void, onAcceptWorker,
+              (Network::ConnectionSocketPtr && socket,
+               bool hand_off_restored_destination_connections, bool rebalanced));
+};
+
 class MockListenerFilterMatcher : public ListenerFilterMatcher {
 public:
   MockListenerFilterMatcher();
@@ -28,6 +28,9 @@ MockInternalRedirectPolicy::MockInternalRedirectPolicy() {
   ON_CALL(*this, enabled()).WillByDefault(Return(false));
 }
 
+MockProactiveHedging::MockProactiveHedging() = default;
+MockProactiveHedging::~MockProactiveHedging() = default;
+
 MockRetryState::MockRetryState() = default;
 
 void MockRetryState::expectHeadersRetry() {
@@ -44,6 +47,11 @@ void MockRetryState::expectHedgedPerTryTimeoutRetry() {
       .WillOnce(DoAll(SaveArg<0>(&callback_), Return(RetryStatus::Yes)));
 }
 
+void MockRetryState::expectProactiveHedge() {
+  EXPECT_CALL(*this, shouldHedgeProactively(_))
+      .WillOnce(DoAll(SaveArg<0>(&callback_), Return(RetryStatus::Yes)));
+}
+
 void MockRetryState::expectResetRetry() {
   EXPECT_CALL(*this, shouldRetryReset(_, _, _, _))
       .WillOnce(Invoke([this](const Http::StreamResetReason, RetryState::Http3Used,
@@ -105,6 +105,18 @@ public:
   absl::optional<bool> forward_not_matching_preflights_;
 };
 
+class MockProactiveHedging : public ProactiveHedging {
+public:
+  MockProactiveHedging();
+  ~MockProactiveHedging() override;
+
+  // Router::ProactiveHedging
+  MOCK_METHOD(absl::optional<std::chrono::milliseconds>, hedgeDelay, (), (const));
+  MOCK_METHOD(void, recordLatency, (std::chrono::milliseconds latency));
+  MOCK_METHOD(void, onRequest, ());
+  MOCK_METHOD(bool, tryHedge, ());
+};
+
 class TestHedgePolicy : public HedgePolicy {
 public:
   // Router::HedgePolicy
@@ -113,10 +125,12 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  ProactiveHedging* proactiveHedging() const override { return proactive_hedging_; }
 
   uint32_t initial_requests_{};
   envoy::type::v3::FractionalPercent additional_request_chance_;
   bool hedge_on_per_try_timeout_{};
+  ProactiveHedging* proactive_hedging_{};
 };
 
 class TestRetryPolicy : public RetryPolicy {
@@ -212,6 +226,7 @@ public:
 
   void expectHeadersRetry();
   void expectHedgedPerTryTimeoutRetry();
+  void expectProactiveHedge();
   void expectResetRetry();
 
   MOCK_METHOD(bool, enabled, ());
@@ -227,6 +242,7 @@ public:
               (const Http::StreamResetReason reset_reason, Http3Used alternate_protocol_used,
                DoRetryResetCallback callback, bool upstream_request_started));
   MOCK_METHOD(RetryStatus, shouldHedgeRetryPerTryTimeout, (DoRetryCallback callback));
+  MOCK_METHOD(RetryStatus, shouldHedgeProactively, (DoRetryCallback callback));
   MOCK_METHOD(void, onHostAttempted, (Upstream::HostDescriptionConstSharedPtr));
   MOCK_METHOD(bool, shouldSelectAnotherHost, (const Upstream::Host& host));
   MOCK_METHOD(const Upstream::HealthyAndDegradedLoad&, priorityLoadForRetry,
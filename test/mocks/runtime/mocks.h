@@ -54,6 +54,22 @@ public:
   MOCK_METHOD(double, getDouble, (absl::string_view key, double default_value), (const));
   MOCK_METHOD(bool, getBoolean, (absl::string_view key, bool default_value), (const));
   MOCK_METHOD(const std::vector<OverrideLayerConstPtr>&, getLayers, (), (const));
+
+  // Lookups through key handles are forwarded to the mocked lookups of their keys, so that
+  // expectations can be set on the keys regardless of how they are looked up.
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override {
+    return featureEnabled(key.key(), default_value);
+  }
+  uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const override {
+    return getInteger(key.key(), default_value);
+  }
+  double getDouble(const KeyHandle& key, double default_value) const override {
+    return getDouble(key.key(), default_value);
+  }
+  bool getBoolean(const KeyHandle& key, bool default_value) const override {
+    return getBoolean(key.key(), default_value);
+  }
 };
 
 class MockLoader : public Loader {
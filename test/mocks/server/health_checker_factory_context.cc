@@ -9,11 +9,16 @@ namespace Envoy {
 namespace Server {
 namespace Configuration {
 
+using ::testing::_;
 using ::testing::ReturnRef;
 
 MockHealthCheckerFactoryContext::MockHealthCheckerFactoryContext() {
   ON_CALL(*this, cluster()).WillByDefault(ReturnRef(cluster_));
   ON_CALL(*this, mainThreadDispatcher()).WillByDefault(ReturnRef(dispatcher_));
+  ON_CALL(*this, healthCheckDispatcher(_))
+      .WillByDefault([this](absl::optional<uint64_t>) -> Event::Dispatcher& {
+        return mainThreadDispatcher();
+      });
   ON_CALL(*this, random()).WillByDefault(ReturnRef(random_));
   ON_CALL(*this, runtime()).WillByDefault(ReturnRef(runtime_));
   ON_CALL(*this, messageValidationVisitor())
@@ -27,6 +27,7 @@ public:
 
   MOCK_METHOD(Upstream::Cluster&, cluster, ());
   MOCK_METHOD(Event::Dispatcher&, mainThreadDispatcher, ());
+  MOCK_METHOD(Event::Dispatcher&, healthCheckDispatcher, (absl::optional<uint64_t>));
   MOCK_METHOD(Envoy::Random::RandomGenerator&, random, ());
   MOCK_METHOD(Envoy::Runtime::Loader&, runtime, ());
   MOCK_METHOD(ProtobufMessage::ValidationVisitor&, messageValidationVisitor, ());
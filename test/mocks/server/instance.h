@@ -27,6 +27,7 @@ public:
   MOCK_METHOD(Http::HttpServerPropertiesCacheManager&, httpServerPropertiesCacheManager, ());
   MOCK_METHOD(Ssl::ContextManager&, sslContextManager, ());
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
+  MOCK_METHOD(Event::Dispatcher&, healthCheckDispatcher, (absl::optional<uint64_t>));
   MOCK_METHOD(Network::DnsResolverSharedPtr, dnsResolver, ());
   MOCK_METHOD(void, drainListeners, (OptRef<const Network::ExtraShutdownListenerOptions> options));
   MOCK_METHOD(DrainManager&, drainManager, ());
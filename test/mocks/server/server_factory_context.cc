@@ -6,6 +6,7 @@ namespace Envoy {
 namespace Server {
 namespace Configuration {
 
+using ::testing::_;
 using ::testing::Return;
 using ::testing::ReturnRef;
 
@@ -19,6 +20,10 @@ MockServerFactoryContext::MockServerFactoryContext()
   ON_CALL(*this, httpServerPropertiesCacheManager())
       .WillByDefault(ReturnRef(http_server_properties_cache_manager_));
   ON_CALL(*this, mainThreadDispatcher()).WillByDefault(ReturnRef(dispatcher_));
+  ON_CALL(*this, healthCheckDispatcher(_))
+      .WillByDefault([this](absl::optional<uint64_t>) -> Event::Dispatcher& {
+        return mainThreadDispatcher();
+      });
   ON_CALL(*this, drainDecision()).WillByDefault(ReturnRef(drain_manager_));
   ON_CALL(*this, localInfo()).WillByDefault(ReturnRef(local_info_));
   ON_CALL(*this, runtime()).WillByDefault(ReturnRef(runtime_loader_));
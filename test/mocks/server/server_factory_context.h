@@ -63,6 +63,7 @@ public:
   MOCK_METHOD(Config::XdsManager&, xdsManager, ());
   MOCK_METHOD(Http::HttpServerPropertiesCacheManager&, httpServerPropertiesCacheManager, ());
   MOCK_METHOD(Event::Dispatcher&, mainThreadDispatcher, ());
+  MOCK_METHOD(Event::Dispatcher&, healthCheckDispatcher, (absl::optional<uint64_t>));
   MOCK_METHOD(const Server::Options&, options, ());
   MOCK_METHOD(const Network::DrainDecision&, drainDecision, ());
   MOCK_METHOD(const LocalInfo::LocalInfo&, localInfo, (), (const));
@@ -164,6 +165,7 @@ public:
   MOCK_METHOD(Config::XdsManager&, xdsManager, ());
   MOCK_METHOD(Http::HttpServerPropertiesCacheManager&, httpServerPropertiesCacheManager, ());
   MOCK_METHOD(Event::Dispatcher&, mainThreadDispatcher, ());
+  MOCK_METHOD(Event::Dispatcher&, healthCheckDispatcher, (absl::optional<uint64_t>));
   MOCK_METHOD(const Server::Options&, options, ());
   MOCK_METHOD(const Network::DrainDecision&, drainDecision, ());
   MOCK_METHOD(const LocalInfo::LocalInfo&, localInfo, (), (const));
@@ -11,6 +11,7 @@
 #include "source/common/http/utility.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/router/upstream_codec_filter.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/upstream_impl.h"
 
 using testing::_;
@@ -58,8 +59,8 @@ MockClusterInfo::MockClusterInfo()
       lb_stats_(lb_stat_names_, *stats_store_.rootScope()),
       endpoint_stats_(endpoint_stat_names_, *stats_store_.rootScope()),
       transport_socket_matcher_(new NiceMock<Upstream::MockTransportSocketMatcher>()),
-      load_report_stats_(ClusterInfoImpl::generateLoadReportStats(
-          *load_report_stats_store_.rootScope(), cluster_load_report_stat_names_)),
+      load_report_stats_(Stats::createDeferredCompatibleStats<ClusterLoadReportStats>(
+          load_report_stats_store_.rootScope(), cluster_load_report_stat_names_, false)),
       request_response_size_stats_(std::make_unique<ClusterRequestResponseSizeStats>(
           ClusterInfoImpl::generateRequestResponseSizeStats(
               *request_response_size_stats_store_.rootScope(),
@@ -137,12 +137,13 @@ public:
   MOCK_METHOD(const std::string&, observabilityName, (), (const));
   MOCK_METHOD(ResourceManager&, resourceManager, (ResourcePriority priority), (const));
   MOCK_METHOD(TransportSocketMatcher&, transportSocketMatcher, (), (const));
+  MOCK_METHOD(uint64_t, transportSocketConfigHash, (), (const));
   MOCK_METHOD(DeferredCreationCompatibleClusterTrafficStats&, trafficStats, (), (const));
   MOCK_METHOD(ClusterLbStats&, lbStats, (), (const));
   MOCK_METHOD(ClusterEndpointStats&, endpointStats, (), (const));
   MOCK_METHOD(ClusterConfigUpdateStats&, configUpdateStats, (), (const));
   MOCK_METHOD(Stats::Scope&, statsScope, (), (const));
-  MOCK_METHOD(ClusterLoadReportStats&, loadReportStats, (), (const));
+  MOCK_METHOD(DeferredCreationCompatibleClusterLoadReportStats&, loadReportStats, (), (const));
   MOCK_METHOD(ClusterRequestResponseSizeStatsOptRef, requestResponseSizeStats, (), (const));
   MOCK_METHOD(ClusterTimeoutBudgetStatsOptRef, timeoutBudgetStats, (), (const));
   MOCK_METHOD(bool, perEndpointStatsEnabled, (), (const));
@@ -206,7 +207,7 @@ public:
   ClusterEndpointStats endpoint_stats_;
   Upstream::TransportSocketMatcherPtr transport_socket_matcher_;
   NiceMock<Stats::MockIsolatedStatsStore> load_report_stats_store_;
-  ClusterLoadReportStats load_report_stats_;
+  mutable DeferredCreationCompatibleClusterLoadReportStats load_report_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> request_response_size_stats_store_;
   ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> timeout_budget_stats_store_;
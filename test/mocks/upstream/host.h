@@ -99,6 +99,7 @@ public:
   MOCK_METHOD(const std::string&, hostname, (), (const));
   MOCK_METHOD(Network::UpstreamTransportSocketFactory&, transportSocketFactory, (), (const));
   MOCK_METHOD(HostStats&, stats, (), (const));
+  MOCK_METHOD(OptRef<HostStats>, statsIfAllocated, (), (const));
   MOCK_METHOD(LoadMetricStats&, loadMetricStats, (), (const));
   MOCK_METHOD(const envoy::config::core::v3::Locality&, locality, (), (const));
   MOCK_METHOD(uint32_t, priority, (), (const));
@@ -199,6 +200,7 @@ public:
   MOCK_METHOD(void, setOutlierDetector, (Outlier::DetectorHostMonitorPtr && outlier_detector));
   MOCK_METHOD(void, setLastHcPassTime, (MonotonicTime last_hc_pass_time));
   MOCK_METHOD(HostStats&, stats, (), (const));
+  MOCK_METHOD(OptRef<HostStats>, statsIfAllocated, (), (const));
   MOCK_METHOD(LoadMetricStats&, loadMetricStats, (), (const));
   MOCK_METHOD(uint32_t, weight, (), (const));
   MOCK_METHOD(void, weight, (uint32_t new_weight));
@@ -1,6 +1,8 @@
 #include "source/server/admin/admin.h"
 #include "source/server/admin/admin_filter.h"
 
+#include "test/mocks/buffer/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/server/instance.h"
 #include "test/test_common/environment.h"
 
@@ -73,5 +75,67 @@ TEST_P(AdminFilterTest, Trailers) {
   EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_.decodeTrailers(request_trailers));
 }
 
+// Emits one of the given chunks per call to nextChunk().
+class ChunkedRequest : public Admin::Request {
+public:
+  ChunkedRequest(std::vector<std::string> chunks) : chunks_(std::move(chunks)) {}
+
+  Http::Code start(Http::ResponseHeaderMap&) override { return Http::Code::OK; }
+  bool nextChunk(Buffer::Instance& response) override {
+    response.add(chunks_[index_++]);
+    return index_ < chunks_.size();
+  }
+
+private:
+  const std::vector<std::string> chunks_;
+  size_t index_{0};
+};
+
+class AdminFilterChunkedTest : public testing::Test {
+public:
+  AdminFilterChunkedTest() : filter_(admin_), request_headers_{{":path", "/"}} {
+    EXPECT_CALL(admin_, makeRequest(_))
+        .WillOnce(Return(ByMove(std::make_unique<ChunkedRequest>(
+            std::vector<std::string>{"chunk1", "chunk2", "chunk3"}))));
+    filter_.setDecoderFilterCallbacks(callbacks_);
+  }
+
+  NiceMock<MockAdmin> admin_;
+  AdminFilter filter_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> callbacks_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+};
+
+TEST_F(AdminFilterChunkedTest, YieldsBetweenChunks) {
+  auto* next_chunk = new Event::MockSchedulableCallback(&callbacks_.dispatcher_);
+
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, false));
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk1"), false));
+  EXPECT_CALL(*next_chunk, scheduleCallbackNextIteration());
+  filter_.decodeHeaders(request_headers_, true);
+
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk2"), false));
+  EXPECT_CALL(*next_chunk, scheduleCallbackNextIteration());
+  next_chunk->invokeCallback();
+
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk3"), true));
+  next_chunk->invokeCallback();
+  filter_.onDestroy();
+}
+
+TEST_F(AdminFilterChunkedTest, DestroyCancelsPendingChunks) {
+  testing::MockFunction<void()> destroy_cb;
+  auto* next_chunk = new Event::MockSchedulableCallback(&callbacks_.dispatcher_, &destroy_cb);
+
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, false));
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk1"), false));
+  EXPECT_CALL(*next_chunk, scheduleCallbackNextIteration());
+  filter_.decodeHeaders(request_headers_, true);
+
+  // The remaining chunks are never rendered.
+  EXPECT_CALL(destroy_cb, Call());
+  filter_.onDestroy();
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -154,6 +154,7 @@ TEST_P(AdminInstanceTest, Help) {
   /contention: dump current Envoy mutex contention stats (if enabled)
   /cpuprofiler (POST): enable/disable the CPU profiler
       enable: enables the CPU profiler; One of (y, n)
+  /dispatchers: print the slowest callbacks of the event dispatchers (if enabled)
   /drain_listeners (POST): drain listeners
       graceful: When draining listeners, enter a graceful drain period prior to closing listeners. This behaviour and duration is configurable via server options or CLI
       skip_exit: When draining listeners, do not exit after the drain period. This must be used with graceful
@@ -173,6 +174,8 @@ TEST_P(AdminInstanceTest, Help) {
       paths: Change multiple logging levels by setting to <logger_name1>:<desired_level1>,<logger_name2>:<desired_level2>. If fine grain logging is enabled, use __FILE__ or a glob experision as the logger name. For example, source/common*:warning
       level: desired logging level, this will change all loggers's level; One of (, trace, debug, info, warning, error, critical, off)
   /memory: print current allocation/heap usage
+  /memory/streams: print the streams using the most memory (if tracked)
+      limit: The maximum number of streams to print, 10 by default
   /quitquitquit (POST): exit the server
   /ready: print server state, return 200 if LIVE, otherwise return 503
   /reopen_logs (POST): reopen access logs
@@ -193,6 +193,45 @@ TEST_F(PrometheusStatsFormatterTest, FormattedTags) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST_F(PrometheusStatsFormatterTest, NameCache) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  custom_namespaces.registerStatNamespace("promstattest");
+  PrometheusNameCache cache(*symbol_table_);
+
+  addCounter("cluster.test_cluster_1.upstream_cx_total",
+             {{makeStat("a.tag-name"), makeStat("a.tag-value")}});
+  addCounter("promstattest.1234abcd.eats-liver", {});
+  const Stats::Counter& tagged = *counters_[0];
+  const Stats::Counter& invalid = *counters_[1];
+
+  uint64_t generation = cache.startScrape();
+  const std::string& name =
+      cache.metricName(tagged.tagExtractedStatName(), custom_namespaces, generation);
+  const std::string& tags = cache.formattedTags(tagged, generation);
+  EXPECT_EQ("envoy_cluster_test_cluster_1_upstream_cx_total", name);
+  EXPECT_EQ("a_tag_name=\"a.tag-value\"", tags);
+  EXPECT_EQ("", cache.metricName(invalid.tagExtractedStatName(), custom_namespaces, generation));
+  EXPECT_EQ("", cache.formattedTags(invalid, generation));
+  cache.endScrape();
+  EXPECT_EQ(4UL, cache.size());
+
+  // Subsequent scrapes reuse the rendered strings.
+  generation = cache.startScrape();
+  EXPECT_EQ(&name, &cache.metricName(tagged.tagExtractedStatName(), custom_namespaces, generation));
+  EXPECT_EQ(&tags, &cache.formattedTags(tagged, generation));
+  cache.endScrape();
+  EXPECT_EQ(4UL, cache.size());
+
+  // Entries that are not rendered by the recent scrapes are released.
+  for (uint64_t i = 0; i < PrometheusNameCache::MaxIdleScrapes; ++i) {
+    generation = cache.startScrape();
+    cache.metricName(tagged.tagExtractedStatName(), custom_namespaces, generation);
+    cache.formattedTags(tagged, generation);
+    cache.endScrape();
+  }
+  EXPECT_EQ(2UL, cache.size());
+}
+
 TEST_F(PrometheusStatsFormatterTest, MetricNameCollison) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
 
@@ -1,9 +1,15 @@
+#include "envoy/admin/v3/dispatchers.pb.h"
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "source/common/buffer/watermark_buffer.h"
+#include "source/common/event/callback_profiler.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/common/tls/context_config_impl.h"
 
+#include "test/mocks/http/stream_reset_handler.h"
 #include "test/server/admin/admin_instance.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 
 using testing::Ge;
@@ -63,6 +69,114 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
 }
 
+TEST_P(AdminInstanceTest, MemoryStreams) {
+  envoy::config::overload::v3::BufferFactoryConfig config;
+  config.set_minimum_account_to_track_power_of_two(20);
+  Buffer::WatermarkBufferFactory factory(config);
+  Http::MockStreamResetHandler reset_handler;
+  std::vector<Buffer::BufferMemoryAccountSharedPtr> accounts;
+  for (const auto& [connection_id, stream_id, bytes] :
+       std::vector<std::tuple<uint64_t, uint64_t, uint64_t>>{
+           {1, 10, 1 << 20}, {1, 11, 3 << 20}, {2, 20, 2 << 20}, {3, 30, 1 << 10}}) {
+    accounts.push_back(factory.createAccount(reset_handler));
+    accounts.back()->setOwner(connection_id, stream_id);
+    accounts.back()->charge(bytes);
+  }
+  accounts[0]->chargeNonBuffer(100);
+
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/memory/streams", header_map, response));
+  envoy::admin::v3::StreamsMemory output_proto;
+  TestUtility::loadFromJson(response.toString(), output_proto);
+  // The untracked stream of connection 3 is not reported.
+  ASSERT_EQ(3, output_proto.streams_size());
+  EXPECT_EQ(11, output_proto.streams(0).stream_id());
+  EXPECT_EQ(20, output_proto.streams(1).stream_id());
+  EXPECT_EQ(10, output_proto.streams(2).stream_id());
+  EXPECT_EQ(1, output_proto.streams(2).connection_id());
+  EXPECT_EQ(1 << 20, output_proto.streams(2).buffer_bytes());
+  EXPECT_EQ(100, output_proto.streams(2).non_buffer_bytes());
+  ASSERT_EQ(2, output_proto.connections_size());
+  EXPECT_EQ(1, output_proto.connections(0).connection_id());
+  EXPECT_EQ((4 << 20) + 100, output_proto.connections(0).bytes());
+  EXPECT_EQ(2, output_proto.connections(0).streams());
+  EXPECT_EQ(2, output_proto.connections(1).connection_id());
+
+  response.drain(response.length());
+  EXPECT_EQ(Http::Code::OK, getCallback("/memory/streams?limit=1", header_map, response));
+  TestUtility::loadFromJson(response.toString(), output_proto);
+  ASSERT_EQ(1, output_proto.streams_size());
+  EXPECT_EQ(11, output_proto.streams(0).stream_id());
+  // The total of the connection includes its streams that are not listed.
+  ASSERT_EQ(1, output_proto.connections_size());
+  EXPECT_EQ(1, output_proto.connections(0).connection_id());
+  EXPECT_EQ((4 << 20) + 100, output_proto.connections(0).bytes());
+  EXPECT_EQ(2, output_proto.connections(0).streams());
+
+  response.drain(response.length());
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/memory/streams?limit=0", header_map, response));
+
+  for (const auto& account : accounts) {
+    const auto& account_impl = static_cast<const Buffer::BufferMemoryAccountImpl&>(*account);
+    account->credit(account_impl.bufferBalance());
+    account->creditNonBuffer(account_impl.nonBufferBalance());
+    account->clearDownstream();
+  }
+}
+
+TEST_P(AdminInstanceTest, DispatchersNotEnabled) {
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/dispatchers", header_map, response));
+  EXPECT_THAT(response.toString(), HasSubstr("Dispatcher callback stats are not enabled"));
+}
+
+TEST_P(AdminInstanceTest, Dispatchers) {
+  server_.bootstrap_.set_enable_dispatcher_stats(true);
+  server_.bootstrap_.set_enable_dispatcher_callback_stats(true);
+
+  Event::SimulatedTimeSystem time_system;
+  Stats::IsolatedStoreImpl store;
+  Event::CallbackProfiler worker_profiler("worker_0", *store.rootScope(), "worker_0.dispatcher.",
+                                          time_system);
+  Event::CallbackProfiler main_profiler("main_thread", *store.rootScope(),
+                                        "server.dispatcher.", time_system);
+  MockScopeTrackedObject tracked_object;
+  for (const auto& [category, duration] :
+       std::vector<std::pair<Event::CallbackCategory, std::chrono::milliseconds>>{
+           {Event::CallbackCategory::Timer, std::chrono::milliseconds(5)},
+           {Event::CallbackCategory::FileEvent, std::chrono::milliseconds(20)}}) {
+    Event::CallbackProfiler::ScopedCallback profiled(&worker_profiler, category, nullptr);
+    worker_profiler.onTrackedObject(tracked_object);
+    time_system.advanceTimeWait(duration);
+  }
+
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/dispatchers", header_map, response));
+  envoy::admin::v3::Dispatchers output_proto;
+  TestUtility::loadFromJson(response.toString(), output_proto);
+  // Other tests of the process may have left profilers registered.
+  std::vector<const envoy::admin::v3::DispatcherCallbacks*> dispatchers;
+  for (const auto& dispatcher : output_proto.dispatchers()) {
+    if (dispatcher.name() == "main_thread" || dispatcher.name() == "worker_0") {
+      dispatchers.push_back(&dispatcher);
+    }
+  }
+  ASSERT_EQ(2, dispatchers.size());
+  EXPECT_EQ("main_thread", dispatchers[0]->name());
+  EXPECT_EQ(0, dispatchers[0]->slowest_callbacks_size());
+  EXPECT_EQ("worker_0", dispatchers[1]->name());
+  ASSERT_EQ(2, dispatchers[1]->slowest_callbacks_size());
+  const auto& slowest = dispatchers[1]->slowest_callbacks(0);
+  EXPECT_EQ(envoy::admin::v3::SlowCallback::FILE_EVENT, slowest.category());
+  EXPECT_EQ(20, DurationUtil::durationToMilliseconds(slowest.duration()));
+  EXPECT_EQ("Envoy::MockScopeTrackedObject", slowest.tracked_object_type());
+  EXPECT_EQ(envoy::admin::v3::SlowCallback::TIMER,
+            dispatchers[1]->slowest_callbacks(1).category());
+}
+
 TEST_P(AdminInstanceTest, GetReadyRequest) {
   NiceMock<Init::MockManager> initManager;
   ON_CALL(server_, initManager()).WillByDefault(ReturnRef(initManager));
@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "test/benchmark/main.h"
@@ -211,6 +212,25 @@ public:
     return count;
   }
 
+  /**
+   * Issues a streaming prometheus request against the stats saved in store_,
+   * rendering the names and labels of the stats through the given cache.
+   */
+  uint64_t handlerPrometheusStats(const StatsParams& params, PrometheusNameCache& cache) {
+    PrometheusStatsRequest request(*store_, params, cm_, custom_namespaces_, cache);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    request.start(*response_headers);
+    Buffer::OwnedImpl data;
+    uint64_t count = 0;
+    bool more = true;
+    do {
+      more = request.nextChunk(data);
+      count += data.length();
+      data.drain(data.length());
+    } while (more);
+    return count;
+  }
+
   std::vector<Stats::ScopeSharedPtr> scopes_;
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
   FastMockClusterManager cm_;
@@ -382,6 +402,55 @@ BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_disabled, false)
 BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_enabled, true)
     ->Unit(benchmark::kMillisecond);
 
+// Streams the same scrape as BM_AllCountersPrometheus in chunks, starting from
+// an empty name cache as the first scrape of a server does.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusStreaming(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  uint64_t count;
+  for (auto _ : state) { // NOLINT
+    Envoy::Server::PrometheusNameCache cache(test_context.store_->symbolTable());
+    count = test_context.handlerPrometheusStats(params, cache);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreaming, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreaming, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
+// Streams the same scrape as BM_AllCountersPrometheus in chunks, reusing the
+// names and labels rendered by the previous scrapes, so that only the values
+// are rendered.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusCached(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  Envoy::Server::PrometheusNameCache cache(test_context.store_->symbolTable());
+  uint64_t count = test_context.handlerPrometheusStats(params, cache);
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerPrometheusStats(params, cache);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusCached, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusCached, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_UsedCountersPrometheus(benchmark::State& state, bool per_endpoint_stats) {
   Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
@@ -4,6 +4,7 @@
 #include "source/common/common/regex.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
@@ -1546,6 +1547,44 @@ TEST_F(StatsHandlerPrometheusDefaultTest, HandlerStatsPrometheusUnsupportedBucke
   EXPECT_EQ(expected_response, code_response.second);
 }
 
+TEST_F(StatsHandlerPrometheusDefaultTest, HandlerStatsPrometheusChunked) {
+  const std::string url = "/stats?format=prometheus&text_readouts";
+
+  createTestStats();
+  Stats::Histogram& h1 = store_->histogramFromString("h1", Stats::Histogram::Unit::Unspecified);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 300));
+  h1.recordValue(300);
+  store_->mergeHistograms([]() -> void {});
+
+  const CodeResponse code_response = handlerStats(url);
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+
+  // Rendering in small chunks resumes in the middle of metric groups, and
+  // yields the same output as a single chunk.
+  PrometheusNameCache cache(symbol_table_);
+  for (uint64_t chunk_size : {1, 10, 100}) {
+    StatsParams params;
+    Buffer::OwnedImpl data;
+    ASSERT_EQ(Http::Code::OK, params.parse(url, data));
+    PrometheusStatsRequest request(*store_, params, endpoints_helper_.cm_, custom_namespaces_,
+                                   cache);
+    request.setChunkSize(chunk_size);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+    std::string response;
+    uint32_t num_chunks = 1;
+    while (request.nextChunk(data)) {
+      EXPECT_LE(chunk_size, data.length());
+      response += data.toString();
+      data.drain(data.length());
+      ++num_chunks;
+    }
+    response += data.toString();
+    EXPECT_EQ(code_response.second, response);
+    EXPECT_LT(1, num_chunks);
+  }
+}
+
 class StatsHandlerPrometheusWithTextReadoutsTest
     : public StatsHandlerPrometheusTest,
       public testing::TestWithParam<std::tuple<Network::Address::IpVersion, std::string>> {};
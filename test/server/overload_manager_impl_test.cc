@@ -903,6 +903,16 @@ TEST_F(OverloadManagerImplTest, ShouldThrowIfUsingResetStreamsWithoutBufferFacto
                           "Overload action .* requires buffer_factory_config.");
 }
 
+TEST_F(OverloadManagerImplTest, ShouldThrowIfUsingResetLargestStreamsWithoutBufferFactoryConfig) {
+  const std::string config = R"EOF(
+  actions:
+    - name: envoy.overload_actions.reset_largest_memory_streams
+  )EOF";
+
+  EXPECT_THROW_WITH_REGEX(createOverloadManager(config), EnvoyException,
+                          "Overload action .* requires buffer_factory_config.");
+}
+
 TEST_F(OverloadManagerImplTest, Shutdown) {
   setDispatcherExpectation();
 